@@ -0,0 +1,419 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file bench_cpu_systems.cpp
+ *  \brief Measures the algorithms of the cpp, omp, tbb and threads systems
+ *         over element types, sizes, thread counts and input distributions,
+ *         and writes the results as JSON. See README.md for how to build,
+ *         run and compare it.
+ */
+
+#include <thrust/copy.h>
+#include <thrust/gather.h>
+#include <thrust/merge.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/set_operations.h>
+#include <thrust/sort.h>
+#include <thrust/system/cpp/execution_policy.h>
+#include <thrust/system/threads/execution_policy.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+
+#ifdef _OPENMP
+#include <thrust/system/omp/execution_policy.h>
+#include <omp.h>
+#endif
+
+#ifdef THRUST_BENCHMARK_TBB
+#include <thrust/system/tbb/execution_policy.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include "bench_utils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+
+struct options
+{
+  std::string systems, algorithms, types, distributions;
+  std::vector<std::size_t> sizes;
+  std::vector<int> threads;
+  double min_seconds;
+  int max_iterations;
+  std::uint64_t seed;
+  std::string output;
+};
+
+
+template<typename T>
+struct is_positive
+{
+  bool operator()(const T &x) const
+  {
+    return x > T(0);
+  }
+};
+
+
+// each system runs a benchmark on the policy of each thread count it can be
+// given; the cpp system always runs on one thread and the threads system on
+// the threads of its pool, which THRUST_THREADS_NUM_THREADS sets
+struct cpp_system
+{
+  static const char *name() { return "cpp"; }
+
+  static std::vector<int> thread_counts(const options &)
+  {
+    return std::vector<int>(1, 1);
+  }
+
+  template<typename Benchmark>
+  static void run(int, Benchmark benchmark)
+  {
+    benchmark(thrust::cpp::par);
+  }
+};
+
+
+struct threads_system
+{
+  static const char *name() { return "threads"; }
+
+  static std::vector<int> thread_counts(const options &)
+  {
+    return std::vector<int>(1, static_cast<int>(thrust::system::threads::detail::thread_pool::instance().size()));
+  }
+
+  template<typename Benchmark>
+  static void run(int, Benchmark benchmark)
+  {
+    benchmark(thrust::threads::par);
+  }
+};
+
+
+#ifdef _OPENMP
+struct omp_system
+{
+  static const char *name() { return "omp"; }
+
+  static std::vector<int> thread_counts(const options &opts)
+  {
+    return opts.threads;
+  }
+
+  template<typename Benchmark>
+  static void run(int threads, Benchmark benchmark)
+  {
+    // OpenMP never runs more threads than omp_get_max_threads()
+    if(omp_get_max_threads() < threads) omp_set_num_threads(threads);
+
+    benchmark(thrust::omp::par.with(0, threads));
+  }
+};
+#endif
+
+
+#ifdef THRUST_BENCHMARK_TBB
+struct tbb_system
+{
+  static const char *name() { return "tbb"; }
+
+  static std::vector<int> thread_counts(const options &opts)
+  {
+    return opts.threads;
+  }
+
+  template<typename Benchmark>
+  static void run(int threads, Benchmark benchmark)
+  {
+    ::tbb::task_arena arena(threads);
+    arena.execute([&]{ benchmark(thrust::tbb::par); });
+  }
+};
+#endif
+
+
+// the inputs of every algorithm for one element type, size and distribution
+template<typename T>
+struct inputs
+{
+  std::vector<T> keys, values;
+  std::vector<T> lhs, rhs;
+  std::vector<std::size_t> map, permutation;
+
+  inputs(std::size_t n, bench::distribution d, std::uint64_t seed)
+    : keys(bench::generate<T>(n, d, seed)),
+      values(bench::generate<T>(n, bench::random, seed + 1)),
+      map(bench::generate_map(n, d, seed + 2)),
+      // scatter is only defined for maps without duplicates
+      permutation(d == bench::few_unique ? bench::generate_map(n, bench::random, seed + 2) : map)
+  {
+    // the sorted halves of the keys are the inputs of merge and the set
+    // operations; sorted and reverse inputs give halves which do not overlap
+    lhs.assign(keys.begin(), keys.begin() + n / 2);
+    rhs.assign(keys.begin() + n / 2, keys.end());
+
+    std::sort(lhs.begin(), lhs.end());
+    std::sort(rhs.begin(), rhs.end());
+  }
+};
+
+
+template<typename T, typename System>
+void run_algorithms(const options &opts,
+                    const inputs<T> &in,
+                    bench::distribution d,
+                    std::vector<bench::result> &results)
+{
+  const std::size_t n = in.keys.size();
+
+  std::vector<T> keys(n), values(n), keys_out(n), values_out(n);
+
+  bench::timer timer(opts.min_seconds, opts.max_iterations);
+
+  const std::vector<int> thread_counts = System::thread_counts(opts);
+
+  for(std::size_t t = 0; t < thread_counts.size(); ++t)
+  {
+    const int threads = thread_counts[t];
+
+    auto measure = [&](const char *algorithm, auto setup, auto run)
+    {
+      if(!bench::selected(opts.algorithms, algorithm)) return;
+
+      System::run(threads, [&](auto policy){ timer.measure(setup, [&]{ run(policy); }); });
+
+      bench::result r;
+      r.system         = System::name();
+      r.algorithm      = algorithm;
+      r.type           = bench::type_name<T>::get();
+      r.distribution   = bench::distribution_name(d);
+      r.size           = n;
+      r.threads        = threads;
+      r.iterations     = timer.iterations();
+      r.median_seconds = timer.median();
+      r.min_seconds    = timer.min();
+
+      std::cerr << r.name() << ": " << r.median_seconds * 1e3 << " ms" << std::endl;
+
+      results.push_back(r);
+    };
+
+    auto copy_keys = [&]{ std::copy(in.keys.begin(), in.keys.end(), keys.begin()); };
+    auto copy_pairs = [&]{ copy_keys(); std::copy(in.values.begin(), in.values.end(), values.begin()); };
+    auto nothing = []{};
+
+    measure("sort", copy_keys, [&](auto policy)
+    {
+      thrust::sort(policy, keys.data(), keys.data() + n);
+    });
+
+    measure("sort_by_key", copy_pairs, [&](auto policy)
+    {
+      thrust::sort_by_key(policy, keys.data(), keys.data() + n, values.data());
+    });
+
+    measure("inclusive_scan", nothing, [&](auto policy)
+    {
+      thrust::inclusive_scan(policy, in.keys.data(), in.keys.data() + n, keys_out.data());
+    });
+
+    measure("reduce_by_key", nothing, [&](auto policy)
+    {
+      thrust::reduce_by_key(policy, in.keys.data(), in.keys.data() + n, in.values.data(), keys_out.data(), values_out.data());
+    });
+
+    measure("copy_if", nothing, [&](auto policy)
+    {
+      thrust::copy_if(policy, in.keys.data(), in.keys.data() + n, keys_out.data(), is_positive<T>());
+    });
+
+    measure("merge", nothing, [&](auto policy)
+    {
+      thrust::merge(policy, in.lhs.data(), in.lhs.data() + in.lhs.size(), in.rhs.data(), in.rhs.data() + in.rhs.size(), keys_out.data());
+    });
+
+    measure("set_union", nothing, [&](auto policy)
+    {
+      thrust::set_union(policy, in.lhs.data(), in.lhs.data() + in.lhs.size(), in.rhs.data(), in.rhs.data() + in.rhs.size(), keys_out.data());
+    });
+
+    measure("set_intersection", nothing, [&](auto policy)
+    {
+      thrust::set_intersection(policy, in.lhs.data(), in.lhs.data() + in.lhs.size(), in.rhs.data(), in.rhs.data() + in.rhs.size(), keys_out.data());
+    });
+
+    measure("gather", nothing, [&](auto policy)
+    {
+      thrust::gather(policy, in.map.data(), in.map.data() + n, in.keys.data(), keys_out.data());
+    });
+
+    measure("scatter", nothing, [&](auto policy)
+    {
+      thrust::scatter(policy, in.keys.data(), in.keys.data() + n, in.permutation.data(), keys_out.data());
+    });
+  }
+}
+
+
+template<typename T>
+void run_type(const options &opts, std::vector<bench::result> &results)
+{
+  if(!bench::selected(opts.types, bench::type_name<T>::get())) return;
+
+  const bench::distribution distributions[] = {bench::sorted, bench::reverse, bench::few_unique, bench::random};
+
+  for(bench::distribution d : distributions)
+  {
+    if(!bench::selected(opts.distributions, bench::distribution_name(d))) continue;
+
+    for(std::size_t n : opts.sizes)
+    {
+      const inputs<T> in(n, d, opts.seed);
+
+      if(bench::selected(opts.systems, cpp_system::name()))     run_algorithms<T,cpp_system>(opts, in, d, results);
+#ifdef _OPENMP
+      if(bench::selected(opts.systems, omp_system::name()))     run_algorithms<T,omp_system>(opts, in, d, results);
+#endif
+#ifdef THRUST_BENCHMARK_TBB
+      if(bench::selected(opts.systems, tbb_system::name()))     run_algorithms<T,tbb_system>(opts, in, d, results);
+#endif
+      if(bench::selected(opts.systems, threads_system::name())) run_algorithms<T,threads_system>(opts, in, d, results);
+    }
+  }
+}
+
+
+void usage(const char *program)
+{
+  std::cerr <<
+    "usage: " << program << " [options]\n"
+    "  --systems LIST        cpp,omp,tbb,threads (default: all that were built)\n"
+    "  --algorithms LIST     sort,sort_by_key,inclusive_scan,reduce_by_key,copy_if,\n"
+    "                        merge,set_union,set_intersection,gather,scatter (default: all)\n"
+    "  --types LIST          i8,i16,i32,i64,f32,f64 (default: all)\n"
+    "  --distributions LIST  sorted,reverse,few_unique,random (default: all)\n"
+    "  --sizes LIST          element counts (default: 1000,10000,...,10000000)\n"
+    "  --threads LIST        thread counts of omp and tbb (default: 1,2,4,... up to the cores)\n"
+    "  --min-time SECONDS    the least time measured per configuration (default: 0.1)\n"
+    "  --max-iterations N    the most runs measured per configuration (default: 100)\n"
+    "  --seed N              the seed of the inputs (default: 1)\n"
+    "  --output FILE         write the JSON there instead of to stdout\n";
+}
+
+
+} // end namespace
+
+
+int main(int argc, char **argv)
+{
+  options opts;
+  opts.min_seconds    = 0.1;
+  opts.max_iterations = 100;
+  opts.seed           = 1;
+
+  for(std::size_t n = 1000; n <= 10000000; n *= 10) opts.sizes.push_back(n);
+
+  const int cores = std::max(1u, std::thread::hardware_concurrency());
+  for(int t = 1; t < cores; t *= 2) opts.threads.push_back(t);
+  opts.threads.push_back(cores);
+
+  try
+  {
+    for(int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+
+      if(arg == "--help" || arg == "-h")
+      {
+        usage(argv[0]);
+        return 0;
+      }
+
+      if(i + 1 == argc) throw std::invalid_argument("missing the value of " + arg);
+
+      const std::string value = argv[++i];
+
+      if(arg == "--systems")             opts.systems = value;
+      else if(arg == "--algorithms")     opts.algorithms = value;
+      else if(arg == "--types")          opts.types = value;
+      else if(arg == "--distributions")
+      {
+        opts.distributions = value;
+        for(const std::string &d : bench::split(value)) bench::parse_distribution(d);
+      }
+      else if(arg == "--sizes" || arg == "--threads")
+      {
+        if(arg == "--sizes") opts.sizes.clear();
+        else                 opts.threads.clear();
+
+        for(const std::string &s : bench::split(value))
+        {
+          // accept 1e9 as well as 1000000000
+          const std::size_t x = static_cast<std::size_t>(std::stod(s));
+
+          if(arg == "--sizes") opts.sizes.push_back(x);
+          else                 opts.threads.push_back(static_cast<int>(x));
+        }
+      }
+      else if(arg == "--min-time")       opts.min_seconds = std::stod(value);
+      else if(arg == "--max-iterations") opts.max_iterations = std::stoi(value);
+      else if(arg == "--seed")           opts.seed = std::stoull(value);
+      else if(arg == "--output")         opts.output = value;
+      else throw std::invalid_argument("unknown option " + arg);
+    }
+  }
+  catch(const std::exception &e)
+  {
+    std::cerr << e.what() << std::endl;
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<bench::result> results;
+
+  run_type<std::int8_t>(opts, results);
+  run_type<std::int16_t>(opts, results);
+  run_type<std::int32_t>(opts, results);
+  run_type<std::int64_t>(opts, results);
+  run_type<float>(opts, results);
+  run_type<double>(opts, results);
+
+  std::FILE *out = opts.output.empty() ? stdout : std::fopen(opts.output.c_str(), "w");
+
+  if(!out)
+  {
+    std::perror(opts.output.c_str());
+    return 1;
+  }
+
+  bench::write_json(out, results);
+
+  if(out != stdout) std::fclose(out);
+
+  return 0;
+}
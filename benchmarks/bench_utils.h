@@ -0,0 +1,316 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file bench_utils.h
+ *  \brief Timing, input generation, command line and JSON output shared by
+ *         the CPU system benchmarks.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench
+{
+
+
+// the name each element type is reported under
+template<typename T> struct type_name;
+template<> struct type_name<std::int8_t>  { static const char *get() { return "i8";  } };
+template<> struct type_name<std::int16_t> { static const char *get() { return "i16"; } };
+template<> struct type_name<std::int32_t> { static const char *get() { return "i32"; } };
+template<> struct type_name<std::int64_t> { static const char *get() { return "i64"; } };
+template<> struct type_name<float>        { static const char *get() { return "f32"; } };
+template<> struct type_name<double>       { static const char *get() { return "f64"; } };
+
+
+enum distribution
+{
+  sorted,
+  reverse,
+  few_unique,
+  random
+};
+
+inline const char *distribution_name(distribution d)
+{
+  switch(d)
+  {
+    case sorted:     return "sorted";
+    case reverse:    return "reverse";
+    case few_unique: return "few_unique";
+    default:         return "random";
+  }
+}
+
+inline distribution parse_distribution(const std::string &name)
+{
+  if(name == "sorted")     return sorted;
+  if(name == "reverse")    return reverse;
+  if(name == "few_unique") return few_unique;
+  if(name == "random")     return random;
+
+  throw std::invalid_argument("unknown distribution " + name);
+}
+
+
+// a value drawn uniformly from the whole range of an integer T, or from
+// [-1, 1) for a floating point T
+template<typename T>
+T random_value(std::mt19937_64 &rng)
+{
+  if(std::is_floating_point<T>::value)
+  {
+    return static_cast<T>(std::uniform_real_distribution<double>(-1.0, 1.0)(rng));
+  }
+
+  return static_cast<T>(rng());
+}
+
+
+// returns n values following distribution d; few_unique draws them from 16
+// distinct values. The same seed always yields the same values
+template<typename T>
+std::vector<T> generate(std::size_t n, distribution d, std::uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<T> result(n);
+
+  if(d == few_unique)
+  {
+    T values[16];
+    for(int i = 0; i < 16; ++i) values[i] = random_value<T>(rng);
+
+    for(std::size_t i = 0; i < n; ++i) result[i] = values[rng() % 16];
+
+    return result;
+  }
+
+  for(std::size_t i = 0; i < n; ++i) result[i] = random_value<T>(rng);
+
+  if(d == sorted)  std::sort(result.begin(), result.end());
+  if(d == reverse) std::sort(result.begin(), result.end(), std::greater<T>());
+
+  return result;
+}
+
+
+// returns n indices into [0, n) following distribution d: the identity when
+// sorted, reversed when reverse, a random permutation when random and 16
+// distinct indices when few_unique
+inline std::vector<std::size_t> generate_map(std::size_t n, distribution d, std::uint64_t seed)
+{
+  std::mt19937_64 rng(seed);
+  std::vector<std::size_t> result(n);
+
+  for(std::size_t i = 0; i < n; ++i) result[i] = i;
+
+  if(d == reverse) std::reverse(result.begin(), result.end());
+  if(d == random)  std::shuffle(result.begin(), result.end(), rng);
+
+  if(d == few_unique && n > 0)
+  {
+    std::size_t indices[16];
+    for(int i = 0; i < 16; ++i) indices[i] = rng() % n;
+
+    for(std::size_t i = 0; i < n; ++i) result[i] = indices[rng() % 16];
+  }
+
+  return result;
+}
+
+
+// the wall clock seconds of each of several runs of a benchmark
+class timer
+{
+  public:
+    timer(double min_seconds, int max_iterations)
+      : m_min_seconds(min_seconds), m_max_iterations(max_iterations)
+    {}
+
+    // calls setup() then measures run() until they have run for min_seconds
+    // in total, at least three times and at most max_iterations times; the
+    // first, untimed run warms up caches and thread pools
+    template<typename Setup, typename Run>
+    void measure(Setup setup, Run run)
+    {
+      m_seconds.clear();
+
+      setup();
+      run();
+
+      double total = 0;
+      while(static_cast<int>(m_seconds.size()) < m_max_iterations &&
+            (m_seconds.size() < 3 || total < m_min_seconds))
+      {
+        setup();
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+        m_seconds.push_back(std::chrono::duration<double>(stop - start).count());
+        total += m_seconds.back();
+      }
+    }
+
+    int iterations() const
+    {
+      return static_cast<int>(m_seconds.size());
+    }
+
+    // the median is robust to the occasional preempted run
+    double median() const
+    {
+      std::vector<double> seconds = m_seconds;
+      std::sort(seconds.begin(), seconds.end());
+
+      const std::size_t n = seconds.size();
+      return n % 2 ? seconds[n / 2] : (seconds[n / 2 - 1] + seconds[n / 2]) / 2;
+    }
+
+    double min() const
+    {
+      return *std::min_element(m_seconds.begin(), m_seconds.end());
+    }
+
+  private:
+    double m_min_seconds;
+    int m_max_iterations;
+    std::vector<double> m_seconds;
+};
+
+
+// one measured configuration
+struct result
+{
+  std::string system, algorithm, type, distribution;
+  std::size_t size;
+  int threads;
+  int iterations;
+  double median_seconds, min_seconds;
+
+  // the name a comparison matches results by
+  std::string name() const
+  {
+    std::ostringstream name;
+    name << system << '/' << algorithm << '/' << type << '/' << distribution << '/' << size << '/' << threads;
+    return name.str();
+  }
+};
+
+
+inline std::string json_string(const std::string &s)
+{
+  std::string result = "\"";
+
+  for(std::size_t i = 0; i < s.size(); ++i)
+  {
+    if(s[i] == '"' || s[i] == '\\') result += '\\';
+    result += s[i];
+  }
+
+  return result + "\"";
+}
+
+
+// writes the results in the layout of Google Benchmark's JSON output, so
+// that the tools reading it, such as its compare.py, read these too; the
+// fields describing the configuration are added to each benchmark
+inline void write_json(std::FILE *out, const std::vector<result> &results)
+{
+  char date[64] = "";
+  const std::time_t now = std::time(0);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+  std::fprintf(out, "{\n");
+  std::fprintf(out, "  \"context\": {\n");
+  std::fprintf(out, "    \"date\": %s,\n", json_string(date).c_str());
+  std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#if defined(__VERSION__)
+  std::fprintf(out, "    \"compiler\": %s,\n", json_string(__VERSION__).c_str());
+#endif
+  std::fprintf(out, "    \"library_build_type\": %s\n", json_string(
+#ifdef NDEBUG
+    "release"
+#else
+    "debug"
+#endif
+  ).c_str());
+  std::fprintf(out, "  },\n");
+  std::fprintf(out, "  \"benchmarks\": [");
+
+  for(std::size_t i = 0; i < results.size(); ++i)
+  {
+    const result &r = results[i];
+
+    std::fprintf(out, "%s\n    {\n", i ? "," : "");
+    std::fprintf(out, "      \"name\": %s,\n", json_string(r.name()).c_str());
+    std::fprintf(out, "      \"run_type\": \"iteration\",\n");
+    std::fprintf(out, "      \"system\": %s,\n", json_string(r.system).c_str());
+    std::fprintf(out, "      \"algorithm\": %s,\n", json_string(r.algorithm).c_str());
+    std::fprintf(out, "      \"type\": %s,\n", json_string(r.type).c_str());
+    std::fprintf(out, "      \"distribution\": %s,\n", json_string(r.distribution).c_str());
+    std::fprintf(out, "      \"size\": %zu,\n", r.size);
+    std::fprintf(out, "      \"threads\": %d,\n", r.threads);
+    std::fprintf(out, "      \"iterations\": %d,\n", r.iterations);
+    std::fprintf(out, "      \"real_time\": %.1f,\n", r.median_seconds * 1e9);
+    std::fprintf(out, "      \"cpu_time\": %.1f,\n", r.median_seconds * 1e9);
+    std::fprintf(out, "      \"min_time\": %.1f,\n", r.min_seconds * 1e9);
+    std::fprintf(out, "      \"time_unit\": \"ns\",\n");
+    std::fprintf(out, "      \"items_per_second\": %.6g\n", r.median_seconds > 0 ? r.size / r.median_seconds : 0.0);
+    std::fprintf(out, "    }");
+  }
+
+  std::fprintf(out, "\n  ]\n}\n");
+}
+
+
+// splits a comma separated list
+inline std::vector<std::string> split(const std::string &list)
+{
+  std::vector<std::string> result;
+  std::istringstream in(list);
+
+  for(std::string item; std::getline(in, item, ',');)
+  {
+    if(!item.empty()) result.push_back(item);
+  }
+
+  return result;
+}
+
+
+// whether the comma separated list is empty or holds item
+inline bool selected(const std::string &list, const std::string &item)
+{
+  const std::vector<std::string> items = split(list);
+  return items.empty() || std::find(items.begin(), items.end(), item) != items.end();
+}
+
+
+} // end bench
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+#
+#  Copyright 2008-2013 NVIDIA Corporation
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+"""Compares two JSON outputs of bench_cpu_systems.
+
+Matches the benchmarks of both files by name, prints the change of the
+median time of each and exits with status 1 when any got slower by more than
+the threshold, so that a CI job fails on a regression.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {b["name"]: b for b in json.load(f)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="JSON output of the reference build")
+    parser.add_argument("contender", help="JSON output of the build to check")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="the relative slowdown reported as a regression (default: 0.10)")
+    parser.add_argument("--min-time", type=float, default=1e4,
+                        help="ignore benchmarks faster than this many nanoseconds in the baseline, "
+                             "whose times are mostly noise (default: 10000)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    regressions = 0
+
+    for name in sorted(set(baseline) & set(contender)):
+        old = baseline[name]["real_time"]
+        new = contender[name]["real_time"]
+
+        if old < args.min_time or old <= 0:
+            continue
+
+        change = new / old - 1
+        regressed = change > args.threshold
+        regressions += regressed
+
+        print("%-60s %12.0f %12.0f %+7.1f%%%s" % (name, old, new, 100 * change, "  REGRESSION" if regressed else ""))
+
+    for name in sorted(set(baseline) - set(contender)):
+        print("%-60s only in the baseline" % name)
+
+    for name in sorted(set(contender) - set(baseline)):
+        print("%-60s only in the contender" % name)
+
+    if regressions:
+        print("%d regression(s) above %.0f%%" % (regressions, 100 * args.threshold))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
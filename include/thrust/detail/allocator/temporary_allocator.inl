@@ -21,6 +21,7 @@
 #include <thrust/detail/allocator/temporary_allocator.h>
 #include <thrust/detail/temporary_buffer.h>
 #include <thrust/system/detail/bad_alloc.h>
+#include <thrust/detail/trace.h>
 #include <cassert>
 
 #if (defined(_NVHPC_CUDA) || defined(__CUDA_ARCH__)) && \
@@ -65,6 +66,12 @@ __host__ __device__
     }
   } // end if
 
+  if (THRUST_IS_HOST_CODE) {
+    #if THRUST_INCLUDE_HOST_CODE
+      THRUST_TRACE_TEMPORARY_ALLOCATION(System, cnt * sizeof(T));
+    #endif
+  }
+
   return result.first;
 } // end temporary_allocator::allocate()
 
@@ -23,6 +23,7 @@
 #define THRUST_DEVICE_SYSTEM_TBB     3
 #define THRUST_DEVICE_SYSTEM_CPP     4
 #define THRUST_DEVICE_SYSTEM_HIP     5
+#define THRUST_DEVICE_SYSTEM_THREADS 6
 
 #ifndef THRUST_DEVICE_SYSTEM
 #if THRUST_DEVICE_COMPILER == THRUST_DEVICE_COMPILER_HIP
@@ -64,6 +65,8 @@
 #define __THRUST_DEVICE_SYSTEM_NAMESPACE cpp
 #elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_HIP
 #define __THRUST_DEVICE_SYSTEM_NAMESPACE hip
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_THREADS
+#define __THRUST_DEVICE_SYSTEM_NAMESPACE threads
 #endif
 
 #define __THRUST_DEVICE_SYSTEM_ROOT thrust/system/__THRUST_DEVICE_SYSTEM_NAMESPACE
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/histogram.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+#include <thrust/system/detail/generic/histogram.h>
+#include <thrust/system/detail/adl/histogram.h>
+
+THRUST_NAMESPACE_BEGIN
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename InputIterator, typename RandomAccessIterator, typename Size, typename T>
+__host__ __device__
+  RandomAccessIterator histogram_even(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  using thrust::system::detail::generic::histogram_even;
+  return histogram_even(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, histogram, num_bins, lower_level, upper_level);
+} // end histogram_even()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename InputIterator, typename LevelIterator, typename RandomAccessIterator>
+__host__ __device__
+  RandomAccessIterator histogram_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  using thrust::system::detail::generic::histogram_range;
+  return histogram_range(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, levels_first, levels_last, histogram);
+} // end histogram_range()
+
+
+template<typename InputIterator, typename RandomAccessIterator, typename Size, typename T>
+  RandomAccessIterator histogram_even(InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator>::type        System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::histogram_even(select_system(system1,system2), first, last, histogram, num_bins, lower_level, upper_level);
+} // end histogram_even()
+
+
+template<typename InputIterator, typename LevelIterator, typename RandomAccessIterator>
+  RandomAccessIterator histogram_range(InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator>::type        System1;
+  typedef typename thrust::iterator_system<LevelIterator>::type        System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return thrust::histogram_range(select_system(system1,system2,system3), first, last, levels_first, levels_last, histogram);
+} // end histogram_range()
+
+
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/partial_sort.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+#include <thrust/system/detail/generic/partial_sort.h>
+#include <thrust/system/detail/adl/partial_sort.h>
+
+THRUST_NAMESPACE_BEGIN
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator>
+__host__ __device__
+  void nth_element(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last)
+{
+  using thrust::system::detail::generic::nth_element;
+  return nth_element(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, nth, last);
+} // end nth_element()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::nth_element;
+  return nth_element(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, nth, last, comp);
+} // end nth_element()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+__host__ __device__
+  void nth_element_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first)
+{
+  using thrust::system::detail::generic::nth_element_by_key;
+  return nth_element_by_key(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_nth, keys_last, values_first);
+} // end nth_element_by_key()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first,
+                          StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::nth_element_by_key;
+  return nth_element_by_key(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_nth, keys_last, values_first, comp);
+} // end nth_element_by_key()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator>
+__host__ __device__
+  void partial_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last)
+{
+  using thrust::system::detail::generic::partial_sort;
+  return partial_sort(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, middle, last);
+} // end partial_sort()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last,
+                    StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::partial_sort;
+  return partial_sort(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, middle, last, comp);
+} // end partial_sort()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+__host__ __device__
+  void partial_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first)
+{
+  using thrust::system::detail::generic::partial_sort_by_key;
+  return partial_sort_by_key(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_middle, keys_last, values_first);
+} // end partial_sort_by_key()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::partial_sort_by_key;
+  return partial_sort_by_key(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_middle, keys_last, values_first, comp);
+} // end partial_sort_by_key()
+
+
+template<typename RandomAccessIterator>
+  void nth_element(RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::nth_element(select_system(system), first, nth, last);
+} // end nth_element()
+
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  void nth_element(RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::nth_element(select_system(system), first, nth, last, comp);
+} // end nth_element()
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+  void nth_element_by_key(RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::nth_element_by_key(select_system(system1,system2), keys_first, keys_nth, keys_last, values_first);
+} // end nth_element_by_key()
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+  void nth_element_by_key(RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first,
+                          StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::nth_element_by_key(select_system(system1,system2), keys_first, keys_nth, keys_last, values_first, comp);
+} // end nth_element_by_key()
+
+
+template<typename RandomAccessIterator>
+  void partial_sort(RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::partial_sort(select_system(system), first, middle, last);
+} // end partial_sort()
+
+
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  void partial_sort(RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last,
+                    StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::partial_sort(select_system(system), first, middle, last, comp);
+} // end partial_sort()
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+  void partial_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::partial_sort_by_key(select_system(system1,system2), keys_first, keys_middle, keys_last, values_first);
+} // end partial_sort_by_key()
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+  void partial_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::partial_sort_by_key(select_system(system1,system2), keys_first, keys_middle, keys_last, values_first, comp);
+} // end partial_sort_by_key()
+
+
+THRUST_NAMESPACE_END
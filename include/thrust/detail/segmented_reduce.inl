@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/segmented_reduce.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+#include <thrust/system/detail/generic/segmented_reduce.h>
+#include <thrust/system/detail/adl/segmented_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename InputIterator, typename OffsetIterator, typename OutputIterator>
+__host__ __device__
+  OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result)
+{
+  using thrust::system::detail::generic::segmented_reduce;
+  return segmented_reduce(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, offsets_first, offsets_last, result);
+} // end segmented_reduce()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T>
+__host__ __device__
+  OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init)
+{
+  using thrust::system::detail::generic::segmented_reduce;
+  return segmented_reduce(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, offsets_first, offsets_last, result, init);
+} // end segmented_reduce()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T, typename BinaryFunction>
+__host__ __device__
+  OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op)
+{
+  using thrust::system::detail::generic::segmented_reduce;
+  return segmented_reduce(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, offsets_first, offsets_last, result, init, binary_op);
+} // end segmented_reduce()
+
+
+template<typename InputIterator, typename OffsetIterator, typename OutputIterator>
+  OutputIterator segmented_reduce(InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator>::type  System1;
+  typedef typename thrust::iterator_system<OutputIterator>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::segmented_reduce(select_system(system1,system2), first, last, offsets_first, offsets_last, result);
+} // end segmented_reduce()
+
+
+template<typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T>
+  OutputIterator segmented_reduce(InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator>::type  System1;
+  typedef typename thrust::iterator_system<OutputIterator>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::segmented_reduce(select_system(system1,system2), first, last, offsets_first, offsets_last, result, init);
+} // end segmented_reduce()
+
+
+template<typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T, typename BinaryFunction>
+  OutputIterator segmented_reduce(InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator>::type  System1;
+  typedef typename thrust::iterator_system<OutputIterator>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::segmented_reduce(select_system(system1,system2), first, last, offsets_first, offsets_last, result, init, binary_op);
+} // end segmented_reduce()
+
+
+THRUST_NAMESPACE_END
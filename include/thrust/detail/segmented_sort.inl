@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/segmented_sort.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/select_system.h>
+#include <thrust/system/detail/generic/segmented_sort.h>
+#include <thrust/system/detail/adl/segmented_sort.h>
+
+THRUST_NAMESPACE_BEGIN
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator, typename OffsetIterator>
+__host__ __device__
+  void segmented_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last)
+{
+  using thrust::system::detail::generic::segmented_sort;
+  return segmented_sort(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, offsets_first, offsets_last);
+} // end segmented_sort()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator, typename OffsetIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::segmented_sort;
+  return segmented_sort(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), first, last, offsets_first, offsets_last, comp);
+} // end segmented_sort()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator>
+__host__ __device__
+  void segmented_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last)
+{
+  using thrust::system::detail::generic::segmented_sort_by_key;
+  return segmented_sort_by_key(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_last, values_first, offsets_first, offsets_last);
+} // end segmented_sort_by_key()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::segmented_sort_by_key;
+  return segmented_sort_by_key(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_last, values_first, offsets_first, offsets_last, comp);
+} // end segmented_sort_by_key()
+
+
+template<typename RandomAccessIterator, typename OffsetIterator>
+  void segmented_sort(RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::segmented_sort(select_system(system), first, last, offsets_first, offsets_last);
+} // end segmented_sort()
+
+
+template<typename RandomAccessIterator, typename OffsetIterator, typename StrictWeakOrdering>
+  void segmented_sort(RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  return thrust::segmented_sort(select_system(system), first, last, offsets_first, offsets_last, comp);
+} // end segmented_sort()
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator>
+  void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::segmented_sort_by_key(select_system(system1,system2), keys_first, keys_last, values_first, offsets_first, offsets_last);
+} // end segmented_sort_by_key()
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator, typename StrictWeakOrdering>
+  void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type System2;
+
+  System1 system1;
+  System2 system2;
+
+  return thrust::segmented_sort_by_key(select_system(system1,system2), keys_first, keys_last, values_first, offsets_first, offsets_last, comp);
+} // end segmented_sort_by_key()
+
+
+THRUST_NAMESPACE_END
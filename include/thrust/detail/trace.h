@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+// The hooks below report to the callback of thrust/trace.h when
+// THRUST_ENABLE_TRACE is defined, and expand to nothing otherwise:
+//
+//   THRUST_TRACE_SCOPE(algorithm, system, n) opens an event for an invocation
+//     of algorithm on n elements, which closes at the end of the enclosing
+//     block
+//   THRUST_TRACE_PHASE(phase) opens an event for a phase of the innermost
+//     open invocation, which closes at the end of the enclosing block
+//   THRUST_TRACE_TEMPORARY_ALLOCATION(System, bytes) charges an allocation of
+//     temporary storage through System to the events open on the calling
+//     thread
+//
+// Events are kept per thread, so the hooks belong on the thread which invoked
+// the algorithm, not inside parallel regions. For the same reason temporary
+// storage only counts toward an event when the invoking thread allocates it
+// outside the algorithm's parallel regions, through the algorithm's policy.
+// Inside their parallel regions the CPU systems only allocate through the
+// sequential algorithms they run on their tiles, with thrust::seq, and
+// whether the invoking thread or another one runs a tile depends on the
+// schedule, so allocations through thrust::seq are never charged.
+
+#if defined(THRUST_ENABLE_TRACE)
+
+#include <thrust/trace.h>
+#include <thrust/detail/preprocessor.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+
+#include <chrono>
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace detail
+{
+
+
+class trace_scope
+{
+  public:
+    inline trace_scope(const char *algorithm, const char *system, std::size_t num_elements)
+      : m_parent(current())
+    {
+      open(algorithm, 0, system, num_elements);
+    }
+
+    inline explicit trace_scope(const char *phase)
+      : m_parent(current())
+    {
+      // a phase outside any invocation has nothing to be a phase of
+      if(m_parent)
+      {
+        open(m_parent->m_event.algorithm, phase, m_parent->m_event.system, m_parent->m_event.num_elements);
+      }
+      else
+      {
+        open("", phase, "", 0);
+      }
+    }
+
+    inline ~trace_scope()
+    {
+      m_event.end = std::chrono::steady_clock::now();
+
+      current() = m_parent;
+
+      if(m_parent)
+      {
+        m_parent->m_event.temporary_bytes += m_event.temporary_bytes;
+      }
+
+      thrust::trace::detail::callback_state &state = thrust::trace::detail::get_callback_state();
+
+      if(state.callback)
+      {
+        state.callback(m_event, state.user_data);
+      }
+    }
+
+    // the cpp system and the parallel systems derived from it convert to
+    // cpp::tag, thrust::seq doesn't
+    template<typename System>
+    inline static void add_temporary_bytes(std::size_t bytes)
+    {
+      if(thrust::detail::is_convertible<System, thrust::system::cpp::tag>::value && current())
+      {
+        current()->m_event.temporary_bytes += bytes;
+      }
+    }
+
+  private:
+    trace_scope *m_parent;
+    thrust::trace::event m_event;
+
+    inline void open(const char *algorithm, const char *phase, const char *system, std::size_t num_elements)
+    {
+      m_event.algorithm       = algorithm;
+      m_event.phase           = phase;
+      m_event.system          = system;
+      m_event.num_elements    = num_elements;
+      m_event.temporary_bytes = 0;
+      m_event.depth           = m_parent ? m_parent->m_event.depth + 1 : 0;
+
+      current() = this;
+
+      m_event.begin = std::chrono::steady_clock::now();
+    }
+
+    // the innermost open scope of the calling thread
+    inline static trace_scope *&current()
+    {
+      static thread_local trace_scope *result = 0;
+      return result;
+    }
+
+    trace_scope(const trace_scope &);
+    trace_scope &operator=(const trace_scope &);
+};
+
+
+} // end detail
+THRUST_NAMESPACE_END
+
+#define THRUST_TRACE_SCOPE(algorithm, system, n) \
+  ::thrust::detail::trace_scope THRUST_PP_CAT2(thrust_trace_scope_, __LINE__)(algorithm, system, static_cast<std::size_t>(n))
+
+#define THRUST_TRACE_PHASE(phase) \
+  ::thrust::detail::trace_scope THRUST_PP_CAT2(thrust_trace_scope_, __LINE__)(phase)
+
+#define THRUST_TRACE_TEMPORARY_ALLOCATION(System, bytes) \
+  ::thrust::detail::trace_scope::add_temporary_bytes<System>(static_cast<std::size_t>(bytes))
+
+#else
+
+#define THRUST_TRACE_SCOPE(algorithm, system, n)
+#define THRUST_TRACE_PHASE(phase)
+#define THRUST_TRACE_TEMPORARY_ALLOCATION(System, bytes)
+
+#endif // THRUST_ENABLE_TRACE
+
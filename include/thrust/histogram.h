@@ -0,0 +1,258 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.h
+ *  \brief Counting the elements of a range which fall in each of a set of bins
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup algorithms
+ */
+
+/*! \addtogroup reductions
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \addtogroup counting
+ *  \ingroup reductions
+ *  \{
+ */
+
+
+/*! \p histogram_even counts the elements of <tt>[first,last)</tt> which fall in each of \p num_bins
+ *  bins of equal width dividing <tt>[lower_level, upper_level)</tt>. Bin \c i holds the elements \c x
+ *  converted to \c T for which <tt>lower_level + i * w <= x < lower_level + (i + 1) * w</tt>, where
+ *  \c w is <tt>(upper_level - lower_level) / num_bins</tt>, and its count is written to
+ *  <tt>histogram[i]</tt>. Elements outside of <tt>[lower_level, upper_level)</tt> are not counted.
+ *
+ *  Unlike sorting the input and searching it for the bin boundaries, \p histogram_even does
+ *  not reorder or copy the input.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param histogram The beginning of the \p num_bins counts.
+ *  \param num_bins The number of bins.
+ *  \param lower_level The lower bound, inclusive, of the first bin.
+ *  \param upper_level The upper bound, exclusive, of the last bin.
+ *  \return <tt>histogram + num_bins</tt>
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/input_iterator">Input Iterator</a>
+ *          and \c InputIterator's \c value_type is convertible to \c T.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable, and \c RandomAccessIterator's \c value_type is an integral type.
+ *  \tparam Size is an integral type.
+ *  \tparam T is an arithmetic type.
+ *
+ *  \pre The range <tt>[histogram, histogram + num_bins)</tt> shall not overlap the range <tt>[first, last)</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_even to count values in
+ *  four bins using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  float data[8] = {0.5f, 1.5f, 1.0f, 3.9f, -1.0f, 2.5f, 4.0f, 0.0f};
+ *  int histogram[4];
+ *
+ *  thrust::histogram_even(thrust::host, data, data + 8, histogram, 4, 0.0f, 4.0f);
+ *
+ *  // histogram is now {2, 2, 1, 1}
+ *  \endcode
+ *
+ *  \see \p histogram_range
+ */
+template<typename DerivedPolicy, typename InputIterator, typename RandomAccessIterator, typename Size, typename T>
+__host__ __device__
+  RandomAccessIterator histogram_even(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level);
+
+
+/*! \p histogram_even counts the elements of <tt>[first,last)</tt> which fall in each of \p num_bins
+ *  bins of equal width dividing <tt>[lower_level, upper_level)</tt>. Bin \c i holds the elements \c x
+ *  converted to \c T for which <tt>lower_level + i * w <= x < lower_level + (i + 1) * w</tt>, where
+ *  \c w is <tt>(upper_level - lower_level) / num_bins</tt>, and its count is written to
+ *  <tt>histogram[i]</tt>. Elements outside of <tt>[lower_level, upper_level)</tt> are not counted.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param histogram The beginning of the \p num_bins counts.
+ *  \param num_bins The number of bins.
+ *  \param lower_level The lower bound, inclusive, of the first bin.
+ *  \param upper_level The upper bound, exclusive, of the last bin.
+ *  \return <tt>histogram + num_bins</tt>
+ *
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/input_iterator">Input Iterator</a>
+ *          and \c InputIterator's \c value_type is convertible to \c T.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable, and \c RandomAccessIterator's \c value_type is an integral type.
+ *  \tparam Size is an integral type.
+ *  \tparam T is an arithmetic type.
+ *
+ *  \pre The range <tt>[histogram, histogram + num_bins)</tt> shall not overlap the range <tt>[first, last)</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_even to count values in
+ *  ten bins.
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<int> data = ...;
+ *  thrust::device_vector<unsigned int> histogram(10);
+ *
+ *  // count the values in [0,10), [10,20), ..., [90,100)
+ *  thrust::histogram_even(data.begin(), data.end(), histogram.begin(), 10, 0, 100);
+ *  \endcode
+ *
+ *  \see \p histogram_range
+ */
+template<typename InputIterator, typename RandomAccessIterator, typename Size, typename T>
+  RandomAccessIterator histogram_even(InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level);
+
+
+/*! \p histogram_range counts the elements of <tt>[first,last)</tt> which fall in each of the bins
+ *  delimited by the sorted sequence of levels <tt>[levels_first, levels_last)</tt>. Bin \c i holds the
+ *  elements \c x for which <tt>levels_first[i] <= x < levels_first[i + 1]</tt>, and its count is written
+ *  to <tt>histogram[i]</tt>. Elements outside of <tt>[levels_first[0], levels_last[-1])</tt> are not counted.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param levels_first The beginning of the bin boundaries.
+ *  \param levels_last The end of the bin boundaries.
+ *  \param histogram The beginning of the <tt>levels_last - levels_first - 1</tt> counts.
+ *  \return <tt>histogram + (levels_last - levels_first - 1)</tt>, or \p histogram if there are
+ *          fewer than two levels.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/input_iterator">Input Iterator</a>
+ *          and \c InputIterator's \c value_type is <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>
+ *          with \c LevelIterator's \c value_type.
+ *  \tparam LevelIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable, and \c RandomAccessIterator's \c value_type is an integral type.
+ *
+ *  \pre The levels shall be sorted in strictly increasing order.
+ *  \pre The range of counts shall not overlap the range <tt>[first, last)</tt> or the range of levels.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_range to count values in
+ *  three bins of unequal width using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  int data[8]   = {1, 7, 3, 12, 0, 5, 9, 2};
+ *  int levels[4] = {0, 2, 8, 10};
+ *  int histogram[3];
+ *
+ *  thrust::histogram_range(thrust::host, data, data + 8, levels, levels + 4, histogram);
+ *
+ *  // histogram is now {2, 4, 1}
+ *  \endcode
+ *
+ *  \see \p histogram_even
+ */
+template<typename DerivedPolicy, typename InputIterator, typename LevelIterator, typename RandomAccessIterator>
+__host__ __device__
+  RandomAccessIterator histogram_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram);
+
+
+/*! \p histogram_range counts the elements of <tt>[first,last)</tt> which fall in each of the bins
+ *  delimited by the sorted sequence of levels <tt>[levels_first, levels_last)</tt>. Bin \c i holds the
+ *  elements \c x for which <tt>levels_first[i] <= x < levels_first[i + 1]</tt>, and its count is written
+ *  to <tt>histogram[i]</tt>. Elements outside of <tt>[levels_first[0], levels_last[-1])</tt> are not counted.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param levels_first The beginning of the bin boundaries.
+ *  \param levels_last The end of the bin boundaries.
+ *  \param histogram The beginning of the <tt>levels_last - levels_first - 1</tt> counts.
+ *  \return <tt>histogram + (levels_last - levels_first - 1)</tt>, or \p histogram if there are
+ *          fewer than two levels.
+ *
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/input_iterator">Input Iterator</a>
+ *          and \c InputIterator's \c value_type is <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>
+ *          with \c LevelIterator's \c value_type.
+ *  \tparam LevelIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable, and \c RandomAccessIterator's \c value_type is an integral type.
+ *
+ *  \pre The levels shall be sorted in strictly increasing order.
+ *  \pre The range of counts shall not overlap the range <tt>[first, last)</tt> or the range of levels.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_range to count values in
+ *  bins of unequal width.
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<float> data = ...;
+ *  thrust::device_vector<float> levels = ...;
+ *  thrust::device_vector<int> histogram(levels.size() - 1);
+ *
+ *  thrust::histogram_range(data.begin(), data.end(), levels.begin(), levels.end(), histogram.begin());
+ *  \endcode
+ *
+ *  \see \p histogram_even
+ */
+template<typename InputIterator, typename LevelIterator, typename RandomAccessIterator>
+  RandomAccessIterator histogram_range(InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram);
+
+
+/*! \} // end counting
+ *  \} // end reductions
+ */
+
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/histogram.inl>
+
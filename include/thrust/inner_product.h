@@ -74,6 +74,7 @@ THRUST_NAMESPACE_BEGIN
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/inner_product
+ *  \see \ref reductions
  */
 template<typename DerivedPolicy,
          typename InputIterator1,
@@ -125,6 +126,7 @@ OutputType inner_product(const thrust::detail::execution_policy_base<DerivedPoli
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/inner_product
+ *  \see \ref reductions
  */
 template<typename InputIterator1, typename InputIterator2, typename OutputType>
 OutputType inner_product(InputIterator1 first1, InputIterator1 last1,
@@ -180,6 +182,7 @@ OutputType inner_product(InputIterator1 first1, InputIterator1 last1,
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/inner_product
+ *  \see \ref reductions
  */
 template<typename DerivedPolicy,
          typename InputIterator1,
@@ -244,6 +247,7 @@ OutputType inner_product(const thrust::detail::execution_policy_base<DerivedPoli
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/inner_product
+ *  \see \ref reductions
  */
 template<typename InputIterator1, typename InputIterator2, typename OutputType,
          typename BinaryFunction1, typename BinaryFunction2>
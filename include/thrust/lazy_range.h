@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file thrust/lazy_range.h
+ *  \brief Ranges whose element-wise stages are evaluated on demand by the
+ *         algorithm which consumes them, in a single pass.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+#include <thrust/detail/modern_gcc_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011 && !defined(THRUST_LEGACY_GCC)
+
+#include <thrust/advance.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/tuple.h>
+#include <thrust/zip_function.h>
+
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup iterators
+ *  \{
+ */
+
+/*! \addtogroup fancyiterator Fancy Iterators
+ *  \ingroup iterators
+ *  \{
+ */
+
+/*! \p lazy_range is a pair of iterators to which element-wise stages can be
+ *  appended without evaluating them. Each stage wraps the iterators in a
+ *  \p transform_iterator or a \p zip_iterator, so nothing is computed or stored
+ *  until an algorithm reads the range through \p begin() and \p end(). That
+ *  algorithm then computes every stage of an element as it reads it, which
+ *  replaces a chain of \p transform calls and their temporary vectors with a
+ *  single pass over the inputs on any system.
+ *
+ *  Since every element is recomputed each time it is read, a range should be
+ *  consumed by an algorithm which reads each element once, like \p reduce,
+ *  \p inclusive_scan, \p copy_if or \p copy. To sort by an expensive key,
+ *  copy the keys out of the range in one pass and sort by those.
+ *
+ *  The following code snippet fuses two transforms and a reduction into one
+ *  pass, and extracts sort keys from two vectors in another:
+ *
+ *  \code
+ *  #include <thrust/lazy_range.h>
+ *  #include <thrust/reduce.h>
+ *  #include <thrust/copy.h>
+ *  #include <thrust/sort.h>
+ *  #include <thrust/device_vector.h>
+ *
+ *  struct standardize
+ *  {
+ *    float mean, scale;
+ *
+ *    __host__ __device__
+ *    float operator()(float x) const { return (x - mean) * scale; }
+ *  };
+ *
+ *  struct square
+ *  {
+ *    __host__ __device__
+ *    float operator()(float x) const { return x * x; }
+ *  };
+ *
+ *  struct weighted
+ *  {
+ *    __host__ __device__
+ *    float operator()(float x, float w) const { return x * w; }
+ *  };
+ *
+ *  ...
+ *  thrust::device_vector<float> x = ...;
+ *  thrust::device_vector<float> w = ...;
+ *
+ *  // sum((x - mean)^2 * scale^2) without materializing the intermediate vectors
+ *  auto squares = thrust::make_lazy_range(x).transform(standardize{mean, scale}).transform(square());
+ *  float sum = thrust::reduce(squares.begin(), squares.end());
+ *
+ *  // the keys x * w, computed in the same pass which stores them
+ *  auto keys = thrust::make_lazy_range(x).transform(thrust::make_lazy_range(w), weighted());
+ *  thrust::device_vector<float> sort_keys(keys.size());
+ *  thrust::copy(keys.begin(), keys.end(), sort_keys.begin());
+ *  thrust::sort_by_key(sort_keys.begin(), sort_keys.end(), x.begin());
+ *  \endcode
+ *
+ *  \see make_lazy_range
+ *  \see lazy_zip
+ *  \see transform_iterator
+ *  \see zip_iterator
+ */
+template<typename Iterator>
+  class lazy_range
+{
+  public:
+    /*! The type of iterator through which algorithms read the range.
+     */
+    typedef Iterator iterator;
+
+    /*! The type of the elements of the range.
+     */
+    typedef typename thrust::iterator_value<Iterator>::type value_type;
+
+    /*! The type of the size of the range.
+     */
+    typedef typename thrust::iterator_difference<Iterator>::type difference_type;
+
+    /*! This constructor creates a \p lazy_range over <tt>[first, last)</tt>.
+     *
+     *  \param first The beginning of the range.
+     *  \param last The end of the range.
+     */
+    __host__ __device__
+    lazy_range(Iterator first, Iterator last)
+      : m_begin(first), m_end(last)
+    {}
+
+    /*! \return The beginning of the range.
+     */
+    __host__ __device__
+    iterator begin() const
+    {
+      return m_begin;
+    }
+
+    /*! \return The end of the range.
+     */
+    __host__ __device__
+    iterator end() const
+    {
+      return m_end;
+    }
+
+    /*! \return The number of elements of the range.
+     */
+    __host__ __device__
+    difference_type size() const
+    {
+      return thrust::distance(m_begin, m_end);
+    }
+
+    /*! \return \c true if the range has no elements.
+     */
+    __host__ __device__
+    bool empty() const
+    {
+      return m_begin == m_end;
+    }
+
+    /*! \p transform appends the stage <tt>f(x)</tt> to this range.
+     *
+     *  \param f The unary function applied to each element.
+     *  \return A \p lazy_range whose elements are <tt>f(x)</tt> for each
+     *          element \c x of this range.
+     */
+    template<typename UnaryFunction>
+    __host__ __device__
+    lazy_range<thrust::transform_iterator<UnaryFunction, Iterator> >
+    transform(UnaryFunction f) const
+    {
+      typedef thrust::transform_iterator<UnaryFunction, Iterator> result_iterator;
+
+      return lazy_range<result_iterator>(result_iterator(m_begin, f), result_iterator(m_end, f));
+    }
+
+    /*! \p transform appends the stage <tt>f(x, y)</tt> combining this range
+     *  with another element-wise.
+     *
+     *  \param other The range whose elements are the second arguments of \p f.
+     *         It shall have at least as many elements as this range.
+     *  \param f The binary function applied to each pair of elements.
+     *  \return A \p lazy_range whose elements are <tt>f(x, y)</tt> for each
+     *          element \c x of this range and the element \c y at the same
+     *          position of \p other.
+     */
+    template<typename OtherIterator, typename BinaryFunction>
+    __host__ __device__
+    lazy_range<
+      thrust::transform_iterator<
+        thrust::zip_function<BinaryFunction>,
+        thrust::zip_iterator<thrust::tuple<Iterator, OtherIterator> >
+      >
+    >
+    transform(const lazy_range<OtherIterator> &other, BinaryFunction f) const
+    {
+      typedef thrust::zip_iterator<thrust::tuple<Iterator, OtherIterator> > zip_iterator;
+
+      return lazy_range<zip_iterator>(zip_iterator(thrust::make_tuple(m_begin, other.begin())),
+                                      zip_iterator(thrust::make_tuple(m_end,   thrust::next(other.begin(), size()))))
+        .transform(thrust::zip_function<BinaryFunction>(f));
+    }
+
+  private:
+    Iterator m_begin, m_end;
+};
+
+
+/*! \p make_lazy_range creates a \p lazy_range over a pair of iterators.
+ *
+ *  \param first The beginning of the range.
+ *  \param last The end of the range.
+ *  \return A \p lazy_range over <tt>[first, last)</tt>.
+ *
+ *  \see lazy_range
+ */
+template<typename Iterator>
+__host__ __device__
+lazy_range<Iterator> make_lazy_range(Iterator first, Iterator last)
+{
+  return lazy_range<Iterator>(first, last);
+}
+
+
+/*! \p make_lazy_range creates a \p lazy_range over the elements of a
+ *  container, such as a \p device_vector, which must outlive the range.
+ *
+ *  \param container The container.
+ *  \return A \p lazy_range over <tt>[container.begin(), container.end())</tt>.
+ *
+ *  \see lazy_range
+ */
+template<typename Container>
+lazy_range<decltype(std::declval<Container&>().begin())>
+make_lazy_range(Container &container)
+{
+  return thrust::make_lazy_range(container.begin(), container.end());
+}
+
+
+/*! \p lazy_zip creates a \p lazy_range whose elements are the \p tuple of the
+ *  elements at the same position of several ranges. Its \p transform stages
+ *  receive each \p tuple, and can unpack it with \p zip_function.
+ *
+ *  \param first The first range, which determines the number of elements.
+ *  \param rest The other ranges, which shall have at least as many elements as \p first.
+ *  \return A \p lazy_range over a \p zip_iterator of the ranges.
+ *
+ *  \see lazy_range
+ *  \see zip_function
+ */
+template<typename Iterator, typename... Iterators>
+__host__ __device__
+lazy_range<thrust::zip_iterator<thrust::tuple<Iterator, Iterators...> > >
+lazy_zip(const lazy_range<Iterator> &first, const lazy_range<Iterators> &... rest)
+{
+  typedef thrust::zip_iterator<thrust::tuple<Iterator, Iterators...> > zip_iterator;
+
+  return lazy_range<zip_iterator>(zip_iterator(thrust::make_tuple(first.begin(), rest.begin()...)),
+                                  zip_iterator(thrust::make_tuple(first.end(),   thrust::next(rest.begin(), first.size())...)));
+}
+
+
+/*! \} // end fancyiterators
+ */
+
+/*! \} // end iterators
+ */
+
+THRUST_NAMESPACE_END
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file arena.h
+ *  \brief A memory resource adaptor which hands out memory by bumping a pointer, and which is reset, rather than freed,
+ *      between uses.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <cassert>
+#include <vector>
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/detail/type_traits/pointer_traits.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/validator.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A memory resource adaptor which carves allocations out of large blocks obtained from an upstream resource, by
+ *      bumping a pointer. Deallocation only returns memory to the arena when it undoes the most recent allocation,
+ *      which is the order in which algorithms release their temporary storage; everything else is reclaimed at once
+ *      by \p reset.
+ *
+ *  This is meant to back the temporary storage of algorithms invoked repeatedly, for instance
+ *      <tt>thrust::stable_sort(thrust::omp::par(alloc), ...)</tt> in a loop, with \p reset called between the calls:
+ *      after the first few calls, the arena holds a single block big enough for a whole call, and the upstream
+ *      resource is not used anymore.
+ *
+ *  This resource is not synchronized. The CPU systems allocate temporary storage on the thread which invoked the
+ *      algorithm, so a single arena may back an execution policy as long as the policy is not used concurrently.
+ *
+ *  The arena writes no bookkeeping into the memory it hands out, so memory allocated from \p Upstream does not need to
+ *      be accessible from the host.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template<typename Upstream>
+class unsynchronized_arena_resource final
+    : public memory_resource<typename Upstream::pointer>,
+        private validator<Upstream>
+{
+    typedef typename Upstream::pointer void_ptr;
+
+    struct block
+    {
+        void_ptr pointer;
+        std::size_t size;
+    };
+
+public:
+    /*! The size of the first block allocated from upstream, unless a constructor is given a different one.
+     */
+    static const std::size_t default_block_size = 64 * 1024;
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param block_size the size of the first block allocated from upstream; every further block is at least twice as
+     *      large as the one before it
+     */
+    unsynchronized_arena_resource(Upstream * upstream, std::size_t block_size = default_block_size)
+        : m_upstream(upstream),
+        m_block_size(block_size),
+        m_used(0),
+        m_allocated(0)
+    {
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param block_size the size of the first block allocated from upstream
+     */
+    unsynchronized_arena_resource(std::size_t block_size = default_block_size)
+        : m_upstream(get_global_resource<Upstream>()),
+        m_block_size(block_size),
+        m_used(0),
+        m_allocated(0)
+    {
+    }
+
+    /*! Destructor. Releases all held memory to upstream.
+     */
+    ~unsynchronized_arena_resource()
+    {
+        release();
+    }
+
+    /*! Releases all held memory to upstream. Any memory allocated from the arena must not be used afterwards.
+     */
+    void release()
+    {
+        for (std::size_t i = 0; i < m_blocks.size(); ++i)
+        {
+            m_upstream->do_deallocate(m_blocks[i].pointer, m_blocks[i].size, THRUST_MR_DEFAULT_ALIGNMENT);
+        }
+
+        m_blocks.clear();
+        m_used = 0;
+        m_allocated = 0;
+    }
+
+    /*! Makes all memory held by the arena available for allocation again. Any memory allocated from the arena must not
+     *      be used afterwards.
+     *
+     *  If the allocations since the last reset needed more than one block, the blocks are replaced by a single one
+     *      large enough to hold all of them, so that the same sequence of allocations can be repeated without using
+     *      the upstream resource.
+     */
+    void reset()
+    {
+        if (m_blocks.size() > 1)
+        {
+            std::size_t total_size = 0;
+            for (std::size_t i = 0; i < m_blocks.size(); ++i)
+            {
+                total_size += m_blocks[i].size;
+            }
+
+            release();
+            push_block(total_size);
+        }
+
+        m_used = 0;
+        m_allocated = 0;
+    }
+
+    /*! Returns the number of bytes handed out since the last reset, including padding, and not counting allocations
+     *      which have already been undone.
+     */
+    std::size_t bytes_in_use() const
+    {
+        return m_allocated;
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        assert(thrust::detail::is_power_of_2(alignment));
+
+        if (!m_blocks.empty())
+        {
+            std::size_t offset = aligned_offset(m_blocks.back(), m_used, alignment);
+            if (offset + bytes <= m_blocks.back().size)
+            {
+                return take(offset, bytes);
+            }
+        }
+
+        // leave room for aligning the start of the allocation, in case upstream aligns less than requested
+        std::size_t needed = bytes + alignment;
+        std::size_t size = m_blocks.empty() ? m_block_size : 2 * m_blocks.back().size;
+        while (size < needed)
+        {
+            size *= 2;
+        }
+
+        push_block(size);
+        m_used = 0;
+
+        return take(aligned_offset(m_blocks.back(), 0, alignment), bytes);
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        (void)alignment;
+
+        if (m_blocks.empty())
+        {
+            return;
+        }
+
+        char * begin = raw(m_blocks.back().pointer);
+        char * ptr = raw(p);
+
+        // undo the most recent allocation; anything else waits for reset
+        if (ptr >= begin && ptr + bytes == begin + m_used)
+        {
+            std::size_t offset = ptr - begin;
+            m_allocated -= m_used - offset;
+            m_used = offset;
+        }
+    }
+
+private:
+    Upstream * m_upstream;
+    std::size_t m_block_size;
+
+    std::vector<block> m_blocks;
+
+    // the number of bytes used in the last block, and since the last reset
+    std::size_t m_used;
+    std::size_t m_allocated;
+
+    static char * raw(void_ptr p)
+    {
+        return static_cast<char *>(static_cast<void *>(thrust::detail::pointer_traits<void_ptr>::get(p)));
+    }
+
+    static std::size_t aligned_offset(const block & b, std::size_t offset, std::size_t alignment)
+    {
+        std::size_t address = reinterpret_cast<std::size_t>(raw(b.pointer)) + offset;
+        std::size_t misalignment = address & (alignment - 1);
+        return misalignment ? offset + alignment - misalignment : offset;
+    }
+
+    void push_block(std::size_t size)
+    {
+        block b;
+        b.pointer = m_upstream->do_allocate(size, THRUST_MR_DEFAULT_ALIGNMENT);
+        b.size = size;
+        m_blocks.push_back(b);
+    }
+
+    void_ptr take(std::size_t offset, std::size_t bytes)
+    {
+        m_allocated += offset + bytes - m_used;
+        m_used = offset + bytes;
+        return void_ptr(static_cast<void *>(raw(m_blocks.back().pointer) + offset));
+    }
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
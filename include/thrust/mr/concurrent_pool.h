@@ -0,0 +1,596 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file concurrent_pool.h
+ *  \brief A pooling memory resource adaptor which serves most allocations from per-thread caches, without taking a lock.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <thrust/mr/pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+namespace concurrent_pool_detail
+{
+
+// a free block; the blocks on a shared list are grouped into batches, which
+// are linked through their first blocks
+struct block
+{
+    block * next;
+    block * next_batch;
+};
+
+// the blocks one thread holds for one pool, one list per size class
+struct thread_cache;
+
+class pool_base
+{
+public:
+    // called by a thread which is exiting, with the cache's owner_mutex held;
+    // takes back the cache's blocks and forgets the cache
+    virtual void adopt(thread_cache & cache) = 0;
+
+protected:
+    ~pool_base() {}
+};
+
+struct thread_cache
+{
+    struct magazine
+    {
+        block * head;
+        std::size_t count;
+    };
+
+    thread_cache(pool_base * owner_, std::size_t num_classes)
+        : owner(owner_), magazines(num_classes, magazine())
+    {
+    }
+
+    // owner is cleared by the pool's destructor, so a thread exiting after
+    // its pool is gone doesn't touch the pool
+    std::mutex owner_mutex;
+    pool_base * owner;
+
+    std::vector<magazine> magazines;
+};
+
+// the caches of the calling thread, keyed by the id of their pool; when the
+// thread exits, the blocks it still holds go back to their pools
+class thread_registry
+{
+    struct entry
+    {
+        std::uint64_t id;
+        std::shared_ptr<thread_cache> cache;
+    };
+
+    std::vector<entry> m_entries;
+
+public:
+    ~thread_registry()
+    {
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            thread_cache & cache = *m_entries[i].cache;
+
+            std::lock_guard<std::mutex> lock(cache.owner_mutex);
+            if (cache.owner)
+            {
+                cache.owner->adopt(cache);
+            }
+        }
+    }
+
+    thread_cache * find(std::uint64_t id) const
+    {
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].id == id)
+            {
+                return m_entries[i].cache.get();
+            }
+        }
+
+        return 0;
+    }
+
+    void insert(std::uint64_t id, std::shared_ptr<thread_cache> cache)
+    {
+        // forget the caches of pools which have been destroyed since
+        for (std::size_t i = 0; i < m_entries.size();)
+        {
+            if (m_entries[i].cache.use_count() == 1)
+            {
+                m_entries[i] = m_entries.back();
+                m_entries.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        entry e = { id, cache };
+        m_entries.push_back(e);
+    }
+
+    static thread_registry & get()
+    {
+        static thread_local thread_registry registry;
+        return registry;
+    }
+};
+
+// pools are told apart by id rather than by address, since a new pool may
+// reuse the address of a destroyed one
+inline std::uint64_t next_pool_id()
+{
+    static std::atomic<std::uint64_t> id(0);
+    return ++id;
+}
+
+} // end concurrent_pool_detail
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A thread-safe pooling memory resource adaptor that serves most allocations without taking a lock.
+ *
+ *  Requests are rounded up to a power of two and served from the block pool of that size class, like in
+ *      \p unsynchronized_pool_resource. Each thread keeps a small cache, or magazine, of free blocks for each size class,
+ *      which serves its allocations and deallocations without any synchronization. A thread whose magazine runs empty
+ *      refills it with a batch of blocks from a lock-free list shared by all threads, and one whose magazine grows too
+ *      large returns a batch to that list. Only allocating new chunks from upstream, and oversized or overaligned
+ *      requests, which are passed straight to upstream, take a lock.
+ *
+ *  Blocks belong to the resource rather than to a thread: a block allocated by one thread may be deallocated by any
+ *      other, and it returns to this resource's pool either way. When a thread exits, the blocks in its magazines go
+ *      back to the shared lists and the resource forgets its cache, so short-lived threads don't accumulate.
+ *
+ *  The free lists are threaded through the blocks themselves, so memory allocated from \p Upstream must be accessible
+ *      from the host. Uses \p std::mutex and \p thread_local, and therefore requires C++11.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template<typename Upstream>
+class concurrent_pool_resource final
+    : public memory_resource<typename Upstream::pointer>,
+        private concurrent_pool_detail::pool_base,
+        private validator<Upstream>
+{
+    typedef concurrent_pool_detail::block block;
+    typedef concurrent_pool_detail::thread_cache thread_cache;
+    typedef thread_cache::magazine magazine;
+
+    typedef typename Upstream::pointer void_ptr;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+    struct chunk
+    {
+        void_ptr pointer;
+        std::size_t size;
+    };
+
+public:
+    /*! Get the default options for a pool. These are meant to be a sensible set of values for many use cases,
+     *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+     *      just a slight departure from the defaults is easy.
+     */
+    static pool_options get_default_options()
+    {
+        return unsynchronized_pool_resource<Upstream>::get_default_options();
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param options pool options to use
+     */
+    concurrent_pool_resource(Upstream * upstream, pool_options options = get_default_options())
+        : m_upstream(upstream),
+        m_options(options),
+        m_smallest_block_log2(thrust::detail::log2_ri((std::max)(m_options.smallest_block_size, sizeof(block)))),
+        m_num_classes(thrust::detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1),
+        m_id(concurrent_pool_detail::next_pool_id()),
+        m_free_lists(new std::atomic<block *>[m_num_classes]),
+        m_popping(0),
+        m_blocks_per_chunk(m_num_classes, 0)
+    {
+        assert(m_options.validate());
+
+        for (std::size_t i = 0; i < m_num_classes; ++i)
+        {
+            m_free_lists[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param options pool options to use
+     */
+    concurrent_pool_resource(pool_options options = get_default_options())
+        : concurrent_pool_resource(get_global_resource<Upstream>(), options)
+    {
+    }
+
+    /*! Destructor. Releases all held memory to upstream.
+     */
+    ~concurrent_pool_resource()
+    {
+        std::vector<std::shared_ptr<thread_cache> > caches;
+        {
+            lock_t lock(m_mutex);
+            caches.swap(m_caches);
+        }
+
+        // a thread exiting meanwhile holds its cache's owner_mutex while it
+        // takes m_mutex in adopt, so m_mutex must not be held here
+        for (std::size_t i = 0; i < caches.size(); ++i)
+        {
+            lock_t cache_lock(caches[i]->owner_mutex);
+            caches[i]->owner = 0;
+        }
+
+        release_chunks();
+    }
+
+    /*! Releases all held memory to upstream. Unlike allocation and deallocation, this must not be called while other
+     *      threads are using the resource.
+     */
+    void release()
+    {
+        {
+            lock_t lock(m_mutex);
+            for (std::size_t i = 0; i < m_caches.size(); ++i)
+            {
+                for (std::size_t j = 0; j < m_num_classes; ++j)
+                {
+                    m_caches[i]->magazines[j] = magazine();
+                }
+            }
+        }
+
+        release_chunks();
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        bytes = (std::max)(bytes, block_size(0));
+        assert(thrust::detail::is_power_of_2(alignment));
+
+        // an oversized and/or overaligned allocation requested; needs to be allocated separately
+        if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            lock_t lock(m_mutex);
+            return m_upstream->do_allocate(bytes, alignment);
+        }
+
+        std::size_t size_class = thrust::detail::log2_ri(bytes) - m_smallest_block_log2;
+        magazine & m = local_cache().magazines[size_class];
+
+        if (!m.head)
+        {
+            refill(m, size_class);
+        }
+
+        block * b = m.head;
+        m.head = b->next;
+        --m.count;
+
+        return void_ptr(static_cast<void *>(b));
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        bytes = (std::max)(bytes, block_size(0));
+        assert(thrust::detail::is_power_of_2(alignment));
+
+        if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
+        {
+            lock_t lock(m_mutex);
+            m_upstream->do_deallocate(p, bytes, alignment);
+            return;
+        }
+
+        std::size_t size_class = thrust::detail::log2_ri(bytes) - m_smallest_block_log2;
+        magazine & m = local_cache().magazines[size_class];
+
+        block * b = static_cast<block *>(static_cast<void *>(thrust::detail::pointer_traits<void_ptr>::get(p)));
+        b->next = m.head;
+        m.head = b;
+        ++m.count;
+
+        // keep a full magazine for the next allocations and share the rest
+        std::size_t capacity = magazine_capacity(size_class);
+        if (m.count > 2 * capacity)
+        {
+            block * first = m.head;
+            block * last = first;
+            for (std::size_t i = 1; i < capacity; ++i)
+            {
+                last = last->next;
+            }
+
+            m.head = last->next;
+            m.count -= capacity;
+
+            last->next = 0;
+            first->next_batch = 0;
+            push(size_class, first, first);
+        }
+    }
+
+private:
+    // the number of bytes a thread keeps in its magazine for one size class
+    static const std::size_t magazine_bytes = static_cast<std::size_t>(1) << 16;
+
+    Upstream * m_upstream;
+
+    pool_options m_options;
+    std::size_t m_smallest_block_log2;
+    std::size_t m_num_classes;
+
+    std::uint64_t m_id;
+
+    // one lock-free stack of batches of free blocks per size class; batches
+    // are only ever popped all at once, so there is no ABA problem
+    std::unique_ptr<std::atomic<block *>[]> m_free_lists;
+
+    // the number of threads between popping a free list and giving back the
+    // batches they don't keep
+    std::atomic<std::size_t> m_popping;
+
+    // guards everything below, and calls to upstream
+    std::mutex m_mutex;
+    std::vector<chunk> m_chunks;
+    std::vector<std::size_t> m_blocks_per_chunk;
+    std::vector<std::shared_ptr<thread_cache> > m_caches;
+
+    std::size_t block_size(std::size_t size_class) const
+    {
+        return static_cast<std::size_t>(1) << (m_smallest_block_log2 + size_class);
+    }
+
+    std::size_t magazine_capacity(std::size_t size_class) const
+    {
+        return (std::max)(static_cast<std::size_t>(4), magazine_bytes / block_size(size_class));
+    }
+
+    thread_cache & local_cache()
+    {
+        concurrent_pool_detail::thread_registry & registry = concurrent_pool_detail::thread_registry::get();
+
+        if (thread_cache * cache = registry.find(m_id))
+        {
+            return *cache;
+        }
+
+        std::shared_ptr<thread_cache> cache = std::make_shared<thread_cache>(static_cast<concurrent_pool_detail::pool_base *>(this), m_num_classes);
+        {
+            lock_t lock(m_mutex);
+            m_caches.push_back(cache);
+        }
+        registry.insert(m_id, cache);
+
+        return *cache;
+    }
+
+    // pushes the batches from first to last, linked through next_batch
+    void push(std::size_t size_class, block * first, block * last)
+    {
+        std::atomic<block *> & list = m_free_lists[size_class];
+
+        block * head = list.load(std::memory_order_relaxed);
+        do
+        {
+            last->next_batch = head;
+        } while (!list.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    block * pop_all(std::size_t size_class)
+    {
+        return m_free_lists[size_class].exchange(0, std::memory_order_acquire);
+    }
+
+    // keeps the first of the batches and gives back the rest
+    block * keep_first(std::size_t size_class, block * batches)
+    {
+        block * rest = batches->next_batch;
+        if (rest)
+        {
+            block * last = rest;
+            while (last->next_batch)
+            {
+                last = last->next_batch;
+            }
+
+            push(size_class, rest, last);
+        }
+
+        return batches;
+    }
+
+    // pops a single batch, or returns null if the list is empty
+    block * pop_batch(std::size_t size_class)
+    {
+        ++m_popping;
+
+        block * batches = pop_all(size_class);
+        if (batches)
+        {
+            batches = keep_first(size_class, batches);
+        }
+
+        --m_popping;
+
+        return batches;
+    }
+
+    void refill(magazine & m, std::size_t size_class)
+    {
+        block * batch = pop_batch(size_class);
+
+        if (!batch)
+        {
+            lock_t lock(m_mutex);
+
+            // the list looks empty while another thread holds all of it, between popping it and giving back the
+            // batches it doesn't keep; wait for those before going upstream
+            while (!(batch = pop_batch(size_class)) && m_popping.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+
+            if (!batch)
+            {
+                batch = keep_first(size_class, allocate_chunk(size_class));
+            }
+        }
+
+        std::size_t count = 0;
+        for (block * b = batch; b; b = b->next)
+        {
+            ++count;
+        }
+
+        m.head = batch;
+        m.count = count;
+    }
+
+    // allocates a new chunk from upstream and splits it into batches of a
+    // magazine's worth of blocks; must be called with m_mutex held
+    block * allocate_chunk(std::size_t size_class)
+    {
+        std::size_t size = block_size(size_class);
+        std::size_t capacity = magazine_capacity(size_class);
+
+        std::size_t n = m_blocks_per_chunk[size_class];
+        if (n == 0)
+        {
+            n = (std::max)(m_options.min_blocks_per_chunk, m_options.min_bytes_per_chunk / size);
+        }
+        else
+        {
+            n = n * 3 / 2;
+            n = (std::min)(n, m_options.max_bytes_per_chunk / size);
+            n = (std::min)(n, m_options.max_blocks_per_chunk);
+            n = (std::max)(n, static_cast<std::size_t>(1));
+        }
+        m_blocks_per_chunk[size_class] = n;
+
+        void_ptr p = m_upstream->do_allocate(n * size, m_options.alignment);
+
+        chunk c = { p, n * size };
+        m_chunks.push_back(c);
+
+        char * raw = static_cast<char *>(static_cast<void *>(thrust::detail::pointer_traits<void_ptr>::get(p)));
+
+        block * first = 0;
+        block * previous_batch = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            block * b = reinterpret_cast<block *>(raw + i * size);
+
+            bool ends_batch = (i + 1) % capacity == 0 || i + 1 == n;
+            b->next = ends_batch ? 0 : reinterpret_cast<block *>(raw + (i + 1) * size);
+
+            if (i % capacity == 0)
+            {
+                b->next_batch = 0;
+                if (previous_batch)
+                {
+                    previous_batch->next_batch = b;
+                }
+                else
+                {
+                    first = b;
+                }
+                previous_batch = b;
+            }
+        }
+
+        return first;
+    }
+
+    virtual void adopt(thread_cache & cache) override
+    {
+        for (std::size_t i = 0; i < m_num_classes; ++i)
+        {
+            if (cache.magazines[i].head)
+            {
+                cache.magazines[i].head->next_batch = 0;
+                push(i, cache.magazines[i].head, cache.magazines[i].head);
+            }
+            cache.magazines[i] = magazine();
+        }
+
+        lock_t lock(m_mutex);
+        for (std::size_t i = 0; i < m_caches.size(); ++i)
+        {
+            if (m_caches[i].get() == &cache)
+            {
+                m_caches[i] = m_caches.back();
+                m_caches.pop_back();
+                break;
+            }
+        }
+    }
+
+    void release_chunks()
+    {
+        lock_t lock(m_mutex);
+
+        for (std::size_t i = 0; i < m_num_classes; ++i)
+        {
+            m_free_lists[i].store(0, std::memory_order_relaxed);
+            m_blocks_per_chunk[i] = 0;
+        }
+
+        for (std::size_t i = 0; i < m_chunks.size(); ++i)
+        {
+            m_upstream->do_deallocate(m_chunks[i].pointer, m_chunks[i].size, m_options.alignment);
+        }
+        m_chunks.clear();
+    }
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // THRUST_CPP_DIALECT >= 2011
+
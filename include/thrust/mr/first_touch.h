@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file first_touch.h
+ *  \brief A memory resource adaptor which touches the pages of every allocation in parallel, so that they are placed
+ *      on the NUMA nodes of the threads which later work on them.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <cassert>
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/detail/type_traits/pointer_traits.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/validator.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+namespace first_touch_detail
+{
+
+// policies which can carry a grain size touch with a grain of one iteration unless they carry one, so that the
+// default grain of the policy's system doesn't leave small allocations to a single thread
+template<typename Policy>
+auto touch_policy(Policy policy, int)
+    -> decltype(policy.with(get_grain_size(policy), get_max_threads(policy)))
+{
+    const std::size_t grain_size = get_grain_size(policy);
+
+    return policy.with(grain_size > 0 ? grain_size : 1, get_max_threads(policy));
+}
+
+template<typename Policy>
+Policy touch_policy(Policy policy, long)
+{
+    return policy;
+}
+
+} // end first_touch_detail
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A memory resource adaptor which, after allocating from an upstream resource, writes to every page of the
+ *      allocation with a parallel \p for_each through an execution policy.
+ *
+ *  Operating systems place a page on the NUMA node of the thread which first writes to it. When an allocation is
+ *      first written by a single thread, for instance when a \p host_vector is constructed sequentially, all of it
+ *      ends up on one node, and every parallel pass over it afterwards pulls most of its data from remote memory.
+ *      Touching the pages with the same system as the algorithms which later use the memory instead spreads the
+ *      allocation over the nodes of the threads which work on it.
+ *
+ *  The touch is a \p for_each over the allocation in steps of 64 bytes, so it is split like a \p for_each over the
+ *      allocation's elements. With \p thrust::omp::par that is one contiguous tile per thread, the same tiles
+ *      \p for_each, \p transform and the other element-wise algorithms of the OpenMP system use. A policy which can
+ *      carry a grain size, such as \p thrust::omp::par, touches with a grain of one step unless it carries one, so
+ *      small allocations are spread as well; with \p thrust::omp::par.with(grain_size), the grain counts steps of
+ *      64 bytes. Reductions and scans of arithmetic values don't split inputs smaller than their own grain, so
+ *      they may process such allocations on a single thread regardless. The TBB system schedules its tiles
+ *      dynamically, so there placement only follows the threads on average.
+ *
+ *  Only pages which have not been touched yet are placed; memory which the upstream resource recycles keeps its
+ *      placement. Large allocations from \p new_delete_resource are usually fresh mappings from the operating system.
+ *
+ *  The resource does not construct anything; the bytes it writes are left zeroed.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory; its memory must be
+ *      accessible from the host
+ *  \tparam ExecutionPolicy the type of execution policy used to touch the pages, e.g. \p thrust::omp::detail::par_t
+ */
+template<typename Upstream, typename ExecutionPolicy>
+class first_touch_resource final
+    : public memory_resource<typename Upstream::pointer>,
+        private validator<Upstream>
+{
+    typedef typename Upstream::pointer void_ptr;
+
+    // every iteration of the parallel loop covers this many bytes, so that the loop is split like a loop over the
+    // elements of the allocation would be, not like one over its few pages
+    static const std::size_t stride = 64;
+
+    struct touch_page
+    {
+        char * begin;
+        std::size_t page_size;
+
+        void operator()(std::size_t i) const
+        {
+            char * p = begin + i * stride;
+
+            // the first iteration also covers the partial page the allocation may start in
+            if (i == 0 || (reinterpret_cast<std::size_t>(p) & (page_size - 1)) < stride)
+            {
+                *p = 0;
+            }
+        }
+    };
+
+public:
+    /*! The distance between the bytes written to, unless a constructor is given a different one. A value smaller
+     *      than the page size of the system only costs extra writes.
+     */
+    static const std::size_t default_page_size = 4096;
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param policy the execution policy used to touch the pages
+     *  \param page_size the distance between the bytes written to; must be a power of 2
+     */
+    first_touch_resource(Upstream * upstream,
+                         const ExecutionPolicy & policy = ExecutionPolicy(),
+                         std::size_t page_size = default_page_size)
+        : m_upstream(upstream),
+        m_policy(policy),
+        m_page_size(page_size)
+    {
+        assert(thrust::detail::is_power_of_2(page_size));
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param policy the execution policy used to touch the pages
+     *  \param page_size the distance between the bytes written to; must be a power of 2
+     */
+    first_touch_resource(const ExecutionPolicy & policy = ExecutionPolicy(),
+                         std::size_t page_size = default_page_size)
+        : m_upstream(get_global_resource<Upstream>()),
+        m_policy(policy),
+        m_page_size(page_size)
+    {
+        assert(thrust::detail::is_power_of_2(page_size));
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        void_ptr p = m_upstream->do_allocate(bytes, alignment);
+
+        if (bytes > 0)
+        {
+            touch_page f;
+            f.begin = static_cast<char *>(static_cast<void *>(thrust::detail::pointer_traits<void_ptr>::get(p)));
+            f.page_size = m_page_size;
+
+            thrust::for_each_n(first_touch_detail::touch_policy(m_policy, 0),
+                               thrust::counting_iterator<std::size_t>(0), (bytes + stride - 1) / stride, f);
+        }
+
+        return p;
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        m_upstream->do_deallocate(p, bytes, alignment);
+    }
+
+private:
+    Upstream * m_upstream;
+    ExecutionPolicy m_policy;
+    std::size_t m_page_size;
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
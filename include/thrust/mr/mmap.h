@@ -0,0 +1,464 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file mmap.h
+ *  \brief Memory resources which map their allocations directly from the operating system, optionally backed by huge
+ *      pages or by a file.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/system/detail/bad_alloc.h>
+#include <thrust/system/system_error.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A type used for configuring \p mmap_memory_resource.
+ */
+struct mmap_options
+{
+    /*! How allocations are backed by huge pages. */
+    enum huge_page_mode
+    {
+        /*! Allocations use the default page size. */
+        no_huge_pages,
+        /*! Allocations are aligned to \p huge_page_size and advised to be backed by transparent huge pages, which the
+         *      kernel provides when it can. */
+        transparent_huge_pages,
+        /*! Allocations are mapped from the kernel's reserved huge pages with \p MAP_HUGETLB, falling back to
+         *      transparent huge pages when none are available. */
+        explicit_huge_pages
+    };
+
+    /*! How allocations of at least \p huge_page_size bytes are backed by huge pages. Smaller allocations always use
+     *      the default page size.
+     */
+    huge_page_mode huge_pages;
+
+    /*! The size of a huge page. Allocations backed by huge pages are aligned to and rounded up to this size.
+     */
+    std::size_t huge_page_size;
+
+    /*! Decides whether all pages of an allocation are faulted in when it is made, like with \p MAP_POPULATE, rather
+     *      than when they are first accessed.
+     */
+    bool populate;
+
+    /*! Checks if the options are self-consistent.
+     *
+     *  /returns true if the options are self-consitent, false otherwise.
+     */
+    bool validate() const
+    {
+        if (huge_pages != no_huge_pages && !detail::is_power_of_2(huge_page_size)) return false;
+
+        return true;
+    }
+};
+
+/*! A memory resource which maps every allocation as a separate anonymous mapping, and unmaps it on deallocation.
+ *
+ *  Mapping has a cost of its own, so this resource is meant for large, long lived allocations such as the storage of
+ *      multi-gigabyte vectors; put a pool in front of it for anything else. Backing such allocations with huge pages
+ *      lets the TLB cover all of them, which matters for algorithms which access memory all over the place, like
+ *      sorts and gathers.
+ */
+class mmap_memory_resource final : public memory_resource<>
+{
+public:
+    /*! Get the default options for an mmap resource. These are, as of the time of writing this documentation:
+     *
+     *  \li \p huge_pages: \p transparent_huge_pages
+     *  \li \p huge_page_size: 2 MiB
+     *  \li \p populate: false
+     *
+     *  \returns the default options for an mmap resource.
+     */
+    static mmap_options get_default_options()
+    {
+        mmap_options ret;
+
+        ret.huge_pages = mmap_options::transparent_huge_pages;
+        ret.huge_page_size = 2 * 1024 * 1024;
+        ret.populate = false;
+
+        return ret;
+    }
+
+    /*! Constructor.
+     *
+     *  \param options mmap options
+     */
+    mmap_memory_resource(mmap_options options = get_default_options())
+        : m_options(options),
+        m_page_size(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))
+    {
+        assert(m_options.validate());
+    }
+
+    /*! Returns the options of this resource.
+     */
+    const mmap_options & options() const
+    {
+        return m_options;
+    }
+
+    THRUST_NODISCARD virtual void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        const bool huge = uses_huge_pages(bytes);
+        const std::size_t length = mapping_size(bytes);
+
+#if defined(MAP_HUGETLB)
+        if (huge && m_options.huge_pages == mmap_options::explicit_huge_pages && alignment <= m_options.huge_page_size)
+        {
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+# if defined(MAP_POPULATE)
+            if (m_options.populate) flags |= MAP_POPULATE;
+# endif
+
+            void * p = ::mmap(0, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                return p;
+            }
+
+            // no reserved huge pages are left; fall through to transparent ones
+        }
+#endif
+
+        // a huge page can only back a range aligned to its size, which mmap does not give us, so map enough extra
+        // to align the allocation and unmap what is left on either side
+        if (huge && alignment < m_options.huge_page_size)
+        {
+            alignment = m_options.huge_page_size;
+        }
+
+        if (alignment <= m_page_size)
+        {
+            void * p = map(length, !huge && m_options.populate);
+            if (huge) advise_huge_pages(p, length);
+            return p;
+        }
+
+        const std::size_t padding = alignment - m_page_size;
+        char * mapping = static_cast<char *>(map(length + padding, false));
+
+        const std::size_t misalignment = reinterpret_cast<std::size_t>(mapping) & (alignment - 1);
+        const std::size_t head = misalignment ? alignment - misalignment : 0;
+
+        if (head > 0) ::munmap(mapping, head);
+        if (padding > head) ::munmap(mapping + head + length, padding - head);
+
+        char * p = mapping + head;
+
+        if (huge) advise_huge_pages(p, length);
+        if (m_options.populate) populate(p, length);
+
+        return p;
+    }
+
+    virtual void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        (void)alignment;
+
+        ::munmap(p, mapping_size(bytes));
+    }
+
+private:
+    mmap_options m_options;
+    std::size_t m_page_size;
+
+    bool uses_huge_pages(std::size_t bytes) const
+    {
+        return m_options.huge_pages != mmap_options::no_huge_pages && bytes >= m_options.huge_page_size;
+    }
+
+    // the size of the mapping behind an allocation, which depends only on its size, so that deallocation can
+    // recompute it
+    std::size_t mapping_size(std::size_t bytes) const
+    {
+        const std::size_t granularity = uses_huge_pages(bytes) ? m_options.huge_page_size : m_page_size;
+
+        return bytes == 0 ? granularity : (bytes + granularity - 1) / granularity * granularity;
+    }
+
+    static void * map(std::size_t length, bool populate)
+    {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+        if (populate) flags |= MAP_POPULATE;
+#else
+        (void)populate;
+#endif
+
+        void * p = ::mmap(0, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw thrust::system::detail::bad_alloc(std::string("mmap failed: ") + std::strerror(errno));
+        }
+
+        return p;
+    }
+
+    static void advise_huge_pages(void * p, std::size_t length)
+    {
+#if defined(MADV_HUGEPAGE)
+        // only a hint; kernels without transparent huge pages refuse it
+        ::madvise(p, length, MADV_HUGEPAGE);
+#else
+        (void)p;
+        (void)length;
+#endif
+    }
+
+    // faults in a range which could not be mapped with MAP_POPULATE
+    void populate(char * p, std::size_t length) const
+    {
+#if defined(MADV_POPULATE_WRITE)
+        if (::madvise(p, length, MADV_POPULATE_WRITE) == 0) return;
+#endif
+
+        for (std::size_t offset = 0; offset < length; offset += m_page_size)
+        {
+            p[offset] = 0;
+        }
+    }
+};
+
+/*! A memory resource which maps every allocation from the beginning of a file, so that a container allocating from it
+ *      starts out holding the contents of the file, without reading or copying them.
+ *
+ *  The pages of the file are read when they are first accessed, and are shared with the operating system's page
+ *      cache. With \p copy_on_write, writes stay private to the allocation; with \p write_back, they go to the file. The file
+ *      never changes size: the bytes of an allocation past its end start out zero, and writes to them are not kept.
+ *
+ *  Allocations are aligned to the page size, and no more.
+ *
+ *  To get a vector holding the file's contents, use a \p mapped_file_allocator, which leaves the elements default
+ *      initialized rather than overwriting them:
+ *
+ *  \code
+ *  thrust::mr::mapped_file_resource file("dataset.bin");
+ *  thrust::mr::mapped_file_allocator<float> alloc(&file);
+ *  thrust::host_vector<float, thrust::mr::mapped_file_allocator<float> > v(file.file_size() / sizeof(float), alloc);
+ *  \endcode
+ */
+class mapped_file_resource final : public memory_resource<>
+{
+public:
+    /*! Where writes to an allocation go. */
+    enum access_mode
+    {
+        /*! Writes are private to the allocation; the file is opened read only. */
+        copy_on_write,
+        /*! Writes go to the file; the file is opened for reading and writing. */
+        write_back
+    };
+
+    /*! Constructor. Opens the file.
+     *
+     *  \param path the path of the file
+     *  \param access where writes to allocations go
+     *  \param populate whether all pages of an allocation are read in when it is made, rather than when they are first
+     *      accessed
+     *  \throws thrust::system_error when the file cannot be opened
+     */
+    mapped_file_resource(const char * path, access_mode access = copy_on_write, bool populate = false)
+        : m_fd(::open(path, access == write_back ? O_RDWR : O_RDONLY)),
+        m_access(access),
+        m_populate(populate),
+        m_page_size(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))
+    {
+        if (m_fd < 0)
+        {
+            throw thrust::system::system_error(errno, thrust::system::system_category(), path);
+        }
+    }
+
+    /*! Destructor. Closes the file; allocations which are still mapped remain valid.
+     */
+    ~mapped_file_resource()
+    {
+        ::close(m_fd);
+    }
+
+    /*! Returns the current size of the file in bytes.
+     */
+    std::size_t file_size() const
+    {
+        struct stat s;
+        if (::fstat(m_fd, &s) != 0)
+        {
+            throw thrust::system::system_error(errno, thrust::system::system_category(), "fstat failed");
+        }
+
+        return static_cast<std::size_t>(s.st_size);
+    }
+
+    THRUST_NODISCARD virtual void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        if (alignment > m_page_size)
+        {
+            throw thrust::system::detail::bad_alloc("mapped_file_resource cannot align beyond the page size");
+        }
+
+        const std::size_t length = mapping_size(bytes);
+        const std::size_t size = file_size();
+        const std::size_t file_length = size == 0 ? 0 : (std::min)(length, mapping_size(size));
+
+        int flags = m_access == write_back ? MAP_SHARED : MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+        if (m_populate) flags |= MAP_POPULATE;
+#endif
+
+        if (file_length == length)
+        {
+            return map(0, length, flags, m_fd);
+        }
+
+        // pages past the end of the file cannot be accessed through a mapping of it, so reserve the whole range
+        // with anonymous memory, and map the file over its beginning
+        char * p = static_cast<char *>(map(0, length, MAP_PRIVATE | MAP_ANONYMOUS, -1));
+
+        if (file_length > 0)
+        {
+            try
+            {
+                map(p, file_length, flags | MAP_FIXED, m_fd);
+            }
+            catch (...)
+            {
+                ::munmap(p, length);
+                throw;
+            }
+        }
+
+        return p;
+    }
+
+    virtual void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        (void)alignment;
+
+        ::munmap(p, mapping_size(bytes));
+    }
+
+private:
+    int m_fd;
+    access_mode m_access;
+    bool m_populate;
+    std::size_t m_page_size;
+
+    std::size_t mapping_size(std::size_t bytes) const
+    {
+        return bytes == 0 ? m_page_size : (bytes + m_page_size - 1) / m_page_size * m_page_size;
+    }
+
+    static void * map(void * address, std::size_t length, int flags, int fd)
+    {
+        void * p = ::mmap(address, length, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            throw thrust::system::detail::bad_alloc(std::string("mmap failed: ") + std::strerror(errno));
+        }
+
+        return p;
+    }
+
+    mapped_file_resource(const mapped_file_resource &);
+    mapped_file_resource & operator=(const mapped_file_resource &);
+};
+
+/*! An allocator which allocates from a \p mapped_file_resource, and which default initializes elements rather than
+ *      value initializing them, so that containers using it keep the contents of the file. Elements of types with
+ *      trivial default constructors are not written to at all.
+ *
+ *  \tparam T the type that will be allocated by this allocator.
+ */
+template<typename T>
+class mapped_file_allocator : public thrust::mr::allocator<T, mapped_file_resource>
+{
+    typedef thrust::mr::allocator<T, mapped_file_resource> base;
+
+public:
+    /*! The \p rebind metafunction provides the type of a \p mapped_file_allocator instantiated with another type.
+     *
+     *  \tparam U the other type to use for instantiation.
+     */
+    template<typename U>
+    struct rebind
+    {
+        /*! The typedef \p other gives the type of the rebound \p mapped_file_allocator.
+         */
+        typedef mapped_file_allocator<U> other;
+    };
+
+    /*! Constructor.
+     *
+     *  \param resource the resource to be used to allocate raw memory.
+     */
+    mapped_file_allocator(mapped_file_resource * resource) : base(resource)
+    {
+    }
+
+    /*! Conversion constructor from an allocator of a different type. Copies the memory resource pointer. */
+    template<typename U>
+    mapped_file_allocator(const mapped_file_allocator<U> & other) : base(other)
+    {
+    }
+
+    /*! Default initializes an object of type \p U at \p p. */
+    template<typename U>
+    void construct(U * p)
+    {
+        ::new(static_cast<void *>(p)) U;
+    }
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // POSIX
+
@@ -0,0 +1,805 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file partial_sort.h
+ *  \brief Functions for selecting and sorting the smallest elements of a range
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup sorting
+ *  \ingroup algorithms
+ *  \{
+ */
+
+
+/*! \p nth_element rearranges the elements of <tt>[first, last)</tt> so that the element pointed
+ *  to by \p nth is the element which would be in that position if the whole range were sorted
+ *  into ascending order. No element of <tt>[first, nth)</tt> is greater than <tt>*nth</tt> and no
+ *  element of <tt>[nth, last)</tt> is less than it; the elements are otherwise in no particular
+ *  order. If \p nth is \p last, the range is left unchanged.
+ *
+ *  This selects the <tt>nth - first</tt> smallest elements of the range in linear time, without
+ *  sorting it.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param nth The position of the element to select.
+ *  \param last The end of the sequence.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element to find the median of a
+ *  sequence of integers using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::nth_element(thrust::host, A, A + 3, A + N);
+ *  // A[3] is now 5
+ *  // A[0], A[1] and A[2] are now 1, 2 and 3 in some order
+ *  // A[4], A[5] and A[6] are now 7, 8 and 9 in some order
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/nth_element
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator>
+__host__ __device__
+  void nth_element(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last);
+
+
+/*! \p nth_element rearranges the elements of <tt>[first, last)</tt> so that the element pointed
+ *  to by \p nth is the element which would be in that position if the whole range were sorted
+ *  into ascending order. No element of <tt>[first, nth)</tt> is greater than <tt>*nth</tt> and no
+ *  element of <tt>[nth, last)</tt> is less than it; the elements are otherwise in no particular
+ *  order. If \p nth is \p last, the range is left unchanged.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param nth The position of the element to select.
+ *  \param last The end of the sequence.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element to find the median of a
+ *  sequence of integers.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::nth_element(A, A + 3, A + N);
+ *  // A[3] is now 5
+ *  // A[0], A[1] and A[2] are now 1, 2 and 3 in some order
+ *  // A[4], A[5] and A[6] are now 7, 8 and 9 in some order
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/nth_element
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename RandomAccessIterator>
+  void nth_element(RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last);
+
+
+/*! \p nth_element rearranges the elements of <tt>[first, last)</tt> so that the element pointed
+ *  to by \p nth is the element which would be in that position if the whole range were sorted
+ *  as determined by the function object \p comp. No element of <tt>[first, nth)</tt> is ordered
+ *  after <tt>*nth</tt> and no element of <tt>[nth, last)</tt> is ordered before it; the elements
+ *  are otherwise in no particular order. If \p nth is \p last, the range is left unchanged.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param nth The position of the element to select.
+ *  \param last The end of the sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element to gather the three largest
+ *  integers of a sequence at its beginning using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::nth_element(thrust::host, A, A + 3, A + N, thrust::greater<int>());
+ *  // A[0], A[1] and A[2] are now 7, 8 and 9 in some order
+ *  // A[3] is now 5
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/nth_element
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp);
+
+
+/*! \p nth_element rearranges the elements of <tt>[first, last)</tt> so that the element pointed
+ *  to by \p nth is the element which would be in that position if the whole range were sorted
+ *  as determined by the function object \p comp. No element of <tt>[first, nth)</tt> is ordered
+ *  after <tt>*nth</tt> and no element of <tt>[nth, last)</tt> is ordered before it; the elements
+ *  are otherwise in no particular order. If \p nth is \p last, the range is left unchanged.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param nth The position of the element to select.
+ *  \param last The end of the sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element to gather the three largest
+ *  integers of a sequence at its beginning.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::nth_element(A, A + 3, A + N, thrust::greater<int>());
+ *  // A[0], A[1] and A[2] are now 7, 8 and 9 in some order
+ *  // A[3] is now 5
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/nth_element
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  void nth_element(RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp);
+
+
+/*! \p nth_element_by_key performs a key-value \p nth_element: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that the key pointed to by \p keys_nth is the key which
+ *  would be in that position if the keys were sorted into ascending order, with no key of
+ *  <tt>[keys_first, keys_nth)</tt> greater than it and no key of <tt>[keys_nth, keys_last)</tt>
+ *  less than it. The values starting at \p values_first are permuted along with the keys.
+ *
+ *  With a sequence of indices for values, this selects the positions of the
+ *  <tt>keys_nth - keys_first</tt> smallest keys.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_nth The position of the key to select.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element_by_key to find the
+ *  positions of the two smallest keys using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 6;
+ *  int keys[N]    = {4, 6, 1, 5, 2, 3};
+ *  int indices[N] = {0, 1, 2, 3, 4, 5};
+ *  thrust::nth_element_by_key(thrust::host, keys, keys + 2, keys + N, indices);
+ *  // keys[0] and keys[1] are now 1 and 2 in some order
+ *  // indices[0] and indices[1] are now 2 and 4 in the same order
+ *  \endcode
+ *
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+__host__ __device__
+  void nth_element_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first);
+
+
+/*! \p nth_element_by_key performs a key-value \p nth_element: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that the key pointed to by \p keys_nth is the key which
+ *  would be in that position if the keys were sorted into ascending order, with no key of
+ *  <tt>[keys_first, keys_nth)</tt> greater than it and no key of <tt>[keys_nth, keys_last)</tt>
+ *  less than it. The values starting at \p values_first are permuted along with the keys.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_nth The position of the key to select.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element_by_key to find the
+ *  positions of the two smallest keys.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  ...
+ *  const int N = 6;
+ *  int keys[N]    = {4, 6, 1, 5, 2, 3};
+ *  int indices[N] = {0, 1, 2, 3, 4, 5};
+ *  thrust::nth_element_by_key(keys, keys + 2, keys + N, indices);
+ *  // keys[0] and keys[1] are now 1 and 2 in some order
+ *  // indices[0] and indices[1] are now 2 and 4 in the same order
+ *  \endcode
+ *
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+  void nth_element_by_key(RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first);
+
+
+/*! \p nth_element_by_key performs a key-value \p nth_element: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that the key pointed to by \p keys_nth is the key which
+ *  would be in that position if the keys were sorted as determined by the function object
+ *  \p comp, with no key of <tt>[keys_first, keys_nth)</tt> ordered after it and no key of
+ *  <tt>[keys_nth, keys_last)</tt> ordered before it. The values starting at \p values_first are
+ *  permuted along with the keys.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_nth The position of the key to select.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element_by_key to find the
+ *  positions of the two largest keys using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 6;
+ *  int keys[N]    = {4, 6, 1, 5, 2, 3};
+ *  int indices[N] = {0, 1, 2, 3, 4, 5};
+ *  thrust::nth_element_by_key(thrust::host, keys, keys + 2, keys + N, indices, thrust::greater<int>());
+ *  // keys[0] and keys[1] are now 6 and 5 in some order
+ *  // indices[0] and indices[1] are now 1 and 3 in the same order
+ *  \endcode
+ *
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first,
+                          StrictWeakOrdering comp);
+
+
+/*! \p nth_element_by_key performs a key-value \p nth_element: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that the key pointed to by \p keys_nth is the key which
+ *  would be in that position if the keys were sorted as determined by the function object
+ *  \p comp, with no key of <tt>[keys_first, keys_nth)</tt> ordered after it and no key of
+ *  <tt>[keys_nth, keys_last)</tt> ordered before it. The values starting at \p values_first are
+ *  permuted along with the keys.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_nth The position of the key to select.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p nth_element_by_key to find the
+ *  positions of the two largest keys.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  const int N = 6;
+ *  int keys[N]    = {4, 6, 1, 5, 2, 3};
+ *  int indices[N] = {0, 1, 2, 3, 4, 5};
+ *  thrust::nth_element_by_key(keys, keys + 2, keys + N, indices, thrust::greater<int>());
+ *  // keys[0] and keys[1] are now 6 and 5 in some order
+ *  // indices[0] and indices[1] are now 1 and 3 in the same order
+ *  \endcode
+ *
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+  void nth_element_by_key(RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first,
+                          StrictWeakOrdering comp);
+
+
+/*! \p partial_sort rearranges the elements of <tt>[first, last)</tt> so that
+ *  <tt>[first, middle)</tt> holds the <tt>middle - first</tt> smallest elements of the range,
+ *  sorted into ascending order. The remaining elements are placed in <tt>[middle, last)</tt> in
+ *  no particular order. The order of equivalent elements is not guaranteed to be preserved.
+ *
+ *  When <tt>middle - first</tt> is much smaller than <tt>last - first</tt>, this is much faster
+ *  than sorting the whole range.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param middle The end of the sorted part of the sequence.
+ *  \param last The end of the sequence.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort to sort the three
+ *  smallest integers of a sequence using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::partial_sort(thrust::host, A, A + 3, A + N);
+ *  // A[0], A[1] and A[2] are now 1, 2 and 3
+ *  // A[3] through A[6] are now 5, 7, 8 and 9 in some order
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/partial_sort
+ *  \see \p sort
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator>
+__host__ __device__
+  void partial_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last);
+
+
+/*! \p partial_sort rearranges the elements of <tt>[first, last)</tt> so that
+ *  <tt>[first, middle)</tt> holds the <tt>middle - first</tt> smallest elements of the range,
+ *  sorted into ascending order. The remaining elements are placed in <tt>[middle, last)</tt> in
+ *  no particular order. The order of equivalent elements is not guaranteed to be preserved.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param middle The end of the sorted part of the sequence.
+ *  \param last The end of the sequence.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort to sort the three
+ *  smallest integers of a sequence.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::partial_sort(A, A + 3, A + N);
+ *  // A[0], A[1] and A[2] are now 1, 2 and 3
+ *  // A[3] through A[6] are now 5, 7, 8 and 9 in some order
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/partial_sort
+ *  \see \p sort
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename RandomAccessIterator>
+  void partial_sort(RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last);
+
+
+/*! \p partial_sort rearranges the elements of <tt>[first, last)</tt> so that
+ *  <tt>[first, middle)</tt> holds the <tt>middle - first</tt> elements of the range which are
+ *  ordered first by the function object \p comp, sorted in that order. The remaining elements are
+ *  placed in <tt>[middle, last)</tt> in no particular order. The order of equivalent elements is
+ *  not guaranteed to be preserved.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param middle The end of the sorted part of the sequence.
+ *  \param last The end of the sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort to sort the three largest
+ *  integers of a sequence into descending order using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::partial_sort(thrust::host, A, A + 3, A + N, thrust::greater<int>());
+ *  // A[0], A[1] and A[2] are now 9, 8 and 7
+ *  // A[3] through A[6] are now 1, 2, 3 and 5 in some order
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/partial_sort
+ *  \see \p sort
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last,
+                    StrictWeakOrdering comp);
+
+
+/*! \p partial_sort rearranges the elements of <tt>[first, last)</tt> so that
+ *  <tt>[first, middle)</tt> holds the <tt>middle - first</tt> elements of the range which are
+ *  ordered first by the function object \p comp, sorted in that order. The remaining elements are
+ *  placed in <tt>[middle, last)</tt> in no particular order. The order of equivalent elements is
+ *  not guaranteed to be preserved.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param middle The end of the sorted part of the sequence.
+ *  \param last The end of the sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort to sort the three largest
+ *  integers of a sequence into descending order.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 9, 3, 7, 2, 8};
+ *  thrust::partial_sort(A, A + 3, A + N, thrust::greater<int>());
+ *  // A[0], A[1] and A[2] are now 9, 8 and 7
+ *  // A[3] through A[6] are now 1, 2, 3 and 5 in some order
+ *  \endcode
+ *
+ *  \see https://en.cppreference.com/w/cpp/algorithm/partial_sort
+ *  \see \p sort
+ *  \see \p nth_element
+ *  \see \p partial_sort_by_key
+ */
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+  void partial_sort(RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last,
+                    StrictWeakOrdering comp);
+
+
+/*! \p partial_sort_by_key performs a key-value \p partial_sort: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that <tt>[keys_first, keys_middle)</tt> holds the
+ *  <tt>keys_middle - keys_first</tt> smallest keys, sorted into ascending order, and the
+ *  remaining keys follow in no particular order. The values starting at \p values_first are
+ *  permuted along with the keys.
+ *
+ *  With a sequence of indices for values, this computes the top-k keys of a range together
+ *  with their positions.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_middle The end of the sorted part of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort_by_key to find the two
+ *  smallest keys and their positions using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 6;
+ *  int keys[N]    = {4, 6, 1, 5, 2, 3};
+ *  int indices[N] = {0, 1, 2, 3, 4, 5};
+ *  thrust::partial_sort_by_key(thrust::host, keys, keys + 2, keys + N, indices);
+ *  // keys[0] and keys[1] are now 1 and 2
+ *  // indices[0] and indices[1] are now 2 and 4
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+__host__ __device__
+  void partial_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first);
+
+
+/*! \p partial_sort_by_key performs a key-value \p partial_sort: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that <tt>[keys_first, keys_middle)</tt> holds the
+ *  <tt>keys_middle - keys_first</tt> smallest keys, sorted into ascending order, and the
+ *  remaining keys follow in no particular order. The values starting at \p values_first are
+ *  permuted along with the keys.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_middle The end of the sorted part of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort_by_key to find the two
+ *  smallest keys and their positions.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  ...
+ *  const int N = 6;
+ *  int keys[N]    = {4, 6, 1, 5, 2, 3};
+ *  int indices[N] = {0, 1, 2, 3, 4, 5};
+ *  thrust::partial_sort_by_key(keys, keys + 2, keys + N, indices);
+ *  // keys[0] and keys[1] are now 1 and 2
+ *  // indices[0] and indices[1] are now 2 and 4
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+  void partial_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first);
+
+
+/*! \p partial_sort_by_key performs a key-value \p partial_sort: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that <tt>[keys_first, keys_middle)</tt> holds the
+ *  <tt>keys_middle - keys_first</tt> keys which are ordered first by the function object \p comp,
+ *  sorted in that order, and the remaining keys follow in no particular order. The values
+ *  starting at \p values_first are permuted along with the keys.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_middle The end of the sorted part of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort_by_key to find the three
+ *  highest scores and their positions using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 5;
+ *  float scores[N] = {0.5f, 0.9f, 0.1f, 0.7f, 0.3f};
+ *  int  indices[N] = {0, 1, 2, 3, 4};
+ *  thrust::partial_sort_by_key(thrust::host, scores, scores + 3, scores + N, indices, thrust::greater<float>());
+ *  // scores[0], scores[1] and scores[2] are now 0.9f, 0.7f and 0.5f
+ *  // indices[0], indices[1] and indices[2] are now 1, 3 and 0
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           StrictWeakOrdering comp);
+
+
+/*! \p partial_sort_by_key performs a key-value \p partial_sort: it rearranges the keys of
+ *  <tt>[keys_first, keys_last)</tt> so that <tt>[keys_first, keys_middle)</tt> holds the
+ *  <tt>keys_middle - keys_first</tt> keys which are ordered first by the function object \p comp,
+ *  sorted in that order, and the remaining keys follow in no particular order. The values
+ *  starting at \p values_first are permuted along with the keys.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_middle The end of the sorted part of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p partial_sort_by_key to find the three
+ *  highest scores and their positions.
+ *
+ *  \code
+ *  #include <thrust/partial_sort.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  const int N = 5;
+ *  float scores[N] = {0.5f, 0.9f, 0.1f, 0.7f, 0.3f};
+ *  int  indices[N] = {0, 1, 2, 3, 4};
+ *  thrust::partial_sort_by_key(scores, scores + 3, scores + N, indices, thrust::greater<float>());
+ *  // scores[0], scores[1] and scores[2] are now 0.9f, 0.7f and 0.5f
+ *  // indices[0], indices[1] and indices[2] are now 1, 3 and 0
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p partial_sort
+ *  \see \p nth_element_by_key
+ */
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering>
+  void partial_sort_by_key(RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           StrictWeakOrdering comp);
+
+
+/*! \} // end sorting
+ */
+
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/partial_sort.inl>
@@ -95,11 +95,36 @@ template<typename Engine, size_t p, size_t r>
   void discard_block_engine<Engine,p,r>
     ::discard(unsigned long long z)
 {
-  // XXX this should be accelerated
-  for(; z > 0; --z)
+  // results left in the current block
+  const unsigned long long available = m_n < used_block ? used_block - m_n : 0;
+
+  if(z <= available)
+  {
+    m_e.discard(z);
+    m_n += static_cast<unsigned int>(z);
+    return;
+  }
+
+  // each block after the current one begins by skipping the rest of the previous block
+  const unsigned long long remaining = z - available;
+  const unsigned long long blocks    = (remaining - 1) / used_block + 1;
+  const unsigned long long skipped   = block_size - used_block;
+
+  if(skipped == 0 || blocks <= (~0ull - z) / skipped)
   {
-    this->operator()();
-  } // end for
+    m_e.discard(z + blocks * skipped);
+  }
+  else
+  {
+    // avoid overflow in the number of base engine steps
+    m_e.discard(z);
+    for(size_t i = 0; i < skipped; ++i)
+    {
+      m_e.discard(blocks);
+    }
+  }
+
+  m_n = static_cast<unsigned int>(remaining - (blocks - 1) * used_block);
 }
 
 
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// A step of a linear feedback shift engine is linear over GF(2), so z steps are the
+// z-th power of a bit matrix, which we compute by repeated squaring.
+struct linear_feedback_shift_engine_discard
+{
+  // below this many steps, stepping the engine is cheaper than a jump
+  static const unsigned long long jump_threshold = 1 << 14;
+
+  // the product of a bit matrix, stored as columns, and a vector
+  template<typename UIntType>
+  __host__ __device__
+  static UIntType multiply(const UIntType *matrix, UIntType x)
+  {
+    UIntType result = 0;
+    for(int j = 0; x != 0; ++j, x >>= 1)
+    {
+      // select column j without a branch
+      result ^= matrix[j] & (UIntType(0) - (x & 1));
+    }
+
+    return result;
+  }
+
+  template<typename LinearFeedbackShiftEngine>
+  __host__ __device__
+  static void discard(LinearFeedbackShiftEngine &e, unsigned long long z)
+  {
+    typedef typename LinearFeedbackShiftEngine::result_type result_type;
+    const int digits = 8 * sizeof(result_type);
+
+    if(z < jump_threshold)
+    {
+      for(; z > 0; --z)
+      {
+        e();
+      }
+
+      return;
+    }
+
+    // column j of the step's matrix is the image of bit j
+    result_type power[digits];
+    result_type square[digits];
+    for(int j = 0; j < digits; ++j)
+    {
+      LinearFeedbackShiftEngine basis;
+      basis.m_value = static_cast<result_type>(result_type(1) << j);
+      power[j] = basis();
+    }
+
+    // see http://en.wikipedia.org/wiki/Modular_exponentiation
+    result_type x = e.m_value;
+    while(z > 0)
+    {
+      if(z & 1)
+      {
+        x = multiply(power, x);
+      }
+
+      z >>= 1;
+
+      if(z > 0)
+      {
+        for(int j = 0; j < digits; ++j)
+        {
+          square[j] = multiply(power, power[j]);
+        }
+
+        for(int j = 0; j < digits; ++j)
+        {
+          power[j] = square[j];
+        }
+      }
+    }
+
+    e.m_value = x;
+  }
+}; // end linear_feedback_shift_engine_discard
+
+
+} // end detail
+
+} // end random
+
+THRUST_NAMESPACE_END
+
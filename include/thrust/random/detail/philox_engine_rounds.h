@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// the word type and multiply of Philox with w-bit words
+template<size_t w> struct philox_engine_word;
+
+
+template<>
+  struct philox_engine_word<32>
+{
+  typedef thrust::detail::uint32_t type;
+
+  __host__ __device__
+  static type mulhilo(type a, type b, type &hi)
+  {
+    const thrust::detail::uint64_t product = thrust::detail::uint64_t(a) * b;
+    hi = static_cast<type>(product >> 32);
+    return static_cast<type>(product);
+  }
+}; // end philox_engine_word
+
+
+template<>
+  struct philox_engine_word<64>
+{
+  typedef thrust::detail::uint64_t type;
+
+  __host__ __device__
+  static type mulhilo(type a, type b, type &hi)
+  {
+#if defined(__CUDA_ARCH__)
+    hi = __umul64hi(a, b);
+#elif defined(__SIZEOF_INT128__)
+    hi = static_cast<type>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+    // assemble the high word from 32-bit halves
+    const type a_lo = a & 0xffffffffu, a_hi = a >> 32;
+    const type b_lo = b & 0xffffffffu, b_hi = b >> 32;
+
+    const type lo_lo = a_lo * b_lo;
+    const type hi_lo = a_hi * b_lo;
+    const type lo_hi = a_lo * b_hi;
+
+    const type middle = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+    hi = a_hi * b_hi + (hi_lo >> 32) + (middle >> 32);
+#endif
+    return a * b;
+  }
+}; // end philox_engine_word
+
+
+// the multipliers and round key increments of Salmon et al. (2011)
+template<size_t w, size_t n> struct philox_engine_constants;
+
+template<>
+  struct philox_engine_constants<32,2>
+{
+  static const thrust::detail::uint32_t multiplier0 = 0xD256D193u;
+  static const thrust::detail::uint32_t weyl0       = 0x9E3779B9u;
+};
+
+template<>
+  struct philox_engine_constants<32,4>
+{
+  static const thrust::detail::uint32_t multiplier0 = 0xD2511F53u;
+  static const thrust::detail::uint32_t multiplier1 = 0xCD9E8D57u;
+  static const thrust::detail::uint32_t weyl0       = 0x9E3779B9u;
+  static const thrust::detail::uint32_t weyl1       = 0xBB67AE85u;
+};
+
+template<>
+  struct philox_engine_constants<64,2>
+{
+  static const thrust::detail::uint64_t multiplier0 = 0xD2B74407B1CE6E93ull;
+  static const thrust::detail::uint64_t weyl0       = 0x9E3779B97F4A7C15ull;
+};
+
+template<>
+  struct philox_engine_constants<64,4>
+{
+  static const thrust::detail::uint64_t multiplier0 = 0xD2E7470EE14C6C93ull;
+  static const thrust::detail::uint64_t multiplier1 = 0xCA5A826395121157ull;
+  static const thrust::detail::uint64_t weyl0       = 0x9E3779B97F4A7C15ull;
+  static const thrust::detail::uint64_t weyl1       = 0xBB67AE8584CAA73Bull;
+};
+
+
+// applies r rounds of Philox to the n words of x with the n/2 words of key
+template<size_t w, size_t n, size_t r> struct philox_engine_rounds;
+
+
+template<size_t w, size_t r>
+  struct philox_engine_rounds<w,2,r>
+{
+  typedef typename philox_engine_word<w>::type word_type;
+  typedef philox_engine_constants<w,2>         constants;
+
+  __host__ __device__
+  static void apply(word_type *x, const word_type *key)
+  {
+    word_type k0 = key[0];
+
+    for(size_t i = 0; i < r; ++i, k0 += constants::weyl0)
+    {
+      word_type hi;
+      const word_type lo = philox_engine_word<w>::mulhilo(constants::multiplier0, x[0], hi);
+
+      x[0] = hi ^ k0 ^ x[1];
+      x[1] = lo;
+    }
+  }
+}; // end philox_engine_rounds
+
+
+template<size_t w, size_t r>
+  struct philox_engine_rounds<w,4,r>
+{
+  typedef typename philox_engine_word<w>::type word_type;
+  typedef philox_engine_constants<w,4>         constants;
+
+  __host__ __device__
+  static void apply(word_type *x, const word_type *key)
+  {
+    word_type k0 = key[0];
+    word_type k1 = key[1];
+
+    for(size_t i = 0; i < r; ++i, k0 += constants::weyl0, k1 += constants::weyl1)
+    {
+      word_type hi0, hi1;
+      const word_type lo0 = philox_engine_word<w>::mulhilo(constants::multiplier0, x[0], hi0);
+      const word_type lo1 = philox_engine_word<w>::mulhilo(constants::multiplier1, x[2], hi1);
+
+      x[0] = hi1 ^ x[1] ^ k0;
+      x[1] = lo1;
+      x[2] = hi0 ^ x[3] ^ k1;
+      x[3] = lo0;
+    }
+  }
+}; // end philox_engine_rounds
+
+
+} // end detail
+
+} // end random
+
+THRUST_NAMESPACE_END
+
@@ -94,10 +94,7 @@ template<typename UIntType, size_t w, size_t s, size_t r>
   void subtract_with_carry_engine<UIntType,w,s,r>
     ::discard(unsigned long long z)
 {
-  for(; z > 0; --z)
-  {
-    this->operator()();
-  } // end for
+  thrust::random::detail::subtract_with_carry_engine_discard::discard(*this, z);
 } // end subtract_with_carry_engine::discard()
 
 
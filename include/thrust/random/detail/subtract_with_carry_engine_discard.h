@@ -0,0 +1,320 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// A subtract with borrow generator with base b = 2^w and lags s < r is a linear
+// congruential generator in disguise (Tezuka, L'Ecuyer & Couture, 1993): if y_0, ..., y_{r-1}
+// are the last r results, oldest first, and c is the carry, then
+//
+//   X = sum_{i < r} y_i b^i - sum_{i < s} y_{r-s+i} b^i + c
+//
+// evolves as X <- a X mod m, with m = b^r - b^s + 1 and a = m - (m - 1) / b.
+// We jump X ahead by a^z with arithmetic on numbers of r words, split into limbs which leave
+// room for carries in 64 bits, and map it back to a state with a zero carry.
+// Distinct states may share X, but they agree after r more steps.
+template<typename UIntType, size_t w, size_t s, size_t r>
+  struct subtract_with_carry_engine_discard_implementation
+{
+  typedef thrust::detail::uint32_t limb_type;
+  typedef thrust::detail::uint64_t wide_type;
+
+  static const size_t limbs_per_word = (w + 31) / 32;
+  static const size_t limb_bits      = w / limbs_per_word;
+  static const size_t n              = r * limbs_per_word;
+  static const size_t k              = s * limbs_per_word;
+
+  // we only jump when words split evenly into limbs
+  static const bool is_jumpable = (limb_bits * limbs_per_word == w);
+
+  // below this many steps, stepping the engine is cheaper than a jump
+  static const unsigned long long jump_threshold = 1 << 14;
+
+  __host__ __device__
+  static limb_type limb_mask()
+  {
+    return static_cast<limb_type>((wide_type(1) << limb_bits) - 1);
+  }
+
+  // x[0,len) += y[0,ylen) * B^shift, returning the carry out of x
+  __host__ __device__
+  static limb_type add(limb_type *x, size_t len, const limb_type *y, size_t ylen, size_t shift)
+  {
+    wide_type carry = 0;
+    for(size_t i = shift; i < len && (carry != 0 || i < shift + ylen); ++i)
+    {
+      wide_type t = wide_type(x[i]) + carry + (i < shift + ylen ? y[i - shift] : 0);
+      x[i] = static_cast<limb_type>(t & limb_mask());
+      carry = t >> limb_bits;
+    }
+
+    return static_cast<limb_type>(carry);
+  }
+
+  // x[0,len) -= y[0,ylen), assuming the result is nonnegative
+  __host__ __device__
+  static void subtract(limb_type *x, size_t len, const limb_type *y, size_t ylen)
+  {
+    wide_type borrow = 0;
+    for(size_t i = 0; i < len && (borrow != 0 || i < ylen); ++i)
+    {
+      wide_type t = (wide_type(1) << limb_bits) + x[i] - borrow - (i < ylen ? y[i] : 0);
+      x[i] = static_cast<limb_type>(t & limb_mask());
+      borrow = 1 - (t >> limb_bits);
+    }
+  }
+
+  // x <- x y mod m
+  __host__ __device__
+  static void multiply(limb_type *x, const limb_type *y)
+  {
+    limb_type buffer[2][2 * n + 1];
+    limb_type *p = buffer[0];
+    limb_type *q = buffer[1];
+
+    for(size_t i = 0; i < 2 * n; ++i)
+    {
+      p[i] = 0;
+    }
+
+    // schoolbook multiplication
+    for(size_t i = 0; i < n; ++i)
+    {
+      wide_type carry = 0;
+      for(size_t j = 0; j < n; ++j)
+      {
+        wide_type t = wide_type(x[i]) * y[j] + p[i + j] + carry;
+        p[i + j] = static_cast<limb_type>(t & limb_mask());
+        carry = t >> limb_bits;
+      }
+      p[i + n] = static_cast<limb_type>(carry);
+    }
+
+    // fold the high part H of L + H B^n using B^n = B^k - 1 (mod m)
+    size_t len = 2 * n;
+    while(len > n)
+    {
+      const size_t high = len - n;
+      const size_t folded = (k + high > n ? k + high : n) + 1;
+
+      for(size_t i = 0; i < folded; ++i)
+      {
+        q[i] = i < n ? p[i] : 0;
+      }
+
+      add(q, folded, p + n, high, k);
+      subtract(q, folded, p + n, high);
+
+      len = folded;
+      while(len > n && q[len - 1] == 0)
+      {
+        --len;
+      }
+
+      limb_type *tmp = p;
+      p = q;
+      q = tmp;
+    }
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      x[i] = p[i];
+    }
+
+    reduce(x);
+  }
+
+  // brings x < B^n into [0, m)
+  __host__ __device__
+  static void reduce(limb_type *x)
+  {
+    // x >= m exactly when x + B^k - 1 overflows B^n
+    limb_type y[n];
+    for(size_t i = 0; i < n; ++i)
+    {
+      y[i] = x[i];
+    }
+
+    limb_type ones[k];
+    for(size_t i = 0; i < k; ++i)
+    {
+      ones[i] = limb_mask();
+    }
+
+    if(add(y, n, ones, k, 0))
+    {
+      for(size_t i = 0; i < n; ++i)
+      {
+        x[i] = y[i];
+      }
+    }
+  }
+
+  __host__ __device__
+  static void jump(UIntType *state, unsigned int first, int &carry, unsigned long long z)
+  {
+    const size_t d = limbs_per_word;
+
+    // gather the words oldest first
+    limb_type x[n];
+    limb_type top[k];
+    for(size_t i = 0; i < n; ++i)
+    {
+      x[i] = static_cast<limb_type>((state[(first + i / d) % r] >> ((i % d) * limb_bits)) & limb_mask());
+    }
+
+    for(size_t i = 0; i < k; ++i)
+    {
+      top[i] = x[n - k + i];
+    }
+
+    subtract(x, n, top, k);
+
+    limb_type c = static_cast<limb_type>(carry);
+    add(x, n, &c, 1, 0);
+    reduce(x);
+
+    bool is_zero = true;
+    for(size_t i = 0; i < n; ++i)
+    {
+      is_zero = is_zero && x[i] == 0;
+    }
+
+    // the states with X = 0 never change
+    if(is_zero) return;
+
+    // a = B^n - B^(n-d) - B^k + B^(k-d) + 1
+    limb_type a[n];
+    limb_type a_low[k];
+    for(size_t i = 0; i < n; ++i)
+    {
+      a[i] = i >= n - d ? limb_mask() : 0;
+    }
+
+    for(size_t i = 0; i < k; ++i)
+    {
+      a_low[i] = i >= k - d ? limb_mask() : 0;
+    }
+
+    limb_type one = 1;
+    add(a, n, &one, 1, 0);
+    subtract(a, n, a_low, k);
+
+    // see http://en.wikipedia.org/wiki/Modular_exponentiation
+    while(z > 0)
+    {
+      if(z & 1)
+      {
+        multiply(x, a);
+      }
+
+      z >>= 1;
+
+      if(z > 0)
+      {
+        multiply(a, a);
+      }
+    }
+
+    // find the state A with no carry for which A - floor(A / B^(n-k)) = X
+    limb_type guess[k];
+    for(size_t i = 0; i < k; ++i)
+    {
+      guess[i] = x[n - k + i];
+    }
+
+    limb_type y[n];
+    for(bool converged = false; !converged; )
+    {
+      for(size_t i = 0; i < n; ++i)
+      {
+        y[i] = x[i];
+      }
+
+      add(y, n, guess, k, 0);
+
+      converged = true;
+      for(size_t i = 0; i < k; ++i)
+      {
+        converged = converged && guess[i] == y[n - k + i];
+        guess[i] = y[n - k + i];
+      }
+    }
+
+    for(size_t i = 0; i < r; ++i)
+    {
+      UIntType word = 0;
+      for(size_t j = 0; j < d; ++j)
+      {
+        word |= static_cast<UIntType>(y[i * d + j]) << (j * limb_bits);
+      }
+
+      state[(first + i) % r] = word;
+    }
+
+    carry = 0;
+  }
+}; // end subtract_with_carry_engine_discard_implementation
+
+
+struct subtract_with_carry_engine_discard
+{
+  template<typename SubtractWithCarryEngine>
+  __host__ __device__
+  static void discard(SubtractWithCarryEngine &e, unsigned long long z)
+  {
+    typedef typename SubtractWithCarryEngine::result_type result_type;
+    const size_t w = SubtractWithCarryEngine::word_size;
+    const size_t s = SubtractWithCarryEngine::short_lag;
+    const size_t r = SubtractWithCarryEngine::long_lag;
+
+    typedef subtract_with_carry_engine_discard_implementation<result_type,w,s,r> implementation;
+
+    if(implementation::is_jumpable && z >= implementation::jump_threshold + r)
+    {
+      // jump to a state which agrees with the target after the last r steps
+      implementation::jump(e.m_x, e.m_k, e.m_carry, z - r);
+      z = r;
+    }
+
+    for(; z > 0; --z)
+    {
+      e();
+    }
+  }
+}; // end subtract_with_carry_engine_discard
+
+
+} // end detail
+
+} // end random
+
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,304 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <thrust/random/threefry_engine.h>
+#include <thrust/random/detail/random_core_access.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  threefry_engine<UIntType,w,n,r>
+    ::threefry_engine(result_type value)
+{
+  seed(value);
+} // end threefry_engine::threefry_engine()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  threefry_engine<UIntType,w,n,r>
+    ::threefry_engine(const result_type (&key)[key_size], const result_type (&counter)[word_count])
+{
+  seed(key, counter);
+} // end threefry_engine::threefry_engine()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,n,r>
+    ::seed(result_type value)
+{
+  for(size_t i = 0; i < key_size; ++i)
+  {
+    m_key[i] = 0;
+  }
+
+  m_key[0] = value & max;
+
+  for(size_t i = 0; i < word_count; ++i)
+  {
+    m_counter[i] = 0;
+    m_results[i] = 0;
+  }
+
+  // the next result begins a new block
+  m_index = word_count - 1;
+} // end threefry_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,n,r>
+    ::seed(const result_type (&key)[key_size], const result_type (&counter)[word_count])
+{
+  for(size_t i = 0; i < key_size; ++i)
+  {
+    m_key[i] = key[i] & max;
+  }
+
+  for(size_t i = 0; i < word_count; ++i)
+  {
+    m_counter[i] = counter[i] & max;
+    m_results[i] = 0;
+  }
+
+  // the next result begins a new block
+  m_index = word_count - 1;
+} // end threefry_engine::seed()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,n,r>
+    ::advance_counter(unsigned long long z)
+{
+  for(size_t i = 0; i < word_count && z > 0; ++i)
+  {
+    const result_type addend = static_cast<result_type>(z) & max;
+    const result_type sum    = (m_counter[i] + addend) & max;
+
+    // shift in two steps to allow w == 64
+    z = ((z >> (w / 2)) >> (w / 2)) + (sum < addend ? 1 : 0);
+
+    m_counter[i] = sum;
+  }
+} // end threefry_engine::advance_counter()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,n,r>
+    ::generate_results(void)
+{
+  typedef detail::threefry_engine_rounds<w,n,r> rounds;
+  typedef typename rounds::word_type          word_type;
+
+  word_type x[word_count];
+  word_type k[key_size];
+
+  for(size_t i = 0; i < word_count; ++i)
+  {
+    x[i] = static_cast<word_type>(m_counter[i]);
+  }
+
+  for(size_t i = 0; i < key_size; ++i)
+  {
+    k[i] = static_cast<word_type>(m_key[i]);
+  }
+
+  rounds::apply(x, k);
+
+  for(size_t i = 0; i < word_count; ++i)
+  {
+    m_results[i] = static_cast<result_type>(x[i]);
+  }
+
+  advance_counter(1);
+} // end threefry_engine::generate_results()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  typename threefry_engine<UIntType,w,n,r>::result_type
+    threefry_engine<UIntType,w,n,r>
+      ::operator()(void)
+{
+  if(++m_index == word_count)
+  {
+    generate_results();
+    m_index = 0;
+  }
+
+  return m_results[m_index];
+} // end threefry_engine::operator()()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  void threefry_engine<UIntType,w,n,r>
+    ::discard(unsigned long long z)
+{
+  // results left in the current block
+  const unsigned long long available = word_count - 1 - m_index;
+
+  if(z <= available)
+  {
+    m_index += static_cast<unsigned int>(z);
+    return;
+  }
+
+  // skip whole blocks by advancing the counter, then generate the block holding the last result
+  z -= available + 1;
+
+  advance_counter(z / word_count);
+  generate_results();
+
+  m_index = static_cast<unsigned int>(z % word_count);
+} // end threefry_engine::discard()
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& threefry_engine<UIntType,w,n,r>
+      ::stream_out(std::basic_ostream<CharT,Traits> &os) const
+{
+  typedef std::basic_ostream<CharT,Traits> ostream_type;
+  typedef typename ostream_type::ios_base  ios_base;
+
+  // save old flags & fill character
+  const typename ios_base::fmtflags flags = os.flags();
+  const CharT fill = os.fill();
+
+  const CharT space = os.widen(' ');
+  os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+  os.fill(space);
+
+  // output the key, the counter, the current block and the position within it
+  for(size_t i = 0; i < key_size; ++i)
+    os << m_key[i] << space;
+  for(size_t i = 0; i < word_count; ++i)
+    os << m_counter[i] << space;
+  for(size_t i = 0; i < word_count; ++i)
+    os << m_results[i] << space;
+  os << m_index;
+
+  // restore flags & fill character
+  os.flags(flags);
+  os.fill(fill);
+
+  return os;
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& threefry_engine<UIntType,w,n,r>
+      ::stream_in(std::basic_istream<CharT,Traits> &is)
+{
+  typedef std::basic_istream<CharT,Traits> istream_type;
+  typedef typename istream_type::ios_base  ios_base;
+
+  // save old flags
+  const typename ios_base::fmtflags flags = is.flags();
+
+  is.flags(ios_base::dec | ios_base::skipws);
+
+  // input the key, the counter, the current block and the position within it
+  for(size_t i = 0; i < key_size; ++i)
+    is >> m_key[i];
+  for(size_t i = 0; i < word_count; ++i)
+    is >> m_counter[i];
+  for(size_t i = 0; i < word_count; ++i)
+    is >> m_results[i];
+  is >> m_index;
+
+  // restore flags
+  is.flags(flags);
+
+  return is;
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+  __host__ __device__
+  bool threefry_engine<UIntType,w,n,r>
+    ::equal(const threefry_engine<UIntType,w,n,r> &rhs) const
+{
+  for(size_t i = 0; i < key_size; ++i)
+  {
+    if(m_key[i] != rhs.m_key[i]) return false;
+  }
+
+  for(size_t i = 0; i < word_count; ++i)
+  {
+    if(m_counter[i] != rhs.m_counter[i] || m_results[i] != rhs.m_results[i]) return false;
+  }
+
+  return m_index == rhs.m_index;
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+__host__ __device__
+bool operator==(const threefry_engine<UIntType,w,n,r> &lhs,
+                const threefry_engine<UIntType,w,n,r> &rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs,rhs);
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r>
+__host__ __device__
+bool operator!=(const threefry_engine<UIntType,w,n,r> &lhs,
+                const threefry_engine<UIntType,w,n,r> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const threefry_engine<UIntType,w,n,r> &e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os,e);
+}
+
+
+template<typename UIntType, size_t w, size_t n, size_t r,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           threefry_engine<UIntType,w,n,r> &e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is,e);
+}
+
+
+} // end random
+
+THRUST_NAMESPACE_END
+
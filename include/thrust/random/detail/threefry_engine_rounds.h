@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <thrust/detail/cstdint.h>
+#include <cstddef> // for size_t
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+
+// the word type, key schedule parity and rotations of Threefry with w-bit words and n lanes,
+// after Salmon et al. (2011)
+template<size_t w, size_t n> struct threefry_engine_constants;
+
+template<>
+  struct threefry_engine_constants<32,2>
+{
+  typedef thrust::detail::uint32_t word_type;
+
+  static const word_type parity = 0x1BD11BDAu;
+
+  __host__ __device__
+  static unsigned int rotation(size_t round, size_t)
+  {
+    const unsigned int r[8] = {13, 15, 26, 6, 17, 29, 16, 24};
+    return r[round % 8];
+  }
+};
+
+template<>
+  struct threefry_engine_constants<32,4>
+{
+  typedef thrust::detail::uint32_t word_type;
+
+  static const word_type parity = 0x1BD11BDAu;
+
+  __host__ __device__
+  static unsigned int rotation(size_t round, size_t pair)
+  {
+    const unsigned int r[8][2] = {{10, 26}, {11, 21}, {13, 27}, {23,  5},
+                                  { 6, 20}, {17, 11}, {25, 10}, {18, 20}};
+    return r[round % 8][pair];
+  }
+};
+
+template<>
+  struct threefry_engine_constants<64,2>
+{
+  typedef thrust::detail::uint64_t word_type;
+
+  static const word_type parity = 0x1BD11BDAA9FC1A22ull;
+
+  __host__ __device__
+  static unsigned int rotation(size_t round, size_t)
+  {
+    const unsigned int r[8] = {16, 42, 12, 31, 16, 32, 24, 21};
+    return r[round % 8];
+  }
+};
+
+template<>
+  struct threefry_engine_constants<64,4>
+{
+  typedef thrust::detail::uint64_t word_type;
+
+  static const word_type parity = 0x1BD11BDAA9FC1A22ull;
+
+  __host__ __device__
+  static unsigned int rotation(size_t round, size_t pair)
+  {
+    const unsigned int r[8][2] = {{14, 16}, {52, 57}, {23, 40}, { 5, 37},
+                                  {25, 33}, {46, 12}, {58, 22}, {32, 32}};
+    return r[round % 8][pair];
+  }
+};
+
+
+// applies r rounds of Threefry to the n words of x with the n words of key
+template<size_t w, size_t n, size_t r>
+  struct threefry_engine_rounds
+{
+  typedef threefry_engine_constants<w,n>     constants;
+  typedef typename constants::word_type      word_type;
+
+  __host__ __device__
+  static word_type rotate_left(word_type x, unsigned int s)
+  {
+    return (x << s) | (x >> (w - s));
+  }
+
+  // x[i] += x[j]; x[j] = rotl(x[j]) ^ x[i]
+  __host__ __device__
+  static void mix(word_type &xi, word_type &xj, unsigned int s)
+  {
+    xi += xj;
+    xj = rotate_left(xj, s) ^ xi;
+  }
+
+  __host__ __device__
+  static void apply(word_type *x, const word_type *key)
+  {
+    // the key schedule has an extra word, the parity of the others
+    word_type schedule[n + 1];
+    schedule[n] = constants::parity;
+    for(size_t i = 0; i < n; ++i)
+    {
+      schedule[i] = key[i];
+      schedule[n] ^= key[i];
+      x[i] += key[i];
+    }
+
+    for(size_t i = 0; i < r; ++i)
+    {
+      if(n == 2)
+      {
+        mix(x[0], x[1], constants::rotation(i, 0));
+      }
+      else if(i % 2 == 0)
+      {
+        mix(x[0], x[1], constants::rotation(i, 0));
+        mix(x[2], x[3], constants::rotation(i, 1));
+      }
+      else
+      {
+        mix(x[0], x[3], constants::rotation(i, 0));
+        mix(x[2], x[1], constants::rotation(i, 1));
+      }
+
+      // inject the key every four rounds
+      if(i % 4 == 3)
+      {
+        const size_t s = (i + 1) / 4;
+        for(size_t j = 0; j < n; ++j)
+        {
+          x[j] += schedule[(s + j) % (n + 1)];
+        }
+
+        x[n - 1] += static_cast<word_type>(s);
+      }
+    }
+  }
+}; // end threefry_engine_rounds
+
+
+} // end detail
+
+} // end random
+
+THRUST_NAMESPACE_END
+
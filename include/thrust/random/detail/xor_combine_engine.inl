@@ -110,10 +110,9 @@ template<typename Engine1, size_t s1,
   void xor_combine_engine<Engine1, s1, Engine2, s2>
     ::discard(unsigned long long z)
 {
-  for(; z > 0; --z)
-  {
-    this->operator()();
-  } // end for
+  // each result advances both base engines once
+  m_b1.discard(z);
+  m_b2.discard(z);
 } // end xor_combine_engine::discard()
 
 
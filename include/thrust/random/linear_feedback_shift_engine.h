@@ -34,6 +34,7 @@
 #include <iostream>
 #include <cstddef> // for size_t
 #include <thrust/random/detail/random_core_access.h>
+#include <thrust/random/detail/linear_feedback_shift_engine_discard.h>
 
 THRUST_NAMESPACE_BEGIN
 
@@ -154,6 +155,8 @@ template<typename UIntType, size_t w, size_t k, size_t q, size_t s>
 
     friend struct thrust::random::detail::random_core_access;
 
+    friend struct thrust::random::detail::linear_feedback_shift_engine_discard;
+
     __host__ __device__
     bool equal(const linear_feedback_shift_engine &rhs) const;
 
@@ -0,0 +1,305 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file threefry_engine.h
+ *  \brief A counter-based pseudorandom number engine based on Threefry.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <iostream>
+#include <cstddef> // for size_t
+#include <thrust/detail/cstdint.h>
+#include <thrust/random/detail/random_core_access.h>
+#include <thrust/random/detail/threefry_engine_rounds.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class threefry_engine
+ *  \brief A \p threefry_engine random number engine produces unsigned integer random numbers
+ *         by applying the Threefry block function of Salmon et al. (2011), a reduced-round
+ *         variant of the Threefish block cipher, to a counter.
+ *
+ *         The engine's state is a key, an <tt>n * w</tt>-bit counter and the \c n words of
+ *         output last produced from it. Each block of \c n results is a function of the key and
+ *         the counter alone, so \p discard takes constant time and independent streams can
+ *         be created directly from a (key, counter) pair instead of by seeding or discarding.
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values, \c 32 or \c 64.
+ *  \tparam n The number of words in the counter, \c 2 or \c 4.
+ *  \tparam r The number of rounds applied to the counter, usually \c 20.
+ *
+ *  \note Inexperienced users should not use this class template directly.  Instead, use
+ *  \p threefry2x64, \p threefry4x32 or \p threefry4x64.
+ *
+ *  The following code snippet shows an example of generating an independent random
+ *  number for each index of a range:
+ *
+ *  \code
+ *  #include <thrust/random/threefry_engine.h>
+ *  #include <thrust/random/uniform_real_distribution.h>
+ *  #include <thrust/tabulate.h>
+ *  #include <thrust/device_vector.h>
+ *
+ *  struct random_at
+ *  {
+ *    __host__ __device__
+ *    float operator()(unsigned int i) const
+ *    {
+ *      // the i-th counter of the stream with key 13
+ *      const thrust::threefry4x32::result_type key[4] = {13, 0, 0, 0};
+ *      const thrust::threefry4x32::result_type counter[4] = {i, 0, 0, 0};
+ *
+ *      thrust::threefry4x32 rng(key, counter);
+ *      thrust::uniform_real_distribution<float> dist;
+ *
+ *      return dist(rng);
+ *    }
+ *  };
+ *  ...
+ *  thrust::device_vector<float> v(1000);
+ *  thrust::tabulate(v.begin(), v.end(), random_at());
+ *  \endcode
+ */
+template<typename UIntType, size_t w, size_t n, size_t r>
+  class threefry_engine
+{
+  public:
+    // types
+
+    /*! \typedef result_type
+     *  \brief The type of the unsigned integer produced by this \p threefry_engine.
+     */
+    typedef UIntType result_type;
+
+    // engine characteristics
+
+    /*! The word size of the produced values.
+     */
+    static const size_t word_size = w;
+
+    /*! The number of words in the counter and in each block of results.
+     */
+    static const size_t word_count = n;
+
+    /*! The number of words in the key.
+     */
+    static const size_t key_size = n;
+
+    /*! The number of rounds used in the generation algorithm.
+     */
+    static const size_t round_count = r;
+
+    /*! The smallest value this \p threefry_engine may potentially produce.
+     */
+    static const result_type min = 0;
+
+    /*! The largest value this \p threefry_engine may potentially produce.
+     */
+    static const result_type max = (~result_type(0)) >> (8 * sizeof(result_type) - w);
+
+    /*! The default seed of this \p threefry_engine.
+     */
+    static const result_type default_seed = 20111115u;
+
+    // constructors and seeding functions
+
+    /*! This constructor, which optionally accepts a seed, initializes a new
+     *  \p threefry_engine.
+     *
+     *  \param value The seed used to intialize this \p threefry_engine's key. The counter starts at zero.
+     */
+    __host__ __device__
+    explicit threefry_engine(result_type value = default_seed);
+
+    /*! This constructor initializes a new \p threefry_engine from a key and a counter.
+     *
+     *  \param key The key of this \p threefry_engine.
+     *  \param counter The counter of this \p threefry_engine's first block of results, least
+     *         significant word first.
+     */
+    __host__ __device__
+    threefry_engine(const result_type (&key)[key_size], const result_type (&counter)[word_count]);
+
+    /*! This method initializes this \p threefry_engine's state, and optionally accepts
+     *  a seed value.
+     *
+     *  \param value The seed used to initializes this \p threefry_engine's key. The counter starts at zero.
+     */
+    __host__ __device__
+    void seed(result_type value = default_seed);
+
+    /*! This method initializes this \p threefry_engine's state from a key and a counter.
+     *
+     *  \param key The key of this \p threefry_engine.
+     *  \param counter The counter of this \p threefry_engine's next block of results, least
+     *         significant word first.
+     */
+    __host__ __device__
+    void seed(const result_type (&key)[key_size], const result_type (&counter)[word_count]);
+
+    // generating functions
+
+    /*! This member function produces a new random value and updates this \p threefry_engine's state.
+     *  \return A new random number.
+     */
+    __host__ __device__
+    result_type operator()(void);
+
+    /*! This member function advances this \p threefry_engine's state a given number of times
+     *  and discards the results.
+     *
+     *  \param z The number of random values to discard.
+     *  \note This function takes constant time.
+     */
+    __host__ __device__
+    void discard(unsigned long long z);
+
+    /*! \cond
+     */
+  private:
+    result_type m_key[key_size];
+    result_type m_counter[word_count];
+    result_type m_results[word_count];
+    unsigned int m_index;
+
+    friend struct thrust::random::detail::random_core_access;
+
+    __host__ __device__
+    void advance_counter(unsigned long long z);
+
+    __host__ __device__
+    void generate_results(void);
+
+    __host__ __device__
+    bool equal(const threefry_engine &rhs) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_ostream<CharT,Traits>& stream_out(std::basic_ostream<CharT,Traits> &os) const;
+
+    template<typename CharT, typename Traits>
+    std::basic_istream<CharT,Traits>& stream_in(std::basic_istream<CharT,Traits> &is);
+
+    /*! \endcond
+     */
+}; // end threefry_engine
+
+
+/*! This function checks two \p threefry_engines for equality.
+ *  \param lhs The first \p threefry_engine to test.
+ *  \param rhs The second \p threefry_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_>
+__host__ __device__
+bool operator==(const threefry_engine<UIntType_,w_,n_,r_> &lhs,
+                const threefry_engine<UIntType_,w_,n_,r_> &rhs);
+
+
+/*! This function checks two \p threefry_engines for inequality.
+ *  \param lhs The first \p threefry_engine to test.
+ *  \param rhs The second \p threefry_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_>
+__host__ __device__
+bool operator!=(const threefry_engine<UIntType_,w_,n_,r_> &lhs,
+                const threefry_engine<UIntType_,w_,n_,r_> &rhs);
+
+
+/*! This function streams a threefry_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p threefry_engine to stream out.
+ *  \return \p os
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_,
+         typename CharT, typename Traits>
+std::basic_ostream<CharT,Traits>&
+operator<<(std::basic_ostream<CharT,Traits> &os,
+           const threefry_engine<UIntType_,w_,n_,r_> &e);
+
+
+/*! This function streams a threefry_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p threefry_engine to stream in.
+ *  \return \p is
+ */
+template<typename UIntType_, size_t w_, size_t n_, size_t r_,
+         typename CharT, typename Traits>
+std::basic_istream<CharT,Traits>&
+operator>>(std::basic_istream<CharT,Traits> &is,
+           threefry_engine<UIntType_,w_,n_,r_> &e);
+
+
+/*! \} // end random_number_engine_templates
+ */
+
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef threefry2x64
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Threefry2x64-20 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry2x64
+ *        shall produce the value \c 10067442004315573443 .
+ */
+typedef threefry_engine<thrust::detail::uint64_t, 64, 2, 20> threefry2x64;
+
+
+/*! \typedef threefry4x32
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Threefry4x32-20 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry4x32
+ *        shall produce the value \c 112810865 .
+ */
+typedef threefry_engine<thrust::detail::uint32_t, 32, 4, 20> threefry4x32;
+
+
+/*! \typedef threefry4x64
+ *  \brief A random number engine with predefined parameters which implements the
+ *         Threefry4x64-20 counter-based random number generation algorithm.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry4x64
+ *        shall produce the value \c 9253438642465275567 .
+ */
+typedef threefry_engine<thrust::detail::uint64_t, 64, 4, 20> threefry4x64;
+
+/*! \} // end predefined_random
+ */
+
+} // end random
+
+// import names into thrust::
+using random::threefry_engine;
+using random::threefry2x64;
+using random::threefry4x32;
+using random::threefry4x64;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/random/detail/threefry_engine.inl>
+
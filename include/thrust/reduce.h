@@ -29,6 +29,17 @@
 THRUST_NAMESPACE_BEGIN
 
 /*! \addtogroup reductions
+ *
+ *  With the \p omp, \p tbb and \p threads systems, a reduction of a
+ *  contiguous range of floating point values with \p plus, \p minimum or
+ *  \p maximum interleaves several partial reductions, which are combined at
+ *  the end, so that the compiler may vectorize it. This holds for \p reduce,
+ *  for \p transform_reduce and for the reduction \p inner_product performs
+ *  with \p binary_op1. A sum may then differ from the one
+ *  <tt>std::accumulate</tt> computes by rounding, and when the range holds
+ *  NaNs, a minimum or maximum may differ as well. \p thrust::seq and the
+ *  \p cpp system always reduce in order.
+ *
  *  \{
  */
 
@@ -76,6 +87,7 @@ THRUST_NAMESPACE_BEGIN
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/accumulate
+ *  \see \ref reductions
  */
 template<typename DerivedPolicy, typename InputIterator>
 __host__ __device__
@@ -121,6 +133,7 @@ __host__ __device__
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/accumulate
+ *  \see \ref reductions
  */
 template<typename InputIterator> typename
   thrust::iterator_traits<InputIterator>::value_type reduce(InputIterator first, InputIterator last);
@@ -170,6 +183,7 @@ template<typename InputIterator> typename
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/accumulate
+ *  \see \ref reductions
  */
 template<typename DerivedPolicy, typename InputIterator, typename T>
 __host__ __device__
@@ -217,6 +231,7 @@ __host__ __device__
  *  \endcode
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/accumulate
+ *  \see \ref reductions
  */
 template<typename InputIterator, typename T>
   T reduce(InputIterator first,
@@ -275,6 +290,7 @@ template<typename InputIterator, typename T>
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/accumulate
  *  \see transform_reduce
+ *  \see \ref reductions
  */
 template<typename DerivedPolicy,
          typename InputIterator,
@@ -332,6 +348,7 @@ __host__ __device__
  *
  *  \see https://en.cppreference.com/w/cpp/algorithm/accumulate
  *  \see transform_reduce
+ *  \see \ref reductions
  */
 template<typename InputIterator,
          typename T,
@@ -0,0 +1,348 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_reduce.h
+ *  \brief Functions for reducing each of a set of contiguous segments of a range
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup reductions
+ *  \{
+ */
+
+
+/*! \p segmented_reduce reduces each segment of <tt>[first, last)</tt> with \c plus, independently
+ *  of the others. The segments are delimited by the offsets <tt>[offsets_first, offsets_last)</tt>:
+ *  segment \c i is <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, so \c n + 1
+ *  offsets delimit \c n segments, and its sum is written to <tt>result[i]</tt>. The sum of an
+ *  empty segment is zero.
+ *
+ *  Each segment is reduced as by \p reduce, so the order in which its elements are summed is
+ *  unspecified.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param result The beginning of the output sequence.
+ *  \return The end of the output sequence, <tt>result + (offsets_last - offsets_first - 1)</tt>.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and if \c x and \c y are objects of \p InputIterator's \c value_type,
+ *          then <tt>x + y</tt> is defined and is convertible to \p InputIterator's \c value_type.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam OutputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>, \p OutputIterator is mutable,
+ *          and \p InputIterator's \c value_type is convertible to \c OutputIterator's \c value_type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_reduce to sum three segments
+ *  of integers using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/segmented_reduce.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  int data[6] = {1, 0, 2, 2, 1, 3};
+ *  int offsets[4] = {0, 2, 2, 6};
+ *  int sums[3];
+ *  thrust::segmented_reduce(thrust::host, data, data + 6, offsets, offsets + 4, sums);
+ *  // sums is now {1, 0, 8}
+ *  \endcode
+ *
+ *  \see \p reduce
+ *  \see \p reduce_by_key
+ */
+template<typename DerivedPolicy, typename InputIterator, typename OffsetIterator, typename OutputIterator>
+__host__ __device__
+  OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result);
+
+
+/*! \p segmented_reduce reduces each segment of <tt>[first, last)</tt> with \c plus, independently
+ *  of the others. The segments are delimited by the offsets <tt>[offsets_first, offsets_last)</tt>:
+ *  segment \c i is <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, so \c n + 1
+ *  offsets delimit \c n segments, and its sum is written to <tt>result[i]</tt>. The sum of an
+ *  empty segment is zero.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param result The beginning of the output sequence.
+ *  \return The end of the output sequence, <tt>result + (offsets_last - offsets_first - 1)</tt>.
+ *
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and if \c x and \c y are objects of \p InputIterator's \c value_type,
+ *          then <tt>x + y</tt> is defined and is convertible to \p InputIterator's \c value_type.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam OutputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>, \p OutputIterator is mutable,
+ *          and \p InputIterator's \c value_type is convertible to \c OutputIterator's \c value_type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_reduce to sum three segments
+ *  of integers.
+ *
+ *  \code
+ *  #include <thrust/segmented_reduce.h>
+ *  ...
+ *  int data[6] = {1, 0, 2, 2, 1, 3};
+ *  int offsets[4] = {0, 2, 2, 6};
+ *  int sums[3];
+ *  thrust::segmented_reduce(data, data + 6, offsets, offsets + 4, sums);
+ *  // sums is now {1, 0, 8}
+ *  \endcode
+ *
+ *  \see \p reduce
+ *  \see \p reduce_by_key
+ */
+template<typename InputIterator, typename OffsetIterator, typename OutputIterator>
+  OutputIterator segmented_reduce(InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result);
+
+
+/*! \p segmented_reduce reduces each segment of <tt>[first, last)</tt> with \c plus, independently
+ *  of the others, starting from the initial value \p init. The segments are delimited by the
+ *  offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, and its sum is written to
+ *  <tt>result[i]</tt>. The sum of an empty segment is \p init.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param result The beginning of the output sequence.
+ *  \param init The initial value of every segment's reduction.
+ *  \return The end of the output sequence, <tt>result + (offsets_last - offsets_first - 1)</tt>.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and if \c x and \c y are objects of \p InputIterator's \c value_type,
+ *          then <tt>x + y</tt> is defined and is convertible to \p T.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam OutputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>, \p OutputIterator is mutable,
+ *          and \p T is convertible to \c OutputIterator's \c value_type.
+ *  \tparam T is convertible to \p InputIterator's \c value_type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  \see \p reduce
+ *  \see \p reduce_by_key
+ */
+template<typename DerivedPolicy, typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T>
+__host__ __device__
+  OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init);
+
+
+/*! \p segmented_reduce reduces each segment of <tt>[first, last)</tt> with \c plus, independently
+ *  of the others, starting from the initial value \p init. The segments are delimited by the
+ *  offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, and its sum is written to
+ *  <tt>result[i]</tt>. The sum of an empty segment is \p init.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param result The beginning of the output sequence.
+ *  \param init The initial value of every segment's reduction.
+ *  \return The end of the output sequence, <tt>result + (offsets_last - offsets_first - 1)</tt>.
+ *
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and if \c x and \c y are objects of \p InputIterator's \c value_type,
+ *          then <tt>x + y</tt> is defined and is convertible to \p T.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam OutputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>, \p OutputIterator is mutable,
+ *          and \p T is convertible to \c OutputIterator's \c value_type.
+ *  \tparam T is convertible to \p InputIterator's \c value_type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  \see \p reduce
+ *  \see \p reduce_by_key
+ */
+template<typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T>
+  OutputIterator segmented_reduce(InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init);
+
+
+/*! \p segmented_reduce reduces each segment of <tt>[first, last)</tt> with \p binary_op,
+ *  independently of the others, starting from the initial value \p init. The segments are
+ *  delimited by the offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, and its reduction is written
+ *  to <tt>result[i]</tt>. The reduction of an empty segment is \p init.
+ *
+ *  Each segment is reduced as by \p reduce, so \p binary_op should be associative and the order in
+ *  which it is applied is unspecified.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param result The beginning of the output sequence.
+ *  \param init The initial value of every segment's reduction.
+ *  \param binary_op The binary function used to combine values.
+ *  \return The end of the output sequence, <tt>result + (offsets_last - offsets_first - 1)</tt>.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c InputIterator's \c value_type is convertible to \c T.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam OutputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>, \p OutputIterator is mutable,
+ *          and \p T is convertible to \c OutputIterator's \c value_type.
+ *  \tparam T is a model of <a href="https://en.cppreference.com/w/cpp/named_req/CopyAssignable">Assignable</a>,
+ *          and is convertible to \p BinaryFunction's \c first_argument_type and \c second_argument_type.
+ *  \tparam BinaryFunction is a model of <a href="https://en.cppreference.com/w/cpp/utility/functional/binary_function">Binary Function</a>,
+ *          and \p BinaryFunction's \c result_type is convertible to \p T.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_reduce to compute the maximum
+ *  of each of three segments of integers using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/segmented_reduce.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  int data[6] = {1, 0, 2, 2, 1, 3};
+ *  int offsets[4] = {0, 2, 2, 6};
+ *  int maxima[3];
+ *  thrust::segmented_reduce(thrust::host, data, data + 6, offsets, offsets + 4, maxima, -1, thrust::maximum<int>());
+ *  // maxima is now {1, -1, 3}
+ *  \endcode
+ *
+ *  \see \p reduce
+ *  \see \p reduce_by_key
+ */
+template<typename DerivedPolicy, typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T, typename BinaryFunction>
+__host__ __device__
+  OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op);
+
+
+/*! \p segmented_reduce reduces each segment of <tt>[first, last)</tt> with \p binary_op,
+ *  independently of the others, starting from the initial value \p init. The segments are
+ *  delimited by the offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, and its reduction is written
+ *  to <tt>result[i]</tt>. The reduction of an empty segment is \p init.
+ *
+ *  Each segment is reduced as by \p reduce, so \p binary_op should be associative and the order in
+ *  which it is applied is unspecified.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param result The beginning of the output sequence.
+ *  \param init The initial value of every segment's reduction.
+ *  \param binary_op The binary function used to combine values.
+ *  \return The end of the output sequence, <tt>result + (offsets_last - offsets_first - 1)</tt>.
+ *
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c InputIterator's \c value_type is convertible to \c T.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam OutputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>, \p OutputIterator is mutable,
+ *          and \p T is convertible to \c OutputIterator's \c value_type.
+ *  \tparam T is a model of <a href="https://en.cppreference.com/w/cpp/named_req/CopyAssignable">Assignable</a>,
+ *          and is convertible to \p BinaryFunction's \c first_argument_type and \c second_argument_type.
+ *  \tparam BinaryFunction is a model of <a href="https://en.cppreference.com/w/cpp/utility/functional/binary_function">Binary Function</a>,
+ *          and \p BinaryFunction's \c result_type is convertible to \p T.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_reduce to compute the maximum
+ *  of each of three segments of integers.
+ *
+ *  \code
+ *  #include <thrust/segmented_reduce.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  int data[6] = {1, 0, 2, 2, 1, 3};
+ *  int offsets[4] = {0, 2, 2, 6};
+ *  int maxima[3];
+ *  thrust::segmented_reduce(data, data + 6, offsets, offsets + 4, maxima, -1, thrust::maximum<int>());
+ *  // maxima is now {1, -1, 3}
+ *  \endcode
+ *
+ *  \see \p reduce
+ *  \see \p reduce_by_key
+ */
+template<typename InputIterator, typename OffsetIterator, typename OutputIterator, typename T, typename BinaryFunction>
+  OutputIterator segmented_reduce(InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op);
+
+
+/*! \} // end reductions
+ */
+
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/segmented_reduce.inl>
+
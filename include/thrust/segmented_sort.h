@@ -0,0 +1,440 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.h
+ *  \brief Functions for sorting each of a set of contiguous segments of a range
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup sorting
+ *  \ingroup algorithms
+ *  \{
+ */
+
+
+/*! \p segmented_sort sorts each segment of <tt>[first, last)</tt> into ascending order,
+ *  independently of the others. The segments are delimited by the offsets
+ *  <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, so \c n + 1 offsets delimit
+ *  \c n segments. Elements which belong to no segment are left unchanged. The order of equivalent
+ *  elements within a segment is not guaranteed to be preserved.
+ *
+ *  This is equivalent to sorting by the pair (segment, element), but neither widens the keys nor
+ *  sorts the range as a whole.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_sort to sort three segments
+ *  of integers using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 3, 9, 2, 8, 7};
+ *  int offsets[4] = {0, 3, 3, 7};
+ *  thrust::segmented_sort(thrust::host, A, A + N, offsets, offsets + 4);
+ *  // A is now {1, 3, 5, 2, 7, 8, 9}
+ *  \endcode
+ *
+ *  \see \p sort
+ *  \see \p segmented_sort_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator, typename OffsetIterator>
+__host__ __device__
+  void segmented_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last);
+
+
+/*! \p segmented_sort sorts each segment of <tt>[first, last)</tt> into ascending order,
+ *  independently of the others. The segments are delimited by the offsets
+ *  <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>, so \c n + 1 offsets delimit
+ *  \c n segments. Elements which belong to no segment are left unchanged. The order of equivalent
+ *  elements within a segment is not guaranteed to be preserved.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_sort to sort three segments
+ *  of integers.
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 3, 9, 2, 8, 7};
+ *  int offsets[4] = {0, 3, 3, 7};
+ *  thrust::segmented_sort(A, A + N, offsets, offsets + 4);
+ *  // A is now {1, 3, 5, 2, 7, 8, 9}
+ *  \endcode
+ *
+ *  \see \p sort
+ *  \see \p segmented_sort_by_key
+ */
+template<typename RandomAccessIterator, typename OffsetIterator>
+  void segmented_sort(RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last);
+
+
+/*! \p segmented_sort sorts each segment of <tt>[first, last)</tt> into ascending order,
+ *  independently of the others, as determined by the function object \p comp. The segments are
+ *  delimited by the offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>. Elements which belong to no
+ *  segment are left unchanged. The order of equivalent elements within a segment is not guaranteed
+ *  to be preserved.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code demonstrates how to sort three segments of integers into descending order
+ *  using the \p greater<int> comparison operator using the \p thrust::host execution policy for
+ *  parallelization:
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 3, 9, 2, 8, 7};
+ *  int offsets[4] = {0, 3, 3, 7};
+ *  thrust::segmented_sort(thrust::host, A, A + N, offsets, offsets + 4, thrust::greater<int>());
+ *  // A is now {5, 3, 1, 9, 8, 7, 2}
+ *  \endcode
+ *
+ *  \see \p sort
+ *  \see \p segmented_sort_by_key
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator, typename OffsetIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp);
+
+
+/*! \p segmented_sort sorts each segment of <tt>[first, last)</tt> into ascending order,
+ *  independently of the others, as determined by the function object \p comp. The segments are
+ *  delimited by the offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[first + offsets_first[i], first + offsets_first[i + 1])</tt>. Elements which belong to no
+ *  segment are left unchanged. The order of equivalent elements within a segment is not guaranteed
+ *  to be preserved.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator is mutable,
+ *          and \p RandomAccessIterator's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, last - first]</tt>.
+ *
+ *  The following code demonstrates how to sort three segments of integers into descending order
+ *  using the \p greater<int> comparison operator.
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {5, 1, 3, 9, 2, 8, 7};
+ *  int offsets[4] = {0, 3, 3, 7};
+ *  thrust::segmented_sort(A, A + N, offsets, offsets + 4, thrust::greater<int>());
+ *  // A is now {5, 3, 1, 9, 8, 7, 2}
+ *  \endcode
+ *
+ *  \see \p sort
+ *  \see \p segmented_sort_by_key
+ */
+template<typename RandomAccessIterator, typename OffsetIterator, typename StrictWeakOrdering>
+  void segmented_sort(RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp);
+
+
+/*! \p segmented_sort_by_key performs a key-value sort of each segment of
+ *  <tt>[keys_first, keys_last)</tt>, independently of the others. The segments are delimited by
+ *  the offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[keys_first + offsets_first[i], keys_first + offsets_first[i + 1])</tt>. Within each segment,
+ *  the keys are sorted into ascending order and the values starting at
+ *  <tt>values_first + offsets_first[i]</tt> are permuted along with them. Keys and values which
+ *  belong to no segment are left unchanged. The order of equivalent keys within a segment is not
+ *  guaranteed to be preserved.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, keys_last - keys_first]</tt>.
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_sort_by_key to sort two
+ *  segments of keys and values using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 6;
+ *  int    keys[N] = {  3,   1,   2,   6,   4,   5};
+ *  char values[N] = {'a', 'b', 'c', 'd', 'e', 'f'};
+ *  int offsets[3] = {0, 3, 6};
+ *  thrust::segmented_sort_by_key(thrust::host, keys, keys + N, values, offsets, offsets + 3);
+ *  // keys is now   {  1,   2,   3,   4,   5,   6}
+ *  // values is now {'b', 'c', 'a', 'e', 'f', 'd'}
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p segmented_sort
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator>
+__host__ __device__
+  void segmented_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last);
+
+
+/*! \p segmented_sort_by_key performs a key-value sort of each segment of
+ *  <tt>[keys_first, keys_last)</tt>, independently of the others. The segments are delimited by
+ *  the offsets <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[keys_first + offsets_first[i], keys_first + offsets_first[i + 1])</tt>. Within each segment,
+ *  the keys are sorted into ascending order and the values starting at
+ *  <tt>values_first + offsets_first[i]</tt> are permuted along with them. Keys and values which
+ *  belong to no segment are left unchanged. The order of equivalent keys within a segment is not
+ *  guaranteed to be preserved.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is a model of <a href="https://en.cppreference.com/w/cpp/named_req/LessThanComparable">LessThan Comparable</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, keys_last - keys_first]</tt>.
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p segmented_sort_by_key to sort two
+ *  segments of keys and values.
+ *
+ *  \code
+ *  #include <thrust/segmented_sort.h>
+ *  ...
+ *  const int N = 6;
+ *  int    keys[N] = {  3,   1,   2,   6,   4,   5};
+ *  char values[N] = {'a', 'b', 'c', 'd', 'e', 'f'};
+ *  int offsets[3] = {0, 3, 6};
+ *  thrust::segmented_sort_by_key(keys, keys + N, values, offsets, offsets + 3);
+ *  // keys is now   {  1,   2,   3,   4,   5,   6}
+ *  // values is now {'b', 'c', 'a', 'e', 'f', 'd'}
+ *  \endcode
+ *
+ *  \see \p sort_by_key
+ *  \see \p segmented_sort
+ */
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator>
+  void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last);
+
+
+/*! \p segmented_sort_by_key performs a key-value sort of each segment of
+ *  <tt>[keys_first, keys_last)</tt>, independently of the others, ordering the keys as
+ *  determined by the function object \p comp. The segments are delimited by the offsets
+ *  <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[keys_first + offsets_first[i], keys_first + offsets_first[i + 1])</tt>, and the values
+ *  starting at <tt>values_first + offsets_first[i]</tt> are permuted along with its keys. Keys and
+ *  values which belong to no segment are left unchanged. The order of equivalent keys within a
+ *  segment is not guaranteed to be preserved.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, keys_last - keys_first]</tt>.
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  \see \p sort_by_key
+ *  \see \p segmented_sort
+ */
+template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp);
+
+
+/*! \p segmented_sort_by_key performs a key-value sort of each segment of
+ *  <tt>[keys_first, keys_last)</tt>, independently of the others, ordering the keys as
+ *  determined by the function object \p comp. The segments are delimited by the offsets
+ *  <tt>[offsets_first, offsets_last)</tt>: segment \c i is
+ *  <tt>[keys_first + offsets_first[i], keys_first + offsets_first[i + 1])</tt>, and the values
+ *  starting at <tt>values_first + offsets_first[i]</tt> are permuted along with its keys. Keys and
+ *  values which belong to no segment are left unchanged. The order of equivalent keys within a
+ *  segment is not guaranteed to be preserved.
+ *
+ *  \param keys_first The beginning of the key sequence.
+ *  \param keys_last The end of the key sequence.
+ *  \param values_first The beginning of the value sequence.
+ *  \param offsets_first The beginning of the segment offsets.
+ *  \param offsets_last The end of the segment offsets.
+ *  \param comp Comparison operator.
+ *
+ *  \tparam RandomAccessIterator1 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          \p RandomAccessIterator1 is mutable,
+ *          and \p RandomAccessIterator1's \c value_type is convertible to \p StrictWeakOrdering's
+ *          \c first_argument_type and \c second_argument_type.
+ *  \tparam RandomAccessIterator2 is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>,
+ *          and \p RandomAccessIterator2 is mutable.
+ *  \tparam OffsetIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/random_access_iterator">Random Access Iterator</a>
+ *          and \c OffsetIterator's \c value_type is an integral type.
+ *  \tparam StrictWeakOrdering is a model of <a href="https://en.cppreference.com/w/cpp/concepts/strict_weak_order">Strict Weak Ordering</a>.
+ *
+ *  \pre The offsets shall be sorted in ascending order and lie in <tt>[0, keys_last - keys_first]</tt>.
+ *  \pre The range <tt>[keys_first, keys_last)</tt> shall not overlap the range <tt>[values_first, values_first + (keys_last - keys_first))</tt>.
+ *
+ *  \see \p sort_by_key
+ *  \see \p segmented_sort
+ */
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename OffsetIterator, typename StrictWeakOrdering>
+  void segmented_sort_by_key(RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp);
+
+
+/*! \} // end sorting
+ */
+
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/segmented_sort.inl>
+
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/cpp/detail/execution_policy.h>
+#include <thrust/system/cpp/future.h>
+#include <thrust/system/cpp/detail/async/executor.h>
+#include <thrust/detail/execute_with_dependencies.h>
+#include <thrust/copy.h>
+
+#include <tuple>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace cpp { namespace detail
+{
+
+// ADL entry point.
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+__host__
+unique_eager_event async_copy(
+  execution_policy<FromPolicy>& from_policy,
+  execution_policy<ToPolicy>&   to_policy,
+  ForwardIt                     first,
+  Sentinel                      last,
+  OutputIt                      output
+)
+{
+  FromPolicy& from_exec = thrust::detail::derived_cast(from_policy);
+  ToPolicy&   to_exec   = thrust::detail::derived_cast(to_policy);
+
+  // Both ranges are in host memory, so the copy runs with the source's policy
+  // once both policies' dependencies are satisfied.
+  async_executor executor = select_async_executor(from_exec);
+
+  auto deps = std::tuple_cat(
+    thrust::detail::extract_dependencies(std::move(from_exec))
+  , thrust::detail::extract_dependencies(std::move(to_exec))
+  );
+
+  return make_dependent_event(
+    executor
+  , [exec = std::move(from_exec), first, last, output] () mutable
+    {
+      thrust::copy(exec, first, last, output);
+    }
+  , std::move(deps)
+  );
+}
+
+}}} // namespace system::cpp::detail
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
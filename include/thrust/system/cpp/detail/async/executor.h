@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/cpp/detail/execution_policy.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace cpp { namespace detail
+{
+
+// Runs a task of an asynchronous algorithm once its dependencies have
+// finished. A task launched from within another task runs on the launching
+// thread instead (see `async_signal`), so a task which waits for the tasks it
+// launches never waits for a thread of the executor, and any fixed number of
+// threads is enough to run them all.
+using async_executor = void (*)(std::function<void()>&&);
+
+// A fixed set of threads which run the tasks submitted to them in order. The
+// cpp system runs its asynchronous algorithms on one thread per hardware
+// thread; the OpenMP system has a queue of its own.
+class task_queue
+{
+public:
+  __host__
+  static task_queue& instance()
+  {
+    static task_queue queue(
+      std::max(std::thread::hardware_concurrency(), 1u)
+    );
+
+    return queue;
+  }
+
+  __host__
+  explicit task_queue(std::size_t num_threads)
+    : stop_(false)
+  {
+    threads_.reserve(num_threads);
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+      threads_.emplace_back([this] { run(); });
+  }
+
+  task_queue(task_queue const&) = delete;
+  task_queue& operator=(task_queue const&) = delete;
+
+  // Runs the tasks already submitted, then stops the threads.
+  __host__
+  ~task_queue()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+
+    wake_.notify_all();
+
+    for (auto& thread : threads_)
+      thread.join();
+  }
+
+  // `task` must not throw.
+  __host__
+  void submit(std::function<void()>&& task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+
+    wake_.notify_one();
+  }
+
+private:
+  __host__
+  void run()
+  {
+    for (;;)
+    {
+      std::function<void()> task;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        wake_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+
+        if (tasks_.empty())
+          return;
+
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+
+      task();
+    }
+  }
+
+  std::vector<std::thread>          threads_;
+  std::mutex                        mutex_;
+  std::condition_variable           wake_;
+  std::deque<std::function<void()>> tasks_;
+  bool                              stop_;
+};
+
+inline __host__
+void submit_to_task_queue(std::function<void()>&& task)
+{
+  task_queue::instance().submit(std::move(task));
+}
+
+// Runs `task` on the thread which finished its last dependency. Only for
+// tasks which do no work of their own, such as those of `when_all`.
+inline __host__
+void submit_inline(std::function<void()>&& task)
+{
+  task();
+}
+
+// ADL hook which selects the executor of a policy's asynchronous algorithms.
+// The systems derived from cpp which have a scheduler of their own overload
+// it for their policies.
+template <typename DerivedPolicy>
+__host__
+async_executor select_async_executor(execution_policy<DerivedPolicy>&)
+{
+  return &submit_to_task_queue;
+}
+
+}}} // namespace system::cpp::detail
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/cpp/detail/execution_policy.h>
+#include <thrust/system/cpp/future.h>
+#include <thrust/system/cpp/detail/async/executor.h>
+#include <thrust/detail/execute_with_dependencies.h>
+#include <thrust/sort.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace cpp { namespace detail
+{
+
+// ADL entry point.
+template <
+  typename DerivedPolicy
+, typename ForwardIt, typename Sentinel, typename StrictWeakOrdering
+>
+__host__
+unique_eager_event async_stable_sort(
+  execution_policy<DerivedPolicy>& policy,
+  ForwardIt                        first,
+  Sentinel                         last,
+  StrictWeakOrdering               comp
+)
+{
+  DerivedPolicy& exec = thrust::detail::derived_cast(policy);
+
+  async_executor executor = select_async_executor(exec);
+
+  auto deps = thrust::detail::extract_dependencies(std::move(exec));
+
+  return make_dependent_event(
+    executor
+  , [exec = std::move(exec), first, last, comp] () mutable
+    {
+      thrust::stable_sort(exec, first, last, comp);
+    }
+  , std::move(deps)
+  );
+}
+
+// ADL entry point.
+template <
+  typename DerivedPolicy
+, typename ForwardIt, typename Sentinel, typename StrictWeakOrdering
+>
+__host__
+unique_eager_event async_sort(
+  execution_policy<DerivedPolicy>& policy,
+  ForwardIt                        first,
+  Sentinel                         last,
+  StrictWeakOrdering               comp
+)
+{
+  DerivedPolicy& exec = thrust::detail::derived_cast(policy);
+
+  async_executor executor = select_async_executor(exec);
+
+  auto deps = thrust::detail::extract_dependencies(std::move(exec));
+
+  return make_dependent_event(
+    executor
+  , [exec = std::move(exec), first, last, comp] () mutable
+    {
+      thrust::sort(exec, first, last, comp);
+    }
+  , std::move(deps)
+  );
+}
+
+}}} // namespace system::cpp::detail
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
@@ -0,0 +1,740 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/optional.h>
+#include <thrust/detail/type_deduction.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/type_traits/remove_cvref.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/execute_with_dependencies.h>
+#include <thrust/detail/event_error.h>
+#include <thrust/system/cpp/future.h>
+#include <thrust/system/cpp/detail/async/executor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace cpp
+{
+
+namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Rethrows the exception of a dependency whose task failed. A task only runs
+// once its dependencies have finished, so this never blocks there.
+// Dependencies without a task, such as moved-from events, never fail.
+
+inline __host__
+void wait_for_dependency(ready_event&) {}
+
+template <typename X>
+__host__
+void wait_for_dependency(ready_future<X>&) {}
+
+inline __host__
+void wait_for_dependency(unique_eager_event& dependency);
+
+template <typename X>
+__host__
+void wait_for_dependency(unique_eager_future<X>& dependency);
+
+template <typename... Dependencies, std::size_t... Is>
+__host__
+void wait_for_dependencies_impl(
+  std::tuple<Dependencies...>& deps, index_sequence<Is...>
+)
+{
+  int l[] = { 0, (wait_for_dependency(std::get<Is>(deps)), 0)... };
+  THRUST_UNUSED_VAR(l);
+}
+
+template <typename... Dependencies>
+__host__
+void wait_for_dependencies(std::tuple<Dependencies...>& deps)
+{
+  wait_for_dependencies_impl(deps, make_index_sequence<sizeof...(Dependencies)>{});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The state shared by an asynchronous task, the event or future that owns
+// it, and the tasks which depend on it. A task is submitted to its executor
+// only once all of its dependencies have finished, so it never blocks a
+// thread waiting for them; instead, each dependency keeps a continuation
+// which counts down the dependent's pending dependencies when it finishes.
+struct async_signal : std::enable_shared_from_this<async_signal>
+{
+protected:
+  struct task_base
+  {
+    virtual ~task_base() {}
+    virtual void run() = 0;
+  };
+
+  template <typename Body, typename... Dependencies>
+  struct task final : task_base
+  {
+    Body                        body;
+    std::tuple<Dependencies...> deps;
+
+    task(Body&& b, std::tuple<Dependencies...>&& d)
+      : body(std::move(b)), deps(std::move(d))
+    {}
+
+    void run() override
+    {
+      wait_for_dependencies(deps);
+      body();
+    }
+  };
+
+  std::unique_ptr<task_base>         task_;
+  async_executor                     executor_;
+
+  // the dependencies which have not finished yet, plus one until the task has
+  // been launched
+  std::atomic<std::size_t>           pending_;
+
+  // guards done_'s transition and continuations_
+  std::mutex                         mutex_;
+  std::condition_variable            finished_;
+  std::atomic<bool>                  done_;
+  std::exception_ptr                 error_;
+  std::vector<std::function<void()>> continuations_;
+
+  // Whether the calling thread is running the body of a task.
+  __host__
+  static bool& inside_task()
+  {
+    static thread_local bool result = false;
+    return result;
+  }
+
+  // Called once for each dependency and once by `launch`; submits the task
+  // after the last call.
+  __host__
+  void dependency_finished()
+  {
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      // A task launched by the body of another task runs right away on the
+      // same thread. The launching task may wait for it, and every thread of
+      // the executor may be busy with a task waiting like this.
+      if (inside_task())
+      {
+        run();
+        return;
+      }
+
+      // The submitted function keeps this state alive until the task has run
+      // and called its continuations.
+      executor_([self = shared_from_this()] { self->run(); });
+    }
+  }
+
+  __host__
+  void run() noexcept
+  {
+    bool& inside = inside_task();
+    bool const outer = inside;
+
+    inside = true;
+
+    try
+    {
+      task_->run();
+    }
+    catch (...)
+    {
+      error_ = std::current_exception();
+    }
+
+    inside = outer;
+
+    // Release the dependencies before the dependents can run.
+    task_.reset();
+
+    std::vector<std::function<void()>> continuations;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.store(true, std::memory_order_release);
+      continuations.swap(continuations_);
+    }
+
+    finished_.notify_all();
+
+    for (auto& continuation : continuations)
+      continuation();
+  }
+
+  // Calls `dependent->dependency_finished()` once this task has finished.
+  __host__
+  void notify_when_finished(std::shared_ptr<async_signal> const& dependent)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (!done_.load(std::memory_order_relaxed))
+      {
+        continuations_.emplace_back(
+          [dependent] { dependent->dependency_finished(); }
+        );
+        return;
+      }
+    }
+
+    dependent->dependency_finished();
+  }
+
+  template <typename Dependency>
+  __host__
+  void depend_on(Dependency& dependency)
+  {
+    if (dependency.valid_stream())
+      dependency.async_signal_->notify_when_finished(shared_from_this());
+    else
+      dependency_finished();
+  }
+
+  __host__
+  void depend_on(ready_event&) { dependency_finished(); }
+
+  template <typename X>
+  __host__
+  void depend_on(ready_future<X>&) { dependency_finished(); }
+
+  template <typename... Dependencies, std::size_t... Is>
+  __host__
+  void depend_on_all(
+    std::tuple<Dependencies...>& deps, index_sequence<Is...>
+  )
+  {
+    int l[] = { 0, (depend_on(std::get<Is>(deps)), 0)... };
+    THRUST_UNUSED_VAR(l);
+  }
+
+public:
+  __host__
+  async_signal() : executor_(nullptr), pending_(0), done_(false) {}
+
+  async_signal(async_signal const&) = delete;
+  async_signal& operator=(async_signal const&) = delete;
+
+  __host__
+  virtual ~async_signal() {}
+
+  // Submits `body` to `executor` once every one of `deps` has finished. The
+  // task takes ownership of `deps` and releases them as soon as it has run.
+  // Anything `body` throws, or the first exception of a failed dependency, is
+  // rethrown by `wait`.
+  // Precondition: this state is owned by a `std::shared_ptr`.
+  template <typename Body, typename... Dependencies>
+  __host__
+  void launch(
+    async_executor executor, Body&& body, std::tuple<Dependencies...>&& deps
+  )
+  {
+    executor_ = executor;
+    pending_.store(sizeof...(Dependencies) + 1, std::memory_order_relaxed);
+
+    // The continuations refer to the dependencies' states rather than to the
+    // events in `deps`, so the task may take the events afterwards.
+    depend_on_all(deps, make_index_sequence<sizeof...(Dependencies)>{});
+
+    using body_type = remove_cvref_t<Body>;
+    task_.reset(
+      new task<body_type, Dependencies...>(
+        body_type(std::forward<Body>(body)), std::move(deps)
+      )
+    );
+
+    dependency_finished();
+  }
+
+  __host__
+  bool ready() const noexcept
+  {
+    return done_.load(std::memory_order_acquire);
+  }
+
+  // Blocks until the task has finished.
+  __host__
+  void join() noexcept
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return ready(); });
+  }
+
+  __host__
+  void wait()
+  {
+    join();
+
+    if (error_)
+      std::rethrow_exception(error_);
+  }
+};
+
+template <typename T>
+struct async_value : async_signal
+{
+  using value_type        = remove_cvref_t<T>;
+  using raw_const_pointer = value_type const*;
+
+protected:
+  thrust::optional<value_type> value_;
+
+public:
+  // Like `launch`, and keeps the result of `compute_content`.
+  template <typename ComputeContent, typename... Dependencies>
+  __host__
+  void launch_with_content(
+    async_executor                executor
+  , ComputeContent&&              compute_content
+  , std::tuple<Dependencies...>&& deps
+  )
+  {
+    launch(
+      executor
+    , [this, cc = std::forward<ComputeContent>(compute_content)] () mutable
+      {
+        value_.emplace(cc());
+      }
+    , std::move(deps)
+    );
+  }
+
+  // Blocks.
+  __host__
+  value_type get()
+  {
+    wait();
+    return *value_;
+  }
+
+  // Blocks.
+  __host__
+  value_type extract()
+  {
+    wait();
+    return std::move(*value_);
+  }
+
+  // For testing only.
+  #if defined(THRUST_ENABLE_FUTURE_RAW_DATA_MEMBER)
+  __host__
+  raw_const_pointer raw_data() const
+  {
+    return value_ ? addressof(*value_) : nullptr;
+  }
+  #endif
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename ComputeContent, typename... Dependencies>
+__host__
+unique_eager_event
+make_dependent_event(
+  async_executor executor, ComputeContent&& cc, std::tuple<Dependencies...>&& deps
+);
+
+template <
+  typename T
+, typename ComputeContent, typename... Dependencies
+>
+__host__
+unique_eager_future<T>
+make_dependent_future(
+  async_executor executor, ComputeContent&& cc, std::tuple<Dependencies...>&& deps
+);
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct ready_event final
+{
+  ready_event() = default;
+
+  template <typename U>
+  __host__
+  explicit ready_event(ready_future<U>) {}
+
+  __host__
+  static constexpr bool valid_content() noexcept { return true; }
+
+  __host__
+  static constexpr bool ready() noexcept { return true; }
+};
+
+template <typename T>
+struct ready_future final
+{
+  using value_type        = T;
+  using raw_const_pointer = T const*;
+
+private:
+  value_type value_;
+
+public:
+  __host__
+  ready_future() : value_{} {}
+
+  ready_future(ready_future&&) = default;
+  ready_future(ready_future const&) = default;
+  ready_future& operator=(ready_future&&) = default;
+  ready_future& operator=(ready_future const&) = default;
+
+  template <typename U>
+  __host__
+  explicit ready_future(U&& u) : value_(THRUST_FWD(u)) {}
+
+  __host__
+  static constexpr bool valid_content() noexcept { return true; }
+
+  __host__
+  static constexpr bool ready() noexcept { return true; }
+
+  __host__
+  value_type get() const
+  {
+    return value_;
+  }
+
+  THRUST_NODISCARD __host__
+  value_type extract()
+  {
+    return std::move(value_);
+  }
+
+  #if defined(THRUST_ENABLE_FUTURE_RAW_DATA_MEMBER)
+  // For testing only.
+  __host__
+  raw_const_pointer data() const
+  {
+    return addressof(value_);
+  }
+  #endif
+};
+
+// The task of an event or future plays the role of a CUDA stream, so the
+// `*_stream` names match the CUDA system's and generic code works with both.
+
+struct unique_eager_event final
+{
+protected:
+  std::shared_ptr<detail::async_signal> async_signal_;
+
+  __host__
+  explicit unique_eager_event(std::shared_ptr<detail::async_signal> async_signal)
+    : async_signal_(std::move(async_signal))
+  {}
+
+public:
+  __host__
+  unique_eager_event()
+    : async_signal_()
+  {}
+
+  unique_eager_event(unique_eager_event&&) = default;
+  unique_eager_event(unique_eager_event const&) = delete;
+  unique_eager_event& operator=(unique_eager_event&&) = default;
+  unique_eager_event& operator=(unique_eager_event const&) = delete;
+
+  // Any `unique_eager_future<T>` can be explicitly converted to a
+  // `unique_eager_event`.
+  template <typename U>
+  __host__
+  explicit unique_eager_event(unique_eager_future<U>&& other)
+    // NOTE: We upcast to `shared_ptr<async_signal>` here.
+    : async_signal_(std::move(other.async_signal_))
+  {}
+
+  __host__
+  ~unique_eager_event()
+  {
+    // The task may still refer to the objects it was launched on, so we can't
+    // let it outlive us.
+    if (valid_stream()) async_signal_->join();
+  }
+
+  __host__
+  bool valid_stream() const noexcept
+  {
+    return bool(async_signal_);
+  }
+
+  __host__
+  bool ready() const noexcept
+  {
+    if (valid_stream())
+      return async_signal_->ready();
+    else
+      return false;
+  }
+
+  // Blocks.
+  // Precondition: `true == valid_stream()`.
+  __host__
+  void wait()
+  {
+    if (!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    async_signal_->wait();
+  }
+
+  friend struct detail::async_signal;
+
+  template <typename ComputeContent, typename... Dependencies>
+  friend __host__
+  unique_eager_event
+  thrust::system::cpp::detail::make_dependent_event(
+    async_executor executor
+  , ComputeContent&& cc, std::tuple<Dependencies...>&& deps
+  );
+};
+
+template <typename T>
+struct unique_eager_future final
+{
+  THRUST_STATIC_ASSERT_MSG(
+    (!std::is_same<T, remove_cvref_t<void>>::value)
+  , "`thrust::event` should be used to express valueless futures"
+  );
+
+  using value_type        = typename detail::async_value<T>::value_type;
+  using raw_const_pointer = typename detail::async_value<T>::raw_const_pointer;
+
+private:
+  std::shared_ptr<detail::async_value<value_type>> async_signal_;
+
+  __host__
+  explicit unique_eager_future(
+    std::shared_ptr<detail::async_value<value_type>> async_signal
+  )
+    : async_signal_(std::move(async_signal))
+  {}
+
+public:
+  __host__
+  unique_eager_future()
+    : async_signal_()
+  {}
+
+  unique_eager_future(unique_eager_future&&) = default;
+  unique_eager_future(unique_eager_future const&) = delete;
+  unique_eager_future& operator=(unique_eager_future&&) = default;
+  unique_eager_future& operator=(unique_eager_future const&) = delete;
+
+  __host__
+  ~unique_eager_future()
+  {
+    // The task may still refer to the objects it was launched on, so we can't
+    // let it outlive us.
+    if (valid_stream()) async_signal_->join();
+  }
+
+  __host__
+  bool valid_stream() const noexcept
+  {
+    return bool(async_signal_);
+  }
+
+  __host__
+  bool valid_content() const noexcept
+  {
+    return valid_stream();
+  }
+
+  __host__
+  bool ready() const noexcept
+  {
+    if (valid_stream())
+      return async_signal_->ready();
+    else
+      return false;
+  }
+
+  // Blocks.
+  // Precondition: `true == valid_stream()`.
+  __host__
+  void wait()
+  {
+    if (!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    async_signal_->wait();
+  }
+
+  // Blocks.
+  // Precondition: `true == valid_content()`.
+  __host__
+  value_type get()
+  {
+    if (!valid_content())
+      throw thrust::event_error(event_errc::no_content);
+
+    return async_signal_->get();
+  }
+
+  // Blocks.
+  // Precondition: `true == valid_content()`.
+  THRUST_NODISCARD __host__
+  value_type extract()
+  {
+    if (!valid_content())
+      throw thrust::event_error(event_errc::no_content);
+
+    value_type tmp(async_signal_->extract());
+    async_signal_.reset();
+    return tmp;
+  }
+
+  // For testing only.
+  #if defined(THRUST_ENABLE_FUTURE_RAW_DATA_MEMBER)
+  // Precondition: `true == valid_stream()`.
+  __host__
+  raw_const_pointer raw_data() const
+  {
+    if (!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    return async_signal_->raw_data();
+  }
+  #endif
+
+  template <
+    typename X
+  , typename ComputeContent, typename... Dependencies
+  >
+  friend __host__
+  unique_eager_future<X>
+  thrust::system::cpp::detail::make_dependent_future(
+    async_executor executor
+  , ComputeContent&& cc, std::tuple<Dependencies...>&& deps
+  );
+
+  friend struct unique_eager_event;
+  friend struct detail::async_signal;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+
+inline __host__
+void wait_for_dependency(unique_eager_event& dependency)
+{
+  if (dependency.valid_stream())
+    dependency.wait();
+}
+
+template <typename X>
+__host__
+void wait_for_dependency(unique_eager_future<X>& dependency)
+{
+  if (dependency.valid_stream())
+    dependency.wait();
+}
+
+// Launches a task which calls `cc` on `executor` once `deps` have finished.
+// The task takes ownership of `deps`, so they stay alive until it has run.
+template <typename ComputeContent, typename... Dependencies>
+__host__
+unique_eager_event
+make_dependent_event(
+  async_executor executor, ComputeContent&& cc, std::tuple<Dependencies...>&& deps
+)
+{
+  std::shared_ptr<async_signal> signal = std::make_shared<async_signal>();
+
+  signal->launch(executor, THRUST_FWD(cc), std::move(deps));
+
+  return unique_eager_event(std::move(signal));
+}
+
+// Launches a task which stores the result of `cc` in the returned future once
+// `deps` have finished.
+template <
+  typename T
+, typename ComputeContent, typename... Dependencies
+>
+__host__
+unique_eager_future<T>
+make_dependent_future(
+  async_executor executor, ComputeContent&& cc, std::tuple<Dependencies...>&& deps
+)
+{
+  std::shared_ptr<async_value<T>> signal = std::make_shared<async_value<T>>();
+
+  signal->launch_with_content(executor, THRUST_FWD(cc), std::move(deps));
+
+  return unique_eager_future<T>(std::move(signal));
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename... Events>
+__host__
+unique_eager_event when_all(Events&&... evs)
+// TODO: Constrain to events and futures.
+{
+  return detail::make_dependent_event(
+    &detail::submit_inline, [] {}, std::make_tuple(std::move(evs)...)
+  );
+}
+
+// ADL hook for transparent `.after` move support.
+inline __host__
+auto capture_as_dependency(unique_eager_event& dependency)
+THRUST_DECLTYPE_RETURNS(std::move(dependency))
+
+// ADL hook for transparent `.after` move support.
+template <typename X>
+__host__
+auto capture_as_dependency(unique_eager_future<X>& dependency)
+THRUST_DECLTYPE_RETURNS(std::move(dependency))
+
+}} // namespace system::cpp
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
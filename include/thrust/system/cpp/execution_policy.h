@@ -44,12 +44,14 @@
 #include <thrust/system/cpp/detail/gather.h>
 #include <thrust/system/cpp/detail/generate.h>
 #include <thrust/system/cpp/detail/get_value.h>
+#include <thrust/system/cpp/detail/histogram.h>
 #include <thrust/system/cpp/detail/inner_product.h>
 #include <thrust/system/cpp/detail/iter_swap.h>
 #include <thrust/system/cpp/detail/logical.h>
 #include <thrust/system/cpp/detail/malloc_and_free.h>
 #include <thrust/system/cpp/detail/merge.h>
 #include <thrust/system/cpp/detail/mismatch.h>
+#include <thrust/system/cpp/detail/partial_sort.h>
 #include <thrust/system/cpp/detail/partition.h>
 #include <thrust/system/cpp/detail/reduce.h>
 #include <thrust/system/cpp/detail/reduce_by_key.h>
@@ -59,6 +61,8 @@
 #include <thrust/system/cpp/detail/scan.h>
 #include <thrust/system/cpp/detail/scan_by_key.h>
 #include <thrust/system/cpp/detail/scatter.h>
+#include <thrust/system/cpp/detail/segmented_reduce.h>
+#include <thrust/system/cpp/detail/segmented_sort.h>
 #include <thrust/system/cpp/detail/sequence.h>
 #include <thrust/system/cpp/detail/set_operations.h>
 #include <thrust/system/cpp/detail/sort.h>
@@ -66,6 +70,7 @@
 #include <thrust/system/cpp/detail/tabulate.h>
 #include <thrust/system/cpp/detail/transform.h>
 #include <thrust/system/cpp/detail/transform_reduce.h>
+#include <thrust/system/cpp/detail/transform_reduce_multi.h>
 #include <thrust/system/cpp/detail/transform_scan.h>
 #include <thrust/system/cpp/detail/uninitialized_copy.h>
 #include <thrust/system/cpp/detail/uninitialized_fill.h>
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thrust/system/cpp/future.h
+ *  \brief \p thrust::future and \p thrust::event for the standard C++ system
+ *         and the CPU systems derived from it.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/cpp/pointer.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace cpp
+{
+
+struct ready_event;
+
+template <typename T>
+struct ready_future;
+
+struct unique_eager_event;
+
+template <typename T>
+struct unique_eager_future;
+
+template <typename... Events>
+__host__
+unique_eager_event when_all(Events&&... evs);
+
+}} // namespace system::cpp
+
+namespace cpp
+{
+
+using thrust::system::cpp::ready_event;
+
+using thrust::system::cpp::ready_future;
+
+using thrust::system::cpp::unique_eager_event;
+using event = unique_eager_event;
+
+using thrust::system::cpp::unique_eager_future;
+template <typename T> using future = unique_eager_future<T>;
+
+using thrust::system::cpp::when_all;
+
+} // namespace cpp
+
+// The OpenMP, TBB and threads systems derive from the cpp system, so these
+// also select the event and future types of their policies. Asynchronous
+// algorithms run as tasks which call the synchronous algorithm with the same
+// policy. A task is submitted once its policy's dependencies have finished, to
+// the executor of the policy's system: a fixed set of threads for the cpp and
+// OpenMP systems, a TBB task arena, or the threads system's pool.
+
+template <typename DerivedPolicy>
+__host__
+thrust::cpp::unique_eager_event
+unique_eager_event_type(
+  thrust::cpp::execution_policy<DerivedPolicy> const&
+) noexcept;
+
+template <typename T, typename DerivedPolicy>
+__host__
+thrust::cpp::unique_eager_future<T>
+unique_eager_future_type(
+  thrust::cpp::execution_policy<DerivedPolicy> const&
+) noexcept;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/system/cpp/detail/future.inl>
+
+#endif // C++14
@@ -24,9 +24,9 @@
 
 //#include <thrust/system/detail/sequential/async/copy.h>
 
-//#define __THRUST_HOST_SYSTEM_ASYNC_COPY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/copy.h>
-//#include __THRUST_HOST_SYSTEM_ASYNC_COPY_HEADER
-//#undef __THRUST_HOST_SYSTEM_ASYNC_COPY_HEADER
+#define __THRUST_HOST_SYSTEM_ASYNC_COPY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/copy.h>
+#include __THRUST_HOST_SYSTEM_ASYNC_COPY_HEADER
+#undef __THRUST_HOST_SYSTEM_ASYNC_COPY_HEADER
 
 #define __THRUST_DEVICE_SYSTEM_ASYNC_COPY_HEADER <__THRUST_DEVICE_SYSTEM_ROOT/detail/async/copy.h>
 #include __THRUST_DEVICE_SYSTEM_ASYNC_COPY_HEADER
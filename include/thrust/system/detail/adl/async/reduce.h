@@ -24,9 +24,9 @@
 
 //#include <thrust/system/detail/sequential/async/reduce.h>
 
-//#define __THRUST_HOST_SYSTEM_ASYNC_REDUCE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/reduce.h>
-//#include __THRUST_HOST_SYSTEM_ASYNC_REDUCE_HEADER
-//#undef __THRUST_HOST_SYSTEM_ASYNC_REDUCE_HEADER
+#define __THRUST_HOST_SYSTEM_ASYNC_REDUCE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/reduce.h>
+#include __THRUST_HOST_SYSTEM_ASYNC_REDUCE_HEADER
+#undef __THRUST_HOST_SYSTEM_ASYNC_REDUCE_HEADER
 
 #define __THRUST_DEVICE_SYSTEM_ASYNC_REDUCE_HEADER <__THRUST_DEVICE_SYSTEM_ROOT/detail/async/reduce.h>
 #include __THRUST_DEVICE_SYSTEM_ASYNC_REDUCE_HEADER
@@ -24,9 +24,9 @@
 
 //#include <thrust/system/detail/sequential/async/sort.h>
 
-//#define __THRUST_HOST_SYSTEM_ASYNC_SORT_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/sort.h>
-//#include __THRUST_HOST_SYSTEM_ASYNC_SORT_HEADER
-//#undef __THRUST_HOST_SYSTEM_ASYNC_SORT_HEADER
+#define __THRUST_HOST_SYSTEM_ASYNC_SORT_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/sort.h>
+#include __THRUST_HOST_SYSTEM_ASYNC_SORT_HEADER
+#undef __THRUST_HOST_SYSTEM_ASYNC_SORT_HEADER
 
 #define __THRUST_DEVICE_SYSTEM_ASYNC_SORT_HEADER <__THRUST_DEVICE_SYSTEM_ROOT/detail/async/sort.h>
 #include __THRUST_DEVICE_SYSTEM_ASYNC_SORT_HEADER
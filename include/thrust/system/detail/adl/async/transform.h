@@ -24,9 +24,9 @@
 
 //#include <thrust/system/detail/sequential/async/transform.h>
 
-//#define __THRUST_HOST_SYSTEM_ASYNC_TRANSFORM_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/transform.h>
-//#include __THRUST_HOST_SYSTEM_ASYNC_TRANSFORM_HEADER
-//#undef __THRUST_HOST_SYSTEM_ASYNC_TRANSFORM_HEADER
+#define __THRUST_HOST_SYSTEM_ASYNC_TRANSFORM_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/async/transform.h>
+#include __THRUST_HOST_SYSTEM_ASYNC_TRANSFORM_HEADER
+#undef __THRUST_HOST_SYSTEM_ASYNC_TRANSFORM_HEADER
 
 #define __THRUST_DEVICE_SYSTEM_ASYNC_TRANSFORM_HEADER <__THRUST_DEVICE_SYSTEM_ROOT/detail/async/transform.h>
 #include __THRUST_DEVICE_SYSTEM_ASYNC_TRANSFORM_HEADER
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/binary_search.h>
 #include <thrust/system/omp/detail/binary_search.h>
 #include <thrust/system/tbb/detail/binary_search.h>
+#include <thrust/system/threads/detail/binary_search.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_BINARY_SEARCH_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/binary_search.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/copy.h>
 #include <thrust/system/omp/detail/copy.h>
 #include <thrust/system/tbb/detail/copy.h>
+#include <thrust/system/threads/detail/copy.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_COPY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/copy.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/count.h>
 #include <thrust/system/omp/detail/count.h>
 #include <thrust/system/tbb/detail/count.h>
+#include <thrust/system/threads/detail/count.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_COUNT_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/count.h>
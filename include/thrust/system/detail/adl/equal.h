@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/equal.h>
 #include <thrust/system/omp/detail/equal.h>
 #include <thrust/system/tbb/detail/equal.h>
+#include <thrust/system/threads/detail/equal.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_EQUAL_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/equal.h>
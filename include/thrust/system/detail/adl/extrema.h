@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/extrema.h>
 #include <thrust/system/omp/detail/extrema.h>
 #include <thrust/system/tbb/detail/extrema.h>
+#include <thrust/system/threads/detail/extrema.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_EXTREMA_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/extrema.h>
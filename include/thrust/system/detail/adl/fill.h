@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/fill.h>
 #include <thrust/system/omp/detail/fill.h>
 #include <thrust/system/tbb/detail/fill.h>
+#include <thrust/system/threads/detail/fill.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_FILL_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/fill.h>
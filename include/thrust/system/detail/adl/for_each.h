@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/for_each.h>
 #include <thrust/system/omp/detail/for_each.h>
 #include <thrust/system/tbb/detail/for_each.h>
+#include <thrust/system/threads/detail/for_each.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_FOR_EACH_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/for_each.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/gather.h>
 #include <thrust/system/omp/detail/gather.h>
 #include <thrust/system/tbb/detail/gather.h>
+#include <thrust/system/threads/detail/gather.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_GATHER_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/gather.h>
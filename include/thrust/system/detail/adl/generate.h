@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/generate.h>
 #include <thrust/system/omp/detail/generate.h>
 #include <thrust/system/tbb/detail/generate.h>
+#include <thrust/system/threads/detail/generate.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_GENERATE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/generate.h>
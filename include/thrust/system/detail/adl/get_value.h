@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/get_value.h>
 #include <thrust/system/omp/detail/get_value.h>
 #include <thrust/system/tbb/detail/get_value.h>
+#include <thrust/system/threads/detail/get_value.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_GET_VALUE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/get_value.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/iter_swap.h>
 #include <thrust/system/omp/detail/iter_swap.h>
 #include <thrust/system/tbb/detail/iter_swap.h>
+#include <thrust/system/threads/detail/iter_swap.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_ITER_SWAP_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/iter_swap.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/logical.h>
 #include <thrust/system/omp/detail/logical.h>
 #include <thrust/system/tbb/detail/logical.h>
+#include <thrust/system/threads/detail/logical.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_LOGICAL_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/logical.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/merge.h>
 #include <thrust/system/omp/detail/merge.h>
 #include <thrust/system/tbb/detail/merge.h>
+#include <thrust/system/threads/detail/merge.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_MERGE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/merge.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/mismatch.h>
 #include <thrust/system/omp/detail/mismatch.h>
 #include <thrust/system/tbb/detail/mismatch.h>
+#include <thrust/system/threads/detail/mismatch.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_MISMATCH_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/mismatch.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/partition.h>
 #include <thrust/system/omp/detail/partition.h>
 #include <thrust/system/tbb/detail/partition.h>
+#include <thrust/system/threads/detail/partition.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_PARTITION_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/partition.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/reduce_by_key.h>
 #include <thrust/system/omp/detail/reduce_by_key.h>
 #include <thrust/system/tbb/detail/reduce_by_key.h>
+#include <thrust/system/threads/detail/reduce_by_key.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_REDUCE_BY_KEY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/reduce_by_key.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/remove.h>
 #include <thrust/system/omp/detail/remove.h>
 #include <thrust/system/tbb/detail/remove.h>
+#include <thrust/system/threads/detail/remove.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_REMOVE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/remove.h>
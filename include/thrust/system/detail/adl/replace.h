@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/replace.h>
 #include <thrust/system/omp/detail/replace.h>
 #include <thrust/system/tbb/detail/replace.h>
+#include <thrust/system/threads/detail/replace.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_REPLACE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/replace.h>
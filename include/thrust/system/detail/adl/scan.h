@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/scan.h>
 #include <thrust/system/omp/detail/scan.h>
 #include <thrust/system/tbb/detail/scan.h>
+#include <thrust/system/threads/detail/scan.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_SCAN_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/scan.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/scan_by_key.h>
 #include <thrust/system/omp/detail/scan_by_key.h>
 #include <thrust/system/tbb/detail/scan_by_key.h>
+#include <thrust/system/threads/detail/scan_by_key.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_SCAN_BY_KEY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/scan_by_key.h>
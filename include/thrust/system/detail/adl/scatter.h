@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/scatter.h>
 #include <thrust/system/omp/detail/scatter.h>
 #include <thrust/system/tbb/detail/scatter.h>
+#include <thrust/system/threads/detail/scatter.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_SCATTER_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/scatter.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/sequence.h>
 #include <thrust/system/omp/detail/sequence.h>
 #include <thrust/system/tbb/detail/sequence.h>
+#include <thrust/system/threads/detail/sequence.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_SEQUENCE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/sequence.h>
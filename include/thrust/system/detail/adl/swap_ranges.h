@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/swap_ranges.h>
 #include <thrust/system/omp/detail/swap_ranges.h>
 #include <thrust/system/tbb/detail/swap_ranges.h>
+#include <thrust/system/threads/detail/swap_ranges.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_SWAP_RANGES_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/swap_ranges.h>
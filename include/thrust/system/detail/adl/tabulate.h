@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/tabulate.h>
 #include <thrust/system/omp/detail/tabulate.h>
 #include <thrust/system/tbb/detail/tabulate.h>
+#include <thrust/system/threads/detail/tabulate.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_TABULATE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/tabulate.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/transform.h>
 #include <thrust/system/omp/detail/transform.h>
 #include <thrust/system/tbb/detail/transform.h>
+#include <thrust/system/threads/detail/transform.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_TRANSFORM_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/transform.h>
@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/transform_reduce.h>
 #include <thrust/system/omp/detail/transform_reduce.h>
 #include <thrust/system/tbb/detail/transform_reduce.h>
+#include <thrust/system/threads/detail/transform_reduce.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_TRANSFORM_REDUCE_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/transform_reduce.h>
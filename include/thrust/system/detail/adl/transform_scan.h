@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/transform_scan.h>
 #include <thrust/system/omp/detail/transform_scan.h>
 #include <thrust/system/tbb/detail/transform_scan.h>
+#include <thrust/system/threads/detail/transform_scan.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_TRANSFORM_SCAN_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/transform_scan.h>
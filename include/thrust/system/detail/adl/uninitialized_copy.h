@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/uninitialized_copy.h>
 #include <thrust/system/omp/detail/uninitialized_copy.h>
 #include <thrust/system/tbb/detail/uninitialized_copy.h>
+#include <thrust/system/threads/detail/uninitialized_copy.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_UNINITIALIZED_COPY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/uninitialized_copy.h>
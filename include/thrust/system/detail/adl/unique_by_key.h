@@ -34,6 +34,7 @@
 #include <thrust/system/hip/detail/unique_by_key.h>
 #include <thrust/system/omp/detail/unique_by_key.h>
 #include <thrust/system/tbb/detail/unique_by_key.h>
+#include <thrust/system/threads/detail/unique_by_key.h>
 #endif
 
 #define __THRUST_HOST_SYSTEM_UNIQUE_BY_KEY_HEADER <__THRUST_HOST_SYSTEM_ROOT/detail/unique_by_key.h>
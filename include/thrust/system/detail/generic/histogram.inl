@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/histogram.h>
+#include <thrust/system/detail/internal/histogram.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/adjacent_difference.h>
+#include <thrust/binary_search.h>
+#include <thrust/distance.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace histogram_detail
+{
+
+
+// systems without atomics or private bins sort the bin of each sample and
+// find where each bin's run ends; samples outside every bin map to num_bins
+// and sort after the others
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename BinFunction>
+__host__ __device__
+  RandomAccessIterator histogram(thrust::execution_policy<DerivedPolicy> &exec,
+                                 InputIterator first,
+                                 InputIterator last,
+                                 RandomAccessIterator histogram,
+                                 Size num_bins,
+                                 BinFunction bin)
+{
+  if(num_bins <= 0) return histogram;
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> bins(exec, thrust::distance(first, last));
+
+  thrust::transform(exec, first, last, bins.begin(), bin);
+  thrust::sort(exec, bins.begin(), bins.end());
+
+  thrust::counting_iterator<Size> bins_first(0);
+  thrust::upper_bound(exec, bins.begin(), bins.end(), bins_first, bins_first + num_bins, histogram);
+  thrust::adjacent_difference(exec, histogram, histogram + num_bins, histogram);
+
+  return histogram + num_bins;
+} // end histogram()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+__host__ __device__
+  RandomAccessIterator histogram_even(thrust::execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  thrust::system::detail::internal::even_bin<T,Size> bin(num_bins, lower_level, upper_level);
+
+  return histogram_detail::histogram(exec, first, last, histogram, num_bins, bin);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename LevelIterator,
+         typename RandomAccessIterator>
+__host__ __device__
+  RandomAccessIterator histogram_range(thrust::execution_policy<DerivedPolicy> &exec,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  typedef typename thrust::iterator_difference<LevelIterator>::type Size;
+
+  const Size num_bins = thrust::distance(levels_first, levels_last) - 1;
+
+  thrust::system::detail::internal::range_bin<LevelIterator> bin(levels_first, num_bins);
+
+  return histogram_detail::histogram(exec, first, last, histogram, num_bins, bin);
+} // end histogram_range()
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
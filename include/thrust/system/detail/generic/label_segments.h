@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/tag.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/binary_search.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace segmented_detail
+{
+
+
+// labels every element of [first, last) with the number of offsets not
+// greater than its index, i.e. one plus the index of its segment
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename OffsetIterator,
+         typename Size>
+__host__ __device__
+  void label_segments(thrust::execution_policy<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      thrust::detail::temporary_array<Size,DerivedPolicy> &segments)
+{
+  thrust::counting_iterator<Size> indices_first(0);
+
+  thrust::upper_bound(exec,
+                      offsets_first, offsets_last,
+                      indices_first, indices_first + thrust::distance(first, last),
+                      segments.begin());
+} // end label_segments()
+
+
+} // end segmented_detail
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
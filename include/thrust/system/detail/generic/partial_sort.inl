@@ -0,0 +1,660 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/partial_sort.h>
+#include <thrust/system/detail/internal/heap.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/gather.h>
+#include <thrust/partial_sort.h>
+#include <thrust/partition.h>
+#include <thrust/remove.h>
+#include <thrust/sort.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/tuple.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace partial_sort_detail
+{
+
+
+// ranges no longer than this are simply sorted
+const int sort_threshold = 1 << 14;
+
+// the largest sample sorted to choose splitters
+const int max_sample_size = 1 << 14;
+
+// selections of fewer elements than this first reduce each tile of
+// tile_size elements to its smallest elements, with one heap per tile
+const int max_heap_select_size = 256;
+const int tile_size = 1 << 12;
+
+
+// the number of elements below the lower of two splitters, equivalent to it,
+// between the splitters and equivalent to the upper splitter
+template<typename Size>
+struct splitter_counts
+{
+  Size count[4];
+}; // end splitter_counts
+
+
+template<typename Size>
+struct add_splitter_counts
+{
+  __host__ __device__
+  splitter_counts<Size> operator()(const splitter_counts<Size> &lhs, const splitter_counts<Size> &rhs) const
+  {
+    splitter_counts<Size> result;
+
+    result.count[0] = lhs.count[0] + rhs.count[0];
+    result.count[1] = lhs.count[1] + rhs.count[1];
+    result.count[2] = lhs.count[2] + rhs.count[2];
+    result.count[3] = lhs.count[3] + rhs.count[3];
+
+    return result;
+  }
+}; // end add_splitter_counts
+
+
+// places an element relative to two splitters, lower not after upper: 0 below
+// lower, 1 equivalent to lower, 2 between them, 3 equivalent to upper and 4
+// above upper
+template<typename T, typename StrictWeakOrdering>
+struct splitter_class
+{
+  T lower, upper;
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> comp;
+
+  __host__ __device__
+  splitter_class(const T &lower, const T &upper, StrictWeakOrdering comp)
+    : lower(lower), upper(upper), comp(comp)
+  {}
+
+  template<typename U>
+  __host__ __device__
+  int operator()(const U &x) const
+  {
+    const bool below_lower = comp(x, lower);
+    const bool above_lower = comp(lower, x);
+    const bool below_upper = comp(x, upper);
+    const bool above_upper = comp(upper, x);
+
+    // summed rather than branched on, since the outcomes are unpredictable;
+    // an element equivalent to both splitters is equivalent to the lower one
+    return !below_lower + above_lower + (above_lower && !below_upper) + above_upper;
+  }
+}; // end splitter_class
+
+
+template<typename Size, typename T, typename StrictWeakOrdering>
+struct count_splitter_class
+{
+  splitter_class<T,StrictWeakOrdering> classify;
+
+  __host__ __device__
+  count_splitter_class(const splitter_class<T,StrictWeakOrdering> &classify)
+    : classify(classify)
+  {}
+
+  template<typename U>
+  __host__ __device__
+  splitter_counts<Size> operator()(const U &x) const
+  {
+    const int c = classify(x);
+
+    splitter_counts<Size> result;
+
+    result.count[0] = (c == 0);
+    result.count[1] = (c == 1);
+    result.count[2] = (c == 2);
+    result.count[3] = (c == 3);
+
+    return result;
+  }
+}; // end count_splitter_class
+
+
+template<typename T, typename StrictWeakOrdering>
+struct is_splitter_class
+{
+  splitter_class<T,StrictWeakOrdering> classify;
+  int c;
+
+  __host__ __device__
+  is_splitter_class(const splitter_class<T,StrictWeakOrdering> &classify, int c)
+    : classify(classify), c(c)
+  {}
+
+  template<typename U>
+  __host__ __device__
+  bool operator()(const U &x) const
+  {
+    return classify(x) == c;
+  }
+}; // end is_splitter_class
+
+
+template<typename T, typename StrictWeakOrdering>
+struct is_not_splitter_class
+{
+  splitter_class<T,StrictWeakOrdering> classify;
+  int c;
+
+  __host__ __device__
+  is_not_splitter_class(const splitter_class<T,StrictWeakOrdering> &classify, int c)
+    : classify(classify), c(c)
+  {}
+
+  template<typename U>
+  __host__ __device__
+  bool operator()(const U &x) const
+  {
+    return classify(x) != c;
+  }
+}; // end is_not_splitter_class
+
+
+// a random position within the i-th of the strata of stride elements, so that
+// the sample adapts to no pattern in the input
+template<typename Size>
+struct sample_position
+{
+  Size stride;
+  thrust::detail::uint64_t seed;
+
+  __host__ __device__
+  sample_position(Size stride, thrust::detail::uint64_t seed)
+    : stride(stride), seed(seed)
+  {}
+
+  __host__ __device__
+  Size operator()(Size i) const
+  {
+    // the splitmix64 finalizer
+    thrust::detail::uint64_t h = static_cast<thrust::detail::uint64_t>(i) + seed * 0x9e3779b97f4a7c15ull;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    h ^= h >> 31;
+
+    return i * stride + static_cast<Size>(h % static_cast<thrust::detail::uint64_t>(stride));
+  }
+}; // end sample_position
+
+
+template<typename T, typename StrictWeakOrdering>
+struct less_than_pivot
+{
+  T pivot;
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> comp;
+
+  __host__ __device__
+  less_than_pivot(const T &pivot, StrictWeakOrdering comp)
+    : pivot(pivot), comp(comp)
+  {}
+
+  template<typename U>
+  __host__ __device__
+  bool operator()(const U &x) const
+  {
+    return comp(x, pivot);
+  }
+}; // end less_than_pivot
+
+
+template<typename T, typename StrictWeakOrdering>
+struct not_greater_than_pivot
+{
+  T pivot;
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> comp;
+
+  __host__ __device__
+  not_greater_than_pivot(const T &pivot, StrictWeakOrdering comp)
+    : pivot(pivot), comp(comp)
+  {}
+
+  template<typename U>
+  __host__ __device__
+  bool operator()(const U &x) const
+  {
+    return !comp(pivot, x);
+  }
+}; // end not_greater_than_pivot
+
+
+// applies a predicate on keys to the first element of a (key, value) tuple
+template<typename Predicate>
+struct on_key
+{
+  Predicate pred;
+
+  __host__ __device__
+  on_key(Predicate pred)
+    : pred(pred)
+  {}
+
+  template<typename Tuple>
+  __host__ __device__
+  bool operator()(const Tuple &t) const
+  {
+    return pred(thrust::get<0>(t));
+  }
+}; // end on_key
+
+
+// copies the k smallest elements of each tile of [first, first + n) to
+// candidates + tile * k; the last tile may contribute fewer
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename StrictWeakOrdering>
+struct select_tile_candidates
+{
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 candidates;
+  Size n, k;
+  StrictWeakOrdering comp;
+
+  __host__ __device__
+  select_tile_candidates(RandomAccessIterator1 first, RandomAccessIterator2 candidates, Size n, Size k, StrictWeakOrdering comp)
+    : first(first), candidates(candidates), n(n), k(k), comp(comp)
+  {}
+
+  __host__ __device__
+  void operator()(Size tile) const
+  {
+    const Size begin = tile * tile_size;
+    const Size end   = thrust::min<Size>(n, begin + tile_size);
+
+    thrust::system::detail::internal::heap_select_copy(first + begin, first + end,
+                                                       candidates + tile * k,
+                                                       thrust::min<Size>(k, end - begin),
+                                                       comp);
+  }
+}; // end select_tile_candidates
+
+
+// chooses two splitters from a sample of [first, first + n), about two
+// standard deviations either side of the estimated position of rank k, and
+// counts the elements around them; returns the splitter class holding rank k
+// and updates n and k to its size and the rank within it
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T,
+         typename StrictWeakOrdering>
+__host__ __device__
+  int sample_select_pass(thrust::execution_policy<DerivedPolicy> &exec,
+                         RandomAccessIterator first,
+                         Size &n,
+                         Size &k,
+                         T &lower,
+                         T &upper,
+                         StrictWeakOrdering comp,
+                         thrust::detail::uint64_t pass)
+{
+  const Size sample_size = thrust::min<Size>(n / 16, max_sample_size);
+
+  thrust::detail::temporary_array<T,DerivedPolicy> sample(exec, sample_size);
+
+  thrust::gather(exec,
+                 thrust::make_transform_iterator(thrust::counting_iterator<Size>(0), sample_position<Size>(n / sample_size, pass)),
+                 thrust::make_transform_iterator(thrust::counting_iterator<Size>(sample_size), sample_position<Size>(n / sample_size, pass)),
+                 first,
+                 sample.begin());
+
+  thrust::sort(exec, sample.begin(), sample.end(), comp);
+
+  // the position in the sample of the element of rank k has a standard
+  // deviation of at most half the square root of the sample size
+  Size spread = 1;
+  while(spread * spread < sample_size) ++spread;
+
+  const Size estimate = static_cast<Size>(static_cast<double>(k) / n * sample_size);
+
+  lower = sample[estimate > spread ? estimate - spread : Size(0)];
+  upper = sample[thrust::min<Size>(estimate + spread, sample_size - 1)];
+
+  const splitter_class<T,StrictWeakOrdering> classify(lower, upper, comp);
+
+  const splitter_counts<Size> init = {{0, 0, 0, 0}};
+  const splitter_counts<Size> counts =
+    thrust::transform_reduce(exec, first, first + n, count_splitter_class<Size,T,StrictWeakOrdering>(classify), init, add_splitter_counts<Size>());
+
+  int c = 0;
+  for(; c < 4 && k >= counts.count[c]; ++c)
+  {
+    k -= counts.count[c];
+    n -= counts.count[c];
+  }
+
+  if(c < 4)
+  {
+    n = counts.count[c];
+  }
+
+  return c;
+} // end sample_select_pass()
+
+
+// returns the element of rank k in the first n elements of buffer, which it
+// is free to reorder
+template<typename DerivedPolicy,
+         typename T,
+         typename Size,
+         typename StrictWeakOrdering>
+__host__ __device__
+  T sample_select(thrust::execution_policy<DerivedPolicy> &exec,
+                  thrust::detail::temporary_array<T,DerivedPolicy> &buffer,
+                  Size n,
+                  Size k,
+                  StrictWeakOrdering comp)
+{
+  for(thrust::detail::uint64_t pass = 1; n > sort_threshold; ++pass)
+  {
+    const Size size = n;
+
+    T lower, upper;
+    const int c = sample_select_pass(exec, buffer.begin(), n, k, lower, upper, comp, pass);
+
+    if(c == 1) return lower;
+    if(c == 3) return upper;
+
+    thrust::remove_if(exec, buffer.begin(), buffer.begin() + size,
+                      is_not_splitter_class<T,StrictWeakOrdering>(splitter_class<T,StrictWeakOrdering>(lower, upper, comp), c));
+  }
+
+  thrust::sort(exec, buffer.begin(), buffer.begin() + n, comp);
+
+  return buffer[k];
+} // end sample_select()
+
+
+// returns the element of rank k in [first, first + n) without modifying it
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename StrictWeakOrdering>
+__host__ __device__
+  typename thrust::iterator_value<RandomAccessIterator>::type
+    select(thrust::execution_policy<DerivedPolicy> &exec,
+           RandomAccessIterator first,
+           Size n,
+           Size k,
+           StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+  if(k < max_heap_select_size && n / tile_size > 1)
+  {
+    // the element of rank k is among the k + 1 smallest elements of its tile
+    const Size num_tiles  = (n + tile_size - 1) / tile_size;
+    const Size last_tile  = n - (num_tiles - 1) * tile_size;
+    const Size candidates = (num_tiles - 1) * (k + 1) + thrust::min<Size>(k + 1, last_tile);
+
+    thrust::detail::temporary_array<T,DerivedPolicy> buffer(exec, candidates);
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<Size>(0),
+                     thrust::counting_iterator<Size>(num_tiles),
+                     select_tile_candidates<RandomAccessIterator,typename thrust::detail::temporary_array<T,DerivedPolicy>::iterator,Size,StrictWeakOrdering>(first, buffer.begin(), n, k + 1, comp));
+
+    return sample_select(exec, buffer, candidates, k, comp);
+  }
+
+  // the first pass reads the input and copies the splitter class holding
+  // rank k to a buffer, which the later passes narrow in place
+  const Size size = n;
+
+  T lower, upper;
+  const int c = sample_select_pass(exec, first, n, k, lower, upper, comp, thrust::detail::uint64_t(0));
+
+  if(c == 1) return lower;
+  if(c == 3) return upper;
+
+  thrust::detail::temporary_array<T,DerivedPolicy> buffer(exec, n);
+
+  thrust::copy_if(exec, first, first + size, buffer.begin(),
+                  is_splitter_class<T,StrictWeakOrdering>(splitter_class<T,StrictWeakOrdering>(lower, upper, comp), c));
+
+  return sample_select(exec, buffer, n, k, comp);
+} // end select()
+
+
+// partitions [first, last) into the elements less than the pivot, those
+// equivalent to it and the greater ones; the second partition only reorders
+// the side of the first which does not hold position k, the smaller one
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename LessThanPivot,
+         typename NotGreaterThanPivot>
+__host__ __device__
+  void partition_around_pivot(thrust::execution_policy<DerivedPolicy> &exec,
+                              RandomAccessIterator first,
+                              RandomAccessIterator last,
+                              Size k,
+                              LessThanPivot less_than_pivot,
+                              NotGreaterThanPivot not_greater_than_pivot)
+{
+  if(k < (last - first) / 2)
+  {
+    RandomAccessIterator middle = thrust::stable_partition(exec, first, last, not_greater_than_pivot);
+
+    thrust::stable_partition(exec, first, middle, less_than_pivot);
+  }
+  else
+  {
+    RandomAccessIterator middle = thrust::stable_partition(exec, first, last, less_than_pivot);
+
+    thrust::stable_partition(exec, middle, last, not_greater_than_pivot);
+  }
+} // end partition_around_pivot()
+
+
+} // end partial_sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator>
+__host__ __device__
+  void nth_element(thrust::execution_policy<DerivedPolicy> &exec,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  thrust::nth_element(exec, first, nth, last, thrust::less<value_type>());
+} // end nth_element()
+
+
+// selects the element of rank nth - first with sampling passes over the
+// range, after reducing every tile to its smallest elements when only a few
+// are selected, then partitions the range around it
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element(thrust::execution_policy<DerivedPolicy> &exec,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      T;
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+
+  const Size n = last - first;
+  const Size k = nth - first;
+
+  if(k >= n) return;
+
+  if(n <= partial_sort_detail::sort_threshold)
+  {
+    thrust::sort(exec, first, last, comp);
+    return;
+  }
+
+  const T pivot = partial_sort_detail::select(exec, first, n, k, comp);
+
+  partial_sort_detail::partition_around_pivot(exec, first, last, k,
+                                              partial_sort_detail::less_than_pivot<T,StrictWeakOrdering>(pivot, comp),
+                                              partial_sort_detail::not_greater_than_pivot<T,StrictWeakOrdering>(pivot, comp));
+} // end nth_element()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+__host__ __device__
+  void nth_element_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type;
+  thrust::nth_element_by_key(exec, keys_first, keys_nth, keys_last, values_first, thrust::less<value_type>());
+} // end nth_element_by_key()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first,
+                          StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      T;
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size n = keys_last - keys_first;
+  const Size k = keys_nth - keys_first;
+
+  if(k >= n) return;
+
+  if(n <= partial_sort_detail::sort_threshold)
+  {
+    thrust::sort_by_key(exec, keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  const T pivot = partial_sort_detail::select(exec, keys_first, n, k, comp);
+
+  typedef partial_sort_detail::not_greater_than_pivot<T,StrictWeakOrdering> not_greater_than_pivot;
+  typedef partial_sort_detail::less_than_pivot<T,StrictWeakOrdering>        less_than_pivot;
+
+  partial_sort_detail::partition_around_pivot(exec,
+                                              thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first)),
+                                              thrust::make_zip_iterator(thrust::make_tuple(keys_last, values_first + n)),
+                                              k,
+                                              partial_sort_detail::on_key<less_than_pivot>(less_than_pivot(pivot, comp)),
+                                              partial_sort_detail::on_key<not_greater_than_pivot>(not_greater_than_pivot(pivot, comp)));
+} // end nth_element_by_key()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator>
+__host__ __device__
+  void partial_sort(thrust::execution_policy<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  thrust::partial_sort(exec, first, middle, last, thrust::less<value_type>());
+} // end partial_sort()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort(thrust::execution_policy<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last,
+                    StrictWeakOrdering comp)
+{
+  if(first == middle) return;
+
+  // select the last element of the sorted part, then sort the ones before it
+  thrust::nth_element(exec, first, middle - 1, last, comp);
+
+  thrust::sort(exec, first, middle - 1, comp);
+} // end partial_sort()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+__host__ __device__
+  void partial_sort_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type;
+  thrust::partial_sort_by_key(exec, keys_first, keys_middle, keys_last, values_first, thrust::less<value_type>());
+} // end partial_sort_by_key()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           StrictWeakOrdering comp)
+{
+  if(keys_first == keys_middle) return;
+
+  thrust::nth_element_by_key(exec, keys_first, keys_middle - 1, keys_last, values_first, comp);
+
+  thrust::sort_by_key(exec, keys_first, keys_middle - 1, values_first, comp);
+} // end partial_sort_by_key()
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
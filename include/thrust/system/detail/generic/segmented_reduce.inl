@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/segmented_reduce.h>
+#include <thrust/system/detail/generic/label_segments.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace segmented_reduce_detail
+{
+
+
+// writes the reduction of every run of reduce_by_key which belongs to a
+// segment, i.e. whose label is neither 0 nor num_offsets, to its segment
+template<typename LabelIterator,
+         typename ValueIterator,
+         typename OutputIterator,
+         typename Size,
+         typename T,
+         typename BinaryFunction>
+struct write_segment
+{
+  LabelIterator labels;
+  ValueIterator values;
+  OutputIterator result;
+  Size num_offsets;
+  T init;
+  thrust::detail::wrapped_function<BinaryFunction,T> binary_op;
+
+  __host__ __device__
+  write_segment(LabelIterator labels, ValueIterator values, OutputIterator result, Size num_offsets, T init, BinaryFunction binary_op)
+    : labels(labels), values(values), result(result), num_offsets(num_offsets), init(init), binary_op(binary_op)
+  {}
+
+  __host__ __device__
+  void operator()(Size run) const
+  {
+    const Size label = labels[run];
+
+    if(0 < label && label < num_offsets)
+    {
+      result[label - 1] = binary_op(init, values[run]);
+    }
+  }
+}; // end write_segment
+
+
+} // end segmented_reduce_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OffsetIterator,
+         typename OutputIterator>
+__host__ __device__
+  OutputIterator segmented_reduce(thrust::execution_policy<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type InputType;
+
+  // use InputType(0) as init by default
+  return thrust::segmented_reduce(exec, first, last, offsets_first, offsets_last, result, InputType(0));
+} // end segmented_reduce()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OffsetIterator,
+         typename OutputIterator,
+         typename T>
+__host__ __device__
+  OutputIterator segmented_reduce(thrust::execution_policy<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init)
+{
+  // use plus<T> by default
+  return thrust::segmented_reduce(exec, first, last, offsets_first, offsets_last, result, init, thrust::plus<T>());
+} // end segmented_reduce()
+
+
+// systems without a segmented reduction of their own label every element with
+// its segment and reduce the runs of equal labels
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OffsetIterator,
+         typename OutputIterator,
+         typename T,
+         typename BinaryFunction>
+__host__ __device__
+  OutputIterator segmented_reduce(thrust::execution_policy<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator last,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  const Size num_offsets = thrust::distance(offsets_first, offsets_last);
+
+  if(num_offsets < 2) return result;
+
+  const Size num_segments = num_offsets - 1;
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> labels(exec, thrust::distance(first, last));
+
+  segmented_detail::label_segments(exec, first, last, offsets_first, offsets_last, labels);
+
+  // besides the non-empty segments, there may be a run before the first
+  // offset and one after the last
+  thrust::detail::temporary_array<Size,DerivedPolicy> run_labels(exec, num_segments + 2);
+  thrust::detail::temporary_array<T,DerivedPolicy>    run_values(exec, num_segments + 2);
+
+  const Size num_runs = thrust::reduce_by_key(exec,
+                                              labels.begin(), labels.end(),
+                                              first,
+                                              run_labels.begin(),
+                                              run_values.begin(),
+                                              thrust::equal_to<Size>(),
+                                              binary_op).first - run_labels.begin();
+
+  // empty segments reduce to init
+  thrust::fill(exec, result, result + num_segments, init);
+
+  typedef segmented_reduce_detail::write_segment<
+    typename thrust::detail::temporary_array<Size,DerivedPolicy>::iterator,
+    typename thrust::detail::temporary_array<T,DerivedPolicy>::iterator,
+    OutputIterator,
+    Size,
+    T,
+    BinaryFunction
+  > write_segment_type;
+
+  thrust::for_each(exec,
+                   thrust::counting_iterator<Size>(0),
+                   thrust::counting_iterator<Size>(num_runs),
+                   write_segment_type(run_labels.begin(), run_values.begin(), result, num_offsets, init, binary_op));
+
+  return result + num_segments;
+} // end segmented_reduce()
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/segmented_sort.h>
+#include <thrust/system/detail/generic/label_segments.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/functional.h>
+#include <thrust/sort.h>
+#include <thrust/tuple.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace segmented_sort_detail
+{
+
+
+// orders (segment, key) pairs by segment, then by key; elements before the
+// first offset or after the last belong to no segment and compare equivalent,
+// so a stable sort leaves them in place
+template<typename Size, typename StrictWeakOrdering>
+struct segment_then_key_less
+{
+  Size num_offsets;
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> comp;
+
+  __host__ __device__
+  segment_then_key_less(Size num_offsets, StrictWeakOrdering comp)
+    : num_offsets(num_offsets), comp(comp)
+  {}
+
+  template<typename Tuple1, typename Tuple2>
+  __host__ __device__
+  bool operator()(const Tuple1 &lhs, const Tuple2 &rhs) const
+  {
+    const Size lhs_segment = thrust::get<0>(lhs);
+    const Size rhs_segment = thrust::get<0>(rhs);
+
+    if(lhs_segment != rhs_segment) return lhs_segment < rhs_segment;
+
+    return 0 < lhs_segment && lhs_segment < num_offsets && comp(thrust::get<1>(lhs), thrust::get<1>(rhs));
+  }
+}; // end segment_then_key_less
+
+
+} // end segmented_sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename OffsetIterator>
+__host__ __device__
+  void segmented_sort(thrust::execution_policy<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  thrust::segmented_sort(exec, first, last, offsets_first, offsets_last, thrust::less<value_type>());
+} // end segmented_sort()
+
+
+// systems without a segmented sort of their own sort the whole range once,
+// by segment and then by key
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename OffsetIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort(thrust::execution_policy<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator last,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+
+  const Size num_offsets = thrust::distance(offsets_first, offsets_last);
+
+  if(num_offsets < 2) return;
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> segments(exec, thrust::distance(first, last));
+
+  segmented_detail::label_segments(exec, first, last, offsets_first, offsets_last, segments);
+
+  thrust::stable_sort(exec,
+                      thrust::make_zip_iterator(thrust::make_tuple(segments.begin(), first)),
+                      thrust::make_zip_iterator(thrust::make_tuple(segments.end(), last)),
+                      segmented_sort_detail::segment_then_key_less<Size,StrictWeakOrdering>(num_offsets, comp));
+} // end segmented_sort()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OffsetIterator>
+__host__ __device__
+  void segmented_sort_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type;
+  thrust::segmented_sort_by_key(exec, keys_first, keys_last, values_first, offsets_first, offsets_last, thrust::less<value_type>());
+} // end segmented_sort_by_key()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OffsetIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1 keys_last,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size num_offsets = thrust::distance(offsets_first, offsets_last);
+
+  if(num_offsets < 2) return;
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> segments(exec, thrust::distance(keys_first, keys_last));
+
+  segmented_detail::label_segments(exec, keys_first, keys_last, offsets_first, offsets_last, segments);
+
+  thrust::stable_sort_by_key(exec,
+                             thrust::make_zip_iterator(thrust::make_tuple(segments.begin(), keys_first)),
+                             thrust::make_zip_iterator(thrust::make_tuple(segments.end(), keys_last)),
+                             values_first,
+                             segmented_sort_detail::segment_then_key_less<Size,StrictWeakOrdering>(num_offsets, comp));
+} // end segmented_sort_by_key()
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
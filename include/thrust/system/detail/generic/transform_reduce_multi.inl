@@ -0,0 +1,56 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/transform_reduce_multi.h>
+#include <thrust/system/detail/internal/transform_reduce_multi.h>
+#include <thrust/transform_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+__host__ __device__
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(thrust::execution_policy<DerivedPolicy> &exec,
+                           InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions)
+{
+  // a single reduction of the tuples of every reduction's result
+  thrust::tuple<Reductions...> reductions_tuple(reductions...);
+
+  return thrust::transform_reduce(exec, first, last,
+                                  thrust::system::detail::internal::multi_transform<Reductions...>(reductions_tuple),
+                                  thrust::system::detail::internal::multi_init(reductions...),
+                                  thrust::system::detail::internal::multi_combine<Reductions...>(reductions_tuple));
+} // end transform_reduce_multi()
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
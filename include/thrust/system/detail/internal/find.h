@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <atomic>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the state a parallel find_if shares among its threads: the next chunk to
+// search and the lowest index of a match found so far. Chunks are claimed in
+// increasing order, and no thread claims or keeps searching a chunk above a
+// match, so the search stops shortly after the first match is found no
+// matter how long the input is.
+template<typename Size>
+  class find_if_state
+{
+  public:
+    // the number of elements claimed at a time; small enough that the work
+    // wasted past a match stays small, large enough that the shared counter
+    // is rarely touched
+    static const Size chunk_size = 1 << 12;
+
+    explicit find_if_state(Size n)
+      : m_n(n), m_next_chunk(0), m_result(n)
+    {}
+
+    // returns the index of the first match, or n when there is none
+    Size result() const
+    {
+      return m_result.load(std::memory_order_relaxed);
+    }
+
+    // searches chunks of [first, first + n) until none is left which could
+    // hold a match below the lowest one found so far
+    template<typename RandomAccessIterator, typename Predicate>
+      void search(RandomAccessIterator first, Predicate pred)
+    {
+      thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+      while(true)
+      {
+        const Size begin = chunk_size * m_next_chunk.fetch_add(1, std::memory_order_relaxed);
+
+        if(begin >= result()) return;
+
+        const Size end = m_n - begin < chunk_size ? m_n : begin + chunk_size;
+
+        for(Size i = begin; i < end; ++i)
+        {
+          if(wrapped_pred(first[i]))
+          {
+            lower_result(i);
+            break;
+          }
+        }
+      }
+    }
+
+  private:
+    // records a match at i unless a lower one has already been found
+    void lower_result(Size i)
+    {
+      Size current = result();
+
+      while(i < current && !m_result.compare_exchange_weak(current, i, std::memory_order_relaxed))
+      {}
+    }
+
+    const Size        m_n;
+    std::atomic<Size> m_next_chunk;
+    std::atomic<Size> m_result;
+
+    find_if_state(const find_if_state &);
+    find_if_state &operator=(const find_if_state &);
+};
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
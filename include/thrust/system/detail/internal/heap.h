@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// restores the heap property of the max-heap [first, first + n) after the
+// element at hole may have become smaller than its children
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator, typename Size, typename StrictWeakOrdering>
+__host__ __device__
+  void sift_down(RandomAccessIterator first,
+                 Size hole,
+                 Size n,
+                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  value_type value = first[hole];
+
+  for(Size child = 2 * hole + 1; child < n; child = 2 * hole + 1)
+  {
+    if(child + 1 < n && wrapped_comp(first[child], first[child + 1]))
+    {
+      ++child;
+    }
+
+    if(!wrapped_comp(value, first[child])) break;
+
+    first[hole] = first[child];
+    hole = child;
+  }
+
+  first[hole] = value;
+} // end sift_down()
+
+
+// arranges [first, first + n) into a max-heap
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator, typename Size, typename StrictWeakOrdering>
+__host__ __device__
+  void make_heap(RandomAccessIterator first,
+                 Size n,
+                 StrictWeakOrdering comp)
+{
+  for(Size i = n / 2; i > 0; --i)
+  {
+    internal::sift_down(first, i - 1, n, comp);
+  }
+} // end make_heap()
+
+
+// moves the middle - first smallest elements of [first, last) to
+// [first, middle), arranged as a max-heap, so that *first is the largest of them
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void heap_select(RandomAccessIterator first,
+                   RandomAccessIterator middle,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      value_type;
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  const Size k = middle - first;
+
+  if(k == 0) return;
+
+  internal::make_heap(first, k, comp);
+
+  for(; middle < last; ++middle)
+  {
+    if(wrapped_comp(*middle, *first))
+    {
+      value_type tmp = *middle;
+      *middle = *first;
+      *first = tmp;
+
+      internal::sift_down(first, Size(0), k, comp);
+    }
+  }
+} // end heap_select()
+
+
+// copies the k smallest elements of [first, last), which holds at least k
+// elements, to [result, result + k), arranged as a max-heap; the input is not
+// modified
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename StrictWeakOrdering>
+__host__ __device__
+  void heap_select_copy(RandomAccessIterator1 first,
+                        RandomAccessIterator1 last,
+                        RandomAccessIterator2 result,
+                        Size k,
+                        StrictWeakOrdering comp)
+{
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  for(Size i = 0; i < k; ++i, ++first)
+  {
+    result[i] = *first;
+  }
+
+  internal::make_heap(result, k, comp);
+
+  for(; first < last; ++first)
+  {
+    if(wrapped_comp(*first, result[0]))
+    {
+      result[0] = *first;
+
+      internal::sift_down(result, Size(0), k, comp);
+    }
+  }
+} // end heap_select_copy()
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
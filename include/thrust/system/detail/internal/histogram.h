@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// maps a sample to its bin among num_bins bins of equal width dividing
+// [lower, upper), or to num_bins when it lies outside
+template<typename T, typename Size, bool = thrust::detail::is_integral<T>::value>
+  struct even_bin
+{
+  T lower, upper, scale;
+  Size num_bins;
+
+  __host__ __device__
+  even_bin(Size num_bins, T lower, T upper)
+    : lower(lower), upper(upper), scale(T(num_bins) / (upper - lower)), num_bins(num_bins)
+  {}
+
+  template<typename Sample>
+  __host__ __device__
+  Size operator()(const Sample &sample) const
+  {
+    const T x = sample;
+
+    // note that this rejects NaNs
+    if(!(lower <= x && x < upper)) return num_bins;
+
+    const Size bin = static_cast<Size>((x - lower) * scale);
+
+    // rounding may carry samples just below upper past the last bin
+    return bin < num_bins ? bin : num_bins - 1;
+  }
+}; // end even_bin
+
+
+template<typename T, typename Size>
+  struct even_bin<T,Size,true>
+{
+  typedef thrust::detail::uint64_t wide_type;
+
+  T lower, upper;
+  Size num_bins;
+
+  __host__ __device__
+  even_bin(Size num_bins, T lower, T upper)
+    : lower(lower), upper(upper), num_bins(num_bins)
+  {}
+
+  template<typename Sample>
+  __host__ __device__
+  Size operator()(const Sample &sample) const
+  {
+    const T x = sample;
+
+    if(!(lower <= x && x < upper)) return num_bins;
+
+    // differences of signed values are exact modulo 2^64
+    const wide_type offset = wide_type(x) - wide_type(lower);
+    const wide_type range  = wide_type(upper) - wide_type(lower);
+    const wide_type bins   = wide_type(num_bins);
+
+    if(range <= ~wide_type(0) / bins)
+    {
+      return static_cast<Size>(offset * bins / range);
+    }
+
+    return static_cast<Size>(wide_multiply_divide(offset, bins, range));
+  }
+
+  // computes a * b / c exactly for a < c, when a * b overflows 64 bits,
+  // which only happens for ranges near 2^64
+  __host__ __device__
+  static wide_type wide_multiply_divide(wide_type a, wide_type b, wide_type c)
+  {
+    const wide_type mask = 0xffffffffu;
+
+    // the 128-bit product hi:lo from 32-bit halves
+    const wide_type ll = (a & mask) * (b & mask);
+    const wide_type lh = (a & mask) * (b >> 32);
+    const wide_type hl = (a >> 32) * (b & mask);
+    const wide_type hh = (a >> 32) * (b >> 32);
+
+    const wide_type mid = (ll >> 32) + (lh & mask) + (hl & mask);
+
+    wide_type lo = (mid << 32) | (ll & mask);
+    wide_type hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+    // since a < c, hi < c and the quotient fits in 64 bits; divide bitwise
+    wide_type quotient = 0;
+    for(int i = 0; i < 64; ++i)
+    {
+      const bool carry = (hi >> 63) != 0;
+
+      hi = (hi << 1) | (lo >> 63);
+      lo <<= 1;
+      quotient <<= 1;
+
+      if(carry || hi >= c)
+      {
+        hi -= c;
+        quotient |= 1;
+      }
+    }
+
+    return quotient;
+  }
+}; // end even_bin
+
+
+// maps a sample to the bin i for which levels[i] <= sample < levels[i + 1],
+// or to num_bins when it lies outside
+template<typename LevelIterator>
+  struct range_bin
+{
+  typedef typename thrust::iterator_difference<LevelIterator>::type Size;
+
+  LevelIterator levels;
+  Size num_bins;
+
+  __host__ __device__
+  range_bin(LevelIterator levels, Size num_bins)
+    : levels(levels), num_bins(num_bins)
+  {}
+
+  template<typename Sample>
+  __host__ __device__
+  Size operator()(const Sample &x) const
+  {
+    if(num_bins <= 0 || x < levels[0] || !(x < levels[num_bins])) return num_bins;
+
+    // binary search maintaining levels[lo] <= x < levels[hi]
+    Size lo = 0, hi = num_bins;
+    while(hi - lo > 1)
+    {
+      const Size mid = lo + (hi - lo) / 2;
+
+      if(x < levels[mid])
+      {
+        hi = mid;
+      }
+      else
+      {
+        lo = mid;
+      }
+    }
+
+    return lo;
+  }
+}; // end range_bin
+
+
+// counts the samples of [first, last) falling in each of num_bins bins
+__thrust_exec_check_disable__
+template<typename InputIterator, typename RandomAccessIterator, typename Size, typename BinFunction>
+__host__ __device__
+  void count_bins(InputIterator first,
+                  InputIterator last,
+                  RandomAccessIterator counts,
+                  Size num_bins,
+                  BinFunction bin)
+{
+  for(Size i = 0; i < num_bins; ++i)
+  {
+    counts[i] = 0;
+  }
+
+  for(; first != last; ++first)
+  {
+    const Size b = static_cast<Size>(bin(*first));
+
+    if(b < num_bins)
+    {
+      ++counts[b];
+    }
+  }
+} // end count_bins()
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
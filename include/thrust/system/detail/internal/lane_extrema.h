@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/pair.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// min_element, max_element and minmax_element for systems whose reduce
+// reduces contiguous ranges of arithmetic values in lanes; other ranges and
+// comparisons go to the generic algorithms
+template<typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+  ForwardIterator lane_min_element(thrust::execution_policy<DerivedPolicy> &exec,
+                                   ForwardIterator first,
+                                   ForwardIterator last,
+                                   BinaryPredicate comp);
+
+
+template<typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+  ForwardIterator lane_max_element(thrust::execution_policy<DerivedPolicy> &exec,
+                                   ForwardIterator first,
+                                   ForwardIterator last,
+                                   BinaryPredicate comp);
+
+
+template<typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+  thrust::pair<ForwardIterator,ForwardIterator> lane_minmax_element(thrust::execution_policy<DerivedPolicy> &exec,
+                                                                    ForwardIterator first,
+                                                                    ForwardIterator last,
+                                                                    BinaryPredicate comp);
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/detail/internal/lane_extrema.inl>
+
@@ -0,0 +1,304 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/tuple.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+
+// The serial reductions below read contiguous ranges of arithmetic values,
+// possibly seen through a transform_iterator or a zip_iterator of two such
+// ranges as in inner_product, through raw pointers, so that the compiler may
+// vectorize them. Only the leaves of the parallel CPU systems use them; the
+// sequential system always reduces in order.
+//
+// Integer arithmetic is exact, so compilers vectorize reductions of integers
+// on their own. They may not reassociate floating point arithmetic, so when
+// the operator is plus, minimum or maximum over a floating point type, the
+// reduction keeps a block of independent accumulators (lanes) instead, each
+// summing every num_lanes-th element, and combines them pairwise at the end.
+// minimum and maximum are exact in the absence of NaNs, so only plus gives a
+// different result than the sequential loop, and then only by rounding; with
+// NaNs, the lanes may change which NaN or number survives a < b ? a : b.
+// Like the parallel reductions, which combine partial sums in an order
+// depending on the number of threads, the results are reproducible for a
+// given input length but not across lengths or systems.
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace lane_reduce_detail
+{
+
+
+// contiguous_source, transform_source and zip_source produce the elements of
+// an iterator from raw pointers; source<Iterator>::value is false for
+// iterators they do not understand
+template<typename Iterator, typename Enable = void>
+  struct source
+{
+  static const bool value = false;
+};
+
+
+template<typename Iterator>
+  struct contiguous_source
+{
+  typedef typename thrust::detail::contiguous_iterator_raw_pointer_t<Iterator> pointer;
+
+  pointer ptr;
+
+  explicit contiguous_source(Iterator iter)
+    : ptr(thrust::detail::contiguous_iterator_raw_pointer_cast(iter))
+  {}
+
+  template<typename Size>
+  typename thrust::iterator_value<Iterator>::type operator[](Size i) const
+  {
+    return ptr[i];
+  }
+};
+
+
+template<typename Iterator>
+  struct source<
+    Iterator,
+    typename thrust::detail::enable_if<thrust::is_contiguous_iterator<Iterator>::value>::type
+  >
+{
+  static const bool value = true;
+  typedef contiguous_source<Iterator> type;
+};
+
+
+template<typename UnaryFunction, typename Iterator, typename Reference, typename Value>
+  struct transform_source
+{
+  typedef thrust::transform_iterator<UnaryFunction,Iterator,Reference,Value> iterator;
+  typedef typename thrust::iterator_value<iterator>::type                      value_type;
+
+  typename source<Iterator>::type base;
+
+  // some functors, like the one inner_product uses, have a non-const call operator
+  mutable UnaryFunction f;
+
+  explicit transform_source(iterator iter)
+    : base(iter.base()), f(iter.functor())
+  {}
+
+  template<typename Size>
+  value_type operator[](Size i) const
+  {
+    return static_cast<value_type>(f(base[i]));
+  }
+};
+
+
+template<typename UnaryFunction, typename Iterator, typename Reference, typename Value>
+  struct source<
+    thrust::transform_iterator<UnaryFunction,Iterator,Reference,Value>,
+    typename thrust::detail::enable_if<source<Iterator>::value>::type
+  >
+{
+  static const bool value = true;
+  typedef transform_source<UnaryFunction,Iterator,Reference,Value> type;
+};
+
+
+template<typename Iterator1, typename Iterator2>
+  struct zip_source
+{
+  typedef thrust::zip_iterator<thrust::tuple<Iterator1,Iterator2> > iterator;
+
+  typename source<Iterator1>::type first1;
+  typename source<Iterator2>::type first2;
+
+  explicit zip_source(iterator iter)
+    : first1(thrust::get<0>(iter.get_iterator_tuple())),
+      first2(thrust::get<1>(iter.get_iterator_tuple()))
+  {}
+
+  template<typename Size>
+  thrust::tuple<
+    typename thrust::iterator_value<Iterator1>::type,
+    typename thrust::iterator_value<Iterator2>::type
+  > operator[](Size i) const
+  {
+    return thrust::make_tuple(first1[i], first2[i]);
+  }
+};
+
+
+template<typename Iterator1, typename Iterator2>
+  struct source<
+    thrust::zip_iterator<thrust::tuple<Iterator1,Iterator2> >,
+    typename thrust::detail::enable_if<source<Iterator1>::value && source<Iterator2>::value>::type
+  >
+{
+  static const bool value = true;
+  typedef zip_source<Iterator1,Iterator2> type;
+};
+
+
+// operators which the lanes may reassociate
+template<typename BinaryFunction, typename T>
+  struct is_lane_operator : thrust::detail::false_type
+{};
+
+template<typename T> struct is_lane_operator<thrust::plus<T>,       T> : thrust::detail::true_type {};
+template<typename T> struct is_lane_operator<thrust::plus<void>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_lane_operator<thrust::minimum<T>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_lane_operator<thrust::minimum<void>, T> : thrust::detail::true_type {};
+template<typename T> struct is_lane_operator<thrust::maximum<T>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_lane_operator<thrust::maximum<void>, T> : thrust::detail::true_type {};
+
+
+// 128 bytes of accumulators keep several vector registers' worth of
+// independent additions in flight on any current SIMD instruction set
+template<typename OutputType, typename BinaryFunction>
+  struct num_lanes
+    : thrust::detail::integral_constant<
+        int,
+        (thrust::detail::is_floating_point<OutputType>::value &&
+         is_lane_operator<BinaryFunction,OutputType>::value) ? int(128 / sizeof(OutputType)) : 1
+      >
+{};
+
+
+template<int NumLanes, typename Source, typename Size, typename OutputType, typename BinaryFunction>
+  OutputType reduce_lanes(Source src, Size n, OutputType init, BinaryFunction binary_op, thrust::detail::false_type)
+{
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
+
+  for(Size i = 0; i < n; ++i)
+  {
+    init = wrapped_binary_op(init, src[i]);
+  }
+
+  return init;
+}
+
+
+template<int NumLanes, typename Source, typename Size, typename OutputType, typename BinaryFunction>
+  OutputType reduce_lanes(Source src, Size n, OutputType init, BinaryFunction binary_op, thrust::detail::true_type)
+{
+  if(n < 2 * NumLanes)
+  {
+    return lane_reduce_detail::reduce_lanes<1>(src, n, init, binary_op, thrust::detail::false_type());
+  }
+
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
+
+  OutputType lanes[NumLanes];
+
+  for(int j = 0; j < NumLanes; ++j)
+  {
+    lanes[j] = src[j];
+  }
+
+  const Size num_full = n - n % NumLanes;
+
+  for(Size i = NumLanes; i < num_full; i += NumLanes)
+  {
+    for(int j = 0; j < NumLanes; ++j)
+    {
+      lanes[j] = wrapped_binary_op(lanes[j], src[i + j]);
+    }
+  }
+
+  for(int width = NumLanes / 2; width > 0; width /= 2)
+  {
+    for(int j = 0; j < width; ++j)
+    {
+      lanes[j] = wrapped_binary_op(lanes[j], lanes[j + width]);
+    }
+  }
+
+  init = wrapped_binary_op(init, lanes[0]);
+
+  for(Size i = num_full; i < n; ++i)
+  {
+    init = wrapped_binary_op(init, src[i]);
+  }
+
+  return init;
+}
+
+
+template<typename InputIterator, typename Size, typename OutputType, typename BinaryFunction>
+  OutputType reduce_n(InputIterator first, Size n, OutputType init, BinaryFunction binary_op, thrust::detail::true_type /* is source */)
+{
+  const int lanes = num_lanes<OutputType,BinaryFunction>::value;
+
+  typename source<InputIterator>::type src(first);
+
+  return lane_reduce_detail::reduce_lanes<lanes>(src, n, init, binary_op, thrust::detail::integral_constant<bool, (lanes > 1)>());
+}
+
+
+template<typename InputIterator, typename Size, typename OutputType, typename BinaryFunction>
+  OutputType reduce_n(InputIterator first, Size n, OutputType init, BinaryFunction binary_op, thrust::detail::false_type /* is source */)
+{
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
+
+  for(; n > 0; --n, ++first)
+  {
+    init = wrapped_binary_op(init, *first);
+  }
+
+  return init;
+}
+
+
+template<typename InputIterator, typename OutputType>
+  struct is_source
+    : thrust::detail::integral_constant<
+        bool,
+        source<InputIterator>::value &&
+        thrust::detail::is_arithmetic<typename thrust::iterator_value<InputIterator>::type>::value &&
+        thrust::detail::is_arithmetic<OutputType>::value
+      >
+{};
+
+
+} // end lane_reduce_detail
+
+
+// returns init reduced with the n elements beginning at first, in order
+// unless reassociation is allowed as described above
+template<typename InputIterator, typename Size, typename OutputType, typename BinaryFunction>
+  OutputType lane_reduce_n(InputIterator first, Size n, OutputType init, BinaryFunction binary_op)
+{
+  return lane_reduce_detail::reduce_n(first, n, init, binary_op, lane_reduce_detail::is_source<InputIterator,OutputType>());
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
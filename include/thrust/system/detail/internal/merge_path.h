@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/pair.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+  // Returns the number of elements contributed by [first1, first1 + n1) to the
+  // first diag elements of the stable merge of [first1, first1 + n1) and
+  // [first2, first2 + n2). The remaining diag - result elements come from the
+  // second range. Ties are resolved in favor of the first range.
+  template <typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size,
+            typename StrictWeakOrdering>
+    __host__ __device__
+    Size merge_path(RandomAccessIterator1 first1, Size n1,
+                    RandomAccessIterator2 first2, Size n2,
+                    Size diag,
+                    StrictWeakOrdering comp)
+    {
+      thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+      Size lo = (diag > n2) ? diag - n2 : Size(0);
+      Size hi = (diag < n1) ? diag      : n1;
+
+      while (lo < hi)
+      {
+        Size mid = lo + (hi - lo) / 2;
+
+        if (wrapped_comp(first2[diag - 1 - mid], first1[mid]))
+        {
+          hi = mid;
+        }
+        else
+        {
+          lo = mid + 1;
+        }
+      }
+
+      return lo;
+    }
+
+
+  // Returns the number of elements of the sorted range [first, first + n)
+  // which are less than *value. The search works on indices, so that no
+  // iterator is copy-assigned; the set operations by key pass zipped
+  // iterators whose constant_iterators do not support it cleanly.
+  template <typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size,
+            typename StrictWeakOrdering>
+    __host__ __device__
+    Size lower_bound_index(RandomAccessIterator1 first, Size n,
+                           RandomAccessIterator2 value,
+                           StrictWeakOrdering comp)
+    {
+      Size lo = 0;
+      Size hi = n;
+
+      while (lo < hi)
+      {
+        Size mid = lo + (hi - lo) / 2;
+
+        if (comp(first[mid], *value))
+        {
+          lo = mid + 1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+
+      return lo;
+    }
+
+
+  // Like merge_path, but moves the split back to the first element of both
+  // ranges that is equivalent to the element following the split in the
+  // merged order. All the elements of a run of equivalent keys then fall on
+  // the same side of the split, which is what the set operations need to
+  // pair up duplicates the way their sequential versions do. The result is
+  // the split position in each range.
+  template <typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size,
+            typename StrictWeakOrdering>
+    __host__ __device__
+    thrust::pair<Size,Size>
+      key_aligned_merge_path(RandomAccessIterator1 first1, Size n1,
+                             RandomAccessIterator2 first2, Size n2,
+                             Size diag,
+                             StrictWeakOrdering comp)
+    {
+      Size i = merge_path(first1, n1, first2, n2, diag, comp);
+      Size j = diag - i;
+
+      if (i < n1 && (j == n2 || !comp(first2[j], first1[i])))
+      {
+        // the next element is first1[i]
+        j = lower_bound_index(first2, j, first1 + i, comp);
+        i = lower_bound_index(first1, i, first1 + i, comp);
+      }
+      else if (j < n2)
+      {
+        // the next element is first2[j]
+        i = lower_bound_index(first1, i, first2 + j, comp);
+        j = lower_bound_index(first2, j, first2 + j, comp);
+      }
+
+      return thrust::make_pair(i, j);
+    }
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
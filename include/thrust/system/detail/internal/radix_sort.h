@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/stable_radix_sort.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+  // The building blocks of a tiled LSD radix sort. A backend sorts one digit
+  // per pass: every tile counts its digits with radix_histogram, the counts of
+  // all tiles are turned into output offsets with radix_scan_histograms, and
+  // every tile scatters its elements with radix_scatter. Tiles are processed
+  // independently in the first and last step, which is where the parallelism
+  // comes from.
+
+  template <typename KeyType, typename Compare>
+    struct use_radix_sort
+      : thrust::detail::and_<
+          thrust::detail::is_arithmetic<KeyType>,
+          thrust::detail::not_<thrust::detail::is_same<KeyType, bool> >,
+          thrust::detail::or_<
+            thrust::detail::is_same<Compare, thrust::less<KeyType> >,
+            thrust::detail::is_same<Compare, thrust::greater<KeyType> >
+          >
+        >
+  {};
+
+
+  // extracts the pass'th 8-bit digit of a key's radix encoding
+  // sorting in descending order is handled by complementing the encoding
+  template <typename KeyType, typename Compare>
+    struct radix_digit
+  {
+    typedef thrust::system::detail::sequential::radix_sort_detail::RadixEncoder<KeyType> Encoder;
+    typedef typename Encoder::result_type                                                 EncodedType;
+
+    static const unsigned int radix_bits  = 8;
+    static const unsigned int num_buckets = 1 << radix_bits;
+    static const unsigned int num_passes  = sizeof(EncodedType);
+
+    Encoder     encode;
+    EncodedType complement;
+    EncodedType shift;
+
+    radix_digit(unsigned int pass)
+      : encode(),
+        complement(thrust::detail::is_same<Compare, thrust::greater<KeyType> >::value ? static_cast<EncodedType>(~EncodedType(0)) : EncodedType(0)),
+        shift(static_cast<EncodedType>(radix_bits * pass))
+    {}
+
+    inline size_t operator()(KeyType key) const
+    {
+      const EncodedType x = static_cast<EncodedType>(encode(key)) ^ complement;
+
+      return static_cast<size_t>((x >> shift) & static_cast<EncodedType>(num_buckets - 1));
+    }
+  };
+
+
+  // counts the digits of the tile [begin, end) into histogram[0, num_buckets)
+  template <typename Digit, typename RandomAccessIterator, typename Size>
+    void radix_histogram(Digit digit,
+                         RandomAccessIterator keys,
+                         Size begin,
+                         Size end,
+                         size_t *histogram)
+  {
+    for (unsigned int b = 0; b < Digit::num_buckets; ++b)
+    {
+      histogram[b] = 0;
+    }
+
+    for (Size i = begin; i < end; ++i)
+    {
+      ++histogram[digit(keys[i])];
+    }
+  }
+
+
+  // replaces the num_tiles tile-major histograms with the position at which
+  // each tile writes its first element of each bucket
+  // returns false if all n keys share the same digit, in which case the pass
+  // would not move anything and may be skipped
+  template <typename Digit, typename Size>
+    bool radix_scan_histograms(size_t *histograms, Size num_tiles, size_t n)
+  {
+    size_t sum = 0;
+
+    for (unsigned int b = 0; b < Digit::num_buckets; ++b)
+    {
+      size_t bucket_size = 0;
+
+      for (Size t = 0; t < num_tiles; ++t)
+      {
+        size_t count = histograms[t * Digit::num_buckets + b];
+        histograms[t * Digit::num_buckets + b] = sum;
+        sum += count;
+        bucket_size += count;
+      }
+
+      if (bucket_size == n)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+
+  // stably scatters the tile [begin, end) to the positions given by offsets
+  template <typename Digit,
+            typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename Size>
+    void radix_scatter(Digit digit,
+                       RandomAccessIterator1 keys_src,
+                       Size begin,
+                       Size end,
+                       RandomAccessIterator2 keys_dst,
+                       size_t *offsets)
+  {
+    for (Size i = begin; i < end; ++i)
+    {
+      keys_dst[offsets[digit(keys_src[i])]++] = keys_src[i];
+    }
+  }
+
+
+  template <typename Digit,
+            typename RandomAccessIterator1,
+            typename RandomAccessIterator2,
+            typename RandomAccessIterator3,
+            typename RandomAccessIterator4,
+            typename Size>
+    void radix_scatter(Digit digit,
+                       RandomAccessIterator1 keys_src,
+                       RandomAccessIterator2 values_src,
+                       Size begin,
+                       Size end,
+                       RandomAccessIterator3 keys_dst,
+                       RandomAccessIterator4 values_dst,
+                       size_t *offsets)
+  {
+    for (Size i = begin; i < end; ++i)
+    {
+      const size_t j = offsets[digit(keys_src[i])]++;
+
+      keys_dst[j]   = keys_src[i];
+      values_dst[j] = values_src[i];
+    }
+  }
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+  // The building blocks of a tiled segmented scan. A backend computes a
+  // scan_by_key in three steps:
+  //   1. every tile reduces its last segment with reduce_last_segment
+  //   2. the partial sums are chained across tile boundaries with
+  //      propagate_segment_carries
+  //   3. every tile scans its elements, seeding its first segment with the
+  //      carry of the previous tiles when that segment began before the tile
+  // Steps 1 and 3 are independent for each tile.
+
+
+  // Reduces the values of the last segment of the tile [begin, end) into sum,
+  // walking backwards from the end of the tile. Returns the index at which
+  // that segment begins within the tile; a result greater than begin means
+  // the tile contains the head of a segment other than its first element.
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename Size,
+            typename ValueType,
+            typename BinaryPredicate,
+            typename BinaryFunction>
+    Size reduce_last_segment(InputIterator1 keys,
+                             InputIterator2 values,
+                             Size begin,
+                             Size end,
+                             ValueType &sum,
+                             BinaryPredicate binary_pred,
+                             BinaryFunction binary_op)
+  {
+    Size i = end - 1;
+
+    sum = values[i];
+
+    for (; i > begin && binary_pred(keys[i - 1], keys[i]); --i)
+    {
+      sum = binary_op(ValueType(values[i - 1]), sum);
+    }
+
+    return i;
+  }
+
+
+  // Computes carries[t], the reduction of the values that precede tile t in
+  // the segment tile t begins with. carries[t] is only written if
+  // continues[t] is true, i.e. if the segment began before tile t.
+  template <typename ValueType,
+            typename Size,
+            typename BinaryFunction>
+    void propagate_segment_carries(const ValueType *sums,
+                                   const bool *has_head,
+                                   const bool *continues,
+                                   ValueType *carries,
+                                   Size num_tiles,
+                                   BinaryFunction binary_op)
+  {
+    for (Size t = 1; t < num_tiles; ++t)
+    {
+      if (!continues[t])
+      {
+        continue;
+      }
+
+      if (continues[t - 1] && !has_head[t - 1])
+      {
+        // tile t - 1 lies entirely inside the segment
+        carries[t] = binary_op(carries[t - 1], sums[t - 1]);
+      }
+      else
+      {
+        carries[t] = sums[t - 1];
+      }
+    }
+  }
+
+
+  // carry points to the carry of the tile's first segment, or is null if
+  // that segment begins at begin
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename Size,
+            typename ValueType,
+            typename BinaryPredicate,
+            typename BinaryFunction>
+    void inclusive_scan_by_key_tile(InputIterator1 keys,
+                                    InputIterator2 values,
+                                    OutputIterator result,
+                                    Size begin,
+                                    Size end,
+                                    const ValueType *carry,
+                                    BinaryPredicate binary_pred,
+                                    BinaryFunction binary_op)
+  {
+    typedef typename thrust::iterator_traits<InputIterator1>::value_type KeyType;
+
+    KeyType   prev_key   = keys[begin];
+    ValueType prev_value = values[begin];
+
+    if (carry)
+    {
+      prev_value = binary_op(*carry, prev_value);
+    }
+
+    result[begin] = prev_value;
+
+    for (Size i = begin + 1; i < end; ++i)
+    {
+      KeyType key = keys[i];
+
+      if (binary_pred(prev_key, key))
+        result[i] = prev_value = binary_op(prev_value, values[i]);
+      else
+        result[i] = prev_value = values[i];
+
+      prev_key = key;
+    }
+  }
+
+
+  // carry points to the carry of the tile's first segment, or is null if
+  // that segment begins at begin
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename Size,
+            typename ValueType,
+            typename BinaryPredicate,
+            typename BinaryFunction>
+    void exclusive_scan_by_key_tile(InputIterator1 keys,
+                                    InputIterator2 values,
+                                    OutputIterator result,
+                                    Size begin,
+                                    Size end,
+                                    const ValueType *carry,
+                                    ValueType init,
+                                    BinaryPredicate binary_pred,
+                                    BinaryFunction binary_op)
+  {
+    typedef typename thrust::iterator_traits<InputIterator1>::value_type KeyType;
+
+    KeyType   prev_key   = keys[begin];
+    ValueType temp_value = values[begin]; // use temp to permit in-place scans
+    ValueType next       = carry ? binary_op(init, *carry) : init;
+
+    result[begin] = next;
+    next = binary_op(next, temp_value);
+
+    for (Size i = begin + 1; i < end; ++i)
+    {
+      KeyType key = keys[i];
+
+      temp_value = values[i];
+
+      if (!binary_pred(prev_key, key))
+        next = init; // reset sum
+
+      result[i] = next;
+      next = binary_op(next, temp_value);
+
+      prev_key = key;
+    }
+  }
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/execute_with_allocator.h>
+#include <thrust/detail/type_traits.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+#  include <thrust/detail/execute_with_dependencies.h>
+#endif
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// the sequential policy used by parallel algorithms for the work they run on
+// the calling thread, e.g. the serial path taken for small inputs
+// when the parallel policy carries an allocator, e.g. omp::par(alloc), the
+// sequential policy allocates its temporary storage through the same allocator
+template<typename DerivedPolicy>
+struct serial_policy_type
+{
+  typedef thrust::detail::seq_t type;
+
+  static type make(DerivedPolicy &)
+  {
+    return type();
+  }
+};
+
+template<typename Allocator, template<typename> class BaseSystem>
+struct serial_policy_type<thrust::detail::execute_with_allocator<Allocator, BaseSystem> >
+{
+  typedef typename thrust::detail::remove_reference<Allocator>::type allocator_type;
+
+  typedef typename thrust::detail::seq_t::template execute_with_allocator_type<
+    allocator_type&
+  >::type type;
+
+  static type make(thrust::detail::execute_with_allocator<Allocator, BaseSystem> &exec)
+  {
+    return type(exec.get_allocator());
+  }
+};
+
+#if THRUST_CPP_DIALECT >= 2011
+template<typename Allocator, template<typename> class BaseSystem, typename... Dependencies>
+struct serial_policy_type<thrust::detail::execute_with_allocator_and_dependencies<Allocator, BaseSystem, Dependencies...> >
+{
+  typedef typename thrust::detail::remove_reference<Allocator>::type allocator_type;
+
+  typedef typename thrust::detail::seq_t::template execute_with_allocator_type<
+    allocator_type&
+  >::type type;
+
+  static type make(thrust::detail::execute_with_allocator_and_dependencies<Allocator, BaseSystem, Dependencies...> &exec)
+  {
+    return type(exec.get_allocator());
+  }
+};
+#endif
+
+// the temporary storage of the sequential algorithm is requested from the
+// calling thread only, so the allocator need not be safe to use concurrently
+template<typename DerivedPolicy>
+typename serial_policy_type<DerivedPolicy>::type
+serial_policy(thrust::execution_policy<DerivedPolicy> &exec)
+{
+  return serial_policy_type<DerivedPolicy>::make(thrust::detail::derived_cast(exec));
+}
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
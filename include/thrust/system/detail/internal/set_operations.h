@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/seq.h>
+#include <thrust/system/detail/sequential/set_operations.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+  // Function objects that apply a sequential set operation to one partition
+  // of the inputs. Parallel backends use them to first count and then write
+  // the output of each partition.
+
+  struct serial_set_difference
+  {
+    template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+      OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp) const
+    {
+      thrust::detail::seq_t exec;
+      return thrust::system::detail::sequential::set_difference(exec, first1, last1, first2, last2, result, comp);
+    }
+  };
+
+
+  struct serial_set_intersection
+  {
+    template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+      OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp) const
+    {
+      thrust::detail::seq_t exec;
+      return thrust::system::detail::sequential::set_intersection(exec, first1, last1, first2, last2, result, comp);
+    }
+  };
+
+
+  struct serial_set_symmetric_difference
+  {
+    template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+      OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp) const
+    {
+      thrust::detail::seq_t exec;
+      return thrust::system::detail::sequential::set_symmetric_difference(exec, first1, last1, first2, last2, result, comp);
+    }
+  };
+
+
+  struct serial_set_union
+  {
+    template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename StrictWeakOrdering>
+      OutputIterator operator()(InputIterator1 first1, InputIterator1 last1,
+                                InputIterator2 first2, InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp) const
+    {
+      thrust::detail::seq_t exec;
+      return thrust::system::detail::sequential::set_union(exec, first1, last1, first2, last2, result, comp);
+    }
+  };
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/sequential/stable_merge_sort.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// stably sorts one tile of a parallel merge sort on the calling thread
+// the scratch space is a slice of a buffer the parallel algorithm allocated
+// through its policy beforehand, so no tile sort calls an allocator; buffer
+// must hold at least half as many elements as [first, last)
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void sort_tile(RandomAccessIterator1 first,
+               RandomAccessIterator1 last,
+               RandomAccessIterator2 buffer,
+               StrictWeakOrdering comp)
+{
+  thrust::system::detail::sequential::stable_merge_sort_detail::recursive_stable_merge_sort(first, last, buffer, comp);
+}
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename StrictWeakOrdering>
+void sort_tile_by_key(RandomAccessIterator1 keys_first,
+                      RandomAccessIterator1 keys_last,
+                      RandomAccessIterator2 values_first,
+                      RandomAccessIterator3 keys_buffer,
+                      RandomAccessIterator4 values_buffer,
+                      StrictWeakOrdering comp)
+{
+  thrust::system::detail::sequential::stable_merge_sort_detail::recursive_stable_merge_sort_by_key(keys_first, keys_last, values_first, keys_buffer, values_buffer, comp);
+}
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// each search finds the first element of the haystack which doesn't precede
+// the needle, and derives its result from that position
+
+// lower_bound: the first element not less than the needle
+template<typename Size>
+  struct lower_bound_search
+{
+  typedef Size result_type;
+
+  template<typename T1, typename T2, typename StrictWeakOrdering>
+  __host__ __device__
+  static bool precedes(const T1 &element, const T2 &needle, StrictWeakOrdering &comp)
+  {
+    return comp(element, needle);
+  }
+
+  template<typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
+  __host__ __device__
+  static result_type result(RandomAccessIterator, Size, Size bound, const T &, StrictWeakOrdering &)
+  {
+    return bound;
+  }
+};
+
+
+// upper_bound: the first element greater than the needle
+template<typename Size>
+  struct upper_bound_search
+{
+  typedef Size result_type;
+
+  template<typename T1, typename T2, typename StrictWeakOrdering>
+  __host__ __device__
+  static bool precedes(const T1 &element, const T2 &needle, StrictWeakOrdering &comp)
+  {
+    return !comp(needle, element);
+  }
+
+  template<typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
+  __host__ __device__
+  static result_type result(RandomAccessIterator, Size, Size bound, const T &, StrictWeakOrdering &)
+  {
+    return bound;
+  }
+};
+
+
+// binary_search: whether the lower bound is equivalent to the needle
+template<typename Size>
+  struct binary_search_search
+{
+  typedef bool result_type;
+
+  template<typename T1, typename T2, typename StrictWeakOrdering>
+  __host__ __device__
+  static bool precedes(const T1 &element, const T2 &needle, StrictWeakOrdering &comp)
+  {
+    return comp(element, needle);
+  }
+
+  template<typename RandomAccessIterator, typename T, typename StrictWeakOrdering>
+  __host__ __device__
+  static result_type result(RandomAccessIterator first, Size n, Size bound, const T &needle, StrictWeakOrdering &comp)
+  {
+    return bound < n && !comp(needle, first[bound]);
+  }
+};
+
+
+// returns the first position in [lo, hi) whose element doesn't precede needle,
+// or hi, given that the elements of [lo, hi) are partitioned that way
+__thrust_exec_check_disable__
+template<typename Search, typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+__host__ __device__
+  Size partition_point(RandomAccessIterator first, Size lo, Size hi, const T &needle, StrictWeakOrdering &comp)
+{
+  while(lo < hi)
+  {
+    const Size mid = lo + (hi - lo) / 2;
+
+    if(Search::precedes(first[mid], needle, comp))
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+} // end partition_point()
+
+
+// like partition_point over [lo, n), but in time logarithmic in the distance
+// from lo to the result rather than in n - lo, by probing exponentially
+// growing steps away from lo first
+__thrust_exec_check_disable__
+template<typename Search, typename RandomAccessIterator, typename Size, typename T, typename StrictWeakOrdering>
+__host__ __device__
+  Size gallop(RandomAccessIterator first, Size lo, Size n, const T &needle, StrictWeakOrdering &comp)
+{
+  Size step = 1;
+  Size hi = lo;
+
+  while(hi < n && Search::precedes(first[hi], needle, comp))
+  {
+    lo = hi + 1;
+    hi = n - lo > step ? lo + step : n;
+    step *= 2;
+  }
+
+  return internal::partition_point<Search>(first, lo, hi, needle, comp);
+} // end gallop()
+
+
+// writes the result of searching the sorted haystack [first, first + n) for
+// each of the needles [needles_first, needles_first + m) to output.
+//
+// Sorted needles have non-decreasing positions, so a needle which doesn't
+// fall before its predecessor's position is searched for by galloping from
+// there: a sorted batch of needles costs O(m log(n / m)) comparisons rather
+// than O(m log n), and walks the haystack forward. The first needle which
+// falls before its predecessor switches the rest of its block to independent
+// binary searches, so unsorted needles cost one extra comparison each.
+__thrust_exec_check_disable__
+template<template<typename> class Search,
+         typename RandomAccessIterator1,
+         typename Size1,
+         typename RandomAccessIterator2,
+         typename Size2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void sorted_search(RandomAccessIterator1 first,
+                     Size1 n,
+                     RandomAccessIterator2 needles_first,
+                     Size2 m,
+                     RandomAccessIterator3 output,
+                     StrictWeakOrdering comp)
+{
+  typedef Search<Size1> search_type;
+
+  const Size2 block_size = 256;
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  for(Size2 block = 0; block < m; block += block_size)
+  {
+    const Size2 block_end = m - block < block_size ? m : block + block_size;
+
+    Size1 bound = 0;
+    bool sorted = true;
+
+    for(Size2 i = block; i < block_end; ++i)
+    {
+      const typename thrust::iterator_reference<RandomAccessIterator2>::type needle = needles_first[i];
+
+      if(i == block)
+      {
+        bound = internal::partition_point<search_type>(first, Size1(0), n, needle, wrapped_comp);
+      }
+      else if(sorted && (bound == 0 || search_type::precedes(first[bound - 1], needle, wrapped_comp)))
+      {
+        bound = internal::gallop<search_type>(first, bound, n, needle, wrapped_comp);
+      }
+      else
+      {
+        sorted = false;
+        bound = internal::partition_point<search_type>(first, Size1(0), n, needle, wrapped_comp);
+      }
+
+      output[i] = search_type::result(first, n, bound, needle, wrapped_comp);
+    }
+  }
+} // end sorted_search()
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/tuple.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/system/detail/internal/lane_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// maps an element to the tuple of every reduction's unary_op of it, so that
+// the reductions of transform_reduce_multi can run as one reduction of tuples
+template<typename... Reductions>
+  struct multi_transform
+{
+  typedef thrust::tuple<typename Reductions::value_type...> result_type;
+
+  // unary_op may have a non-const call operator
+  mutable thrust::tuple<Reductions...> reductions;
+
+  __host__ __device__
+  multi_transform(const thrust::tuple<Reductions...> &reductions)
+    : reductions(reductions)
+  {}
+
+  template<typename T>
+  __host__ __device__
+  result_type operator()(const T &x) const
+  {
+    return apply(x, thrust::make_index_sequence<sizeof...(Reductions)>());
+  }
+
+  template<typename T, std::size_t... Is>
+  __host__ __device__
+  result_type apply(const T &x, thrust::index_sequence<Is...>) const
+  {
+    return result_type(static_cast<typename Reductions::value_type>(thrust::get<Is>(reductions).unary_op(x))...);
+  }
+};
+
+
+// combines two tuples of results component-wise, each with its reduction's
+// binary_op
+template<typename... Reductions>
+  struct multi_combine
+{
+  typedef thrust::tuple<typename Reductions::value_type...> result_type;
+
+  mutable thrust::tuple<Reductions...> reductions;
+
+  __host__ __device__
+  multi_combine(const thrust::tuple<Reductions...> &reductions)
+    : reductions(reductions)
+  {}
+
+  __host__ __device__
+  result_type operator()(const result_type &x, const result_type &y) const
+  {
+    return apply(x, y, thrust::make_index_sequence<sizeof...(Reductions)>());
+  }
+
+  template<std::size_t... Is>
+  __host__ __device__
+  result_type apply(const result_type &x, const result_type &y, thrust::index_sequence<Is...>) const
+  {
+    return result_type(static_cast<typename Reductions::value_type>(thrust::get<Is>(reductions).binary_op(thrust::get<Is>(x), thrust::get<Is>(y)))...);
+  }
+};
+
+
+// the tuple of every reduction's init
+template<typename... Reductions>
+__host__ __device__
+  thrust::tuple<typename Reductions::value_type...>
+    multi_init(const Reductions&... reductions)
+{
+  return thrust::tuple<typename Reductions::value_type...>(reductions.init...);
+}
+
+
+namespace multi_reduce_detail
+{
+
+
+// a tile which every reduction reads in turn while it stays in the L1 cache
+const std::size_t tile_bytes = 1 << 14;
+
+
+template<typename RandomAccessIterator, typename Size, typename Result, typename Reductions, std::size_t... Is>
+  void reduce_tile(RandomAccessIterator first, Size n, Result &sums, Reductions &reductions, thrust::index_sequence<Is...>)
+{
+  // evaluates the reductions in order
+  int expand[] = {0, (
+    thrust::get<Is>(sums) = thrust::system::detail::internal::lane_reduce_n(
+      thrust::make_transform_iterator(first, thrust::get<Is>(reductions).unary_op),
+      n,
+      thrust::get<Is>(sums),
+      thrust::get<Is>(reductions).binary_op),
+    0)...};
+
+  (void) expand;
+}
+
+
+} // end multi_reduce_detail
+
+
+// returns the tuple of results of the reductions of transform of the n > 0
+// elements beginning at first, excluding their inits; every reduction reads
+// each tile in turn, so that the elements are read from memory once and each
+// reduction still runs in its own, vectorizable, loop
+template<typename RandomAccessIterator, typename Size, typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    multi_reduce_n(RandomAccessIterator first, Size n, const multi_transform<Reductions...> &transform)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  const Size tile_size = static_cast<Size>(multi_reduce_detail::tile_bytes / sizeof(value_type) > 0 ? multi_reduce_detail::tile_bytes / sizeof(value_type) : 1);
+
+  // the first element seeds every reduction, which therefore needs no identity
+  thrust::tuple<typename Reductions::value_type...> sums = transform(*first);
+
+  for(Size i = 1; i < n; i += tile_size)
+  {
+    const Size size = (n - i < tile_size) ? n - i : tile_size;
+
+    multi_reduce_detail::reduce_tile(first + i, size, sums, transform.reductions, thrust::make_index_sequence<sizeof...(Reductions)>());
+  }
+
+  return sums;
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -27,6 +27,7 @@
 #include <thrust/distance.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
+#include <thrust/system/detail/internal/sorted_search.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -151,6 +152,75 @@ bool binary_search(sequential::execution_policy<DerivedPolicy> &exec,
 }
 
 
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+OutputIterator lower_bound(sequential::execution_policy<DerivedPolicy> &,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  const typename thrust::iterator_difference<InputIterator>::type m = thrust::distance(values_first, values_last);
+
+  thrust::system::detail::internal::sorted_search<thrust::system::detail::internal::lower_bound_search>(first, thrust::distance(first, last), values_first, m, output, comp);
+
+  return output + m;
+}
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+OutputIterator upper_bound(sequential::execution_policy<DerivedPolicy> &,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  const typename thrust::iterator_difference<InputIterator>::type m = thrust::distance(values_first, values_last);
+
+  thrust::system::detail::internal::sorted_search<thrust::system::detail::internal::upper_bound_search>(first, thrust::distance(first, last), values_first, m, output, comp);
+
+  return output + m;
+}
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+OutputIterator binary_search(sequential::execution_policy<DerivedPolicy> &,
+                             ForwardIterator first,
+                             ForwardIterator last,
+                             InputIterator values_first,
+                             InputIterator values_last,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+  const typename thrust::iterator_difference<InputIterator>::type m = thrust::distance(values_first, values_last);
+
+  thrust::system::detail::internal::sorted_search<thrust::system::detail::internal::binary_search_search>(first, thrust::distance(first, last), values_first, m, output, comp);
+
+  return output + m;
+}
+
+
 } // end namespace sequential
 } // end namespace detail
 } // end namespace system
@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.h
+ *  \brief Sequential implementation of histogram algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/detail/internal/histogram.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+__host__ __device__
+  RandomAccessIterator histogram_even(sequential::execution_policy<DerivedPolicy> &,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  thrust::system::detail::internal::even_bin<T,Size> bin(num_bins, lower_level, upper_level);
+
+  thrust::system::detail::internal::count_bins(first, last, histogram, num_bins, bin);
+
+  return num_bins > 0 ? histogram + num_bins : histogram;
+} // end histogram_even()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename LevelIterator,
+         typename RandomAccessIterator>
+__host__ __device__
+  RandomAccessIterator histogram_range(sequential::execution_policy<DerivedPolicy> &,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  typedef typename thrust::iterator_difference<LevelIterator>::type Size;
+
+  const Size num_bins = thrust::distance(levels_first, levels_last) - 1;
+
+  thrust::system::detail::internal::range_bin<LevelIterator> bin(levels_first, num_bins);
+
+  thrust::system::detail::internal::count_bins(first, last, histogram, num_bins, bin);
+
+  return num_bins > 0 ? histogram + num_bins : histogram;
+} // end histogram_range()
+
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
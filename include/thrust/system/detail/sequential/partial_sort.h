@@ -0,0 +1,235 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file partial_sort.h
+ *  \brief Sequential implementations of selection and partial sort algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/internal_functional.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/detail/sequential/insertion_sort.h>
+#include <thrust/system/detail/sequential/partition.h>
+#include <thrust/system/detail/internal/heap.h>
+#include <thrust/sort.h>
+#include <thrust/tuple.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace partial_sort_detail
+{
+
+
+// swaps the median of *a, *b and *c into *result
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void move_median_to_first(RandomAccessIterator result,
+                            RandomAccessIterator a,
+                            RandomAccessIterator b,
+                            RandomAccessIterator c,
+                            StrictWeakOrdering comp)
+{
+  if(comp(*a, *b))
+  {
+    if(comp(*b, *c))      sequential::iter_swap(result, b);
+    else if(comp(*a, *c)) sequential::iter_swap(result, c);
+    else                  sequential::iter_swap(result, a);
+  }
+  else if(comp(*a, *c))   sequential::iter_swap(result, a);
+  else if(comp(*b, *c))   sequential::iter_swap(result, c);
+  else                    sequential::iter_swap(result, b);
+} // end move_median_to_first()
+
+
+// partitions [first, last) around the median of three of its elements, which
+// is left in *first; returns the beginning of the elements not less than it
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  RandomAccessIterator partition_around_median(RandomAccessIterator first,
+                                               RandomAccessIterator last,
+                                               StrictWeakOrdering comp)
+{
+  partial_sort_detail::move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+
+  RandomAccessIterator pivot = first;
+
+  // the pivot and the median-of-three guard both scans
+  ++first;
+  while(true)
+  {
+    while(comp(*first, *pivot)) ++first;
+
+    --last;
+    while(comp(*pivot, *last)) --last;
+
+    if(!(first < last)) return first;
+
+    sequential::iter_swap(first, last);
+    ++first;
+  }
+} // end partition_around_median()
+
+
+// introselect: quickselect on the side holding nth, falling back to heap
+// selection when the partitions keep coming out unbalanced
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator, typename StrictWeakOrdering>
+__host__ __device__
+  void introselect(RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+
+  Size depth_limit = 0;
+  for(Size n = last - first; n > 1; n /= 2)
+  {
+    depth_limit += 2;
+  }
+
+  while(last - first > 16)
+  {
+    if(depth_limit-- == 0)
+    {
+      thrust::system::detail::internal::heap_select(first, nth + 1, last, comp);
+
+      // the largest of the selected elements is the one which belongs at nth
+      sequential::iter_swap(first, nth);
+      return;
+    }
+
+    RandomAccessIterator cut = partial_sort_detail::partition_around_median(first, last, comp);
+
+    if(cut <= nth)
+    {
+      first = cut;
+    }
+    else
+    {
+      last = cut;
+    }
+  }
+
+  sequential::insertion_sort(first, last, comp);
+} // end introselect()
+
+
+} // end partial_sort_detail
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element(sequential::execution_policy<DerivedPolicy> &,
+                   RandomAccessIterator first,
+                   RandomAccessIterator nth,
+                   RandomAccessIterator last,
+                   StrictWeakOrdering comp)
+{
+  if(nth == last) return;
+
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  partial_sort_detail::introselect(first, nth, last, wrapped_comp);
+} // end nth_element()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void nth_element_by_key(sequential::execution_policy<DerivedPolicy> &,
+                          RandomAccessIterator1 keys_first,
+                          RandomAccessIterator1 keys_nth,
+                          RandomAccessIterator1 keys_last,
+                          RandomAccessIterator2 values_first,
+                          StrictWeakOrdering comp)
+{
+  if(keys_nth == keys_last) return;
+
+  thrust::detail::compare_first<StrictWeakOrdering> comp_first(comp);
+
+  partial_sort_detail::introselect(thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first)),
+                                   thrust::make_zip_iterator(thrust::make_tuple(keys_nth, values_first + (keys_nth - keys_first))),
+                                   thrust::make_zip_iterator(thrust::make_tuple(keys_last, values_first + (keys_last - keys_first))),
+                                   comp_first);
+} // end nth_element_by_key()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort(sequential::execution_policy<DerivedPolicy> &exec,
+                    RandomAccessIterator first,
+                    RandomAccessIterator middle,
+                    RandomAccessIterator last,
+                    StrictWeakOrdering comp)
+{
+  if(first == middle) return;
+
+  // select the last element of the sorted part, then sort the ones before it
+  sequential::nth_element(exec, first, middle - 1, last, comp);
+
+  thrust::sort(exec, first, middle - 1, comp);
+} // end partial_sort()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void partial_sort_by_key(sequential::execution_policy<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_middle,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           StrictWeakOrdering comp)
+{
+  if(keys_first == keys_middle) return;
+
+  sequential::nth_element_by_key(exec, keys_first, keys_middle - 1, keys_last, values_first, comp);
+
+  thrust::sort_by_key(exec, keys_first, keys_middle - 1, values_first, comp);
+} // end partial_sort_by_key()
+
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_reduce.h
+ *  \brief Sequential implementation of segmented_reduce.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/distance.h>
+#include <thrust/reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OffsetIterator,
+         typename OutputIterator,
+         typename T,
+         typename BinaryFunction>
+__host__ __device__
+  OutputIterator segmented_reduce(sequential::execution_policy<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<OffsetIterator>::type Size;
+
+  const Size num_segments = thrust::distance(offsets_first, offsets_last) - 1;
+
+  for(Size i = 0; i < num_segments; ++i, ++result)
+  {
+    *result = thrust::reduce(exec, first + offsets_first[i], first + offsets_first[i + 1], init, binary_op);
+  }
+
+  return result;
+} // end segmented_reduce()
+
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file segmented_sort.h
+ *  \brief Sequential implementations of segmented sort algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/distance.h>
+#include <thrust/sort.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename OffsetIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort(sequential::execution_policy<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<OffsetIterator>::type Size;
+
+  const Size num_segments = thrust::distance(offsets_first, offsets_last) - 1;
+
+  for(Size i = 0; i < num_segments; ++i)
+  {
+    thrust::sort(exec, first + offsets_first[i], first + offsets_first[i + 1], comp);
+  }
+} // end segmented_sort()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OffsetIterator,
+         typename StrictWeakOrdering>
+__host__ __device__
+  void segmented_sort_by_key(sequential::execution_policy<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<OffsetIterator>::type Size;
+
+  const Size num_segments = thrust::distance(offsets_first, offsets_last) - 1;
+
+  for(Size i = 0; i < num_segments; ++i)
+  {
+    thrust::sort_by_key(exec,
+                        keys_first + offsets_first[i], keys_first + offsets_first[i + 1],
+                        values_first + offsets_first[i],
+                        comp);
+  }
+} // end segmented_sort_by_key()
+
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -24,6 +24,8 @@
 #include <thrust/merge.h>
 #include <thrust/system/detail/sequential/insertion_sort.h>
 #include <thrust/detail/minmax.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_pointer_cast.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -36,54 +38,123 @@ namespace stable_merge_sort_detail
 {
 
 
-template<typename DerivedPolicy,
-         typename RandomAccessIterator,
+// merges the sorted runs [first, middle) and [middle, last) in place, using
+// buffer as scratch space for a copy of the left run
+// the output never overtakes the unread part of the right run, so the right
+// run can be merged where it already lies
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
          typename StrictWeakOrdering>
 __host__ __device__
-void inplace_merge(sequential::execution_policy<DerivedPolicy> &exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+void buffered_inplace_merge(RandomAccessIterator1 first,
+                            RandomAccessIterator1 middle,
+                            RandomAccessIterator1 last,
+                            RandomAccessIterator2 buffer,
+                            StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  // wrap comp
+  thrust::detail::wrapped_function<
+    StrictWeakOrdering,
+    bool
+  > wrapped_comp(comp);
+
+  RandomAccessIterator2 buffer_last = buffer;
+  for(RandomAccessIterator1 i = first; i != middle; ++i, ++buffer_last)
+  {
+    *buffer_last = *i;
+  }
+
+  RandomAccessIterator1 result = first;
 
-  thrust::detail::temporary_array<value_type, DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type, DerivedPolicy> b(exec, middle, last);
+  while(buffer != buffer_last && middle != last)
+  {
+    if(wrapped_comp(*middle, *buffer))
+    {
+      *result = *middle;
+      ++middle;
+    }
+    else
+    {
+      *result = *buffer;
+      ++buffer;
+    }
 
-  thrust::merge(exec, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+    ++result;
+  }
+
+  // whatever remains of the right run is already in place
+  for(; buffer != buffer_last; ++buffer, ++result)
+  {
+    *result = *buffer;
+  }
 }
 
 
-template<typename DerivedPolicy,
-         typename RandomAccessIterator1,
+__thrust_exec_check_disable__
+template<typename RandomAccessIterator1,
          typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
          typename StrictWeakOrdering>
 __host__ __device__
-void inplace_merge_by_key(sequential::execution_policy<DerivedPolicy> &exec,
-                          RandomAccessIterator1 first1,
-                          RandomAccessIterator1 middle1,
-                          RandomAccessIterator1 last1,
-                          RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+void buffered_inplace_merge_by_key(RandomAccessIterator1 first1,
+                                   RandomAccessIterator1 middle1,
+                                   RandomAccessIterator1 last1,
+                                   RandomAccessIterator2 first2,
+                                   RandomAccessIterator3 buffer1,
+                                   RandomAccessIterator4 buffer2,
+                                   StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
+  // wrap comp
+  thrust::detail::wrapped_function<
+    StrictWeakOrdering,
+    bool
+  > wrapped_comp(comp);
 
   RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1   - first1);
-
-  thrust::detail::temporary_array<value_type1, DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1, DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2, DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2, DerivedPolicy> rhs2(exec, middle2, last2);
-
-  thrust::merge_by_key(exec,
-                       lhs1.begin(), lhs1.end(),
-                       rhs1.begin(), rhs1.end(),
-                       lhs2.begin(), rhs2.begin(),
-                       first1, first2,
-                       comp);
+
+  RandomAccessIterator3 buffer1_last = buffer1;
+  RandomAccessIterator4 buffer2_last = buffer2;
+  for(RandomAccessIterator1 i = first1; i != middle1; ++i, ++buffer1_last)
+  {
+    *buffer1_last = *i;
+  }
+  for(RandomAccessIterator2 i = first2; i != middle2; ++i, ++buffer2_last)
+  {
+    *buffer2_last = *i;
+  }
+
+  RandomAccessIterator1 result1 = first1;
+  RandomAccessIterator2 result2 = first2;
+
+  while(buffer1 != buffer1_last && middle1 != last1)
+  {
+    if(wrapped_comp(*middle1, *buffer1))
+    {
+      *result1 = *middle1;
+      *result2 = *middle2;
+      ++middle1;
+      ++middle2;
+    }
+    else
+    {
+      *result1 = *buffer1;
+      *result2 = *buffer2;
+      ++buffer1;
+      ++buffer2;
+    }
+
+    ++result1;
+    ++result2;
+  }
+
+  // whatever remains of the right runs is already in place
+  for(; buffer1 != buffer1_last; ++buffer1, ++buffer2, ++result1, ++result2)
+  {
+    *result1 = *buffer1;
+    *result2 = *buffer2;
+  }
 }
 
 
@@ -312,6 +383,59 @@ void iterative_stable_merge_sort_by_key(sequential::execution_policy<DerivedPoli
 } // end iterative_stable_merge_sort()
 
 
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+__host__ __device__
+void recursive_stable_merge_sort(RandomAccessIterator1 first,
+                                 RandomAccessIterator1 last,
+                                 RandomAccessIterator2 buffer,
+                                 StrictWeakOrdering comp)
+{
+  if(last - first <= 32)
+  {
+    thrust::system::detail::sequential::insertion_sort(first, last, comp);
+  } // end if
+  else
+  {
+    RandomAccessIterator1 middle = first + (last - first) / 2;
+
+    stable_merge_sort_detail::recursive_stable_merge_sort(first, middle, buffer, comp);
+    stable_merge_sort_detail::recursive_stable_merge_sort(middle,  last, buffer, comp);
+    stable_merge_sort_detail::buffered_inplace_merge(first, middle, last, buffer, comp);
+  } // end else
+} // end recursive_stable_merge_sort()
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename StrictWeakOrdering>
+__host__ __device__
+void recursive_stable_merge_sort_by_key(RandomAccessIterator1 first1,
+                                        RandomAccessIterator1 last1,
+                                        RandomAccessIterator2 first2,
+                                        RandomAccessIterator3 buffer1,
+                                        RandomAccessIterator4 buffer2,
+                                        StrictWeakOrdering comp)
+{
+  if(last1 - first1 <= 32)
+  {
+    thrust::system::detail::sequential::insertion_sort_by_key(first1, last1, first2, comp);
+  } // end if
+  else
+  {
+    RandomAccessIterator1 middle1 = first1 + (last1 - first1) / 2;
+    RandomAccessIterator2 middle2 = first2 + (last1 - first1) / 2;
+
+    stable_merge_sort_detail::recursive_stable_merge_sort_by_key(first1, middle1, first2,  buffer1, buffer2, comp);
+    stable_merge_sort_detail::recursive_stable_merge_sort_by_key(middle1,  last1, middle2, buffer1, buffer2, comp);
+    stable_merge_sort_detail::buffered_inplace_merge_by_key(first1, middle1, last1, first2, buffer1, buffer2, comp);
+  } // end else
+} // end recursive_stable_merge_sort_by_key()
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
@@ -321,18 +445,20 @@ void recursive_stable_merge_sort(sequential::execution_policy<DerivedPolicy> &ex
                                  RandomAccessIterator last,
                                  StrictWeakOrdering comp)
 {
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
   if(last - first <= 32)
   {
     thrust::system::detail::sequential::insertion_sort(first, last, comp);
+    return;
   } // end if
-  else
-  {
-    RandomAccessIterator middle = first + (last - first) / 2;
 
-    stable_merge_sort_detail::recursive_stable_merge_sort(exec, first, middle, comp);
-    stable_merge_sort_detail::recursive_stable_merge_sort(exec, middle,  last, comp);
-    stable_merge_sort_detail::inplace_merge(exec, first, middle, last, comp);
-  } // end else
+  // no left run is longer than half the input, so a single scratch buffer of
+  // that size serves every merge of the sort
+  RandomAccessIterator middle = first + (last - first) / 2;
+  thrust::detail::temporary_array<value_type, DerivedPolicy> buffer(exec, first, middle);
+
+  stable_merge_sort_detail::recursive_stable_merge_sort(first, last, thrust::raw_pointer_cast(buffer.data()), comp);
 } // end recursive_stable_merge_sort()
 
 
@@ -347,19 +473,24 @@ void recursive_stable_merge_sort_by_key(sequential::execution_policy<DerivedPoli
                                         RandomAccessIterator2 first2,
                                         StrictWeakOrdering comp)
 {
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
+
   if(last1 - first1 <= 32)
   {
     thrust::system::detail::sequential::insertion_sort_by_key(first1, last1, first2, comp);
+    return;
   } // end if
-  else
-  {
-    RandomAccessIterator1 middle1 = first1 + (last1 - first1) / 2;
-    RandomAccessIterator2 middle2 = first2 + (last1 - first1) / 2;
 
-    stable_merge_sort_detail::recursive_stable_merge_sort_by_key(exec, first1, middle1, first2,  comp);
-    stable_merge_sort_detail::recursive_stable_merge_sort_by_key(exec, middle1,  last1, middle2, comp);
-    stable_merge_sort_detail::inplace_merge_by_key(exec, first1, middle1, last1, first2, comp);
-  } // end else
+  RandomAccessIterator1 middle1 = first1 + (last1 - first1) / 2;
+  RandomAccessIterator2 middle2 = first2 + (last1 - first1) / 2;
+  thrust::detail::temporary_array<value_type1, DerivedPolicy> buffer1(exec, first1, middle1);
+  thrust::detail::temporary_array<value_type2, DerivedPolicy> buffer2(exec, first2, middle2);
+
+  stable_merge_sort_detail::recursive_stable_merge_sort_by_key(first1, last1, first2,
+                                                       thrust::raw_pointer_cast(buffer1.data()),
+                                                       thrust::raw_pointer_cast(buffer2.data()),
+                                                       comp);
 } // end recursive_stable_merge_sort_by_key()
 
 
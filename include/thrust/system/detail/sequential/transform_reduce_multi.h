@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file transform_reduce_multi.h
+ *  \brief Sequential implementation of transform_reduce_multi.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/detail/internal/transform_reduce_multi.h>
+#include <thrust/tuple.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace transform_reduce_multi_detail
+{
+
+
+// the range is read once, each element feeding every reduction in order, so
+// that every result is the one transform_reduce gives; the tiled lane sweep
+// of the parallel systems would reassociate them
+__thrust_exec_check_disable__
+template<typename InputIterator, typename... Reductions>
+__host__ __device__
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(InputIterator first,
+           InputIterator last,
+           Reductions... reductions)
+{
+  thrust::tuple<Reductions...> reductions_tuple(reductions...);
+
+  thrust::system::detail::internal::multi_transform<Reductions...> transform(reductions_tuple);
+  thrust::system::detail::internal::multi_combine<Reductions...>   combine(reductions_tuple);
+
+  thrust::tuple<typename Reductions::value_type...> result = thrust::system::detail::internal::multi_init(reductions...);
+
+  for(; first != last; ++first)
+  {
+    result = combine(result, transform(*first));
+  }
+
+  return result;
+}
+
+
+} // end transform_reduce_multi_detail
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+__host__ __device__
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(sequential::execution_policy<DerivedPolicy> &,
+                           InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions)
+{
+  return transform_reduce_multi_detail::reduce(first, last, reductions...);
+} // end transform_reduce_multi()
+
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
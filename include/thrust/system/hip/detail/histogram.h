@@ -0,0 +1,432 @@
+/******************************************************************************
+ * Copyright (c) 2016, NVIDIA CORPORATION.  All rights reserved.
+ * Modifications Copyright (c) 2019, Advanced Micro Devices, Inc.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+#pragma once
+
+#if THRUST_DEVICE_COMPILER == THRUST_DEVICE_COMPILER_HIP
+#include <thrust/system/hip/config.h>
+
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/system/hip/detail/util.h>
+#include <thrust/system/hip/detail/par_to_seq.h>
+#include <thrust/system/hip/detail/copy.h>
+#include <thrust/system/hip/detail/transform.h>
+#include <thrust/system/detail/internal/histogram.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/functional.h>
+#include <thrust/distance.h>
+
+// rocprim include
+#include <rocprim/rocprim.hpp>
+
+#include <limits>
+
+THRUST_NAMESPACE_BEGIN
+
+// forward declare generic histogram_even and histogram_range
+// to circumvent circular dependency
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename RandomAccessIterator,
+          typename Size,
+          typename T>
+__host__ __device__
+RandomAccessIterator histogram_even(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                    InputIterator                                               first,
+                                    InputIterator                                               last,
+                                    RandomAccessIterator                                        histogram,
+                                    Size                                                        num_bins,
+                                    T                                                           lower_level,
+                                    T                                                           upper_level);
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename LevelIterator,
+          typename RandomAccessIterator>
+__host__ __device__
+RandomAccessIterator histogram_range(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                     InputIterator                                               first,
+                                     InputIterator                                               last,
+                                     LevelIterator                                               levels_first,
+                                     LevelIterator                                               levels_last,
+                                     RandomAccessIterator                                        histogram);
+
+namespace hip_rocprim
+{
+namespace __histogram
+{
+    // invokes rocprim::histogram_even for num_bins bins of equal width
+    template <typename T>
+    struct even_op
+    {
+        unsigned int num_levels;
+        T            lower_level;
+        T            upper_level;
+
+        template <typename InputIt, typename Counter>
+        hipError_t operator()(void*        temp_storage,
+                              size_t&      temp_storage_bytes,
+                              InputIt      samples,
+                              unsigned int size,
+                              Counter*     histogram,
+                              hipStream_t  stream,
+                              bool         debug_sync) const
+        {
+            return rocprim::histogram_even(temp_storage,
+                                           temp_storage_bytes,
+                                           samples,
+                                           size,
+                                           histogram,
+                                           num_levels,
+                                           lower_level,
+                                           upper_level,
+                                           stream,
+                                           debug_sync);
+        }
+    }; // struct even_op
+
+    // rocprim bins floating point samples itself
+    template <typename InputIt, typename T, bool = thrust::detail::is_integral<T>::value>
+    struct even_samples
+    {
+        typedef InputIt    iterator;
+        typedef even_op<T> op_type;
+
+        static iterator make_iterator(InputIt first, unsigned int, T, T)
+        {
+            return first;
+        }
+
+        static op_type make_op(unsigned int num_bins, T lower_level, T upper_level)
+        {
+            op_type op = {num_bins + 1, lower_level, upper_level};
+            return op;
+        }
+    }; // struct even_samples
+
+    // integer samples are binned by even_bin like on the other systems, whose
+    // arithmetic is exact over the whole range of T, and rocprim counts the
+    // bin indices into [0, num_bins), dropping the index num_bins of samples
+    // outside the levels. The levels are 64-bit so that rocprim's own
+    // arithmetic on the indices cannot overflow
+    template <typename InputIt, typename T>
+    struct even_samples<InputIt, T, true>
+    {
+        typedef thrust::system::detail::internal::even_bin<T, unsigned int> bin_type;
+        typedef thrust::transform_iterator<bin_type, InputIt, unsigned int> iterator;
+        typedef even_op<thrust::detail::uint64_t>                           op_type;
+
+        static iterator make_iterator(InputIt first, unsigned int num_bins, T lower_level, T upper_level)
+        {
+            return iterator(first, bin_type(num_bins, lower_level, upper_level));
+        }
+
+        static op_type make_op(unsigned int num_bins, T, T)
+        {
+            op_type op = {num_bins + 1, 0, num_bins};
+            return op;
+        }
+    }; // struct even_samples
+
+    // invokes rocprim::histogram_range for the bins delimited by levels
+    template <typename Level>
+    struct range_op
+    {
+        unsigned int num_levels;
+        Level*       levels;
+
+        template <typename InputIt, typename Counter>
+        hipError_t operator()(void*        temp_storage,
+                              size_t&      temp_storage_bytes,
+                              InputIt      samples,
+                              unsigned int size,
+                              Counter*     histogram,
+                              hipStream_t  stream,
+                              bool         debug_sync) const
+        {
+            return rocprim::histogram_range(temp_storage,
+                                            temp_storage_bytes,
+                                            samples,
+                                            size,
+                                            histogram,
+                                            num_levels,
+                                            levels,
+                                            stream,
+                                            debug_sync);
+        }
+    }; // struct range_op
+
+    // rocprim counts at most 2^32 - 1 samples per call, so larger inputs are
+    // counted in chunks whose histograms are accumulated. rocprim only counts
+    // into the integer types it can increment atomically, so every chunk is
+    // counted into unsigned int, which holds the count of any chunk, and
+    // converted to the value type of the output
+    template <typename Derived,
+              typename InputIt,
+              typename Size,
+              typename OutputIt,
+              typename HistogramOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    OutputIt histogram(execution_policy<Derived>& policy,
+                       InputIt                    first,
+                       Size                       num_items,
+                       OutputIt                   histogram,
+                       size_t                     num_bins,
+                       HistogramOp                histogram_op)
+    {
+        typedef typename iterator_traits<OutputIt>::value_type count_type;
+        typedef unsigned int                                   chunk_count_type;
+
+        const Size max_chunk_size = static_cast<Size>(std::numeric_limits<unsigned int>::max());
+        const bool chunked        = num_items > max_chunk_size;
+
+        size_t      temp_storage_bytes = 0;
+        hipStream_t stream             = hip_rocprim::stream(policy);
+        bool        debug_sync         = THRUST_HIP_DEBUG_SYNC_FLAG;
+
+        // Determine temporary device storage requirements.
+        hip_rocprim::throw_on_error(histogram_op(NULL,
+                                                 temp_storage_bytes,
+                                                 first,
+                                                 static_cast<unsigned int>(chunked ? max_chunk_size : num_items),
+                                                 reinterpret_cast<chunk_count_type*>(NULL),
+                                                 stream,
+                                                 debug_sync),
+                                    "histogram failed on 1st step");
+
+        // Allocate temporary storage, followed by the counts of the current
+        // chunk and, if chunked, those of the whole input.
+        const size_t chunk_counts_offset = (temp_storage_bytes + sizeof(chunk_count_type) - 1)
+                                           / sizeof(chunk_count_type) * sizeof(chunk_count_type);
+        const size_t counts_offset       = (chunk_counts_offset + num_bins * sizeof(chunk_count_type) + sizeof(count_type) - 1)
+                                           / sizeof(count_type) * sizeof(count_type);
+        const size_t storage_size        = chunked ? counts_offset + num_bins * sizeof(count_type)
+                                                   : chunk_counts_offset + num_bins * sizeof(chunk_count_type);
+
+        thrust::detail::temporary_array<thrust::detail::uint8_t, Derived>
+            tmp(policy, storage_size);
+        void *ptr = static_cast<void*>(tmp.data().get());
+
+        chunk_count_type* d_chunk_counts = reinterpret_cast<chunk_count_type*>(
+            reinterpret_cast<char*>(ptr) + chunk_counts_offset);
+        count_type* d_counts = reinterpret_cast<count_type*>(
+            reinterpret_cast<char*>(ptr) + counts_offset);
+
+        for(Size offset = 0; offset < num_items || offset == 0; offset += max_chunk_size)
+        {
+            const Size chunk_size = num_items - offset < max_chunk_size ? num_items - offset : max_chunk_size;
+
+            hip_rocprim::throw_on_error(histogram_op(ptr,
+                                                     temp_storage_bytes,
+                                                     first + offset,
+                                                     static_cast<unsigned int>(chunk_size),
+                                                     d_chunk_counts,
+                                                     stream,
+                                                     debug_sync),
+                                        "histogram failed on 2nd step");
+
+            if(!chunked)
+            {
+                return hip_rocprim::copy_n(policy, d_chunk_counts, num_bins, histogram);
+            }
+
+            if(offset == 0)
+            {
+                hip_rocprim::copy_n(policy, d_chunk_counts, num_bins, d_counts);
+            }
+            else
+            {
+                hip_rocprim::transform(policy,
+                                       d_counts,
+                                       d_counts + num_bins,
+                                       d_chunk_counts,
+                                       d_counts,
+                                       plus<count_type>());
+            }
+        }
+
+        return hip_rocprim::copy_n(policy, d_counts, num_bins, histogram);
+    }
+}
+
+//-------------------------
+// Thrust API entry points
+//-------------------------
+
+template <class Derived, class InputIt, class OutputIt, class Size, class T>
+THRUST_HIP_FUNCTION
+OutputIt histogram_even(execution_policy<Derived>& policy,
+                        InputIt                    first,
+                        InputIt                    last,
+                        OutputIt                   histogram,
+                        Size                       num_bins,
+                        T                          lower_level,
+                        T                          upper_level)
+{
+  struct workaround
+  {
+      __host__
+      static OutputIt par(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    last,
+                          OutputIt                   histogram,
+                          Size                       num_bins,
+                          T                          lower_level,
+                          T                          upper_level)
+      {
+      typedef typename iterator_traits<InputIt>::difference_type size_type;
+      typedef __histogram::even_samples<InputIt, T>              samples;
+      typedef typename samples::iterator                         sample_iterator;
+      typedef typename samples::op_type                          op_type;
+
+      #if __HCC__ && __HIP_DEVICE_COMPILE__
+      THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+          (__histogram::histogram<Derived, sample_iterator, size_type, OutputIt, op_type>)
+      );
+      #else
+      if(num_bins <= 0)
+          return histogram;
+
+      const unsigned int bins = static_cast<unsigned int>(num_bins);
+
+      return __histogram::histogram(policy,
+                                    samples::make_iterator(first, bins, lower_level, upper_level),
+                                    static_cast<size_type>(thrust::distance(first, last)),
+                                    histogram,
+                                    static_cast<size_t>(num_bins),
+                                    samples::make_op(bins, lower_level, upper_level));
+      #endif
+      }
+      __device__
+      static OutputIt seq(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    last,
+                          OutputIt                   histogram,
+                          Size                       num_bins,
+                          T                          lower_level,
+                          T                          upper_level)
+      {
+        return thrust::histogram_even(
+             cvt_to_seq(derived_cast(policy)),
+             first,
+             last,
+             histogram,
+             num_bins,
+             lower_level,
+             upper_level
+          );
+      }
+  };
+
+  #if __THRUST_HAS_HIPRT__
+    return workaround::par(policy, first, last, histogram, num_bins, lower_level, upper_level);
+  #else
+    return workaround::seq(policy, first, last, histogram, num_bins, lower_level, upper_level);
+  #endif
+}
+
+template <class Derived, class InputIt, class LevelIt, class OutputIt>
+THRUST_HIP_FUNCTION
+OutputIt histogram_range(execution_policy<Derived>& policy,
+                         InputIt                    first,
+                         InputIt                    last,
+                         LevelIt                    levels_first,
+                         LevelIt                    levels_last,
+                         OutputIt                   histogram)
+{
+  struct workaround
+  {
+      __host__
+      static OutputIt par(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    last,
+                          LevelIt                    levels_first,
+                          LevelIt                    levels_last,
+                          OutputIt                   histogram)
+      {
+      typedef typename iterator_traits<InputIt>::difference_type size_type;
+      typedef typename iterator_traits<LevelIt>::value_type      level_type;
+      typedef __histogram::range_op<level_type>                  op_type;
+
+      #if __HCC__ && __HIP_DEVICE_COMPILE__
+      THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+          (__histogram::histogram<Derived, InputIt, size_type, OutputIt, op_type>)
+      );
+      #else
+      const size_t num_levels = static_cast<size_t>(thrust::distance(levels_first, levels_last));
+
+      if(num_levels < 2)
+          return histogram;
+
+      // rocprim reads the levels through a raw pointer
+      thrust::detail::temporary_array<level_type, Derived>
+          levels(policy, levels_first, levels_last);
+
+      op_type op = {static_cast<unsigned int>(num_levels), levels.data().get()};
+
+      return __histogram::histogram(policy,
+                                    first,
+                                    static_cast<size_type>(thrust::distance(first, last)),
+                                    histogram,
+                                    num_levels - 1,
+                                    op);
+      #endif
+      }
+      __device__
+      static OutputIt seq(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    last,
+                          LevelIt                    levels_first,
+                          LevelIt                    levels_last,
+                          OutputIt                   histogram)
+      {
+        return thrust::histogram_range(
+             cvt_to_seq(derived_cast(policy)),
+             first,
+             last,
+             levels_first,
+             levels_last,
+             histogram
+          );
+      }
+  };
+
+  #if __THRUST_HAS_HIPRT__
+    return workaround::par(policy, first, last, levels_first, levels_last, histogram);
+  #else
+    return workaround::seq(policy, first, last, levels_first, levels_last, histogram);
+  #endif
+}
+
+} // namespace  hip_rocprim
+
+THRUST_NAMESPACE_END
+
+#include <thrust/histogram.h>
+
+#endif
@@ -0,0 +1,433 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *  Modifications Copyright© 2019 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_DEVICE_COMPILER == THRUST_DEVICE_COMPILER_HIP
+#include <thrust/system/hip/config.h>
+
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/hip/detail/util.h>
+#include <thrust/system/hip/detail/execution_policy.h>
+#include <thrust/system/hip/detail/par_to_seq.h>
+#include <thrust/system/hip/detail/histogram.h>
+#include <thrust/system/hip/detail/sort.h>
+#include <thrust/system/detail/generic/partial_sort.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/functional.h>
+#include <thrust/tuple.h>
+
+#include <cstring>
+
+THRUST_NAMESPACE_BEGIN
+
+// forward declare nth_element and nth_element_by_key to circumvent circular
+// dependency
+template <typename DerivedPolicy,
+          typename RandomAccessIterator,
+          typename StrictWeakOrdering>
+__host__ __device__
+void nth_element(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                 RandomAccessIterator                                        first,
+                 RandomAccessIterator                                        nth,
+                 RandomAccessIterator                                        last,
+                 StrictWeakOrdering                                          comp);
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+__host__ __device__
+void nth_element_by_key(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                        RandomAccessIterator1                                       keys_first,
+                        RandomAccessIterator1                                       keys_nth,
+                        RandomAccessIterator1                                       keys_last,
+                        RandomAccessIterator2                                       values_first,
+                        StrictWeakOrdering                                          comp);
+
+namespace hip_rocprim
+{
+namespace __partial_sort
+{
+    // the unsigned integer of each size
+    template <size_t Bytes> struct radix_bits_type;
+    template <> struct radix_bits_type<1> { typedef thrust::detail::uint8_t  type; };
+    template <> struct radix_bits_type<2> { typedef thrust::detail::uint16_t type; };
+    template <> struct radix_bits_type<4> { typedef thrust::detail::uint32_t type; };
+    template <> struct radix_bits_type<8> { typedef thrust::detail::uint64_t type; };
+
+    // maps keys to unsigned integers ordered as the keys are by less, or by
+    // greater when Descending
+    template <typename Key, bool Descending>
+    struct radix_key
+    {
+        typedef typename radix_bits_type<sizeof(Key)>::type bits_type;
+
+        __host__ __device__
+        static bits_type encode(Key key)
+        {
+            const bits_type sign_bit = bits_type(1) << (8 * sizeof(Key) - 1);
+
+            bits_type bits;
+            memcpy(&bits, &key, sizeof(Key));
+
+            if(thrust::detail::is_floating_point<Key>::value)
+            {
+                // negative values are ordered backwards
+                bits ^= (bits & sign_bit) ? bits_type(~bits_type(0)) : sign_bit;
+            }
+            else if(thrust::detail::is_signed<Key>::value)
+            {
+                bits ^= sign_bit;
+            }
+
+            return Descending ? bits_type(~bits) : bits;
+        }
+
+        __host__ __device__
+        static Key decode(bits_type bits)
+        {
+            const bits_type sign_bit = bits_type(1) << (8 * sizeof(Key) - 1);
+
+            if(Descending) bits = ~bits;
+
+            if(thrust::detail::is_floating_point<Key>::value)
+            {
+                bits ^= (bits & sign_bit) ? sign_bit : bits_type(~bits_type(0));
+            }
+            else if(thrust::detail::is_signed<Key>::value)
+            {
+                bits ^= sign_bit;
+            }
+
+            Key key;
+            memcpy(&key, &bits, sizeof(Key));
+            return key;
+        }
+    }; // struct radix_key
+
+    const unsigned int radix_bits = 8;
+    const unsigned int radix_size = 1 << radix_bits;
+
+    // maps a key to its digit at shift when its higher digits are prefix, and
+    // to radix_size otherwise
+    template <typename Key, bool Descending>
+    struct radix_digit
+    {
+        typedef radix_key<Key, Descending>         radix_key_type;
+        typedef typename radix_key_type::bits_type bits_type;
+
+        bits_type    prefix;
+        bits_type    mask;
+        unsigned int shift;
+
+        __host__ __device__
+        unsigned int operator()(Key key) const
+        {
+            const bits_type bits = radix_key_type::encode(key);
+
+            return (bits & mask) == prefix ? static_cast<unsigned int>((bits >> shift) & (radix_size - 1))
+                                           : radix_size;
+        }
+    }; // struct radix_digit
+
+    template <typename Key, typename CompareOp>
+    struct is_descending : thrust::detail::is_same<CompareOp, thrust::greater<Key> >
+    {};
+
+    // the keys radix_select handles: those rocprim radix sorts, which fit in
+    // 64 bits
+    template <typename Key, typename CompareOp>
+    struct can_use_radix_select
+        : thrust::detail::integral_constant<
+              bool,
+              __smart_sort::can_use_primitive_sort<Key, CompareOp>::value && sizeof(Key) <= 8>
+    {};
+
+    // returns the key of rank k in [first, first + n), found one digit at a
+    // time, from the highest: rocprim counts the digits of the keys which
+    // agree with the digits found so far, and the digit holding rank k is the
+    // next one. Every pass reads the keys and writes nothing but the counts
+    template <typename Derived, typename KeysIt, typename Size, typename CompareOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    typename iterator_value<KeysIt>::type
+    radix_select(execution_policy<Derived>& policy,
+                 KeysIt                     first,
+                 Size                       n,
+                 Size                       k,
+                 CompareOp)
+    {
+        typedef typename iterator_value<KeysIt>::type key_type;
+        typedef is_descending<key_type, CompareOp>    descending;
+        typedef radix_digit<key_type, descending::value> digit_type;
+        typedef typename digit_type::bits_type           bits_type;
+        typedef thrust::detail::uint64_t                 count_type;
+
+        typedef transform_iterator<digit_type, KeysIt, unsigned int> digit_iterator;
+
+        thrust::detail::temporary_array<count_type, Derived> d_counts(policy, radix_size);
+        count_type counts[radix_size];
+
+        const __histogram::even_op<thrust::detail::uint64_t> histogram_op = {radix_size + 1, 0, radix_size};
+
+        digit_type digit = {0, 0, 8 * sizeof(key_type)};
+        count_type rank  = static_cast<count_type>(k);
+
+        while(digit.shift != 0)
+        {
+            digit.shift -= radix_bits;
+
+            __histogram::histogram(policy,
+                                   digit_iterator(first, digit),
+                                   n,
+                                   d_counts.data().get(),
+                                   static_cast<size_t>(radix_size),
+                                   histogram_op);
+
+            hip_rocprim::throw_on_error(hip_rocprim::trivial_copy_from_device(counts,
+                                                                              d_counts.data().get(),
+                                                                              radix_size,
+                                                                              hip_rocprim::stream(policy)),
+                                        "radix_select: failed to copy the counts");
+
+            unsigned int d = 0;
+            for(; rank >= counts[d]; ++d)
+            {
+                rank -= counts[d];
+            }
+
+            digit.prefix |= static_cast<bits_type>(d) << digit.shift;
+            digit.mask   |= static_cast<bits_type>(radix_size - 1) << digit.shift;
+        }
+
+        return digit_type::radix_key_type::decode(digit.prefix);
+    }
+
+    template <typename Derived, typename KeysIt, typename CompareOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    typename thrust::detail::enable_if<
+        can_use_radix_select<typename iterator_value<KeysIt>::type, CompareOp>::value>::type
+    nth_element(execution_policy<Derived>& policy,
+                KeysIt                     first,
+                KeysIt                     nth,
+                KeysIt                     last,
+                CompareOp                  compare_op)
+    {
+        namespace partial_sort_detail = thrust::system::detail::generic::partial_sort_detail;
+
+        typedef typename iterator_value<KeysIt>::type      key_type;
+        typedef typename iterator_difference<KeysIt>::type size_type;
+
+        const size_type n = last - first;
+        const size_type k = nth - first;
+
+        if(k >= n) return;
+
+        if(n <= partial_sort_detail::sort_threshold)
+        {
+            hip_rocprim::sort(policy, first, last, compare_op);
+            return;
+        }
+
+        const key_type pivot = radix_select(policy, first, n, k, compare_op);
+
+        partial_sort_detail::partition_around_pivot(policy, first, last, k,
+                                       partial_sort_detail::less_than_pivot<key_type, CompareOp>(pivot, compare_op),
+                                       partial_sort_detail::not_greater_than_pivot<key_type, CompareOp>(pivot, compare_op));
+    }
+
+    template <typename Derived, typename KeysIt, typename CompareOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    typename thrust::detail::disable_if<
+        can_use_radix_select<typename iterator_value<KeysIt>::type, CompareOp>::value>::type
+    nth_element(execution_policy<Derived>& policy,
+                KeysIt                     first,
+                KeysIt                     nth,
+                KeysIt                     last,
+                CompareOp                  compare_op)
+    {
+        thrust::system::detail::generic::nth_element(policy, first, nth, last, compare_op);
+    }
+
+    template <typename Derived, typename KeysIt, typename ValuesIt, typename CompareOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    typename thrust::detail::enable_if<
+        can_use_radix_select<typename iterator_value<KeysIt>::type, CompareOp>::value>::type
+    nth_element_by_key(execution_policy<Derived>& policy,
+                       KeysIt                     keys_first,
+                       KeysIt                     keys_nth,
+                       KeysIt                     keys_last,
+                       ValuesIt                   values_first,
+                       CompareOp                  compare_op)
+    {
+        namespace partial_sort_detail = thrust::system::detail::generic::partial_sort_detail;
+
+        typedef typename iterator_value<KeysIt>::type      key_type;
+        typedef typename iterator_difference<KeysIt>::type size_type;
+
+        typedef partial_sort_detail::less_than_pivot<key_type, CompareOp>        less_than_pivot;
+        typedef partial_sort_detail::not_greater_than_pivot<key_type, CompareOp> not_greater_than_pivot;
+
+        const size_type n = keys_last - keys_first;
+        const size_type k = keys_nth - keys_first;
+
+        if(k >= n) return;
+
+        if(n <= partial_sort_detail::sort_threshold)
+        {
+            hip_rocprim::sort_by_key(policy, keys_first, keys_last, values_first, compare_op);
+            return;
+        }
+
+        const key_type pivot = radix_select(policy, keys_first, n, k, compare_op);
+
+        partial_sort_detail::partition_around_pivot(policy,
+                                       thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first)),
+                                       thrust::make_zip_iterator(thrust::make_tuple(keys_last, values_first + n)),
+                                       k,
+                                       partial_sort_detail::on_key<less_than_pivot>(less_than_pivot(pivot, compare_op)),
+                                       partial_sort_detail::on_key<not_greater_than_pivot>(not_greater_than_pivot(pivot, compare_op)));
+    }
+
+    template <typename Derived, typename KeysIt, typename ValuesIt, typename CompareOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    typename thrust::detail::disable_if<
+        can_use_radix_select<typename iterator_value<KeysIt>::type, CompareOp>::value>::type
+    nth_element_by_key(execution_policy<Derived>& policy,
+                       KeysIt                     keys_first,
+                       KeysIt                     keys_nth,
+                       KeysIt                     keys_last,
+                       ValuesIt                   values_first,
+                       CompareOp                  compare_op)
+    {
+        thrust::system::detail::generic::nth_element_by_key(policy, keys_first, keys_nth, keys_last, values_first, compare_op);
+    }
+} // namespace __partial_sort
+
+//-------------------------
+// Thrust API entry points
+//-------------------------
+
+// arithmetic keys ordered by less or greater are selected with rocprim
+// histograms of their radix digits; other keys take the generic sample
+// select. partial_sort and partial_sort_by_key are the generic ones, which
+// select with nth_element and sort the rest with rocprim
+__thrust_exec_check_disable__ template <class Derived, class KeysIt, class CompareOp>
+void THRUST_HIP_FUNCTION
+nth_element(execution_policy<Derived>& policy,
+            KeysIt                     first,
+            KeysIt                     nth,
+            KeysIt                     last,
+            CompareOp                  compare_op)
+{
+    // struct workaround is required for HIP-clang
+    // THRUST_HIP_PRESERVE_KERNELS_WORKAROUND is required for HCC
+    struct workaround
+    {
+        __host__
+        static void par(execution_policy<Derived>& policy,
+                        KeysIt                     first,
+                        KeysIt                     nth,
+                        KeysIt                     last,
+                        CompareOp                  compare_op)
+        {
+        #if __HCC__ && __HIP_DEVICE_COMPILE__
+        THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+            (__partial_sort::nth_element<Derived, KeysIt, CompareOp>)
+        );
+        #else
+        __partial_sort::nth_element(policy, first, nth, last, compare_op);
+        #endif
+        }
+        __device__
+        static void seq(execution_policy<Derived>& policy,
+                        KeysIt                     first,
+                        KeysIt                     nth,
+                        KeysIt                     last,
+                        CompareOp                  compare_op)
+        {
+            thrust::nth_element(cvt_to_seq(derived_cast(policy)), first, nth, last, compare_op);
+        }
+    };
+    #if __THRUST_HAS_HIPRT__
+    workaround::par(policy, first, nth, last, compare_op);
+    #else
+    workaround::seq(policy, first, nth, last, compare_op);
+    #endif
+}
+
+__thrust_exec_check_disable__ template <class Derived,
+                                        class KeysIt,
+                                        class ValuesIt,
+                                        class CompareOp>
+void THRUST_HIP_FUNCTION
+nth_element_by_key(execution_policy<Derived>& policy,
+                   KeysIt                     keys_first,
+                   KeysIt                     keys_nth,
+                   KeysIt                     keys_last,
+                   ValuesIt                   values_first,
+                   CompareOp                  compare_op)
+{
+    // struct workaround is required for HIP-clang
+    // THRUST_HIP_PRESERVE_KERNELS_WORKAROUND is required for HCC
+    struct workaround
+    {
+        __host__
+        static void par(execution_policy<Derived>& policy,
+                        KeysIt                     keys_first,
+                        KeysIt                     keys_nth,
+                        KeysIt                     keys_last,
+                        ValuesIt                   values_first,
+                        CompareOp                  compare_op)
+        {
+        #if __HCC__ && __HIP_DEVICE_COMPILE__
+        THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+            (__partial_sort::nth_element_by_key<Derived, KeysIt, ValuesIt, CompareOp>)
+        );
+        #else
+        __partial_sort::nth_element_by_key(policy, keys_first, keys_nth, keys_last, values_first, compare_op);
+        #endif
+        }
+        __device__
+        static void seq(execution_policy<Derived>& policy,
+                        KeysIt                     keys_first,
+                        KeysIt                     keys_nth,
+                        KeysIt                     keys_last,
+                        ValuesIt                   values_first,
+                        CompareOp                  compare_op)
+        {
+            thrust::nth_element_by_key(cvt_to_seq(derived_cast(policy)), keys_first, keys_nth, keys_last, values_first, compare_op);
+        }
+    };
+    #if __THRUST_HAS_HIPRT__
+    workaround::par(policy, keys_first, keys_nth, keys_last, values_first, compare_op);
+    #else
+    workaround::seq(policy, keys_first, keys_nth, keys_last, values_first, compare_op);
+    #endif
+}
+
+} // namespace hip_rocprim
+THRUST_NAMESPACE_END
+
+#include <thrust/partial_sort.h>
+
+#endif
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright (c) 2016, NVIDIA CORPORATION.  All rights reserved.
+ * Modifications Copyright (c) 2019, Advanced Micro Devices, Inc.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+#pragma once
+
+#if THRUST_DEVICE_COMPILER == THRUST_DEVICE_COMPILER_HIP
+#include <thrust/system/hip/config.h>
+
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/system/hip/detail/util.h>
+#include <thrust/system/hip/detail/par_to_seq.h>
+#include <thrust/distance.h>
+
+// rocprim include
+#include <rocprim/rocprim.hpp>
+
+THRUST_NAMESPACE_BEGIN
+
+// forward declare segmented_reduce
+// to circumvent circular dependency
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename OffsetIterator,
+          typename OutputIterator,
+          typename T,
+          typename BinaryFunction>
+__host__ __device__
+OutputIterator segmented_reduce(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                InputIterator                                               first,
+                                InputIterator                                               last,
+                                OffsetIterator                                              offsets_first,
+                                OffsetIterator                                              offsets_last,
+                                OutputIterator                                              result,
+                                T                                                           init,
+                                BinaryFunction                                              binary_op);
+
+namespace hip_rocprim
+{
+namespace __segmented_reduce
+{
+    template <typename Derived,
+              typename InputIt,
+              typename OffsetIt,
+              typename OutputIt,
+              typename T,
+              typename BinaryOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    void segmented_reduce(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          OffsetIt                   offsets_first,
+                          unsigned int               num_segments,
+                          OutputIt                   result,
+                          T                          init,
+                          BinaryOp                   binary_op)
+    {
+        size_t      temp_storage_bytes = 0;
+        hipStream_t stream             = hip_rocprim::stream(policy);
+        bool        debug_sync         = THRUST_HIP_DEBUG_SYNC_FLAG;
+
+        // Determine temporary device storage requirements.
+        hip_rocprim::throw_on_error(rocprim::segmented_reduce(NULL,
+                                                              temp_storage_bytes,
+                                                              first,
+                                                              result,
+                                                              num_segments,
+                                                              offsets_first,
+                                                              offsets_first + 1,
+                                                              binary_op,
+                                                              init,
+                                                              stream,
+                                                              debug_sync),
+                                    "segmented_reduce failed on 1st step");
+
+        // Allocate temporary storage.
+        thrust::detail::temporary_array<thrust::detail::uint8_t, Derived>
+            tmp(policy, temp_storage_bytes);
+        void *ptr = static_cast<void*>(tmp.data().get());
+
+        hip_rocprim::throw_on_error(rocprim::segmented_reduce(ptr,
+                                                              temp_storage_bytes,
+                                                              first,
+                                                              result,
+                                                              num_segments,
+                                                              offsets_first,
+                                                              offsets_first + 1,
+                                                              binary_op,
+                                                              init,
+                                                              stream,
+                                                              debug_sync),
+                                    "segmented_reduce failed on 2nd step");
+        hip_rocprim::throw_on_error(
+            hip_rocprim::synchronize_optional(policy),
+            "segmented_reduce: failed to synchronize"
+        );
+    }
+}
+
+//-------------------------
+// Thrust API entry points
+//-------------------------
+
+template <class Derived, class InputIt, class OffsetIt, class OutputIt, class T, class BinaryOp>
+THRUST_HIP_FUNCTION
+OutputIt segmented_reduce(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    last,
+                          OffsetIt                   offsets_first,
+                          OffsetIt                   offsets_last,
+                          OutputIt                   result,
+                          T                          init,
+                          BinaryOp                   binary_op)
+{
+
+  struct workaround
+  {
+      __host__
+      static OutputIt par(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    ,
+                          OffsetIt                   offsets_first,
+                          OffsetIt                   offsets_last,
+                          OutputIt                   result,
+                          T                          init,
+                          BinaryOp                   binary_op)
+      {
+      #if __HCC__ && __HIP_DEVICE_COMPILE__
+      THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+          (__segmented_reduce::segmented_reduce<Derived, InputIt, OffsetIt, OutputIt, T, BinaryOp>)
+      );
+      #else
+      const size_t num_offsets = static_cast<size_t>(thrust::distance(offsets_first, offsets_last));
+
+      if(num_offsets < 2)
+          return result;
+
+      __segmented_reduce::segmented_reduce(policy,
+                                           first,
+                                           offsets_first,
+                                           static_cast<unsigned int>(num_offsets - 1),
+                                           result,
+                                           init,
+                                           binary_op);
+
+      return result + (num_offsets - 1);
+      #endif
+      }
+      __device__
+      static OutputIt seq(execution_policy<Derived>& policy,
+                          InputIt                    first,
+                          InputIt                    last,
+                          OffsetIt                   offsets_first,
+                          OffsetIt                   offsets_last,
+                          OutputIt                   result,
+                          T                          init,
+                          BinaryOp                   binary_op)
+      {
+        return thrust::segmented_reduce(
+             cvt_to_seq(derived_cast(policy)),
+             first,
+             last,
+             offsets_first,
+             offsets_last,
+             result,
+             init,
+             binary_op
+          );
+      }
+  };
+
+  #if __THRUST_HAS_HIPRT__
+    return workaround::par(policy, first, last, offsets_first, offsets_last, result, init, binary_op);
+  #else
+    return workaround::seq(policy, first, last, offsets_first, offsets_last, result, init, binary_op);
+  #endif
+}
+
+} // namespace  hip_rocprim
+
+THRUST_NAMESPACE_END
+
+#include <thrust/segmented_reduce.h>
+
+#endif
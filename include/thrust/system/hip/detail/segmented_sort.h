@@ -0,0 +1,430 @@
+/******************************************************************************
+ * Copyright (c) 2016, NVIDIA CORPORATION.  All rights reserved.
+ * Modifications Copyright (c) 2019, Advanced Micro Devices, Inc.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+#pragma once
+
+#if THRUST_DEVICE_COMPILER == THRUST_DEVICE_COMPILER_HIP
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+
+#include <thrust/system/hip/detail/execution_policy.h>
+#include <thrust/system/hip/detail/par_to_seq.h>
+#include <thrust/system/hip/detail/sort.h>
+#include <thrust/system/hip/detail/util.h>
+#include <thrust/distance.h>
+
+// rocPRIM includes
+#include <rocprim/rocprim.hpp>
+
+THRUST_NAMESPACE_BEGIN
+
+// forward declare segmented_sort and segmented_sort_by_key
+// to circumvent circular dependency
+template <typename DerivedPolicy,
+          typename RandomAccessIterator,
+          typename OffsetIterator,
+          typename StrictWeakOrdering>
+__host__ __device__
+void segmented_sort(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                    RandomAccessIterator                                        first,
+                    RandomAccessIterator                                        last,
+                    OffsetIterator                                              offsets_first,
+                    OffsetIterator                                              offsets_last,
+                    StrictWeakOrdering                                          comp);
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename OffsetIterator,
+          typename StrictWeakOrdering>
+__host__ __device__
+void segmented_sort_by_key(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                           RandomAccessIterator1                                       keys_first,
+                           RandomAccessIterator1                                       keys_last,
+                           RandomAccessIterator2                                       values_first,
+                           OffsetIterator                                              offsets_first,
+                           OffsetIterator                                              offsets_last,
+                           StrictWeakOrdering                                          comp);
+
+namespace hip_rocprim
+{
+namespace __segmented_sort
+{
+    template <class SORT_ITEMS, class Comparator>
+    struct dispatch;
+
+    // sort keys in ascending order
+    template <class K>
+    struct dispatch<detail::false_type, thrust::less<K>>
+    {
+        template <class KeysIt, class ItemsIt, class OffsetIt>
+        static hipError_t THRUST_HIP_RUNTIME_FUNCTION
+        doit(void*        d_temp_storage,
+             size_t&      temp_storage_bytes,
+             K*           keys_input,
+             KeysIt       keys_output,
+             ItemsIt      /*items_input*/,
+             ItemsIt      /*items_output*/,
+             unsigned int count,
+             unsigned int segments,
+             OffsetIt     offsets,
+             hipStream_t  stream,
+             bool         debug_sync)
+        {
+            return rocprim::segmented_radix_sort_keys(d_temp_storage,
+                                                      temp_storage_bytes,
+                                                      keys_input,
+                                                      keys_output,
+                                                      count,
+                                                      segments,
+                                                      offsets,
+                                                      offsets + 1,
+                                                      0,
+                                                      sizeof(K) * 8,
+                                                      stream,
+                                                      debug_sync);
+        }
+    }; // struct dispatch -- sort keys in ascending order;
+
+    // sort keys in descending order
+    template <class K>
+    struct dispatch<detail::false_type, thrust::greater<K>>
+    {
+        template <class KeysIt, class ItemsIt, class OffsetIt>
+        static hipError_t THRUST_HIP_RUNTIME_FUNCTION
+        doit(void*        d_temp_storage,
+             size_t&      temp_storage_bytes,
+             K*           keys_input,
+             KeysIt       keys_output,
+             ItemsIt      /*items_input*/,
+             ItemsIt      /*items_output*/,
+             unsigned int count,
+             unsigned int segments,
+             OffsetIt     offsets,
+             hipStream_t  stream,
+             bool         debug_sync)
+        {
+            return rocprim::segmented_radix_sort_keys_desc(d_temp_storage,
+                                                           temp_storage_bytes,
+                                                           keys_input,
+                                                           keys_output,
+                                                           count,
+                                                           segments,
+                                                           offsets,
+                                                           offsets + 1,
+                                                           0,
+                                                           sizeof(K) * 8,
+                                                           stream,
+                                                           debug_sync);
+        }
+    }; // struct dispatch -- sort keys in descending order;
+
+    // sort pairs in ascending order
+    template <class K>
+    struct dispatch<detail::true_type, thrust::less<K>>
+    {
+        template <class KeysIt, class ItemsIt, class OffsetIt>
+        static hipError_t THRUST_HIP_RUNTIME_FUNCTION
+        doit(void*        d_temp_storage,
+             size_t&      temp_storage_bytes,
+             K*           keys_input,
+             KeysIt       keys_output,
+             ItemsIt      items_input,
+             ItemsIt      items_output,
+             unsigned int count,
+             unsigned int segments,
+             OffsetIt     offsets,
+             hipStream_t  stream,
+             bool         debug_sync)
+        {
+            return rocprim::segmented_radix_sort_pairs(d_temp_storage,
+                                                       temp_storage_bytes,
+                                                       keys_input,
+                                                       keys_output,
+                                                       items_input,
+                                                       items_output,
+                                                       count,
+                                                       segments,
+                                                       offsets,
+                                                       offsets + 1,
+                                                       0,
+                                                       sizeof(K) * 8,
+                                                       stream,
+                                                       debug_sync);
+        }
+    }; // struct dispatch -- sort pairs in ascending order;
+
+    // sort pairs in descending order
+    template <class K>
+    struct dispatch<detail::true_type, thrust::greater<K>>
+    {
+        template <class KeysIt, class ItemsIt, class OffsetIt>
+        static hipError_t THRUST_HIP_RUNTIME_FUNCTION
+        doit(void*        d_temp_storage,
+             size_t&      temp_storage_bytes,
+             K*           keys_input,
+             KeysIt       keys_output,
+             ItemsIt      items_input,
+             ItemsIt      items_output,
+             unsigned int count,
+             unsigned int segments,
+             OffsetIt     offsets,
+             hipStream_t  stream,
+             bool         debug_sync)
+        {
+            return rocprim::segmented_radix_sort_pairs_desc(d_temp_storage,
+                                                            temp_storage_bytes,
+                                                            keys_input,
+                                                            keys_output,
+                                                            items_input,
+                                                            items_output,
+                                                            count,
+                                                            segments,
+                                                            offsets,
+                                                            offsets + 1,
+                                                            0,
+                                                            sizeof(K) * 8,
+                                                            stream,
+                                                            debug_sync);
+        }
+    }; // struct dispatch -- sort pairs in descending order;
+
+    // rocprim sorts from one buffer into another, so the keys and values are
+    // first copied to temporary storage and sorted back into place
+    template <typename SORT_ITEMS,
+              typename Derived,
+              typename KeysIt,
+              typename ItemsIt,
+              typename OffsetIt,
+              typename CompareOp>
+    THRUST_HIP_RUNTIME_FUNCTION
+    void segmented_radix_sort(execution_policy<Derived>& policy,
+                              KeysIt                     keys_first,
+                              KeysIt                     keys_last,
+                              ItemsIt                    items_first,
+                              OffsetIt                   offsets_first,
+                              OffsetIt                   offsets_last,
+                              CompareOp )
+    {
+        typedef typename iterator_traits<KeysIt>::value_type  key_type;
+        typedef typename iterator_traits<ItemsIt>::value_type item_type;
+
+        const size_t count    = static_cast<size_t>(thrust::distance(keys_first, keys_last));
+        const size_t segments = static_cast<size_t>(thrust::distance(offsets_first, offsets_last));
+
+        if(count == 0 || segments < 2)
+            return;
+
+        size_t      storage_size = 0;
+        hipStream_t stream       = hip_rocprim::stream(policy);
+        bool        debug_sync   = THRUST_HIP_DEBUG_SYNC_FLAG;
+
+        hipError_t status;
+
+        status = dispatch<SORT_ITEMS, CompareOp>::doit(NULL,
+                                                       storage_size,
+                                                       static_cast<key_type*>(NULL),
+                                                       keys_first,
+                                                       items_first,
+                                                       items_first,
+                                                       static_cast<unsigned int>(count),
+                                                       static_cast<unsigned int>(segments - 1),
+                                                       offsets_first,
+                                                       stream,
+                                                       debug_sync);
+        hip_rocprim::throw_on_error(status, "segmented_sort: failed on 1st step");
+
+        // Allocate temporary storage.
+        thrust::detail::temporary_array<thrust::detail::uint8_t, Derived>
+            tmp(policy, storage_size);
+        void *ptr = static_cast<void*>(tmp.data().get());
+
+        thrust::detail::temporary_array<key_type, Derived>
+            keys(policy, keys_first, keys_last);
+
+        if(SORT_ITEMS::value)
+        {
+            thrust::detail::temporary_array<item_type, Derived>
+                items(policy, items_first, items_first + count);
+
+            status = dispatch<SORT_ITEMS, CompareOp>::doit(ptr,
+                                                           storage_size,
+                                                           keys.data().get(),
+                                                           keys_first,
+                                                           items.data().get(),
+                                                           items_first,
+                                                           static_cast<unsigned int>(count),
+                                                           static_cast<unsigned int>(segments - 1),
+                                                           offsets_first,
+                                                           stream,
+                                                           debug_sync);
+        }
+        else
+        {
+            status = dispatch<SORT_ITEMS, CompareOp>::doit(ptr,
+                                                           storage_size,
+                                                           keys.data().get(),
+                                                           keys_first,
+                                                           items_first,
+                                                           items_first,
+                                                           static_cast<unsigned int>(count),
+                                                           static_cast<unsigned int>(segments - 1),
+                                                           offsets_first,
+                                                           stream,
+                                                           debug_sync);
+        }
+        hip_rocprim::throw_on_error(status, "segmented_sort: failed on 2nd step");
+        hip_rocprim::throw_on_error(
+            hip_rocprim::synchronize_optional(policy),
+            "segmented_sort: failed to synchronize"
+        );
+    }
+} // __segmented_sort
+
+//-------------------------
+// Thrust API entry points
+//-------------------------
+
+// keys which rocprim can't radix sort, or custom comparators, are left to the
+// generic implementation
+
+__thrust_exec_check_disable__ template <class Derived,
+                                        class ItemsIt,
+                                        class OffsetIt,
+                                        class CompareOp>
+typename __smart_sort::enable_if_primitive_sort<ItemsIt, CompareOp>::type
+THRUST_HIP_FUNCTION
+segmented_sort(execution_policy<Derived>& policy,
+               ItemsIt                    first,
+               ItemsIt                    last,
+               OffsetIt                   offsets_first,
+               OffsetIt                   offsets_last,
+               CompareOp                  compare_op)
+{
+    // struct workaround is required for HIP-clang
+    // THRUST_HIP_PRESERVE_KERNELS_WORKAROUND is required for HCC
+    struct workaround
+    {
+        __host__
+        static void par(execution_policy<Derived>& policy,
+                        ItemsIt                    first,
+                        ItemsIt                    last,
+                        OffsetIt                   offsets_first,
+                        OffsetIt                   offsets_last,
+                        CompareOp                  compare_op)
+        {
+        #if __HCC__ && __HIP_DEVICE_COMPILE__
+        THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+            (__segmented_sort::segmented_radix_sort<detail::false_type, Derived, ItemsIt, ItemsIt, OffsetIt, CompareOp>)
+        );
+        #else
+        __segmented_sort::segmented_radix_sort<detail::false_type>(
+            policy, first, last, first, offsets_first, offsets_last, compare_op);
+        #endif
+        }
+        __device__
+        static void seq(execution_policy<Derived>& policy,
+                        ItemsIt                    first,
+                        ItemsIt                    last,
+                        OffsetIt                   offsets_first,
+                        OffsetIt                   offsets_last,
+                        CompareOp                  compare_op)
+        {
+            thrust::segmented_sort(
+                cvt_to_seq(derived_cast(policy)), first, last, offsets_first, offsets_last, compare_op);
+        }
+    };
+    #if __THRUST_HAS_HIPRT__
+    workaround::par(policy, first, last, offsets_first, offsets_last, compare_op);
+    #else
+    workaround::seq(policy, first, last, offsets_first, offsets_last, compare_op);
+    #endif
+}
+
+__thrust_exec_check_disable__ template <class Derived,
+                                        class KeysIt,
+                                        class ValuesIt,
+                                        class OffsetIt,
+                                        class CompareOp>
+typename __smart_sort::enable_if_primitive_sort<KeysIt, CompareOp>::type
+THRUST_HIP_FUNCTION
+segmented_sort_by_key(execution_policy<Derived>& policy,
+                      KeysIt                     keys_first,
+                      KeysIt                     keys_last,
+                      ValuesIt                   values,
+                      OffsetIt                   offsets_first,
+                      OffsetIt                   offsets_last,
+                      CompareOp                  compare_op)
+{
+    // struct workaround is required for HIP-clang
+    // THRUST_HIP_PRESERVE_KERNELS_WORKAROUND is required for HCC
+    struct workaround
+    {
+        __host__
+        static void par(execution_policy<Derived>& policy,
+                        KeysIt                     keys_first,
+                        KeysIt                     keys_last,
+                        ValuesIt                   values,
+                        OffsetIt                   offsets_first,
+                        OffsetIt                   offsets_last,
+                        CompareOp                  compare_op)
+        {
+        #if __HCC__ && __HIP_DEVICE_COMPILE__
+        THRUST_HIP_PRESERVE_KERNELS_WORKAROUND(
+            (__segmented_sort::segmented_radix_sort<detail::true_type, Derived, KeysIt, ValuesIt, OffsetIt, CompareOp>)
+        );
+        #else
+        __segmented_sort::segmented_radix_sort<detail::true_type>(
+            policy, keys_first, keys_last, values, offsets_first, offsets_last, compare_op);
+        #endif
+        }
+        __device__
+        static void seq(execution_policy<Derived>& policy,
+                        KeysIt                     keys_first,
+                        KeysIt                     keys_last,
+                        ValuesIt                   values,
+                        OffsetIt                   offsets_first,
+                        OffsetIt                   offsets_last,
+                        CompareOp                  compare_op)
+        {
+            thrust::segmented_sort_by_key(
+                cvt_to_seq(derived_cast(policy)), keys_first, keys_last, values, offsets_first, offsets_last, compare_op);
+        }
+    };
+    #if __THRUST_HAS_HIPRT__
+    workaround::par(policy, keys_first, keys_last, values, offsets_first, offsets_last, compare_op);
+    #else
+    workaround::seq(policy, keys_first, keys_last, values, offsets_first, offsets_last, compare_op);
+    #endif
+}
+
+} // namespace hip_rocprim
+THRUST_NAMESPACE_END
+
+#include <thrust/segmented_sort.h>
+
+#endif
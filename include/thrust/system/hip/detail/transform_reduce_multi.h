@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2016, NVIDIA CORPORATION.  All rights reserved.
+ * Modifications Copyright (c) 2019, Advanced Micro Devices, Inc.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+#pragma once
+
+#if THRUST_DEVICE_COMPILER == THRUST_DEVICE_COMPILER_HIP
+#include <thrust/system/hip/config.h>
+
+#include <thrust/system/hip/detail/transform_reduce.h>
+#include <thrust/system/detail/internal/transform_reduce_multi.h>
+#include <thrust/tuple.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace hip_rocprim
+{
+
+//-------------------------
+// Thrust API entry points
+//-------------------------
+
+// the reductions run as a single rocprim::reduce of tuples, which reads the
+// input once and keeps every partial result in registers
+template <class Derived, class InputIt, class... Reductions>
+thrust::tuple<typename Reductions::value_type...> THRUST_HIP_FUNCTION
+transform_reduce_multi(execution_policy<Derived>& policy,
+                       InputIt                    first,
+                       InputIt                    last,
+                       Reductions...              reductions)
+{
+    thrust::tuple<Reductions...> reductions_tuple(reductions...);
+
+    return hip_rocprim::transform_reduce(
+        policy,
+        first,
+        last,
+        thrust::system::detail::internal::multi_transform<Reductions...>(reductions_tuple),
+        thrust::system::detail::internal::multi_init(reductions...),
+        thrust::system::detail::internal::multi_combine<Reductions...>(reductions_tuple)
+    );
+}
+
+} // namespace hip_rocprim
+THRUST_NAMESPACE_END
+#endif
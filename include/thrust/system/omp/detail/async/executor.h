@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/cpp/detail/async/executor.h>
+
+#include <functional>
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace omp { namespace detail
+{
+
+// Runs `task` on the single thread of a queue shared by the asynchronous
+// algorithms of the OpenMP system. Every task forks an OpenMP team as wide as
+// the machine for the algorithm it calls, so running tasks one at a time keeps
+// the system at one team instead of one team per concurrent task.
+inline __host__
+void submit_to_omp_task_queue(std::function<void()>&& task)
+{
+  static thrust::system::cpp::detail::task_queue queue(1);
+
+  queue.submit(std::move(task));
+}
+
+// ADL hook: asynchronous algorithms run on the OpenMP system's queue.
+template <typename DerivedPolicy>
+__host__
+thrust::system::cpp::detail::async_executor
+select_async_executor(execution_policy<DerivedPolicy>&)
+{
+  return &submit_to_omp_task_queue;
+}
+
+}}} // namespace system::omp::detail
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
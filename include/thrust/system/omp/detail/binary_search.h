@@ -65,8 +65,40 @@ bool binary_search(execution_policy<DerivedPolicy> &exec,
 }
 
 
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp);
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp);
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator first,
+                             ForwardIterator last,
+                             InputIterator values_first,
+                             InputIterator values_last,
+                             OutputIterator output,
+                             StrictWeakOrdering comp);
+
+
 } // end detail
 } // end omp
 } // end system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/omp/detail/binary_search.inl>
+
@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/binary_search.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/sorted_search.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+
+// every thread searches for a contiguous range of the needles, so that sorted
+// needles are searched for by galloping along the haystack
+template<template<typename> class Search,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+  RandomAccessIterator3 sorted_search(execution_policy<DerivedPolicy> &exec,
+                                      RandomAccessIterator1 first,
+                                      RandomAccessIterator1 last,
+                                      RandomAccessIterator2 values_first,
+                                      RandomAccessIterator2 values_last,
+                                      RandomAccessIterator3 output,
+                                      StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size1;
+  typedef typename thrust::iterator_difference<RandomAccessIterator2>::type Size2;
+
+  const Size1 n = thrust::distance(first, last);
+  const Size2 m = thrust::distance(values_first, values_last);
+
+  thrust::system::detail::internal::uniform_decomposition<Size2> decomp = thrust::system::omp::detail::default_decomposition(exec, m);
+
+  const Size2 num_tiles = decomp.size();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(Size2 t = 0; t < num_tiles; ++t)
+  {
+    thrust::system::detail::internal::sorted_search<Search>(first, n,
+                                                            values_first + decomp[t].begin(), decomp[t].size(),
+                                                            output + decomp[t].begin(),
+                                                            comp);
+  }
+
+  return output + m;
+} // end sorted_search()
+
+
+} // end binary_search_detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  return binary_search_detail::sorted_search<thrust::system::detail::internal::lower_bound_search>(exec, first, last, values_first, values_last, output, comp);
+} // end lower_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  return binary_search_detail::sorted_search<thrust::system::detail::internal::upper_bound_search>(exec, first, last, values_first, values_last, output, comp);
+} // end upper_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator first,
+                             ForwardIterator last,
+                             InputIterator values_first,
+                             InputIterator values_last,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+  return binary_search_detail::sorted_search<thrust::system::detail::internal::binary_search_search>(exec, first, last, values_first, values_last, output, comp);
+} // end binary_search()
+
+
+} // end detail
+} // end omp
+} // end system
+THRUST_NAMESPACE_END
+
@@ -18,7 +18,16 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/copy_if.h>
-#include <thrust/system/detail/generic/copy_if.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/stream_compaction.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/copy.h>
+#include <thrust/distance.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -29,6 +38,9 @@ namespace detail
 {
 
 
+// copy_if is computed in two passes over the input: every tile counts the
+// elements it keeps, and after the counts are scanned into output offsets,
+// every tile copies the elements it keeps to its offset
 template<typename DerivedPolicy,
          typename InputIterator1,
          typename InputIterator2,
@@ -41,8 +53,49 @@ template<typename DerivedPolicy,
                          OutputIterator result,
                          Predicate pred)
 {
-  // omp prefers generic::copy_if to cpp::copy_if
-  return thrust::system::detail::generic::copy_if(exec, first, last, stencil, result, pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::copy_if(thrust::system::detail::internal::serial_policy(exec), first, last, stencil, result, pred);
+  }
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_tiles + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  thrust::system::omp::detail::compaction_offsets(exec, stencil, pred, decomp, offsets_ptr);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    thrust::copy_if(thrust::seq,
+                    first + decomp[t].begin(), first + decomp[t].end(),
+                    stencil + decomp[t].begin(),
+                    result + offsets_ptr[t],
+                    pred);
+  }
+
+  return result + offsets_ptr[num_tiles];
 } // end copy_if()
 
 
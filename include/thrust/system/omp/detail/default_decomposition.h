@@ -23,6 +23,16 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/par.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/functional.h>
+#include <thrust/tuple.h>
+#include <thrust/detail/internal_functional.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -32,8 +42,137 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n);
+// the bytes a tile of a loop whose elements cost about as much as an
+// arithmetic operation should at least touch, about the size of a core's L2
+// cache: smaller tiles don't amortize the cost of waking another thread
+const std::size_t cheap_tile_bytes = 256 * 1024;
+
+// returns the grain size of such a loop touching bytes_per_element bytes per
+// element
+inline std::size_t cheap_grain_size(std::size_t bytes_per_element)
+{
+  return bytes_per_element < cheap_tile_bytes ? cheap_tile_bytes / bytes_per_element : 1;
+}
+
+// the standard functional objects which combine two Ts in one instruction
+template<typename BinaryFunction, typename T>
+  struct is_arithmetic_operator : thrust::detail::false_type
+{};
+
+template<typename T> struct is_arithmetic_operator<thrust::plus<T>,          T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::plus<void>,       T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::multiplies<T>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::multiplies<void>, T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::minimum<T>,       T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::minimum<void>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::maximum<T>,       T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_operator<thrust::maximum<void>,    T> : thrust::detail::true_type {};
+
+// the standard functional objects which compute a T from a T in one
+// instruction
+template<typename UnaryFunction, typename T>
+  struct is_arithmetic_unary_operator : thrust::detail::false_type
+{};
+
+template<typename T> struct is_arithmetic_unary_operator<thrust::identity<T>,       T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_unary_operator<thrust::identity<void>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_unary_operator<thrust::negate<T>,         T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_unary_operator<thrust::negate<void>,      T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_unary_operator<thrust::logical_not<T>,    T> : thrust::detail::true_type {};
+template<typename T> struct is_arithmetic_unary_operator<thrust::logical_not<void>, T> : thrust::detail::true_type {};
+
+// whether Iterator is a contiguous iterator over arithmetic values
+template<typename Iterator>
+  struct is_contiguous_arithmetic_iterator
+    : thrust::detail::integral_constant<
+        bool,
+        thrust::is_contiguous_iterator<Iterator>::value &&
+        thrust::detail::is_arithmetic<typename thrust::iterator_value<Iterator>::type>::value
+      >
+{};
+
+// is_cheap_reduction<Iterator,T,BinaryFunction> is true when reducing or
+// scanning the elements of Iterator into a T with BinaryFunction costs about
+// an arithmetic operation per element: plain loads of arithmetic values
+// combined by one of the standard arithmetic functional objects
+template<typename Iterator, typename T, typename BinaryFunction>
+  struct is_cheap_reduction
+    : thrust::detail::integral_constant<
+        bool,
+        thrust::is_contiguous_iterator<Iterator>::value &&
+        thrust::detail::is_arithmetic<typename thrust::iterator_value<Iterator>::type>::value &&
+        thrust::detail::is_arithmetic<T>::value &&
+        is_arithmetic_operator<BinaryFunction,T>::value
+      >
+{};
+
+// returns the grain size of a reduction or scan: cheap_grain_size for cheap
+// ones and 1 otherwise
+template<typename Iterator, typename T, typename BinaryFunction>
+std::size_t reduction_grain_size()
+{
+  return is_cheap_reduction<Iterator,T,BinaryFunction>::value ? cheap_grain_size(sizeof(typename thrust::iterator_value<Iterator>::type)) : 1;
+}
+
+// cheap_for_each_bytes<Iterator,Function>::value is the number of bytes
+// for_each touches per element when calling Function on the elements of
+// Iterator costs about an arithmetic operation per element, and 0 otherwise.
+// The cost of a user's function is unknown, so only the element-wise
+// transforms with the standard functional objects qualify
+template<typename Iterator, typename Function>
+  struct cheap_for_each_bytes
+    : thrust::detail::integral_constant<std::size_t, 0>
+{};
+
+// transform(first, last, result, op)
+template<typename Iterator1, typename Iterator2, typename UnaryFunction>
+  struct cheap_for_each_bytes<
+    thrust::zip_iterator<thrust::tuple<Iterator1,Iterator2> >,
+    thrust::detail::unary_transform_functor<UnaryFunction>
+  >
+    : thrust::detail::integral_constant<
+        std::size_t,
+        (is_contiguous_arithmetic_iterator<Iterator1>::value &&
+         is_contiguous_arithmetic_iterator<Iterator2>::value &&
+         is_arithmetic_unary_operator<UnaryFunction, typename thrust::iterator_value<Iterator1>::type>::value) ?
+          sizeof(typename thrust::iterator_value<Iterator1>::type) + sizeof(typename thrust::iterator_value<Iterator2>::type) : 0
+      >
+{};
+
+// transform(first1, last1, first2, result, op)
+template<typename Iterator1, typename Iterator2, typename Iterator3, typename BinaryFunction>
+  struct cheap_for_each_bytes<
+    thrust::zip_iterator<thrust::tuple<Iterator1,Iterator2,Iterator3> >,
+    thrust::detail::binary_transform_functor<BinaryFunction>
+  >
+    : thrust::detail::integral_constant<
+        std::size_t,
+        (is_contiguous_arithmetic_iterator<Iterator1>::value &&
+         is_contiguous_arithmetic_iterator<Iterator2>::value &&
+         is_contiguous_arithmetic_iterator<Iterator3>::value &&
+         is_arithmetic_operator<BinaryFunction, typename thrust::iterator_value<Iterator1>::type>::value) ?
+          sizeof(typename thrust::iterator_value<Iterator1>::type) +
+          sizeof(typename thrust::iterator_value<Iterator2>::type) +
+          sizeof(typename thrust::iterator_value<Iterator3>::type) : 0
+      >
+{};
+
+// returns the grain size of for_each: cheap_grain_size for cheap functions
+// and 1 otherwise
+template<typename Iterator, typename Function>
+std::size_t for_each_grain_size()
+{
+  return cheap_for_each_bytes<Iterator,Function>::value != 0 ? cheap_grain_size(cheap_for_each_bytes<Iterator,Function>::value) : 1;
+}
+
+// splits [0, n) into at most one tile per thread, using no more threads than
+// the policy's max_threads allows and no tile smaller than its grain size.
+// Policies which carry no grain size use default_grain_size: the cost of an
+// element is unknown in general, so by default any input is split across
+// every thread, and only callers which know their elements to be cheap pass
+// a larger one
+template <typename IndexType, typename DerivedPolicy>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n, std::size_t default_grain_size = 1);
 
 } // end namespace detail
 } // end namespace omp
@@ -18,6 +18,7 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/detail/minmax.h>
 
 // don't attempt to #include this file without omp support
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
@@ -32,8 +33,8 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+template <typename IndexType, typename DerivedPolicy>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n, std::size_t default_grain_size)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -48,7 +49,41 @@ thrust::system::detail::internal::uniform_decomposition<IndexType> default_decom
   );
 
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, omp_get_num_procs());
+  std::size_t grain_size  = get_grain_size(thrust::detail::derived_cast(exec));
+  int         max_threads = get_max_threads(thrust::detail::derived_cast(exec));
+
+  if(grain_size == 0)
+  {
+    grain_size = thrust::max<std::size_t>(1, default_grain_size);
+  }
+
+  // omp_get_max_threads honors OMP_NUM_THREADS, but inside a parallel region
+  // it still returns the team size a nested region would ask for. Such a
+  // region only gets more than one thread while the nesting stays within
+  // max-active-levels, so otherwise a single tile avoids splitting the input
+  // for threads that don't exist
+  int num_threads = omp_get_max_threads();
+
+  if(omp_get_active_level() >= omp_get_max_active_levels())
+  {
+    num_threads = 1;
+  }
+
+  if(max_threads > 0 && max_threads < num_threads)
+  {
+    num_threads = max_threads;
+  }
+
+  // don't split below the grain size; small inputs become a single tile
+  // which callers run without entering a parallel region
+  const std::size_t max_tiles = thrust::max<std::size_t>(1, static_cast<std::size_t>(n) / grain_size);
+
+  if(max_tiles < static_cast<std::size_t>(num_threads))
+  {
+    num_threads = static_cast<int>(max_tiles);
+  }
+
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, num_threads);
 #else
   return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, 1);
 #endif
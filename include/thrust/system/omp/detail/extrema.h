@@ -18,7 +18,7 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/execution_policy.h>
-#include <thrust/system/detail/generic/extrema.h>
+#include <thrust/system/detail/internal/lane_extrema.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -34,8 +34,8 @@ ForwardIterator max_element(execution_policy<DerivedPolicy> &exec,
                             ForwardIterator last,
                             BinaryPredicate comp)
 {
-  // omp prefers generic::max_element to cpp::max_element
-  return thrust::system::detail::generic::max_element(exec, first, last, comp);
+  // omp prefers the lane reductions or generic::max_element to cpp::max_element
+  return thrust::system::detail::internal::lane_max_element(exec, first, last, comp);
 } // end max_element()
 
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
@@ -44,8 +44,8 @@ ForwardIterator min_element(execution_policy<DerivedPolicy> &exec,
                             ForwardIterator last,
                             BinaryPredicate comp)
 {
-  // omp prefers generic::min_element to cpp::min_element
-  return thrust::system::detail::generic::min_element(exec, first, last, comp);
+  // omp prefers the lane reductions or generic::min_element to cpp::min_element
+  return thrust::system::detail::internal::lane_min_element(exec, first, last, comp);
 } // end min_element()
 
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
@@ -54,8 +54,8 @@ thrust::pair<ForwardIterator,ForwardIterator> minmax_element(execution_policy<De
                                                              ForwardIterator last,
                                                              BinaryPredicate comp)
 {
-  // omp prefers generic::minmax_element to cpp::minmax_element
-  return thrust::system::detail::generic::minmax_element(exec, first, last, comp);
+  // omp prefers the lane reductions or generic::minmax_element to cpp::minmax_element
+  return thrust::system::detail::internal::lane_minmax_element(exec, first, last, comp);
 } // end minmax_element()
 
 } // end detail
@@ -22,7 +22,6 @@
 #pragma once
 
 #include <thrust/detail/config.h>
-#include <thrust/system/detail/generic/find.h>
 #include <thrust/system/omp/detail/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -33,18 +32,18 @@ namespace omp
 namespace detail
 {
 
+
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy> &exec,
                       InputIterator first,
                       InputIterator last,
-                      Predicate pred)
-{
-  // omp prefers generic::find_if to cpp::find_if
-  return thrust::system::detail::generic::find_if(exec, first, last, pred);
-}
+                      Predicate pred);
+
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/omp/detail/find.inl>
+
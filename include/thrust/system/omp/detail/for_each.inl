@@ -22,6 +22,8 @@
 #include <thrust/distance.h>
 #include <thrust/for_each.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
 #include <thrust/system/omp/detail/pragma_omp.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -36,7 +38,7 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
@@ -62,13 +64,21 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type DifferenceType;
   DifferenceType signed_n = n;
 
-  THRUST_PRAGMA_OMP(parallel for)
-  for(DifferenceType i = 0;
-      i < signed_n;
-      ++i)
+  thrust::system::detail::internal::uniform_decomposition<DifferenceType> decomp = thrust::system::omp::detail::default_decomposition(exec, signed_n, for_each_grain_size<RandomAccessIterator,UnaryFunction>());
+
+  const DifferenceType num_tiles = decomp.size();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(DifferenceType t = 0; t < num_tiles; ++t)
   {
-    RandomAccessIterator temp = first + i;
-    wrapped_f(*temp);
+    RandomAccessIterator temp = first + decomp[t].begin();
+
+    for(DifferenceType i = decomp[t].begin();
+        i < decomp[t].end();
+        ++i, ++temp)
+    {
+      wrapped_f(*temp);
+    }
   }
 
   return first + n;
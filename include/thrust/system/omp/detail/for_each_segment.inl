@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/for_each_segment.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// segments are binned by size: a segment holding more than a tile's share of
+// the elements is processed by the parallel algorithm on its own, one such
+// segment after another, while the smaller segments are spread over the
+// threads and each processed sequentially
+template <typename DerivedPolicy,
+          typename OffsetIterator,
+          typename SegmentFunction>
+void for_each_segment(execution_policy<DerivedPolicy> &exec,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      SegmentFunction f)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      OffsetIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<OffsetIterator>::type Size;
+
+  const Size num_segments = thrust::distance(offsets_first, offsets_last) - 1;
+
+  if(num_segments <= 0) return;
+
+  const Size n = static_cast<Size>(offsets_first[num_segments]) - static_cast<Size>(offsets_first[0]);
+
+  const Size num_tiles = thrust::system::omp::detail::default_decomposition(exec, n).size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    for(Size i = 0; i < num_segments; ++i)
+    {
+      f(thrust::system::detail::internal::serial_policy(exec), i, static_cast<Size>(offsets_first[i]), static_cast<Size>(offsets_first[i + 1]));
+    }
+
+    return;
+  }
+
+  const Size tile_size = (n + num_tiles - 1) / num_tiles;
+
+  // segments vary in size, so threads take a few of them at a time
+  const Size chunk_size = num_segments / (8 * num_tiles) > 1 ? num_segments / (8 * num_tiles) : 1;
+
+  // the sequential policy's temporary storage is requested from every thread,
+  // so it mustn't go through exec's allocator
+  THRUST_PRAGMA_OMP(parallel for schedule(dynamic, chunk_size) num_threads(num_tiles))
+  for(Size i = 0; i < num_segments; ++i)
+  {
+    const Size begin = offsets_first[i];
+    const Size end   = offsets_first[i + 1];
+
+    if(end - begin <= tile_size)
+    {
+      f(thrust::seq, i, begin, end);
+    }
+  }
+
+  for(Size i = 0; i < num_segments; ++i)
+  {
+    const Size begin = offsets_first[i];
+    const Size end   = offsets_first[i + 1];
+
+    if(end - begin > tile_size)
+    {
+      f(exec, i, begin, end);
+    }
+  }
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/histogram.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/histogram.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace histogram_detail
+{
+
+
+// every tile counts its samples into private bins, which are summed across
+// tiles at the end, so no two threads ever update the same count
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename BinFunction>
+  RandomAccessIterator histogram(execution_policy<DerivedPolicy> &exec,
+                                 InputIterator first,
+                                 InputIterator last,
+                                 RandomAccessIterator histogram,
+                                 Size num_bins,
+                                 BinFunction bin)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type count_type;
+
+  if(num_bins <= 0) return histogram;
+
+  const difference_type n    = thrust::distance(first, last);
+  const difference_type bins = static_cast<difference_type>(num_bins);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  // clearing and summing private bins costs num_bins per tile, so give every
+  // tile at least as many samples as there are bins
+  if(decomp.size() > 1 && decomp.size() > n / bins)
+  {
+    const difference_type num_tiles = n / bins > 1 ? n / bins : 1;
+
+    decomp = thrust::system::detail::internal::uniform_decomposition<difference_type>(n, (n + num_tiles - 1) / num_tiles, num_tiles);
+  }
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::system::detail::internal::count_bins(first, last, histogram, num_bins, bin);
+
+    return histogram + num_bins;
+  }
+
+  thrust::detail::temporary_array<count_type,DerivedPolicy> private_bins(exec, num_tiles * bins);
+
+  count_type *private_bins_ptr = thrust::raw_pointer_cast(private_bins.data());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    thrust::system::detail::internal::count_bins(first + decomp[t].begin(), first + decomp[t].end(),
+                                                 private_bins_ptr + t * bins,
+                                                 bins, bin);
+  }
+
+  // summing few bins isn't worth waking the threads again
+  const bool sum_in_parallel = num_tiles * bins >= static_cast<difference_type>(thrust::system::omp::detail::cheap_grain_size(sizeof(count_type)));
+
+  THRUST_PRAGMA_OMP(parallel for if(sum_in_parallel) num_threads(num_tiles))
+  for(difference_type i = 0; i < bins; ++i)
+  {
+    count_type sum = private_bins_ptr[i];
+
+    for(difference_type t = 1; t < num_tiles; ++t)
+    {
+      sum += private_bins_ptr[t * bins + i];
+    }
+
+    histogram[i] = sum;
+  }
+
+  return histogram + num_bins;
+} // end histogram()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator histogram_even(execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  thrust::system::detail::internal::even_bin<T,Size> bin(num_bins, lower_level, upper_level);
+
+  return histogram_detail::histogram(exec, first, last, histogram, num_bins, bin);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename LevelIterator,
+         typename RandomAccessIterator>
+  RandomAccessIterator histogram_range(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  typedef typename thrust::iterator_difference<LevelIterator>::type Size;
+
+  const Size num_bins = thrust::distance(levels_first, levels_last) - 1;
+
+  thrust::system::detail::internal::range_bin<LevelIterator> bin(levels_first, num_bins);
+
+  return histogram_detail::histogram(exec, first, last, histogram, num_bins, bin);
+} // end histogram_range()
+
+
+} // end detail
+} // end omp
+} // end system
+THRUST_NAMESPACE_END
+
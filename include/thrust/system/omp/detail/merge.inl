@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/distance.h>
+#include <thrust/merge.h>
+#include <thrust/pair.h>
+#include <thrust/detail/seq.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// Both merges split the output into default_decomposition tiles. Each
+// tile finds its starting and ending positions in the two inputs with a
+// merge path search and then merges its share sequentially, so every
+// thread writes the same number of elements regardless of the data.
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
+                     InputIterator1 first1,
+                     InputIterator1 last1,
+                     InputIterator2 first2,
+                     InputIterator2 last2,
+                     OutputIterator result,
+                     StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::detail::intptr_t                                    index_type;
+
+  const difference_type n1 = thrust::distance(first1, last1);
+  const difference_type n2 = thrust::distance(first2, last2);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n1 + n2);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    const difference_type diag_begin = decomp[i].begin();
+    const difference_type diag_end   = decomp[i].end();
+
+    const difference_type begin1 = thrust::system::detail::internal::merge_path(first1, n1, first2, n2, diag_begin, comp);
+    const difference_type end1   = thrust::system::detail::internal::merge_path(first1, n1, first2, n2, diag_end,   comp);
+
+    thrust::merge(thrust::seq,
+                  first1 + begin1, first1 + end1,
+                  first2 + (diag_begin - begin1), first2 + (diag_end - end1),
+                  result + diag_begin,
+                  comp);
+  }
+
+  return result + (n1 + n2);
+} // end merge()
+
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1,OutputIterator2>
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
+               InputIterator1 keys_first1,
+               InputIterator1 keys_last1,
+               InputIterator2 keys_first2,
+               InputIterator2 keys_last2,
+               InputIterator3 values_first3,
+               InputIterator4 values_first4,
+               OutputIterator1 keys_result,
+               OutputIterator2 values_result,
+               StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::detail::intptr_t                                    index_type;
+
+  const difference_type n1 = thrust::distance(keys_first1, keys_last1);
+  const difference_type n2 = thrust::distance(keys_first2, keys_last2);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n1 + n2);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    const difference_type diag_begin = decomp[i].begin();
+    const difference_type diag_end   = decomp[i].end();
+
+    const difference_type begin1 = thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, diag_begin, comp);
+    const difference_type end1   = thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, diag_end,   comp);
+
+    const difference_type begin2 = diag_begin - begin1;
+    const difference_type end2   = diag_end   - end1;
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_first1 + begin1, keys_first1 + end1,
+                         keys_first2 + begin2, keys_first2 + end2,
+                         values_first3 + begin1,
+                         values_first4 + begin2,
+                         keys_result + diag_begin,
+                         values_result + diag_begin,
+                         comp);
+  }
+
+  return thrust::make_pair(keys_result + (n1 + n2), values_result + (n1 + n2));
+} // end merge_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
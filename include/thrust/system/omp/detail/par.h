@@ -18,7 +18,11 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/detail/allocator_aware_execution_policy.h>
+#if THRUST_CPP_DIALECT >= 2011
+#  include <thrust/detail/dependencies_aware_execution_policy.h>
+#endif
 #include <thrust/system/omp/detail/execution_policy.h>
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -29,12 +33,88 @@ namespace detail
 {
 
 
+// policies which don't carry a grain size or a thread limit leave both to
+// default_decomposition
+template<typename DerivedPolicy>
+std::size_t get_grain_size(execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+
+template<typename DerivedPolicy>
+int get_max_threads(execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+
+template<typename Derived>
+struct execute_with_grain_size_base : execution_policy<Derived>
+{
+private:
+  std::size_t grain_size;
+  int max_threads;
+
+public:
+  __host__ __device__
+  execute_with_grain_size_base(std::size_t grain_size_ = 0, int max_threads_ = 0)
+    : grain_size(grain_size_), max_threads(max_threads_)
+  {}
+
+  // grain_size is the smallest number of elements worth giving to a thread
+  // and max_threads bounds the number of threads an algorithm runs on;
+  // zero selects the default for either
+  Derived with(std::size_t grain_size_, int max_threads_ = 0) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.grain_size  = grain_size_;
+    result.max_threads = max_threads_;
+    return result;
+  }
+
+private:
+  friend std::size_t get_grain_size(const execute_with_grain_size_base &exec)
+  {
+    return exec.grain_size;
+  }
+
+  friend int get_max_threads(const execute_with_grain_size_base &exec)
+  {
+    return exec.max_threads;
+  }
+};
+
+
+struct execute_with_grain_size : execute_with_grain_size_base<execute_with_grain_size>
+{
+  typedef execute_with_grain_size_base<execute_with_grain_size> base_t;
+
+  __host__ __device__
+  execute_with_grain_size() : base_t() {}
+
+  __host__ __device__
+  execute_with_grain_size(std::size_t grain_size, int max_threads)
+    : base_t(grain_size, max_threads)
+  {}
+};
+
+
 struct par_t : thrust::system::omp::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
-    thrust::system::omp::detail::execution_policy>
+    execute_with_grain_size_base>
+#if THRUST_CPP_DIALECT >= 2011
+, thrust::detail::dependencies_aware_execution_policy<
+    execute_with_grain_size_base>
+#endif
 {
   __host__ __device__
   constexpr par_t() : thrust::system::omp::detail::execution_policy<par_t>() {}
+
+  execute_with_grain_size with(std::size_t grain_size, int max_threads = 0) const
+  {
+    return execute_with_grain_size(grain_size, max_threads);
+  }
 };
 
 
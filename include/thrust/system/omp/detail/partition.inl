@@ -23,7 +23,16 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/partition.h>
-#include <thrust/system/detail/generic/partition.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/stream_compaction.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/pair.h>
+#include <thrust/partition.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -34,6 +43,127 @@ namespace detail
 {
 
 
+namespace partition_detail
+{
+
+
+// every tile copies its elements to the partitions at its offsets, where
+// offsets are the scanned counts of elements which satisfy pred
+template<typename Decomposition,
+         typename Size,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate>
+  void partition_tiles(Decomposition decomp,
+                       const Size *offsets,
+                       InputIterator1 first,
+                       InputIterator2 stencil,
+                       OutputIterator1 out_true,
+                       OutputIterator2 out_false,
+                       Predicate pred)
+{
+  const Size num_tiles = decomp.size();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    const Size begin = decomp[t].begin();
+
+    thrust::stable_partition_copy(thrust::seq,
+                                  first + begin, first + decomp[t].end(),
+                                  stencil + begin,
+                                  out_true + offsets[t],
+                                  out_false + (begin - offsets[t]),
+                                  pred);
+  }
+}
+
+
+// stable_partition_copy and stable_partition read the input twice: once to
+// count the elements of each tile which satisfy pred, and once to copy them
+// to both partitions at once
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Predicate>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    stable_partition_copy(execution_policy<DerivedPolicy> &exec,
+                          InputIterator1 first,
+                          InputIterator1 last,
+                          InputIterator2 stencil,
+                          OutputIterator1 out_true,
+                          OutputIterator2 out_false,
+                          Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::stable_partition_copy(thrust::system::detail::internal::serial_policy(exec), first, last, stencil, out_true, out_false, pred);
+  }
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_tiles + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  thrust::system::omp::detail::compaction_offsets(exec, stencil, pred, decomp, offsets_ptr);
+
+  partition_detail::partition_tiles(decomp, offsets_ptr, first, stencil, out_true, out_false, pred);
+
+  return thrust::make_pair(out_true + offsets_ptr[num_tiles], out_false + (n - offsets_ptr[num_tiles]));
+}
+
+
+// the input is moved to a temporary buffer, which is then partitioned back
+// into place; the false partition starts where the count of the elements
+// which satisfy pred says
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename Predicate>
+  ForwardIterator stable_partition(execution_policy<DerivedPolicy> &exec,
+                                   ForwardIterator first,
+                                   ForwardIterator last,
+                                   thrust::detail::temporary_array<typename thrust::iterator_value<ForwardIterator>::type,DerivedPolicy> &input,
+                                   InputIterator stencil,
+                                   Predicate pred)
+{
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_tiles + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  thrust::system::omp::detail::compaction_offsets(exec, stencil, pred, decomp, offsets_ptr);
+
+  ForwardIterator middle = first + offsets_ptr[num_tiles];
+
+  partition_detail::partition_tiles(decomp, offsets_ptr, input.begin(), stencil, first, middle, pred);
+
+  return middle;
+}
+
+
+} // end namespace partition_detail
+
+
 template<typename DerivedPolicy,
          typename ForwardIterator,
          typename Predicate>
@@ -42,8 +172,18 @@ template<typename DerivedPolicy,
                                    ForwardIterator last,
                                    Predicate pred)
 {
-  // omp prefers generic::stable_partition to cpp::stable_partition
-  return thrust::system::detail::generic::stable_partition(exec, first, last, pred);
+  typedef typename thrust::iterator_value<ForwardIterator>::type InputType;
+
+  if(thrust::system::omp::detail::default_decomposition(exec, thrust::distance(first, last)).size() <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::stable_partition(thrust::system::detail::internal::serial_policy(exec), first, last, pred);
+  }
+
+  thrust::detail::temporary_array<InputType,DerivedPolicy> input(exec, first, last);
+
+  // the copy of the input is its own stencil
+  return partition_detail::stable_partition(exec, first, last, input, input.begin(), pred);
 } // end stable_partition()
 
 
@@ -57,8 +197,17 @@ template<typename DerivedPolicy,
                                    InputIterator stencil,
                                    Predicate pred)
 {
-  // omp prefers generic::stable_partition to cpp::stable_partition
-  return thrust::system::detail::generic::stable_partition(exec, first, last, stencil, pred);
+  typedef typename thrust::iterator_value<ForwardIterator>::type InputType;
+
+  if(thrust::system::omp::detail::default_decomposition(exec, thrust::distance(first, last)).size() <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::stable_partition(thrust::system::detail::internal::serial_policy(exec), first, last, stencil, pred);
+  }
+
+  thrust::detail::temporary_array<InputType,DerivedPolicy> input(exec, first, last);
+
+  return partition_detail::stable_partition(exec, first, last, input, stencil, pred);
 } // end stable_partition()
 
 
@@ -75,8 +224,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  return partition_detail::stable_partition_copy(exec, first, last, first, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
@@ -95,8 +243,7 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  return partition_detail::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
 } // end stable_partition_copy()
 
 
@@ -18,6 +18,9 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/reduce.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/trace.h>
 #include <thrust/system/omp/detail/reduce.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
 #include <thrust/system/omp/detail/reduce_intervals.h>
@@ -45,8 +48,17 @@ template<typename DerivedPolicy,
 
   const difference_type n = thrust::distance(first,last);
 
+  THRUST_TRACE_SCOPE("reduce", "omp", n);
+
   // determine first and second level decomposition
-  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(n);
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(exec, n, reduction_grain_size<InputIterator,OutputType,BinaryFunction>());
+
+  if(decomp1.size() <= 1)
+  {
+    // too small to be worth a parallel region or a temporary array
+    return thrust::reduce(thrust::seq, first, last, init, binary_op);
+  }
+
   thrust::system::detail::internal::uniform_decomposition<difference_type> decomp2(decomp1.size() + 1, 1, 1);
 
   // allocate storage for the initializer and partial sums
@@ -57,7 +69,11 @@ template<typename DerivedPolicy,
   partial_sums[0] = init;
 
   // accumulate partial sums (first level reduction)
-  thrust::system::omp::detail::reduce_intervals(exec, first, partial_sums.begin() + 1, binary_op, decomp1);
+  {
+    THRUST_TRACE_PHASE("reduce intervals");
+
+    thrust::system::omp::detail::reduce_intervals(exec, first, partial_sums.begin() + 1, binary_op, decomp1);
+  }
 
   // reduce partial sums (second level reduction)
   thrust::system::omp::detail::reduce_intervals(exec, partial_sums.begin(), partial_sums.begin(), binary_op, decomp2);
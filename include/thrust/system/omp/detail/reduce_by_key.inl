@@ -18,8 +18,20 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/reduce_by_key.h>
-#include <thrust/system/detail/generic/reduce_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/scan_by_key.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/range/tail_flags.h>
+#include <thrust/functional.h>
 #include <thrust/distance.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -46,8 +58,112 @@ template <typename DerivedPolicy,
                   BinaryPredicate binary_pred,
                   BinaryFunction binary_op)
 {
-  // omp prefers generic::reduce_by_key to cpp::reduce_by_key
-  return thrust::system::detail::generic::reduce_by_key(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef typename thrust::iterator_value<InputIterator2>::type      ValueType;
+
+  const difference_type n = thrust::distance(keys_first, keys_last);
+
+  // XXX this value is a tuning opportunity
+  const difference_type parallelism_threshold = 10000;
+
+  if(n < parallelism_threshold)
+  {
+    // don't bother parallelizing for small n
+    return thrust::reduce_by_key(thrust::seq, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  }
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  // count the segments which end in each tile; the scan of the counts
+  // gives each tile its output offset, with the size of the result at the end
+  thrust::detail::tail_flags<InputIterator1,BinaryPredicate> tail_flags = thrust::detail::make_tail_flags(keys_first, keys_last, binary_pred);
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_tiles + 1);
+  thrust::system::omp::detail::reduce_intervals(exec, tail_flags.begin(), offsets.begin() + 1, thrust::plus<difference_type>(), decomp);
+  offsets[0] = 0;
+
+  thrust::inclusive_scan(thrust::seq, offsets.begin() + 1, offsets.end(), offsets.begin() + 1);
+
+  const difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  // a tile whose last segment continues into the next tile reduces that
+  // segment into a carry instead of writing it out
+  thrust::detail::temporary_array<ValueType,DerivedPolicy>       carries(exec, num_tiles);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> carry_heads(0, exec, num_tiles);
+
+  ValueType       *carries_ptr     = thrust::raw_pointer_cast(carries.data());
+  difference_type *carry_heads_ptr = thrust::raw_pointer_cast(carry_heads.data());
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    const difference_type begin = decomp[t].begin();
+    difference_type       end   = decomp[t].end();
+
+    if(!tail_flags[end - 1])
+    {
+      end = carry_heads_ptr[t] = thrust::system::detail::internal::reduce_last_segment(keys_first, values_first, begin, end, carries_ptr[t], binary_pred, wrapped_binary_op);
+    }
+
+    thrust::reduce_by_key(thrust::seq,
+                          keys_first + begin, keys_first + end,
+                          values_first + begin,
+                          keys_output + offsets_ptr[t],
+                          values_output + offsets_ptr[t],
+                          binary_pred, binary_op);
+  }
+
+  // sequentially fold the carries into the first segment written after them
+  // note that the last tile never has a carry
+  difference_type run = -1;
+
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    if(run >= 0 && offsets_ptr[t + 1] > offsets_ptr[t])
+    {
+      // tile t closes the segment begun in tile run
+      const difference_type idx = offsets_ptr[t];
+
+      keys_output[idx]   = keys_first[carry_heads_ptr[run]];
+      values_output[idx] = wrapped_binary_op(carries_ptr[run], values_output[idx]);
+
+      run = -1;
+    }
+
+    if(!tail_flags[decomp[t].end() - 1])
+    {
+      if(run >= 0)
+      {
+        // tile t lies entirely inside the segment
+        carries_ptr[run] = wrapped_binary_op(carries_ptr[run], carries_ptr[t]);
+      }
+      else
+      {
+        run = t;
+      }
+    }
+  }
+
+  const difference_type size_of_result = offsets_ptr[num_tiles];
+
+  return thrust::make_pair(keys_output + size_of_result, values_output + size_of_result);
 } // end reduce_by_key()
 
 
@@ -21,6 +21,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
 #include <thrust/detail/cstdint.h>
+#include <thrust/system/detail/internal/lane_reduce.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -56,14 +57,11 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
 
-  // wrap binary_op
-  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
-
   typedef thrust::detail::intptr_t index_type;
 
   index_type n = static_cast<index_type>(decomp.size());
 
-  THRUST_PRAGMA_OMP(parallel for)
+  THRUST_PRAGMA_OMP(parallel for if(n > 1) num_threads(n))
   for(index_type i = 0; i < n; i++)
   {
     InputIterator begin = input + decomp[i].begin();
@@ -73,13 +71,7 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
     {
       OutputType sum = thrust::raw_reference_cast(*begin);
 
-      ++begin;
-
-      while (begin != end)
-      {
-        sum = wrapped_binary_op(sum, *begin);
-        ++begin;
-      }
+      sum = thrust::system::detail::internal::lane_reduce_n(begin + 1, (end - begin) - 1, sum, binary_op);
 
       OutputIterator tmp = output + i;
       *tmp = sum;
@@ -18,7 +18,16 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/remove.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/stream_compaction.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 #include <thrust/system/detail/generic/remove.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/remove.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -28,6 +37,58 @@ namespace omp
 namespace detail
 {
 
+namespace remove_detail
+{
+
+
+// every tile removes its elements in place, after which the tiles' remaining
+// elements are gathered at the front of the range
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename Predicate>
+  ForwardIterator remove_if(execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            InputIterator stencil,
+                            Predicate pred)
+{
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::remove_if(thrust::system::detail::internal::serial_policy(exec), first, last, stencil, pred);
+  }
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> counts(0, exec, num_tiles + 1);
+
+  difference_type *counts_ptr = thrust::raw_pointer_cast(counts.data());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    ForwardIterator tile_first = first + decomp[t].begin();
+
+    counts_ptr[t + 1] = thrust::remove_if(thrust::seq,
+                                          tile_first, first + decomp[t].end(),
+                                          stencil + decomp[t].begin(),
+                                          pred) - tile_first;
+  }
+
+  return thrust::system::omp::detail::gather_tiles(exec, first, decomp, counts_ptr);
+}
+
+
+} // end namespace remove_detail
+
+
 template<typename DerivedPolicy,
          typename ForwardIterator,
          typename Predicate>
@@ -36,8 +97,9 @@ template<typename DerivedPolicy,
                             ForwardIterator last,
                             Predicate pred)
 {
-  // omp prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, pred);
+  // the elements are their own stencil: compacting a tile in place only
+  // overwrites elements the tile has already tested
+  return remove_detail::remove_if(exec, first, last, first, pred);
 }
 
 
@@ -51,8 +113,7 @@ template<typename DerivedPolicy,
                             InputIterator stencil,
                             Predicate pred)
 {
-  // omp prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, stencil, pred);
+  return remove_detail::remove_if(exec, first, last, stencil, pred);
 }
 
 
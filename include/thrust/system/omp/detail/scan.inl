@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/trace.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// Both scans are computed in two passes over the same decomposition:
+//   1. every tile is reduced independently (reduce_intervals)
+//   2. the tile sums are scanned serially to find each tile's carry-in
+//   3. every tile is scanned independently, seeded with its carry-in
+// The input is only read in steps 1 and 3, so in-place scans are safe.
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator>::type      ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                   index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  THRUST_TRACE_SCOPE("inclusive_scan", "omp", n);
+
+  if(n == 0)
+    return result;
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n, reduction_grain_size<InputIterator,ValueType,BinaryFunction>());
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // reduce each tile
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> tile_sums(exec, num_tiles);
+  {
+    THRUST_TRACE_PHASE("reduce tiles");
+
+    thrust::system::omp::detail::reduce_intervals(exec, first, tile_sums.begin(), binary_op, decomp);
+  }
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // tile_sums[i] becomes the carry-in of tile i + 1
+  for(index_type i = 1; i < num_tiles; ++i)
+  {
+    tile_sums[i] = wrapped_binary_op(tile_sums[i - 1], tile_sums[i]);
+  }
+
+  // scan each tile
+  THRUST_TRACE_PHASE("scan tiles");
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator  iter1 = first  + decomp[i].begin();
+    InputIterator  end1  = first  + decomp[i].end();
+    OutputIterator iter2 = result + decomp[i].begin();
+
+    // the first tile has no carry-in
+    ValueType sum = (i == 0) ? ValueType(*iter1) : ValueType(tile_sums[i - 1]);
+
+    if(i == 0)
+    {
+      *iter2 = sum;
+      ++iter1;
+      ++iter2;
+    }
+
+    for(; iter1 != end1; ++iter1, ++iter2)
+    {
+      *iter2 = sum = wrapped_binary_op(sum, *iter1);
+    }
+  }
+
+  return result + n;
+} // end inclusive_scan()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  // Use the initial value type per https://wg21.link/P0571
+  typedef InitialValueType                                           ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                   index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  THRUST_TRACE_SCOPE("exclusive_scan", "omp", n);
+
+  if(n == 0)
+    return result;
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n, reduction_grain_size<InputIterator,ValueType,BinaryFunction>());
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // reduce each tile
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> tile_sums(exec, num_tiles);
+  {
+    THRUST_TRACE_PHASE("reduce tiles");
+
+    thrust::system::omp::detail::reduce_intervals(exec, first, tile_sums.begin(), binary_op, decomp);
+  }
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // tile_sums[i] becomes the carry-in of tile i
+  ValueType carry = init;
+
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    ValueType tile_sum = tile_sums[i];
+    tile_sums[i] = carry;
+    carry = wrapped_binary_op(carry, tile_sum);
+  }
+
+  // scan each tile
+  THRUST_TRACE_PHASE("scan tiles");
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator  iter1 = first  + decomp[i].begin();
+    InputIterator  end1  = first  + decomp[i].end();
+    OutputIterator iter2 = result + decomp[i].begin();
+
+    ValueType sum = tile_sums[i];
+
+    for(; iter1 != end1; ++iter1, ++iter2)
+    {
+      ValueType temp = *iter1; // temporary value allows in-situ scan
+      *iter2 = sum;
+      sum = wrapped_binary_op(sum, temp);
+    }
+  }
+
+  return result + n;
+} // end exclusive_scan()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
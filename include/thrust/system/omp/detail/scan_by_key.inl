@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/scan_by_key.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+
+// Reduces the last segment of every tile and chains the partial sums
+// across tile boundaries. On return, carries[t] holds the carry into tile t
+// if continues[t] is true.
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Decomposition,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+void compute_carries(InputIterator1 first1,
+                     InputIterator2 first2,
+                     Decomposition decomp,
+                     ValueType *sums,
+                     bool *has_head,
+                     bool *continues,
+                     ValueType *carries,
+                     BinaryPredicate binary_pred,
+                     BinaryFunction binary_op)
+{
+  typedef typename Decomposition::index_type index_type;
+
+  const index_type num_tiles = decomp.size();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(index_type t = 0; t < num_tiles; ++t)
+  {
+    const index_type begin = decomp[t].begin();
+
+    has_head[t]  = thrust::system::detail::internal::reduce_last_segment(first1, first2, begin, decomp[t].end(), sums[t], binary_pred, binary_op) > begin;
+    continues[t] = (t > 0) && binary_pred(first1[begin - 1], first1[begin]);
+  }
+
+  thrust::system::detail::internal::propagate_segment_carries(sums, has_head, continues, carries, num_tiles, binary_op);
+}
+
+
+} // end scan_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_traits<InputIterator2>::value_type ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type   difference_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_tiles);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      has_head(0, exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      continues(0, exec, num_tiles);
+
+  ValueType *carries_ptr   = thrust::raw_pointer_cast(carries.data());
+  bool      *continues_ptr = thrust::raw_pointer_cast(continues.data());
+
+  scan_by_key_detail::compute_carries(first1, first2, decomp,
+                                      thrust::raw_pointer_cast(sums.data()),
+                                      thrust::raw_pointer_cast(has_head.data()),
+                                      continues_ptr,
+                                      carries_ptr,
+                                      binary_pred, wrapped_binary_op);
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    thrust::system::detail::internal::inclusive_scan_by_key_tile(first1, first2, result,
+                                                                 decomp[t].begin(), decomp[t].end(),
+                                                                 continues_ptr[t] ? carries_ptr + t : static_cast<ValueType*>(0),
+                                                                 binary_pred, wrapped_binary_op);
+  }
+
+  return result + n;
+} // end inclusive_scan_by_key()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef T                                                          ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_tiles);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      has_head(0, exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      continues(0, exec, num_tiles);
+
+  ValueType *carries_ptr   = thrust::raw_pointer_cast(carries.data());
+  bool      *continues_ptr = thrust::raw_pointer_cast(continues.data());
+
+  scan_by_key_detail::compute_carries(first1, first2, decomp,
+                                      thrust::raw_pointer_cast(sums.data()),
+                                      thrust::raw_pointer_cast(has_head.data()),
+                                      continues_ptr,
+                                      carries_ptr,
+                                      binary_pred, wrapped_binary_op);
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    thrust::system::detail::internal::exclusive_scan_by_key_tile(first1, first2, result,
+                                                                 decomp[t].begin(), decomp[t].end(),
+                                                                 continues_ptr[t] ? carries_ptr + t : static_cast<ValueType*>(0),
+                                                                 init,
+                                                                 binary_pred, wrapped_binary_op);
+  }
+
+  return result + n;
+} // end exclusive_scan_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/segmented_reduce.h>
+#include <thrust/system/omp/detail/for_each_segment.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace segmented_reduce_detail
+{
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename T,
+         typename BinaryFunction>
+struct reduce_segment
+{
+  InputIterator first;
+  OutputIterator result;
+  T init;
+  BinaryFunction binary_op;
+
+  reduce_segment(InputIterator first, OutputIterator result, T init, BinaryFunction binary_op)
+    : first(first), result(result), init(init), binary_op(binary_op)
+  {}
+
+  template<typename Policy, typename Size>
+  void operator()(const Policy &policy, Size i, Size begin, Size end) const
+  {
+    result[i] = thrust::reduce(policy, first + begin, first + end, init, binary_op);
+  }
+};
+
+
+} // end segmented_reduce_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OffsetIterator,
+         typename OutputIterator,
+         typename T,
+         typename BinaryFunction>
+  OutputIterator segmented_reduce(execution_policy<DerivedPolicy> &exec,
+                                  InputIterator first,
+                                  InputIterator,
+                                  OffsetIterator offsets_first,
+                                  OffsetIterator offsets_last,
+                                  OutputIterator result,
+                                  T init,
+                                  BinaryFunction binary_op)
+{
+  const typename thrust::iterator_difference<OffsetIterator>::type num_offsets = thrust::distance(offsets_first, offsets_last);
+
+  if(num_offsets < 2) return result;
+
+  thrust::system::omp::detail::for_each_segment(exec, offsets_first, offsets_last,
+    segmented_reduce_detail::reduce_segment<InputIterator,OutputIterator,T,BinaryFunction>(first, result, init, binary_op));
+
+  return result + (num_offsets - 1);
+} // end segmented_reduce()
+
+
+} // end detail
+} // end omp
+} // end system
+THRUST_NAMESPACE_END
+
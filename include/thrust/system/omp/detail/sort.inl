@@ -18,18 +18,21 @@
 
 #include <thrust/detail/config.h>
 
-// don't attempt to #include this file without omp support
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-#include <omp.h>
-#endif // omp support
-
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/system/detail/internal/sort_tile.h>
+#include <thrust/detail/static_assert.h>
 #include <thrust/system/detail/generic/select_system.h>
 #include <thrust/sort.h>
 #include <thrust/merge.h>
+#include <thrust/copy.h>
 #include <thrust/detail/seq.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/detail/trace.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -42,21 +45,248 @@ namespace sort_detail
 {
 
 
+// Merges each pair of adjacent runs of the form
+//   [decomp[j].begin(), decomp[j + w].begin()), [decomp[j + w].begin(), decomp[j + 2w].begin())
+// where j is a multiple of 2w, from src into dst. Output tile p is produced
+// by iteration p, which locates its share of the two runs with a merge path
+// search, so every level of the merge tree uses all the tiles.
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Decomposition,
+         typename StrictWeakOrdering>
+void merge_level(RandomAccessIterator1 src,
+                 RandomAccessIterator2 dst,
+                 Decomposition decomp,
+                 typename Decomposition::index_type w,
+                 StrictWeakOrdering comp)
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  const IndexType num_tiles = decomp.size();
+  const IndexType n         = decomp[num_tiles - 1].end();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(IndexType p = 0; p < num_tiles; ++p)
+  {
+    const IndexType first_tile = (p / (2 * w)) * (2 * w);
+    const IndexType mid_tile   = first_tile + w;
+    const IndexType last_tile  = (first_tile + 2 * w < num_tiles) ? first_tile + 2 * w : num_tiles;
+
+    const IndexType begin1 = decomp[first_tile].begin();
+    const IndexType begin2 = (mid_tile < num_tiles) ? decomp[mid_tile].begin() : n;
+    const IndexType end2   = decomp[last_tile - 1].end();
+
+    const IndexType diag_begin = decomp[p].begin() - begin1;
+    const IndexType diag_end   = decomp[p].end()   - begin1;
+
+    const IndexType i_begin = thrust::system::detail::internal::merge_path(src + begin1, begin2 - begin1, src + begin2, end2 - begin2, diag_begin, comp);
+    const IndexType i_end   = thrust::system::detail::internal::merge_path(src + begin1, begin2 - begin1, src + begin2, end2 - begin2, diag_end,   comp);
+
+    thrust::merge(thrust::seq,
+                  src + begin1 + i_begin, src + begin1 + i_end,
+                  src + begin2 + (diag_begin - i_begin), src + begin2 + (diag_end - i_end),
+                  dst + decomp[p].begin(),
+                  comp);
+  }
+}
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Decomposition,
+         typename StrictWeakOrdering>
+void merge_level_by_key(RandomAccessIterator1 keys_src,
+                        RandomAccessIterator2 values_src,
+                        RandomAccessIterator3 keys_dst,
+                        RandomAccessIterator4 values_dst,
+                        Decomposition decomp,
+                        typename Decomposition::index_type w,
+                        StrictWeakOrdering comp)
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  const IndexType num_tiles = decomp.size();
+  const IndexType n         = decomp[num_tiles - 1].end();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(IndexType p = 0; p < num_tiles; ++p)
+  {
+    const IndexType first_tile = (p / (2 * w)) * (2 * w);
+    const IndexType mid_tile   = first_tile + w;
+    const IndexType last_tile  = (first_tile + 2 * w < num_tiles) ? first_tile + 2 * w : num_tiles;
+
+    const IndexType begin1 = decomp[first_tile].begin();
+    const IndexType begin2 = (mid_tile < num_tiles) ? decomp[mid_tile].begin() : n;
+    const IndexType end2   = decomp[last_tile - 1].end();
+
+    const IndexType diag_begin = decomp[p].begin() - begin1;
+    const IndexType diag_end   = decomp[p].end()   - begin1;
+
+    const IndexType i_begin = thrust::system::detail::internal::merge_path(keys_src + begin1, begin2 - begin1, keys_src + begin2, end2 - begin2, diag_begin, comp);
+    const IndexType i_end   = thrust::system::detail::internal::merge_path(keys_src + begin1, begin2 - begin1, keys_src + begin2, end2 - begin2, diag_end,   comp);
+
+    const IndexType j_begin = diag_begin - i_begin;
+    const IndexType j_end   = diag_end   - i_end;
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_src + begin1 + i_begin, keys_src + begin1 + i_end,
+                         keys_src + begin2 + j_begin, keys_src + begin2 + j_end,
+                         values_src + begin1 + i_begin,
+                         values_src + begin2 + j_begin,
+                         keys_dst + decomp[p].begin(),
+                         values_dst + decomp[p].begin(),
+                         comp);
+  }
+}
+
+
+// returns the number of levels in a merge tree with num_tiles leaves
+template<typename IndexType>
+int num_merge_levels(IndexType num_tiles)
+{
+  int result = 0;
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+    ++result;
+
+  return result;
+}
+
+
+
+
+// Sorts the tiles' elements by one digit from src into dst. Returns false
+// without touching dst if the pass can be skipped.
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Decomposition>
+bool radix_pass(Digit digit,
+                RandomAccessIterator1 src,
+                RandomAccessIterator2 dst,
+                Decomposition decomp,
+                size_t *histograms)
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  const IndexType num_tiles = decomp.size();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(IndexType p = 0; p < num_tiles; ++p)
+  {
+    thrust::system::detail::internal::radix_histogram(digit, src, decomp[p].begin(), decomp[p].end(), histograms + p * Digit::num_buckets);
+  }
+
+  if(!thrust::system::detail::internal::radix_scan_histograms<Digit>(histograms, num_tiles, decomp[num_tiles - 1].end()))
+    return false;
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(IndexType p = 0; p < num_tiles; ++p)
+  {
+    thrust::system::detail::internal::radix_scatter(digit, src, decomp[p].begin(), decomp[p].end(), dst, histograms + p * Digit::num_buckets);
+  }
+
+  return true;
+}
+
+
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Decomposition>
+bool radix_pass_by_key(Digit digit,
+                       RandomAccessIterator1 keys_src,
+                       RandomAccessIterator2 values_src,
+                       RandomAccessIterator3 keys_dst,
+                       RandomAccessIterator4 values_dst,
+                       Decomposition decomp,
+                       size_t *histograms)
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  const IndexType num_tiles = decomp.size();
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(IndexType p = 0; p < num_tiles; ++p)
+  {
+    thrust::system::detail::internal::radix_histogram(digit, keys_src, decomp[p].begin(), decomp[p].end(), histograms + p * Digit::num_buckets);
+  }
+
+  if(!thrust::system::detail::internal::radix_scan_histograms<Digit>(histograms, num_tiles, decomp[num_tiles - 1].end()))
+    return false;
+
+  THRUST_PRAGMA_OMP(parallel for if(num_tiles > 1) num_threads(num_tiles))
+  for(IndexType p = 0; p < num_tiles; ++p)
+  {
+    thrust::system::detail::internal::radix_scatter(digit, keys_src, values_src, decomp[p].begin(), decomp[p].end(), keys_dst, values_dst, histograms + p * Digit::num_buckets);
+  }
+
+  return true;
+}
+
+
+// XXX this value is a tuning opportunity
+const static int radix_sort_threshold = 1 << 16;
+
+
+////////////////
+// Radix Sort //
+////////////////
+
+
 template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy> &exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      KeyType;
+  typedef thrust::system::detail::internal::radix_digit<KeyType,StrictWeakOrdering> Digit;
+
+  const IndexType n = last - first;
+
+  if(n < radix_sort_threshold)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::system::detail::internal::serial_policy(exec), first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  thrust::detail::temporary_array<KeyType,DerivedPolicy> temp(0, exec, n);
+  thrust::detail::temporary_array<size_t,DerivedPolicy>  histograms(0, exec, decomp.size() * Digit::num_buckets);
+
+  KeyType *temp_ptr       = thrust::raw_pointer_cast(temp.data());
+  size_t  *histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  // false if the most recent data is in [first, last)
+  bool temp_is_source = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    THRUST_TRACE_PHASE("radix pass");
 
-  thrust::detail::temporary_array<value_type,DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type,DerivedPolicy> b(exec, middle, last);
+    bool shuffled = temp_is_source ?
+      radix_pass(Digit(pass), temp_ptr, first, decomp, histograms_ptr) :
+      radix_pass(Digit(pass), first, temp_ptr, decomp, histograms_ptr);
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+    if(shuffled)
+      temp_is_source = !temp_is_source;
+  }
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, temp.begin(), temp.end(), first);
+  }
 }
 
 
@@ -64,34 +294,63 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator1,
          typename RandomAccessIterator2,
          typename StrictWeakOrdering>
-void inplace_merge_by_key(execution_policy<DerivedPolicy> &exec,
-                          RandomAccessIterator1 first1,
-                          RandomAccessIterator1 middle1,
-                          RandomAccessIterator1 last1,
-                          RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
-
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1   - first1);
-
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> rhs2(exec, middle2, last2);
-
-  thrust::merge_by_key(thrust::seq,
-                       lhs1.begin(), lhs1.end(),
-                       rhs1.begin(), rhs1.end(),
-                       lhs2.begin(), rhs2.begin(),
-                       first1, first2,
-                       comp);
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+  typedef thrust::system::detail::internal::radix_digit<KeyType,StrictWeakOrdering> Digit;
+
+  const IndexType n = keys_last - keys_first;
+
+  if(n < radix_sort_threshold)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::system::detail::internal::serial_policy(exec), keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys_temp(0, exec, n);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values_temp(exec, n);
+  thrust::detail::temporary_array<size_t,DerivedPolicy>    histograms(0, exec, decomp.size() * Digit::num_buckets);
+
+  KeyType   *keys_temp_ptr   = thrust::raw_pointer_cast(keys_temp.data());
+  ValueType *values_temp_ptr = thrust::raw_pointer_cast(values_temp.data());
+  size_t    *histograms_ptr  = thrust::raw_pointer_cast(histograms.data());
+
+  // false if the most recent data is in [keys_first, keys_last)
+  bool temp_is_source = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    THRUST_TRACE_PHASE("radix pass");
+
+    bool shuffled = temp_is_source ?
+      radix_pass_by_key(Digit(pass), keys_temp_ptr, values_temp_ptr, keys_first, values_first, decomp, histograms_ptr) :
+      radix_pass_by_key(Digit(pass), keys_first, values_first, keys_temp_ptr, values_temp_ptr, decomp, histograms_ptr);
+
+    if(shuffled)
+      temp_is_source = !temp_is_source;
+  }
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, keys_temp.begin(), keys_temp.end(), keys_first);
+    thrust::copy(exec, values_temp.begin(), values_temp.end(), values_first);
+  }
 }
 
 
-} // end sort_detail
+////////////////
+// Merge Sort //
+////////////////
 
 
 template<typename DerivedPolicy,
@@ -100,78 +359,184 @@ template<typename DerivedPolicy,
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
-  // we're attempting to launch an omp kernel, assert we're compiling with omp support
-  // ========================================================================
-  // X Note to the user: If you've found this line due to a compiler error, X
-  // X you need to enable OpenMP support in your compiler.                  X
-  // ========================================================================
-  THRUST_STATIC_ASSERT_MSG(
-    (thrust::detail::depend_on_instantiation<
-      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    >::value)
-  , "OpenMP compiler support is not enabled"
-  );
-
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      ValueType;
 
   if(first == last)
     return;
 
-  THRUST_PRAGMA_OMP(parallel)
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition<IndexType>(exec, last - first);
+
+  const IndexType num_tiles = decomp.size();
+
+  if(num_tiles == 1)
   {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::system::detail::internal::serial_policy(exec), first, last, comp);
+    return;
+  }
+
+  // a single buffer, allocated here so that the allocator is never called
+  // from inside a parallel region, is the scratch space of the tile sorts and
+  // then the other half of the merges
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> temp(exec, last - first);
 
-    // process id
-    IndexType p_i = omp_get_thread_num();
+  ValueType *temp_ptr = thrust::raw_pointer_cast(temp.data());
 
-    // every thread sorts its own tile
-    if(p_i < decomp.size())
+  // every thread sorts its own tile
+  {
+    THRUST_TRACE_PHASE("tile sort");
+
+    THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+    for(IndexType p = 0; p < num_tiles; ++p)
     {
-      thrust::stable_sort(thrust::seq,
-                          first + decomp[p_i].begin(),
-                          first + decomp[p_i].end(),
-                          comp);
+      thrust::system::detail::internal::sort_tile(first + decomp[p].begin(),
+                                                  first + decomp[p].end(),
+                                                  temp_ptr + decomp[p].begin(),
+                                                  comp);
     }
+  }
 
-    THRUST_PRAGMA_OMP(barrier)
+  // merge the sorted tiles pairwise, alternating between [first, last) and
+  // the buffer; starting from a copy in the buffer when the number of levels
+  // is odd leaves the result of the last level in [first, last)
+  bool temp_is_source = (sort_detail::num_merge_levels(num_tiles) % 2) == 1;
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, first, last, temp.begin());
+  }
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+  {
+    THRUST_TRACE_PHASE("merge");
+
+    if(temp_is_source)
+    {
+      sort_detail::merge_level(temp.begin(), first, decomp, w, comp);
+    }
+    else
+    {
+      sort_detail::merge_level(first, temp.begin(), decomp, w, comp);
+    }
+
+    temp_is_source = !temp_is_source;
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+
+  if(keys_first == keys_last)
+    return;
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition<IndexType>(exec, keys_last - keys_first);
+
+  const IndexType num_tiles = decomp.size();
+
+  if(num_tiles == 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::system::detail::internal::serial_policy(exec), keys_first, keys_last, values_first, comp);
+    return;
+  }
 
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
+  // see merge sort version of stable_sort
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys_temp(exec, keys_last - keys_first);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values_temp(exec, keys_last - keys_first);
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
+  KeyType   *keys_temp_ptr   = thrust::raw_pointer_cast(keys_temp.data());
+  ValueType *values_temp_ptr = thrust::raw_pointer_cast(values_temp.data());
 
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
+  // every thread sorts its own tile
+  {
+    THRUST_TRACE_PHASE("tile sort");
 
-    while(nseg>1)
+    THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+    for(IndexType p = 0; p < num_tiles; ++p)
     {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
+      thrust::system::detail::internal::sort_tile_by_key(keys_first + decomp[p].begin(),
+                                                         keys_first + decomp[p].end(),
+                                                         values_first + decomp[p].begin(),
+                                                         keys_temp_ptr + decomp[p].begin(),
+                                                         values_temp_ptr + decomp[p].begin(),
+                                                         comp);
+    }
+  }
 
-      if((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge(exec,
-                                   first + decomp[a].begin(),
-                                   first + decomp[b].end(),
-                                   first + decomp[c].end(),
-                                   comp);
+  RandomAccessIterator2 values_last = values_first + (keys_last - keys_first);
 
-        b = c;
-        c += h;
-      }
+  bool temp_is_source = (sort_detail::num_merge_levels(num_tiles) % 2) == 1;
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
+  if(temp_is_source)
+  {
+    thrust::copy(exec, keys_first, keys_last, keys_temp.begin());
+    thrust::copy(exec, values_first, values_last, values_temp.begin());
+  }
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+  {
+    THRUST_TRACE_PHASE("merge");
 
-      THRUST_PRAGMA_OMP(barrier)
+    if(temp_is_source)
+    {
+      sort_detail::merge_level_by_key(keys_temp.begin(), values_temp.begin(), keys_first, values_first, decomp, w, comp);
+    }
+    else
+    {
+      sort_detail::merge_level_by_key(keys_first, values_first, keys_temp.begin(), values_temp.begin(), decomp, w, comp);
     }
+
+    temp_is_source = !temp_is_source;
   }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+}
+
+
+} // end sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+  thrust::system::detail::internal::use_radix_sort<KeyType,StrictWeakOrdering> use_radix_sort;
+
+  THRUST_TRACE_SCOPE("stable_sort", "omp", last - first);
+
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
 }
 
 
@@ -197,66 +562,12 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
   , "OpenMP compiler support is not enabled"
   );
 
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
-#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  thrust::system::detail::internal::use_radix_sort<KeyType,StrictWeakOrdering> use_radix_sort;
 
-  if(keys_first == keys_last)
-    return;
+  THRUST_TRACE_SCOPE("stable_sort_by_key", "omp", keys_last - keys_first);
 
-  THRUST_PRAGMA_OMP(parallel)
-  {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(keys_last - keys_first, 1, omp_get_num_threads());
-
-    // process id
-    IndexType p_i = omp_get_thread_num();
-
-    // every thread sorts its own tile
-    if(p_i < decomp.size())
-    {
-      thrust::stable_sort_by_key(thrust::seq,
-                                 keys_first + decomp[p_i].begin(),
-                                 keys_first + decomp[p_i].end(),
-                                 values_first + decomp[p_i].begin(),
-                                 comp);
-    }
-
-    THRUST_PRAGMA_OMP(barrier)
-
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
-
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
-
-    while(nseg>1)
-    {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge_by_key(exec,
-                                          keys_first + decomp[a].begin(),
-                                          keys_first + decomp[b].end(),
-                                          keys_first + decomp[c].end(),
-                                          values_first + decomp[a].begin(),
-                                          comp);
-
-        b = c;
-        c += h;
-      }
-
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
-      THRUST_PRAGMA_OMP(barrier)
-    }
-  }
-#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_radix_sort);
 }
 
 
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file stream_compaction.h
+ *  \brief Building blocks shared by the OpenMP implementations of copy_if, remove, unique and partition.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// Stream compaction proceeds tile by tile, without materializing a flag per
+// element: each tile counts the elements it keeps, the counts are scanned into
+// the tiles' output offsets, and each tile then writes its elements from its
+// offset on.
+
+// counts the elements of each tile of decomp for which pred(stencil[i]) holds,
+// and scans the counts: offsets[t] receives the number of elements kept before
+// tile t, and offsets[decomp.size()] the total
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename Predicate,
+          typename Decomposition,
+          typename Size>
+void compaction_offsets(execution_policy<DerivedPolicy> &exec,
+                        InputIterator stencil,
+                        Predicate pred,
+                        Decomposition decomp,
+                        Size *offsets);
+
+// finishes an in-place compaction after each tile of decomp has been compacted
+// in place: counts[t + 1] holds the number of elements kept at the start of
+// tile t. The kept elements are moved together, the counts are scanned into
+// offsets as compaction_offsets computes them, and the end of the result is
+// returned
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename Decomposition,
+          typename Size>
+ForwardIterator gather_tiles(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator first,
+                             Decomposition decomp,
+                             Size *counts);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/omp/detail/stream_compaction.inl>
+
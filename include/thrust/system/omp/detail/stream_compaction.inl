@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/stream_compaction.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/detail/internal_functional.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/functional.h>
+#include <thrust/copy.h>
+#include <thrust/uninitialized_copy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename Predicate,
+          typename Decomposition,
+          typename Size>
+void compaction_offsets(execution_policy<DerivedPolicy> &exec,
+                        InputIterator stencil,
+                        Predicate pred,
+                        Decomposition decomp,
+                        Size *offsets)
+{
+  const Size num_tiles = decomp.size();
+
+  thrust::system::omp::detail::reduce_intervals(exec,
+                                                thrust::make_transform_iterator(stencil, thrust::detail::predicate_to_integral<Predicate,Size>(pred)),
+                                                offsets + 1,
+                                                thrust::plus<Size>(),
+                                                decomp);
+
+  // there are only as many counts as threads, so scan them serially
+  offsets[0] = 0;
+
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    offsets[t + 1] += offsets[t];
+  }
+}
+
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename Decomposition,
+          typename Size>
+ForwardIterator gather_tiles(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator first,
+                             Decomposition decomp,
+                             Size *counts)
+{
+  typedef typename thrust::iterator_value<ForwardIterator>::type ValueType;
+
+  const Size num_tiles = decomp.size();
+
+  counts[0] = 0;
+
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    counts[t + 1] += counts[t];
+  }
+
+  // the tiles preceded only by tiles which kept everything are in place already
+  Size first_moved = 1;
+
+  while(first_moved < num_tiles && counts[first_moved] == decomp[first_moved].begin())
+  {
+    ++first_moved;
+  }
+
+  const Size num_moved = counts[num_tiles] - counts[first_moved];
+
+  if(num_moved > 0)
+  {
+    // the destination of a tile may overlap the elements kept by the tiles
+    // before it, so the elements are moved through a temporary buffer
+    thrust::detail::temporary_array<ValueType,DerivedPolicy> temp(0, exec, num_moved);
+
+    ValueType *temp_ptr = thrust::raw_pointer_cast(temp.data());
+
+    THRUST_PRAGMA_OMP(parallel for if(num_tiles - first_moved > 1) num_threads(num_tiles - first_moved))
+    for(Size t = first_moved; t < num_tiles; ++t)
+    {
+      ForwardIterator tile_first = first + decomp[t].begin();
+
+      thrust::uninitialized_copy(thrust::seq,
+                                 tile_first, tile_first + (counts[t + 1] - counts[t]),
+                                 temp_ptr + (counts[t] - counts[first_moved]));
+    }
+
+    thrust::copy(exec, temp_ptr, temp_ptr + num_moved, first + counts[first_moved]);
+  }
+
+  return first + counts[num_tiles];
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/transform_reduce_multi.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/generic/transform_reduce_multi.h>
+#include <thrust/system/detail/internal/transform_reduce_multi.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace transform_reduce_multi_detail
+{
+
+
+// every tile reduces its elements into private results, which are combined
+// in tile order at the end
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(execution_policy<DerivedPolicy> &exec,
+           InputIterator first,
+           InputIterator last,
+           thrust::detail::true_type,
+           Reductions... reductions)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::tuple<typename Reductions::value_type...>          result_type;
+
+  thrust::tuple<Reductions...> reductions_tuple(reductions...);
+
+  thrust::system::detail::internal::multi_transform<Reductions...> transform(reductions_tuple);
+  thrust::system::detail::internal::multi_combine<Reductions...>   combine(reductions_tuple);
+
+  result_type result = thrust::system::detail::internal::multi_init(reductions...);
+
+  const difference_type n = last - first;
+
+  if(n == 0) return result;
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return combine(result, thrust::system::detail::internal::multi_reduce_n(first, n, transform));
+  }
+
+  thrust::detail::temporary_array<result_type,DerivedPolicy> partials(exec, num_tiles);
+
+  result_type *partials_ptr = thrust::raw_pointer_cast(partials.data());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    partials_ptr[t] = thrust::system::detail::internal::multi_reduce_n(first + decomp[t].begin(), decomp[t].size(), transform);
+  }
+
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    result = combine(result, partials_ptr[t]);
+  }
+
+  return result;
+} // end reduce()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(execution_policy<DerivedPolicy> &exec,
+           InputIterator first,
+           InputIterator last,
+           thrust::detail::false_type,
+           Reductions... reductions)
+{
+  // other ranges take a single reduction of tuples
+  return thrust::system::detail::generic::transform_reduce_multi(exec, first, last, reductions...);
+} // end reduce()
+
+
+} // end transform_reduce_multi_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(execution_policy<DerivedPolicy> &exec,
+                           InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions)
+{
+  return transform_reduce_multi_detail::reduce(exec, first, last, thrust::is_contiguous_iterator<InputIterator>(), reductions...);
+} // end transform_reduce_multi()
+
+
+} // end detail
+} // end omp
+} // end system
+THRUST_NAMESPACE_END
+
@@ -18,7 +18,13 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/unique.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/stream_compaction.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 #include <thrust/system/detail/generic/unique.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
 #include <thrust/pair.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -30,6 +36,51 @@ namespace detail
 {
 
 
+namespace unique_detail
+{
+
+
+// compacts [first, last) in place, keeping every element which is not
+// equivalent to the element before it, and the first one if keep_first
+// every comparison is between two elements of the input: the element before
+// *i is only ever overwritten by itself before *i is tested
+template<typename ForwardIterator,
+         typename BinaryPredicate>
+  ForwardIterator unique_tile(ForwardIterator first,
+                              ForwardIterator last,
+                              bool keep_first,
+                              BinaryPredicate binary_pred)
+{
+  if(first == last)
+  {
+    return first;
+  }
+
+  ForwardIterator result = first;
+
+  if(keep_first)
+  {
+    ++result;
+  }
+
+  ForwardIterator prev = first;
+
+  for(++first; first != last; ++first, ++prev)
+  {
+    if(!binary_pred(*prev, *first))
+    {
+      *result = *first;
+      ++result;
+    }
+  }
+
+  return result;
+}
+
+
+} // end namespace unique_detail
+
+
 template<typename DerivedPolicy,
          typename ForwardIterator,
          typename BinaryPredicate>
@@ -38,8 +89,46 @@ template<typename DerivedPolicy,
                          ForwardIterator last,
                          BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique to cpp::unique
-  return thrust::system::detail::generic::unique(exec,first,last,binary_pred);
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return unique_detail::unique_tile(first, last, true, binary_pred);
+  }
+
+  // whether the first element of each tile is kept has to be decided before
+  // the tile in front of it is compacted
+  thrust::detail::temporary_array<bool,DerivedPolicy>            keep_head(0, exec, num_tiles);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> counts(0, exec, num_tiles + 1);
+
+  bool            *keep_head_ptr = thrust::raw_pointer_cast(keep_head.data());
+  difference_type *counts_ptr    = thrust::raw_pointer_cast(counts.data());
+
+  keep_head_ptr[0] = true;
+
+  for(difference_type t = 1; t < num_tiles; ++t)
+  {
+    ForwardIterator head = first + decomp[t].begin();
+
+    keep_head_ptr[t] = !binary_pred(*(head - 1), *head);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    ForwardIterator tile_first = first + decomp[t].begin();
+
+    counts_ptr[t + 1] = unique_detail::unique_tile(tile_first, first + decomp[t].end(), keep_head_ptr[t], binary_pred) - tile_first;
+  }
+
+  return thrust::system::omp::detail::gather_tiles(exec, first, decomp, counts_ptr);
 } // end unique()
 
 
@@ -18,7 +18,14 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/unique_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/stream_compaction.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 #include <thrust/system/detail/generic/unique_by_key.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
 #include <thrust/pair.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -30,6 +37,58 @@ namespace detail
 {
 
 
+namespace unique_by_key_detail
+{
+
+
+// the by_key version of unique_detail::unique_tile, which returns the number
+// of elements kept
+template<typename ForwardIterator1,
+         typename ForwardIterator2,
+         typename BinaryPredicate>
+  typename thrust::iterator_difference<ForwardIterator1>::type
+    unique_by_key_tile(ForwardIterator1 keys_first,
+                       ForwardIterator1 keys_last,
+                       ForwardIterator2 values_first,
+                       bool keep_first,
+                       BinaryPredicate binary_pred)
+{
+  if(keys_first == keys_last)
+  {
+    return 0;
+  }
+
+  const ForwardIterator1 keys_begin = keys_first;
+
+  ForwardIterator1 keys_result   = keys_first;
+  ForwardIterator2 values_result = values_first;
+
+  if(keep_first)
+  {
+    ++keys_result;
+    ++values_result;
+  }
+
+  ForwardIterator1 prev = keys_first;
+
+  for(++keys_first, ++values_first; keys_first != keys_last; ++keys_first, ++values_first, ++prev)
+  {
+    if(!binary_pred(*prev, *keys_first))
+    {
+      *keys_result   = *keys_first;
+      *values_result = *values_first;
+      ++keys_result;
+      ++values_result;
+    }
+  }
+
+  return keys_result - keys_begin;
+}
+
+
+} // end namespace unique_by_key_detail
+
+
 template<typename DerivedPolicy,
          typename ForwardIterator1,
          typename ForwardIterator2,
@@ -41,8 +100,53 @@ template<typename DerivedPolicy,
                   ForwardIterator2 values_first,
                   BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique_by_key to cpp::unique_by_key
-  return thrust::system::detail::generic::unique_by_key(exec,keys_first,keys_last,values_first,binary_pred);
+  typedef typename thrust::iterator_difference<ForwardIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(keys_first, keys_last);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    difference_type size = unique_by_key_detail::unique_by_key_tile(keys_first, keys_last, values_first, true, binary_pred);
+    return thrust::make_pair(keys_first + size, values_first + size);
+  }
+
+  // see unique
+  thrust::detail::temporary_array<bool,DerivedPolicy>            keep_head(0, exec, num_tiles);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> counts(0, exec, num_tiles + 1);
+
+  bool            *keep_head_ptr = thrust::raw_pointer_cast(keep_head.data());
+  difference_type *counts_ptr    = thrust::raw_pointer_cast(counts.data());
+
+  keep_head_ptr[0] = true;
+
+  for(difference_type t = 1; t < num_tiles; ++t)
+  {
+    ForwardIterator1 head = keys_first + decomp[t].begin();
+
+    keep_head_ptr[t] = !binary_pred(*(head - 1), *head);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(num_tiles))
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    counts_ptr[t + 1] = unique_by_key_detail::unique_by_key_tile(keys_first + decomp[t].begin(),
+                                                                 keys_first + decomp[t].end(),
+                                                                 values_first + decomp[t].begin(),
+                                                                 keep_head_ptr[t],
+                                                                 binary_pred);
+  }
+
+  const difference_type size = thrust::system::omp::detail::gather_tiles(exec,
+                                                                        thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first)),
+                                                                        decomp,
+                                                                        counts_ptr) - thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first));
+
+  return thrust::make_pair(keys_first + size, values_first + size);
 } // end unique_by_key()
 
 
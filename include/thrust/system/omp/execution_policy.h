@@ -44,12 +44,14 @@
 #include <thrust/system/omp/detail/gather.h>
 #include <thrust/system/omp/detail/generate.h>
 #include <thrust/system/omp/detail/get_value.h>
+#include <thrust/system/omp/detail/histogram.h>
 #include <thrust/system/omp/detail/inner_product.h>
 #include <thrust/system/omp/detail/iter_swap.h>
 #include <thrust/system/omp/detail/logical.h>
 #include <thrust/system/omp/detail/malloc_and_free.h>
 #include <thrust/system/omp/detail/merge.h>
 #include <thrust/system/omp/detail/mismatch.h>
+#include <thrust/system/omp/detail/partial_sort.h>
 #include <thrust/system/omp/detail/partition.h>
 #include <thrust/system/omp/detail/reduce.h>
 #include <thrust/system/omp/detail/reduce_by_key.h>
@@ -59,6 +61,8 @@
 #include <thrust/system/omp/detail/scan.h>
 #include <thrust/system/omp/detail/scan_by_key.h>
 #include <thrust/system/omp/detail/scatter.h>
+#include <thrust/system/omp/detail/segmented_reduce.h>
+#include <thrust/system/omp/detail/segmented_sort.h>
 #include <thrust/system/omp/detail/sequence.h>
 #include <thrust/system/omp/detail/set_operations.h>
 #include <thrust/system/omp/detail/sort.h>
@@ -66,12 +70,19 @@
 #include <thrust/system/omp/detail/tabulate.h>
 #include <thrust/system/omp/detail/transform.h>
 #include <thrust/system/omp/detail/transform_reduce.h>
+#include <thrust/system/omp/detail/transform_reduce_multi.h>
 #include <thrust/system/omp/detail/transform_scan.h>
 #include <thrust/system/omp/detail/uninitialized_copy.h>
 #include <thrust/system/omp/detail/uninitialized_fill.h>
 #include <thrust/system/omp/detail/unique.h>
 #include <thrust/system/omp/detail/unique_by_key.h>
 
+// the executor of the asynchronous algorithms, so that thrust::async uses it
+// whether or not this system is the host or device system
+#if THRUST_CPP_DIALECT >= 2014
+#include <thrust/system/omp/detail/async/executor.h>
+#endif
+
 
 // define these entities here for the purpose of Doxygenating them
 // they are actually defined elsewhere
@@ -115,6 +126,19 @@ struct tag : thrust::system::omp::execution_policy<tag> { unspecified };
  *
  *  The type of \p thrust::omp::par is implementation-defined.
  *
+ *  By default, inputs are split across every thread. Reductions and scans of contiguous
+ *  arithmetic values with \p plus, \p multiplies, \p minimum or \p maximum are the exception:
+ *  their elements are cheap enough that they only split once each thread receives a few tens of
+ *  thousands of elements, and smaller inputs run serially without entering a parallel region.
+ *  <tt>thrust::omp::par.with(grain_size, max_threads)</tt> overrides the smallest number of
+ *  elements given to a thread and the largest number of threads used; zero selects the default
+ *  for either.
+ *
+ *  <tt>thrust::omp::par(alloc)</tt> allocates the temporary storage of an algorithm through \p alloc, including that of
+ *  the serial path taken for small inputs. Temporary storage is only requested from the thread invoking the algorithm,
+ *  so an allocator backed by a \p thrust::mr::unsynchronized_arena_resource, reset between calls, lets repeated calls
+ *  run without going to the system allocator.
+ *
  *  The following code snippet demonstrates how to use \p thrust::omp::par to explicitly dispatch an
  *  invocation of \p thrust::for_each to the OpenMP backend system:
  *
@@ -82,6 +82,17 @@ using universal_allocator = thrust::mr::stateless_resource_allocator<
   T, thrust::system::omp::universal_memory_resource
 >;
 
+/*! \p omp::first_touch_allocator allocates memory for the \p omp system
+ *  from \p omp::first_touch_memory_resource. Containers using it, such as
+ *  <tt>host_vector<T, omp::first_touch_allocator<T> ></tt>, have their pages
+ *  placed on the NUMA nodes of the threads which later work on them, and
+ *  construct their elements in parallel on the \p omp system.
+ */
+template<typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::omp::first_touch_memory_resource
+>;
+
 }} // namespace system::omp
 
 /*! \namespace thrust::omp
@@ -93,6 +104,7 @@ using thrust::system::omp::malloc;
 using thrust::system::omp::free;
 using thrust::system::omp::allocator;
 using thrust::system::omp::universal_allocator;
+using thrust::system::omp::first_touch_allocator;
 } // namespace omp
 
 THRUST_NAMESPACE_END
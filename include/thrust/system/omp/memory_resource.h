@@ -23,8 +23,10 @@
 #include <thrust/detail/config.h>
 #include <thrust/mr/new.h>
 #include <thrust/mr/fancy_pointer_resource.h>
+#include <thrust/mr/first_touch.h>
 
 #include <thrust/system/omp/pointer.h>
+#include <thrust/system/omp/detail/par.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system { namespace omp
@@ -60,6 +62,15 @@ typedef detail::native_resource memory_resource;
 typedef detail::universal_native_resource universal_memory_resource;
 /*! An alias for \p omp::universal_memory_resource. */
 typedef detail::native_resource universal_host_pinned_memory_resource;
+/*! A memory resource for the OpenMP system which places the pages of every
+ *  allocation on the NUMA nodes of the threads which later work on them, by
+ *  touching them in parallel with \p omp::par. Uses
+ *  \p mr::first_touch_resource over \p omp::memory_resource.
+ */
+typedef thrust::mr::first_touch_resource<
+    detail::native_resource,
+    detail::par_t
+> first_touch_memory_resource;
 
 /*! \}
  */
@@ -0,0 +1,62 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/cpp/detail/async/executor.h>
+
+#include <tbb/task_arena.h>
+
+#include <functional>
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace tbb { namespace detail
+{
+
+// Enqueues `task` in an arena shared by the asynchronous algorithms of the
+// TBB system. TBB's worker threads run enqueued tasks even when the arena has
+// no slots for them, and a parallel algorithm called by a task runs in the
+// same arena.
+inline __host__
+void enqueue_in_task_arena(std::function<void()>&& task)
+{
+  static ::tbb::task_arena arena;
+
+  arena.enqueue(std::move(task));
+}
+
+// ADL hook: asynchronous algorithms run as TBB tasks.
+template <typename DerivedPolicy>
+__host__
+thrust::system::cpp::detail::async_executor
+select_async_executor(execution_policy<DerivedPolicy>&)
+{
+  return &enqueue_in_task_arena;
+}
+
+}}} // namespace system::tbb::detail
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
@@ -17,12 +17,17 @@
 #pragma once
 
 #include <thrust/detail/config.h>
-#include <thrust/detail/function.h>
 #include <thrust/system/tbb/detail/copy_if.h>
+#include <thrust/system/tbb/detail/default_decomposition.h>
+#include <thrust/system/tbb/detail/stream_compaction.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/copy.h>
 #include <thrust/distance.h>
 #include <tbb/blocked_range.h>
-#include <tbb/parallel_scan.h>
+#include <tbb/parallel_for.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -38,93 +43,86 @@ template<typename InputIterator1,
          typename InputIterator2,
          typename OutputIterator,
          typename Predicate,
+         typename Decomposition,
          typename Size>
 struct body
 {
-
   InputIterator1 first;
   InputIterator2 stencil;
   OutputIterator result;
-  thrust::detail::wrapped_function<Predicate,bool> pred;
-  Size sum;
+  Predicate pred;
+  Decomposition decomp;
+  Size *offsets;
 
-  body(InputIterator1 first, InputIterator2 stencil, OutputIterator result, Predicate pred)
-    : first(first), stencil(stencil), result(result), pred(pred), sum(0)
+  body(InputIterator1 first, InputIterator2 stencil, OutputIterator result, Predicate pred, Decomposition decomp, Size *offsets)
+    : first(first), stencil(stencil), result(result), pred(pred), decomp(decomp), offsets(offsets)
   {}
 
-  body(body& b, ::tbb::split)
-    : first(b.first), stencil(b.stencil), result(b.result), pred(b.pred), sum(0)
-  {}
-
-  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  void operator()(const ::tbb::blocked_range<Size> &r) const
   {
-    InputIterator2 iter = stencil + r.begin();
-
-    for (Size i = r.begin(); i != r.end(); ++i, ++iter)
+    for(Size t = r.begin(); t != r.end(); ++t)
     {
-      if (pred(*iter))
-        ++sum;
+      thrust::copy_if(thrust::seq,
+                      first + decomp[t].begin(), first + decomp[t].end(),
+                      stencil + decomp[t].begin(),
+                      result + offsets[t],
+                      pred);
     }
   }
-  
-  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
-  {
-    InputIterator1  iter1 = first   + r.begin();
-    InputIterator2  iter2 = stencil + r.begin();
-    OutputIterator  iter3 = result  + sum;
-      
-    for (Size i = r.begin(); i != r.end(); ++i, ++iter1, ++iter2)
-    {
-      if (pred(*iter2))
-      {
-        *iter3 = *iter1;
-        ++sum;
-        ++iter3;
-      }
-    }
-  }
-
-  void reverse_join(body& b)
-  {
-    sum = b.sum + sum;
-  } 
-
-  void assign(body& b)
-  {
-    sum = b.sum;
-  } 
 }; // end body
 
 } // end copy_if_detail
 
-template<typename InputIterator1,
+
+// copy_if is computed in two passes over the input: every tile counts the
+// elements it keeps, and after the counts are scanned into output offsets,
+// every tile copies the elements it keeps to its offset
+template<typename DerivedPolicy,
+         typename InputIterator1,
          typename InputIterator2,
          typename OutputIterator,
          typename Predicate>
-  OutputIterator copy_if(tag,
+  OutputIterator copy_if(execution_policy<DerivedPolicy> &exec,
                          InputIterator1 first,
                          InputIterator1 last,
                          InputIterator2 stencil,
                          OutputIterator result,
                          Predicate pred)
 {
-  typedef typename thrust::iterator_difference<InputIterator1>::type Size; 
-  typedef typename copy_if_detail::body<InputIterator1,InputIterator2,OutputIterator,Predicate,Size> Body;
-  
-  Size n = thrust::distance(first, last);
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+  typedef thrust::detail::wrapped_function<Predicate,bool> WrappedPredicate;
+
+  const difference_type n = thrust::distance(first, last);
+
+  // XXX this value is a tuning opportunity
+  const difference_type parallelism_threshold = 10000;
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n);
 
-  if (n != 0)
+  const difference_type num_tiles = decomp.size();
+
+  if(n < parallelism_threshold || num_tiles <= 1)
   {
-    Body body(first, stencil, result, pred);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), body);
-    thrust::advance(result, body.sum);
+    // don't bother parallelizing for small n
+    return thrust::copy_if(thrust::seq, first, last, stencil, result, pred);
   }
 
-  return result;
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_tiles + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  thrust::system::tbb::detail::compaction_offsets(exec, stencil, pred, decomp, offsets_ptr);
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_tiles, 1),
+    copy_if_detail::body<InputIterator1,InputIterator2,OutputIterator,WrappedPredicate,Decomposition,difference_type>(first, stencil, result, WrappedPredicate(pred), decomp, offsets_ptr),
+    ::tbb::simple_partitioner());
+
+  return result + offsets_ptr[num_tiles];
 } // end copy_if()
 
 } // end detail
 } // end tbb
 } // end system
 THRUST_NAMESPACE_END
-
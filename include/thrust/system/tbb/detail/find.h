@@ -17,7 +17,6 @@
 #pragma once
 
 #include <thrust/detail/config.h>
-#include <thrust/system/detail/generic/find.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -28,18 +27,18 @@ namespace tbb
 namespace detail
 {
 
+
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy> &exec,
                       InputIterator first,
                       InputIterator last,
-                      Predicate pred)
-{
-  // tbb prefers generic::find_if to cpp::find_if
-  return thrust::system::detail::generic::find_if(exec, first, last, pred);
-}
+                      Predicate pred);
+
 
 } // end namespace detail
 } // end namespace tbb
 } // end namespace system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/tbb/detail/find.inl>
+
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/find.h>
+#include <thrust/system/detail/internal/find.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <thrust/find.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+template<typename RandomAccessIterator,
+         typename Size,
+         typename Predicate>
+  struct body
+{
+  RandomAccessIterator m_first;
+  Predicate m_pred;
+  thrust::system::detail::internal::find_if_state<Size> *m_state;
+
+  body(RandomAccessIterator first, Predicate pred, thrust::system::detail::internal::find_if_state<Size> *state)
+    : m_first(first), m_pred(pred), m_state(state)
+  {}
+
+  void operator()(int) const
+  {
+    m_state->search(m_first, m_pred);
+  } // end operator()()
+}; // end body
+
+
+} // end find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::system::detail::internal::find_if_state<difference_type> state_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  const int num_workers = ::tbb::this_task_arena::max_concurrency();
+
+  if(num_workers <= 1 || n <= state_type::chunk_size)
+  {
+    // don't bother parallelizing for small n
+    return thrust::find_if(thrust::seq, first, last, pred);
+  }
+
+  // rather than letting TBB split the input, which would set threads to
+  // search far from its beginning, every worker claims chunks in order until
+  // the first match is found
+  state_type state(n);
+
+  ::tbb::parallel_for(0, num_workers, find_detail::body<InputIterator,difference_type,Predicate>(first, pred, &state));
+
+  return first + state.result();
+} // end find_if()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
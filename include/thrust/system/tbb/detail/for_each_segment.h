@@ -0,0 +1,51 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file for_each_segment.h
+ *  \brief TBB implementation of the loop over segments shared by the segmented algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// calls f(policy, i, begin, end) for segment i = [begin, end) of every segment
+// delimited by [offsets_first, offsets_last), including empty ones
+template <typename DerivedPolicy,
+          typename OffsetIterator,
+          typename SegmentFunction>
+void for_each_segment(execution_policy<DerivedPolicy> &exec,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      SegmentFunction f);
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/tbb/detail/for_each_segment.inl>
+
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/for_each_segment.h>
+#include <thrust/system/tbb/detail/default_decomposition.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace for_each_segment_detail
+{
+
+
+template<typename OffsetIterator, typename Size, typename SegmentFunction>
+struct body
+{
+  OffsetIterator offsets_first;
+  Size max_segment_size;
+  SegmentFunction f;
+
+  body(OffsetIterator offsets_first, Size max_segment_size, SegmentFunction f)
+    : offsets_first(offsets_first), max_segment_size(max_segment_size), f(f)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      const Size begin = offsets_first[i];
+      const Size end   = offsets_first[i + 1];
+
+      // the sequential policy's temporary storage is requested from every
+      // thread, so it mustn't go through exec's allocator
+      if(end - begin <= max_segment_size)
+      {
+        f(thrust::seq, i, begin, end);
+      }
+    }
+  }
+};
+
+
+} // end for_each_segment_detail
+
+
+// segments are binned by size: a segment holding more than a thread's share of
+// the elements is processed by the parallel algorithm on its own, one such
+// segment after another, while TBB spreads the smaller segments over the
+// threads and each is processed sequentially
+template <typename DerivedPolicy,
+          typename OffsetIterator,
+          typename SegmentFunction>
+void for_each_segment(execution_policy<DerivedPolicy> &exec,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      SegmentFunction f)
+{
+  typedef typename thrust::iterator_difference<OffsetIterator>::type Size;
+
+  const Size num_segments = thrust::distance(offsets_first, offsets_last) - 1;
+
+  if(num_segments <= 0) return;
+
+  const Size n = static_cast<Size>(offsets_first[num_segments]) - static_cast<Size>(offsets_first[0]);
+
+  const Size num_tiles = thrust::system::tbb::detail::default_decomposition(n).size();
+
+  if(num_tiles <= 1)
+  {
+    for(Size i = 0; i < num_segments; ++i)
+    {
+      f(thrust::system::detail::internal::serial_policy(exec), i, static_cast<Size>(offsets_first[i]), static_cast<Size>(offsets_first[i + 1]));
+    }
+
+    return;
+  }
+
+  const Size tile_size = (n + num_tiles - 1) / num_tiles;
+
+  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_segments),
+                      for_each_segment_detail::body<OffsetIterator,Size,SegmentFunction>(offsets_first, tile_size, f));
+
+  for(Size i = 0; i < num_segments; ++i)
+  {
+    const Size begin = offsets_first[i];
+    const Size end   = offsets_first[i + 1];
+
+    if(end - begin > tile_size)
+    {
+      f(exec, i, begin, end);
+    }
+  }
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/histogram.h>
+#include <thrust/system/detail/internal/histogram.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace histogram_detail
+{
+
+
+// every body counts its samples into private bins, which are summed when
+// TBB joins the bodies, so no two threads ever update the same count
+template<typename InputIterator,
+         typename CountType,
+         typename BinFunction>
+struct body
+{
+  InputIterator first;
+  BinFunction bin;
+  std::vector<CountType> counts;
+
+  body(InputIterator first, BinFunction bin, std::size_t num_bins)
+    : first(first), bin(bin), counts(num_bins, CountType(0))
+  {}
+
+  body(body& b, ::tbb::split)
+    : first(b.first), bin(b.bin), counts(b.counts.size(), CountType(0))
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size> &r)
+  {
+    // TBB can invoke operator() multiple times on the same body, so accumulate
+    const std::size_t num_bins = counts.size();
+
+    InputIterator iter = first + r.begin();
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++iter)
+    {
+      const std::size_t b = static_cast<std::size_t>(bin(*iter));
+
+      if (b < num_bins)
+      {
+        ++counts[b];
+      }
+    }
+  } // end operator()()
+
+  void join(body& b)
+  {
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+      counts[i] += b.counts[i];
+    }
+  }
+}; // end body
+
+
+template<typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename BinFunction>
+  RandomAccessIterator histogram(InputIterator first,
+                                 InputIterator last,
+                                 RandomAccessIterator histogram,
+                                 Size num_bins,
+                                 BinFunction bin)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type count_type;
+
+  if (num_bins <= 0) return histogram;
+
+  const difference_type n    = thrust::distance(first, last);
+  const difference_type bins = static_cast<difference_type>(num_bins);
+
+  if (n <= bins)
+  {
+    // don't bother parallelizing for small n
+    thrust::system::detail::internal::count_bins(first, last, histogram, num_bins, bin);
+
+    return histogram + num_bins;
+  }
+
+  // clearing and joining private bins costs num_bins per body, so give every
+  // body at least as many samples as there are bins
+  typedef body<InputIterator,count_type,BinFunction> Body;
+  Body histogram_body(first, bin, static_cast<std::size_t>(bins));
+  ::tbb::parallel_reduce(::tbb::blocked_range<difference_type>(0, n, bins), histogram_body);
+
+  for (difference_type i = 0; i < bins; ++i)
+  {
+    histogram[i] = histogram_body.counts[i];
+  }
+
+  return histogram + num_bins;
+} // end histogram()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator histogram_even(execution_policy<DerivedPolicy> &,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  thrust::system::detail::internal::even_bin<T,Size> bin(num_bins, lower_level, upper_level);
+
+  return histogram_detail::histogram(first, last, histogram, num_bins, bin);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename LevelIterator,
+         typename RandomAccessIterator>
+  RandomAccessIterator histogram_range(execution_policy<DerivedPolicy> &,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  typedef typename thrust::iterator_difference<LevelIterator>::type Size;
+
+  const Size num_bins = thrust::distance(levels_first, levels_last) - 1;
+
+  thrust::system::detail::internal::range_bin<LevelIterator> bin(levels_first, num_bins);
+
+  return histogram_detail::histogram(first, last, histogram, num_bins, bin);
+} // end histogram_range()
+
+
+} // end detail
+} // end tbb
+} // end system
+THRUST_NAMESPACE_END
+
@@ -18,6 +18,9 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/detail/allocator_aware_execution_policy.h>
+#if THRUST_CPP_DIALECT >= 2011
+#  include <thrust/detail/dependencies_aware_execution_policy.h>
+#endif
 #include <thrust/system/tbb/detail/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -32,6 +35,10 @@ namespace detail
 struct par_t : thrust::system::tbb::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
     thrust::system::tbb::detail::execution_policy>
+#if THRUST_CPP_DIALECT >= 2011
+, thrust::detail::dependencies_aware_execution_policy<
+    thrust::system::tbb::detail::execution_policy>
+#endif
 {
   __host__ __device__
   constexpr par_t() : thrust::system::tbb::detail::execution_policy<par_t>() {}
@@ -23,6 +23,8 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <thrust/reduce.h>
+#include <thrust/detail/trace.h>
+#include <thrust/system/detail/internal/lane_reduce.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_reduce.h>
 
@@ -67,11 +69,7 @@ struct body
 
     OutputType temp = thrust::raw_reference_cast(*iter);
 
-    ++iter;
-
-    for (Size i = r.begin() + 1; i != r.end(); ++i, ++iter)
-      temp = binary_op(temp, *iter);
-
+    temp = thrust::system::detail::internal::lane_reduce_n(iter + 1, r.size() - 1, temp, binary_op.m_f);
 
     if (first_call)
     {
@@ -109,6 +107,8 @@ template<typename DerivedPolicy,
 
   Size n = thrust::distance(begin, end);
 
+  THRUST_TRACE_SCOPE("reduce", "tbb", n);
+
   if (n == 0)
   {
     return init;
@@ -27,9 +27,9 @@
 #include <thrust/detail/range/tail_flags.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 #include <cassert>
-#include <thread>
 
 
 THRUST_NAMESPACE_BEGIN
@@ -280,8 +280,8 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
     return thrust::reduce_by_key(thrust::seq, keys_first, keys_last, values_first, keys_result, values_result, binary_pred, binary_op);
   }
 
-  // count the number of processors
-  const unsigned int p = thrust::max<unsigned int>(1u, std::thread::hardware_concurrency());
+  // count the threads of the arena we run in
+  const unsigned int p = thrust::max<int>(1, ::tbb::this_task_arena::max_concurrency());
 
   // generate O(P) intervals of sequential work
   // XXX oversubscribing is a tuning opportunity
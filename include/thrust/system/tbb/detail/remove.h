@@ -17,12 +17,12 @@
 #pragma once
 
 #include <thrust/detail/config.h>
-#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
-namespace omp
+namespace tbb
 {
 namespace detail
 {
@@ -72,7 +72,7 @@ template<typename ExecutionPolicy,
 
 
 } // end namespace detail
-} // end namespace omp
+} // end namespace tbb
 } // end namespace system
 THRUST_NAMESPACE_END
 
@@ -18,7 +18,17 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/tbb/detail/remove.h>
+#include <thrust/system/tbb/detail/default_decomposition.h>
+#include <thrust/system/tbb/detail/stream_compaction.h>
 #include <thrust/system/detail/generic/remove.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/remove.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -28,6 +38,89 @@ namespace tbb
 namespace detail
 {
 
+namespace remove_detail
+{
+
+
+template<typename ForwardIterator,
+         typename InputIterator,
+         typename Predicate,
+         typename Decomposition,
+         typename Size>
+struct body
+{
+  ForwardIterator first;
+  InputIterator stencil;
+  Predicate pred;
+  Decomposition decomp;
+  Size *counts;
+
+  body(ForwardIterator first, InputIterator stencil, Predicate pred, Decomposition decomp, Size *counts)
+    : first(first), stencil(stencil), pred(pred), decomp(decomp), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size t = r.begin(); t != r.end(); ++t)
+    {
+      ForwardIterator tile_first = first + decomp[t].begin();
+
+      counts[t + 1] = thrust::remove_if(thrust::seq,
+                                        tile_first, first + decomp[t].end(),
+                                        stencil + decomp[t].begin(),
+                                        pred) - tile_first;
+    }
+  }
+}; // end body
+
+
+// every tile removes its elements in place, after which the tiles' remaining
+// elements are gathered at the front of the range
+template<typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename Predicate>
+  ForwardIterator remove_if(execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first,
+                            ForwardIterator last,
+                            InputIterator stencil,
+                            Predicate pred)
+{
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+  typedef thrust::detail::wrapped_function<Predicate,bool> WrappedPredicate;
+
+  const difference_type n = thrust::distance(first, last);
+
+  // XXX this value is a tuning opportunity
+  const difference_type parallelism_threshold = 10000;
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(n < parallelism_threshold || num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::remove_if(thrust::seq, first, last, stencil, pred);
+  }
+
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> counts(0, exec, num_tiles + 1);
+
+  difference_type *counts_ptr = thrust::raw_pointer_cast(counts.data());
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_tiles, 1),
+    body<ForwardIterator,InputIterator,WrappedPredicate,Decomposition,difference_type>(first, stencil, WrappedPredicate(pred), decomp, counts_ptr),
+    ::tbb::simple_partitioner());
+
+  return thrust::system::tbb::detail::gather_tiles(exec, first, decomp, counts_ptr);
+}
+
+
+} // end namespace remove_detail
+
+
 template<typename DerivedPolicy,
          typename ForwardIterator,
          typename Predicate>
@@ -36,8 +129,9 @@ template<typename DerivedPolicy,
                             ForwardIterator last,
                             Predicate pred)
 {
-  // tbb prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, pred);
+  // the elements are their own stencil: compacting a tile in place only
+  // overwrites elements the tile has already tested
+  return remove_detail::remove_if(exec, first, last, first, pred);
 }
 
 
@@ -51,8 +145,7 @@ template<typename DerivedPolicy,
                             InputIterator stencil,
                             Predicate pred)
 {
-  // tbb prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, stencil, pred);
+  return remove_detail::remove_if(exec, first, last, stencil, pred);
 }
 
 
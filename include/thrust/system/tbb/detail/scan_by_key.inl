@@ -0,0 +1,318 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/scan_by_key.h>
+#include <thrust/system/tbb/detail/default_decomposition.h>
+#include <thrust/system/detail/internal/scan_by_key.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Decomposition,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+struct reduce_tail_body
+{
+  typedef typename Decomposition::index_type Size;
+
+  InputIterator1 first1;
+  InputIterator2 first2;
+  Decomposition decomp;
+  ValueType *sums;
+  bool *has_head;
+  bool *continues;
+  BinaryPredicate binary_pred;
+  BinaryFunction binary_op;
+
+  reduce_tail_body(InputIterator1 first1, InputIterator2 first2,
+                   Decomposition decomp,
+                   ValueType *sums, bool *has_head, bool *continues,
+                   BinaryPredicate binary_pred, BinaryFunction binary_op)
+    : first1(first1), first2(first2), decomp(decomp),
+      sums(sums), has_head(has_head), continues(continues),
+      binary_pred(binary_pred), binary_op(binary_op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size t = r.begin(); t != r.end(); ++t)
+    {
+      const Size begin = decomp[t].begin();
+
+      has_head[t]  = thrust::system::detail::internal::reduce_last_segment(first1, first2, begin, decomp[t].end(), sums[t], binary_pred, binary_op) > begin;
+      continues[t] = (t > 0) && binary_pred(first1[begin - 1], first1[begin]);
+    }
+  }
+};
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Decomposition,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+struct inclusive_scan_body
+{
+  typedef typename Decomposition::index_type Size;
+
+  InputIterator1 first1;
+  InputIterator2 first2;
+  OutputIterator result;
+  Decomposition decomp;
+  const bool *continues;
+  const ValueType *carries;
+  BinaryPredicate binary_pred;
+  BinaryFunction binary_op;
+
+  inclusive_scan_body(InputIterator1 first1, InputIterator2 first2, OutputIterator result,
+                      Decomposition decomp,
+                      const bool *continues, const ValueType *carries,
+                      BinaryPredicate binary_pred, BinaryFunction binary_op)
+    : first1(first1), first2(first2), result(result), decomp(decomp),
+      continues(continues), carries(carries),
+      binary_pred(binary_pred), binary_op(binary_op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size t = r.begin(); t != r.end(); ++t)
+    {
+      thrust::system::detail::internal::inclusive_scan_by_key_tile(first1, first2, result,
+                                                                   decomp[t].begin(), decomp[t].end(),
+                                                                   continues[t] ? carries + t : static_cast<const ValueType*>(0),
+                                                                   binary_pred, binary_op);
+    }
+  }
+};
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Decomposition,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+struct exclusive_scan_body
+{
+  typedef typename Decomposition::index_type Size;
+
+  InputIterator1 first1;
+  InputIterator2 first2;
+  OutputIterator result;
+  Decomposition decomp;
+  const bool *continues;
+  const ValueType *carries;
+  ValueType init;
+  BinaryPredicate binary_pred;
+  BinaryFunction binary_op;
+
+  exclusive_scan_body(InputIterator1 first1, InputIterator2 first2, OutputIterator result,
+                      Decomposition decomp,
+                      const bool *continues, const ValueType *carries,
+                      ValueType init,
+                      BinaryPredicate binary_pred, BinaryFunction binary_op)
+    : first1(first1), first2(first2), result(result), decomp(decomp),
+      continues(continues), carries(carries), init(init),
+      binary_pred(binary_pred), binary_op(binary_op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size t = r.begin(); t != r.end(); ++t)
+    {
+      thrust::system::detail::internal::exclusive_scan_by_key_tile(first1, first2, result,
+                                                                   decomp[t].begin(), decomp[t].end(),
+                                                                   continues[t] ? carries + t : static_cast<const ValueType*>(0),
+                                                                   init,
+                                                                   binary_pred, binary_op);
+    }
+  }
+};
+
+
+// Reduces the last segment of every tile and chains the partial sums
+// across tile boundaries. On return, carries[t] holds the carry into tile t
+// if continues[t] is true.
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Decomposition,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+void compute_carries(InputIterator1 first1,
+                     InputIterator2 first2,
+                     Decomposition decomp,
+                     ValueType *sums,
+                     bool *has_head,
+                     bool *continues,
+                     ValueType *carries,
+                     BinaryPredicate binary_pred,
+                     BinaryFunction binary_op)
+{
+  typedef typename Decomposition::index_type Size;
+
+  const Size num_tiles = decomp.size();
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_tiles, 1),
+    reduce_tail_body<InputIterator1,InputIterator2,Decomposition,ValueType,BinaryPredicate,BinaryFunction>(first1, first2, decomp, sums, has_head, continues, binary_pred, binary_op),
+    ::tbb::simple_partitioner());
+
+  thrust::system::detail::internal::propagate_segment_carries(sums, has_head, continues, carries, num_tiles, binary_op);
+}
+
+
+} // end scan_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_traits<InputIterator2>::value_type ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type   difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+  typedef thrust::detail::wrapped_function<BinaryFunction,ValueType> WrappedFunction;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  WrappedFunction wrapped_binary_op(binary_op);
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n);
+
+  const difference_type num_tiles = decomp.size();
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_tiles);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      has_head(0, exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      continues(0, exec, num_tiles);
+
+  ValueType *carries_ptr   = thrust::raw_pointer_cast(carries.data());
+  bool      *continues_ptr = thrust::raw_pointer_cast(continues.data());
+
+  scan_by_key_detail::compute_carries(first1, first2, decomp,
+                                      thrust::raw_pointer_cast(sums.data()),
+                                      thrust::raw_pointer_cast(has_head.data()),
+                                      continues_ptr,
+                                      carries_ptr,
+                                      binary_pred, wrapped_binary_op);
+
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_tiles, 1),
+    scan_by_key_detail::inclusive_scan_body<InputIterator1,InputIterator2,OutputIterator,Decomposition,ValueType,BinaryPredicate,WrappedFunction>(first1, first2, result, decomp, continues_ptr, carries_ptr, binary_pred, wrapped_binary_op),
+    ::tbb::simple_partitioner());
+
+  return result + n;
+} // end inclusive_scan_by_key()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  typedef T                                                          ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+  typedef thrust::detail::wrapped_function<BinaryFunction,ValueType> WrappedFunction;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+    return result;
+
+  // wrap binary_op
+  WrappedFunction wrapped_binary_op(binary_op);
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n);
+
+  const difference_type num_tiles = decomp.size();
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> sums(exec, num_tiles);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      has_head(0, exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      continues(0, exec, num_tiles);
+
+  ValueType *carries_ptr   = thrust::raw_pointer_cast(carries.data());
+  bool      *continues_ptr = thrust::raw_pointer_cast(continues.data());
+
+  scan_by_key_detail::compute_carries(first1, first2, decomp,
+                                      thrust::raw_pointer_cast(sums.data()),
+                                      thrust::raw_pointer_cast(has_head.data()),
+                                      continues_ptr,
+                                      carries_ptr,
+                                      binary_pred, wrapped_binary_op);
+
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_tiles, 1),
+    scan_by_key_detail::exclusive_scan_body<InputIterator1,InputIterator2,OutputIterator,Decomposition,ValueType,BinaryPredicate,WrappedFunction>(first1, first2, result, decomp, continues_ptr, carries_ptr, init, binary_pred, wrapped_binary_op),
+    ::tbb::simple_partitioner());
+
+  return result + n;
+} // end exclusive_scan_by_key()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/segmented_sort.h>
+#include <thrust/system/tbb/detail/for_each_segment.h>
+#include <thrust/sort.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace segmented_sort_detail
+{
+
+
+template<typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+struct sort_segment
+{
+  RandomAccessIterator first;
+  StrictWeakOrdering comp;
+
+  sort_segment(RandomAccessIterator first, StrictWeakOrdering comp)
+    : first(first), comp(comp)
+  {}
+
+  template<typename Policy, typename Size>
+  void operator()(const Policy &policy, Size, Size begin, Size end) const
+  {
+    thrust::sort(policy, first + begin, first + end, comp);
+  }
+};
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+struct sort_segment_by_key
+{
+  RandomAccessIterator1 keys_first;
+  RandomAccessIterator2 values_first;
+  StrictWeakOrdering comp;
+
+  sort_segment_by_key(RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, StrictWeakOrdering comp)
+    : keys_first(keys_first), values_first(values_first), comp(comp)
+  {}
+
+  template<typename Policy, typename Size>
+  void operator()(const Policy &policy, Size, Size begin, Size end) const
+  {
+    thrust::sort_by_key(policy, keys_first + begin, keys_first + end, values_first + begin, comp);
+  }
+};
+
+
+} // end segmented_sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename OffsetIterator,
+         typename StrictWeakOrdering>
+  void segmented_sort(execution_policy<DerivedPolicy> &exec,
+                      RandomAccessIterator first,
+                      RandomAccessIterator,
+                      OffsetIterator offsets_first,
+                      OffsetIterator offsets_last,
+                      StrictWeakOrdering comp)
+{
+  thrust::system::tbb::detail::for_each_segment(exec, offsets_first, offsets_last,
+    segmented_sort_detail::sort_segment<RandomAccessIterator,StrictWeakOrdering>(first, comp));
+} // end segmented_sort()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename OffsetIterator,
+         typename StrictWeakOrdering>
+  void segmented_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                             RandomAccessIterator1 keys_first,
+                             RandomAccessIterator1,
+                             RandomAccessIterator2 values_first,
+                             OffsetIterator offsets_first,
+                             OffsetIterator offsets_last,
+                             StrictWeakOrdering comp)
+{
+  thrust::system::tbb::detail::for_each_segment(exec, offsets_first, offsets_last,
+    segmented_sort_detail::sort_segment_by_key<RandomAccessIterator1,RandomAccessIterator2,StrictWeakOrdering>(keys_first, values_first, comp));
+} // end segmented_sort_by_key()
+
+
+} // end detail
+} // end tbb
+} // end system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,281 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/tbb/detail/default_decomposition.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/pair.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Decomposition,
+         typename StrictWeakOrdering,
+         typename SetOperation,
+         typename Size>
+struct count_body
+{
+  InputIterator1 first1;
+  InputIterator2 first2;
+  Size n1, n2;
+  Decomposition decomp;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+  Size *splits1;
+  Size *splits2;
+  Size *offsets;
+
+  count_body(InputIterator1 first1, Size n1,
+             InputIterator2 first2, Size n2,
+             Decomposition decomp,
+             StrictWeakOrdering comp,
+             SetOperation set_op,
+             Size *splits1, Size *splits2, Size *offsets)
+    : first1(first1), first2(first2), n1(n1), n2(n2),
+      decomp(decomp), comp(comp), set_op(set_op),
+      splits1(splits1), splits2(splits2), offsets(offsets)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size p = r.begin(); p != r.end(); ++p)
+    {
+      thrust::pair<Size,Size> begin =
+        thrust::system::detail::internal::key_aligned_merge_path(first1, n1, first2, n2, decomp[p].begin(), comp);
+
+      thrust::pair<Size,Size> end =
+        thrust::system::detail::internal::key_aligned_merge_path(first1, n1, first2, n2, decomp[p].end(), comp);
+
+      splits1[p] = begin.first;
+      splits2[p] = begin.second;
+
+      offsets[p + 1] = set_op(first1 + begin.first, first1 + end.first,
+                              first2 + begin.second, first2 + end.second,
+                              thrust::make_discard_iterator(),
+                              comp) - thrust::make_discard_iterator();
+    }
+  }
+};
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation,
+         typename Size>
+struct write_body
+{
+  InputIterator1 first1;
+  InputIterator2 first2;
+  OutputIterator result;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+  const Size *splits1;
+  const Size *splits2;
+  const Size *offsets;
+
+  write_body(InputIterator1 first1,
+             InputIterator2 first2,
+             OutputIterator result,
+             StrictWeakOrdering comp,
+             SetOperation set_op,
+             const Size *splits1, const Size *splits2, const Size *offsets)
+    : first1(first1), first2(first2), result(result),
+      comp(comp), set_op(set_op),
+      splits1(splits1), splits2(splits2), offsets(offsets)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size p = r.begin(); p != r.end(); ++p)
+    {
+      set_op(first1 + splits1[p], first1 + splits1[p + 1],
+             first2 + splits2[p], first2 + splits2[p + 1],
+             result + offsets[p],
+             comp);
+    }
+  }
+};
+
+
+// All four set operations are computed in three steps:
+//   1. the inputs are split into default_decomposition partitions whose
+//      bounds never separate a run of equivalent keys, and each partition
+//      counts its output by writing it to a discard_iterator
+//   2. the counts are scanned serially into output offsets
+//   3. each partition writes its output at its offset
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation>
+  OutputIterator set_operation(execution_policy<DerivedPolicy> &exec,
+                               InputIterator1 first1,
+                               InputIterator1 last1,
+                               InputIterator2 first2,
+                               InputIterator2 last2,
+                               OutputIterator result,
+                               StrictWeakOrdering comp,
+                               SetOperation set_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+
+  const difference_type n1 = thrust::distance(first1, last1);
+  const difference_type n2 = thrust::distance(first2, last2);
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n1 + n2);
+
+  const difference_type num_partitions = decomp.size();
+
+  if(num_partitions <= 1)
+  {
+    // don't bother parallelizing for small n
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+  // partition p covers [splits1[p], splits1[p+1]) and [splits2[p], splits2[p+1])
+  // offsets[p] is where partition p begins writing its output
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> splits1(0, exec, num_partitions + 1);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> splits2(0, exec, num_partitions + 1);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(0, exec, num_partitions + 1);
+
+  difference_type *splits1_ptr = thrust::raw_pointer_cast(splits1.data());
+  difference_type *splits2_ptr = thrust::raw_pointer_cast(splits2.data());
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  splits1_ptr[num_partitions] = n1;
+  splits2_ptr[num_partitions] = n2;
+  offsets_ptr[0] = 0;
+
+  // split the inputs and count each partition's output
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_partitions, 1),
+    count_body<InputIterator1,InputIterator2,Decomposition,StrictWeakOrdering,SetOperation,difference_type>(first1, n1, first2, n2, decomp, comp, set_op, splits1_ptr, splits2_ptr, offsets_ptr),
+    ::tbb::simple_partitioner());
+
+  for(difference_type p = 0; p < num_partitions; ++p)
+  {
+    offsets_ptr[p + 1] += offsets_ptr[p];
+  }
+
+  // write each partition's output
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_partitions, 1),
+    write_body<InputIterator1,InputIterator2,OutputIterator,StrictWeakOrdering,SetOperation,difference_type>(first1, first2, result, comp, set_op, splits1_ptr, splits2_ptr, offsets_ptr),
+    ::tbb::simple_partitioner());
+
+  return result + offsets_ptr[num_partitions];
+} // end set_operation()
+
+
+} // end set_operations_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_difference(execution_policy<DerivedPolicy> &exec,
+                                InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, thrust::system::detail::internal::serial_set_difference());
+} // end set_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_intersection(execution_policy<DerivedPolicy> &exec,
+                                  InputIterator1 first1,
+                                  InputIterator1 last1,
+                                  InputIterator2 first2,
+                                  InputIterator2 last2,
+                                  OutputIterator result,
+                                  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, thrust::system::detail::internal::serial_set_intersection());
+} // end set_intersection()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_symmetric_difference(execution_policy<DerivedPolicy> &exec,
+                                          InputIterator1 first1,
+                                          InputIterator1 last1,
+                                          InputIterator2 first2,
+                                          InputIterator2 last2,
+                                          OutputIterator result,
+                                          StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, thrust::system::detail::internal::serial_set_symmetric_difference());
+} // end set_symmetric_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_union(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp, thrust::system::detail::internal::serial_set_union());
+} // end set_union()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -24,7 +24,14 @@
 #include <thrust/merge.h>
 #include <thrust/sort.h>
 #include <thrust/detail/seq.h>
-#include <tbb/parallel_invoke.h>
+#include <thrust/detail/trace.h>
+#include <thrust/system/tbb/detail/default_decomposition.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/system/detail/internal/sort_tile.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -41,179 +48,618 @@ namespace sort_detail
 const static int threshold = 128 * 1024;
 
 
-template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace);
+// sorts each tile, using the same tile of buffer as scratch space
+template<typename RandomAccessIterator, typename Pointer, typename StrictWeakOrdering, typename Decomposition>
+struct sort_tile_body
+{
+  RandomAccessIterator first;
+  Pointer buffer;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+
+  sort_tile_body(RandomAccessIterator first, Pointer buffer, StrictWeakOrdering comp, Decomposition decomp)
+    : first(first), buffer(buffer), comp(comp), decomp(decomp)
+  {}
+
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    for(size_t p = r.begin(); p != r.end(); ++p)
+    {
+      thrust::system::detail::internal::sort_tile(first + decomp[p].begin(),
+                                                  first + decomp[p].end(),
+                                                  buffer + decomp[p].begin(),
+                                                  comp);
+    }
+  }
+};
 
 
-template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-struct merge_sort_closure
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Pointer1,
+         typename Pointer2,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+struct sort_tile_by_key_body
 {
-  execution_policy<DerivedPolicy> &exec;
-  Iterator1 first1, last1;
-  Iterator2 first2;
+  RandomAccessIterator1 keys_first;
+  RandomAccessIterator2 values_first;
+  Pointer1 keys_buffer;
+  Pointer2 values_buffer;
   StrictWeakOrdering comp;
-  bool inplace;
-
-  merge_sort_closure(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace)
-    : exec(exec), first1(first1), last1(last1), first2(first2), comp(comp), inplace(inplace)
+  Decomposition decomp;
+
+  sort_tile_by_key_body(RandomAccessIterator1 keys_first,
+                        RandomAccessIterator2 values_first,
+                        Pointer1 keys_buffer,
+                        Pointer2 values_buffer,
+                        StrictWeakOrdering comp,
+                        Decomposition decomp)
+    : keys_first(keys_first), values_first(values_first),
+      keys_buffer(keys_buffer), values_buffer(values_buffer),
+      comp(comp), decomp(decomp)
   {}
 
-  void operator()(void) const
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
   {
-    merge_sort(exec, first1, last1, first2, comp, inplace);
+    for(size_t p = r.begin(); p != r.end(); ++p)
+    {
+      thrust::system::detail::internal::sort_tile_by_key(keys_first + decomp[p].begin(),
+                                                         keys_first + decomp[p].end(),
+                                                         values_first + decomp[p].begin(),
+                                                         keys_buffer + decomp[p].begin(),
+                                                         values_buffer + decomp[p].begin(),
+                                                         comp);
+    }
   }
 };
 
 
-template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace)
+// Merges each pair of adjacent runs of the form
+//   [decomp[j].begin(), decomp[j + w].begin()), [decomp[j + w].begin(), decomp[j + 2w].begin())
+// where j is a multiple of 2w, from src into dst. Output tile p locates its
+// share of the two runs with a merge path search, so every level of the
+// merge tree uses all the tiles.
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename StrictWeakOrdering, typename Decomposition>
+struct merge_level_body
 {
-  typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+  typedef typename Decomposition::index_type IndexType;
 
-  difference_type n = thrust::distance(first1, last1);
+  RandomAccessIterator1 src;
+  RandomAccessIterator2 dst;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+  IndexType w;
+
+  merge_level_body(RandomAccessIterator1 src, RandomAccessIterator2 dst, StrictWeakOrdering comp, Decomposition decomp, IndexType w)
+    : src(src), dst(dst), comp(comp), decomp(decomp), w(w)
+  {}
 
-  if (n < threshold)
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
   {
-    thrust::stable_sort(thrust::seq, first1, last1, comp);
+    const IndexType num_tiles = decomp.size();
+    const IndexType n         = decomp[num_tiles - 1].end();
 
-    if(!inplace)
+    for(size_t task = r.begin(); task != r.end(); ++task)
     {
-      thrust::copy(thrust::seq, first1, last1, first2);
-    }
+      const IndexType p = static_cast<IndexType>(task);
 
-    return;
+      const IndexType first_tile = (p / (2 * w)) * (2 * w);
+      const IndexType mid_tile   = first_tile + w;
+      const IndexType last_tile  = (first_tile + 2 * w < num_tiles) ? first_tile + 2 * w : num_tiles;
+
+      const IndexType begin1 = decomp[first_tile].begin();
+      const IndexType begin2 = (mid_tile < num_tiles) ? decomp[mid_tile].begin() : n;
+      const IndexType end2   = decomp[last_tile - 1].end();
+
+      const IndexType diag_begin = decomp[p].begin() - begin1;
+      const IndexType diag_end   = decomp[p].end()   - begin1;
+
+      const IndexType i_begin = thrust::system::detail::internal::merge_path(src + begin1, begin2 - begin1, src + begin2, end2 - begin2, diag_begin, comp);
+      const IndexType i_end   = thrust::system::detail::internal::merge_path(src + begin1, begin2 - begin1, src + begin2, end2 - begin2, diag_end,   comp);
+
+      thrust::merge(thrust::seq,
+                    src + begin1 + i_begin, src + begin1 + i_end,
+                    src + begin2 + (diag_begin - i_begin), src + begin2 + (diag_end - i_end),
+                    dst + decomp[p].begin(),
+                    comp);
+    }
   }
+};
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+struct merge_level_by_key_body
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  RandomAccessIterator1 keys_src;
+  RandomAccessIterator2 values_src;
+  RandomAccessIterator3 keys_dst;
+  RandomAccessIterator4 values_dst;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+  IndexType w;
+
+  merge_level_by_key_body(RandomAccessIterator1 keys_src,
+                          RandomAccessIterator2 values_src,
+                          RandomAccessIterator3 keys_dst,
+                          RandomAccessIterator4 values_dst,
+                          StrictWeakOrdering comp,
+                          Decomposition decomp,
+                          IndexType w)
+    : keys_src(keys_src), values_src(values_src),
+      keys_dst(keys_dst), values_dst(values_dst),
+      comp(comp), decomp(decomp), w(w)
+  {}
+
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    const IndexType num_tiles = decomp.size();
+    const IndexType n         = decomp[num_tiles - 1].end();
 
-  Iterator1 mid1  = first1 + (n / 2);
-  Iterator2 mid2  = first2 + (n / 2);
-  Iterator2 last2 = first2 + n;
+    for(size_t task = r.begin(); task != r.end(); ++task)
+    {
+      const IndexType p = static_cast<IndexType>(task);
+
+      const IndexType first_tile = (p / (2 * w)) * (2 * w);
+      const IndexType mid_tile   = first_tile + w;
+      const IndexType last_tile  = (first_tile + 2 * w < num_tiles) ? first_tile + 2 * w : num_tiles;
+
+      const IndexType begin1 = decomp[first_tile].begin();
+      const IndexType begin2 = (mid_tile < num_tiles) ? decomp[mid_tile].begin() : n;
+      const IndexType end2   = decomp[last_tile - 1].end();
+
+      const IndexType diag_begin = decomp[p].begin() - begin1;
+      const IndexType diag_end   = decomp[p].end()   - begin1;
 
-  typedef merge_sort_closure<DerivedPolicy,Iterator1,Iterator2,StrictWeakOrdering> Closure;
+      const IndexType i_begin = thrust::system::detail::internal::merge_path(keys_src + begin1, begin2 - begin1, keys_src + begin2, end2 - begin2, diag_begin, comp);
+      const IndexType i_end   = thrust::system::detail::internal::merge_path(keys_src + begin1, begin2 - begin1, keys_src + begin2, end2 - begin2, diag_end,   comp);
 
-  Closure left (exec, first1, mid1,  first2, comp, !inplace);
-  Closure right(exec, mid1,   last1, mid2,   comp, !inplace);
+      const IndexType j_begin = diag_begin - i_begin;
+      const IndexType j_end   = diag_end   - i_end;
 
-  ::tbb::parallel_invoke(left, right);
+      thrust::merge_by_key(thrust::seq,
+                           keys_src + begin1 + i_begin, keys_src + begin1 + i_end,
+                           keys_src + begin2 + j_begin, keys_src + begin2 + j_end,
+                           values_src + begin1 + i_begin,
+                           values_src + begin2 + j_begin,
+                           keys_dst + decomp[p].begin(),
+                           values_dst + decomp[p].begin(),
+                           comp);
+    }
+  }
+};
 
-  if(inplace) thrust::merge(exec, first2, mid2, mid2, last2, first1, comp);
-  else	      thrust::merge(exec, first1, mid1, mid1, last1, first2, comp);
+
+// returns the number of levels in a merge tree with num_tiles leaves
+template<typename IndexType>
+int num_merge_levels(IndexType num_tiles)
+{
+  int result = 0;
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+    ++result;
+
+  return result;
 }
 
 
 } // end namespace sort_detail
 
 
-namespace sort_by_key_detail
+namespace radix_sort_detail
 {
 
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
+// XXX this value is a tuning opportunity
+const static int threshold = 1 << 16;
 
 
-template<typename DerivedPolicy,
-         typename Iterator1,
-         typename Iterator2,
-         typename Iterator3,
-         typename Iterator4,
-         typename StrictWeakOrdering>
-void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
-                       Iterator1 first1,
-                       Iterator1 last1,
-                       Iterator2 first2,
-                       Iterator3 first3,
-                       Iterator4 first4,
-                       StrictWeakOrdering comp,
-                       bool inplace);
+template<typename Digit, typename RandomAccessIterator, typename Decomposition>
+struct histogram_body
+{
+  Digit digit;
+  RandomAccessIterator keys;
+  Decomposition decomp;
+  size_t *histograms;
 
+  histogram_body(Digit digit, RandomAccessIterator keys, Decomposition decomp, size_t *histograms)
+    : digit(digit), keys(keys), decomp(decomp), histograms(histograms)
+  {}
 
-template<typename DerivedPolicy,
-         typename Iterator1,
-         typename Iterator2,
-         typename Iterator3,
-         typename Iterator4,
-         typename StrictWeakOrdering>
-struct merge_sort_by_key_closure
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    for(size_t p = r.begin(); p != r.end(); ++p)
+    {
+      thrust::system::detail::internal::radix_histogram(digit, keys, decomp[p].begin(), decomp[p].end(), histograms + p * Digit::num_buckets);
+    }
+  }
+};
+
+
+template<typename Digit, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Decomposition>
+struct scatter_body
 {
-  execution_policy<DerivedPolicy> &exec;
-  Iterator1 first1, last1;
-  Iterator2 first2;
-  Iterator3 first3;
-  Iterator4 first4;
-  StrictWeakOrdering comp;
-  bool inplace;
-
-  merge_sort_by_key_closure(execution_policy<DerivedPolicy> &exec,
-                            Iterator1 first1,
-                            Iterator1 last1,
-                            Iterator2 first2,
-                            Iterator3 first3,
-                            Iterator4 first4,
-                            StrictWeakOrdering comp,
-                            bool inplace)
-    : exec(exec), first1(first1), last1(last1), first2(first2), first3(first3), first4(first4), comp(comp), inplace(inplace)
+  Digit digit;
+  RandomAccessIterator1 keys_src;
+  RandomAccessIterator2 keys_dst;
+  Decomposition decomp;
+  size_t *histograms;
+
+  scatter_body(Digit digit, RandomAccessIterator1 keys_src, RandomAccessIterator2 keys_dst, Decomposition decomp, size_t *histograms)
+    : digit(digit), keys_src(keys_src), keys_dst(keys_dst), decomp(decomp), histograms(histograms)
   {}
 
-  void operator()(void) const
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
   {
-    merge_sort_by_key(exec, first1, last1, first2, first3, first4, comp, inplace);
+    for(size_t p = r.begin(); p != r.end(); ++p)
+    {
+      thrust::system::detail::internal::radix_scatter(digit, keys_src, decomp[p].begin(), decomp[p].end(), keys_dst, histograms + p * Digit::num_buckets);
+    }
   }
 };
 
 
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Decomposition>
+struct scatter_by_key_body
+{
+  Digit digit;
+  RandomAccessIterator1 keys_src;
+  RandomAccessIterator2 values_src;
+  RandomAccessIterator3 keys_dst;
+  RandomAccessIterator4 values_dst;
+  Decomposition decomp;
+  size_t *histograms;
+
+  scatter_by_key_body(Digit digit,
+                      RandomAccessIterator1 keys_src,
+                      RandomAccessIterator2 values_src,
+                      RandomAccessIterator3 keys_dst,
+                      RandomAccessIterator4 values_dst,
+                      Decomposition decomp,
+                      size_t *histograms)
+    : digit(digit),
+      keys_src(keys_src), values_src(values_src),
+      keys_dst(keys_dst), values_dst(values_dst),
+      decomp(decomp), histograms(histograms)
+  {}
+
+  void operator()(const ::tbb::blocked_range<size_t> &r) const
+  {
+    for(size_t p = r.begin(); p != r.end(); ++p)
+    {
+      thrust::system::detail::internal::radix_scatter(digit, keys_src, values_src, decomp[p].begin(), decomp[p].end(), keys_dst, values_dst, histograms + p * Digit::num_buckets);
+    }
+  }
+};
+
+
+// Sorts the tiles' elements by one digit from src into dst. Returns false
+// without touching dst if the pass can be skipped.
+template<typename Digit, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Decomposition>
+bool radix_pass(Digit digit, RandomAccessIterator1 src, RandomAccessIterator2 dst, Decomposition decomp, size_t *histograms)
+{
+  const size_t num_tiles = decomp.size();
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                      histogram_body<Digit,RandomAccessIterator1,Decomposition>(digit, src, decomp, histograms),
+                      ::tbb::simple_partitioner());
+
+  if(!thrust::system::detail::internal::radix_scan_histograms<Digit>(histograms, num_tiles, decomp[num_tiles - 1].end()))
+    return false;
+
+  ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                      scatter_body<Digit,RandomAccessIterator1,RandomAccessIterator2,Decomposition>(digit, src, dst, decomp, histograms),
+                      ::tbb::simple_partitioner());
+
+  return true;
+}
+
+
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Decomposition>
+bool radix_pass_by_key(Digit digit,
+                       RandomAccessIterator1 keys_src,
+                       RandomAccessIterator2 values_src,
+                       RandomAccessIterator3 keys_dst,
+                       RandomAccessIterator4 values_dst,
+                       Decomposition decomp,
+                       size_t *histograms)
+{
+  typedef scatter_by_key_body<Digit,RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,RandomAccessIterator4,Decomposition> Body;
+
+  const size_t num_tiles = decomp.size();
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                      histogram_body<Digit,RandomAccessIterator1,Decomposition>(digit, keys_src, decomp, histograms),
+                      ::tbb::simple_partitioner());
+
+  if(!thrust::system::detail::internal::radix_scan_histograms<Digit>(histograms, num_tiles, decomp[num_tiles - 1].end()))
+    return false;
+
+  ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                      Body(digit, keys_src, values_src, keys_dst, values_dst, decomp, histograms),
+                      ::tbb::simple_partitioner());
+
+  return true;
+}
+
+
+} // end namespace radix_sort_detail
+
+
+namespace sort_detail
+{
+
+
 template<typename DerivedPolicy,
-         typename Iterator1,
-         typename Iterator2,
-         typename Iterator3,
-         typename Iterator4,
+         typename RandomAccessIterator,
          typename StrictWeakOrdering>
-void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
-                       Iterator1 first1,
-                       Iterator1 last1,
-                       Iterator2 first2,
-                       Iterator3 first3,
-                       Iterator4 first4,
-                       StrictWeakOrdering comp,
-                       bool inplace)
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
 {
-  typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+  typedef thrust::system::detail::internal::radix_digit<key_type,StrictWeakOrdering> Digit;
 
-  difference_type n = thrust::distance(first1, last1);
+  size_t n = thrust::distance(first, last);
 
-  Iterator1 mid1  = first1 + (n / 2);
-  Iterator2 mid2  = first2 + (n / 2);
-  Iterator3 mid3  = first3 + (n / 2);
-  Iterator4 mid4  = first4 + (n / 2);
-  Iterator2 last2 = first2 + n;
-  Iterator3 last3 = first3 + n;
+  if(n < static_cast<size_t>(radix_sort_detail::threshold))
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::system::detail::internal::serial_policy(exec), first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<size_t> decomp = thrust::system::tbb::detail::default_decomposition(n);
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(0, exec, n);
+  thrust::detail::temporary_array<size_t, DerivedPolicy>   histograms(0, exec, decomp.size() * Digit::num_buckets);
+
+  key_type *temp_ptr       = thrust::raw_pointer_cast(temp.data());
+  size_t   *histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  // false if the most recent data is in [first, last)
+  bool temp_is_source = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    THRUST_TRACE_PHASE("radix pass");
 
-  if (n < threshold)
+    bool shuffled = temp_is_source ?
+      radix_sort_detail::radix_pass(Digit(pass), temp_ptr, first, decomp, histograms_ptr) :
+      radix_sort_detail::radix_pass(Digit(pass), first, temp_ptr, decomp, histograms_ptr);
+
+    if(shuffled)
+      temp_is_source = !temp_is_source;
+  }
+
+  if(temp_is_source)
   {
-    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    thrust::copy(exec, temp.begin(), temp.end(), first);
+  }
+}
+
 
-    if(!inplace)
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<size_t> Decomposition;
+  typedef typename thrust::detail::temporary_array<key_type, DerivedPolicy>::iterator TempIterator;
+
+  size_t n = thrust::distance(first, last);
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n);
+
+  const size_t num_tiles = decomp.size();
+
+  if(n < static_cast<size_t>(sort_detail::threshold) || num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::system::detail::internal::serial_policy(exec), first, last, comp);
+    return;
+  }
+
+  // a single buffer, allocated here so that the allocator is never called
+  // from inside a task, is the scratch space of the tile sorts and then the
+  // other half of the merges
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, n);
+
+  // every thread sorts its own tile
+  {
+    THRUST_TRACE_PHASE("tile sort");
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                        sort_tile_body<RandomAccessIterator,key_type*,StrictWeakOrdering,Decomposition>(first, thrust::raw_pointer_cast(temp.data()), comp, decomp),
+                        ::tbb::simple_partitioner());
+  }
+
+  // merge the sorted tiles pairwise, alternating between [first, last) and
+  // the buffer; starting from a copy in the buffer when the number of levels
+  // is odd leaves the result of the last level in [first, last)
+  bool temp_is_source = (num_merge_levels(num_tiles) % 2) == 1;
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, first, last, temp.begin());
+  }
+
+  for(size_t w = 1; w < num_tiles; w *= 2)
+  {
+    THRUST_TRACE_PHASE("merge");
+
+    if(temp_is_source)
     {
-      thrust::copy(thrust::seq, first1, last1, first3);
-      thrust::copy(thrust::seq, first2, last2, first4);
+      ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                          merge_level_body<TempIterator,RandomAccessIterator,StrictWeakOrdering,Decomposition>(temp.begin(), first, comp, decomp, w),
+                          ::tbb::simple_partitioner());
     }
+    else
+    {
+      ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                          merge_level_body<RandomAccessIterator,TempIterator,StrictWeakOrdering,Decomposition>(first, temp.begin(), comp, decomp, w),
+                          ::tbb::simple_partitioner());
+    }
+
+    temp_is_source = !temp_is_source;
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
+  typedef thrust::system::detail::internal::radix_digit<key_type,StrictWeakOrdering> Digit;
+
+  size_t n = thrust::distance(first1, last1);
 
+  if(n < static_cast<size_t>(radix_sort_detail::threshold))
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::system::detail::internal::serial_policy(exec), first1, last1, first2, comp);
     return;
   }
 
-  typedef merge_sort_by_key_closure<DerivedPolicy,Iterator1,Iterator2,Iterator3,Iterator4,StrictWeakOrdering> Closure;
+  thrust::system::detail::internal::uniform_decomposition<size_t> decomp = thrust::system::tbb::detail::default_decomposition(n);
 
-  Closure left (exec, first1, mid1,  first2, first3, first4, comp, !inplace);
-  Closure right(exec, mid1,   last1, mid2,   mid3,   mid4,   comp, !inplace);
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(0, exec, n);
+  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, n);
+  thrust::detail::temporary_array<size_t, DerivedPolicy>   histograms(0, exec, decomp.size() * Digit::num_buckets);
 
-  ::tbb::parallel_invoke(left, right);
+  key_type *temp1_ptr      = thrust::raw_pointer_cast(temp1.data());
+  val_type *temp2_ptr      = thrust::raw_pointer_cast(temp2.data());
+  size_t   *histograms_ptr = thrust::raw_pointer_cast(histograms.data());
 
-  if(inplace)
+  // false if the most recent data is in (first1, first2)
+  bool temp_is_source = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
   {
-    thrust::merge_by_key(exec, first3, mid3, mid3, last3, first4, mid4, first1, first2, comp);
+    THRUST_TRACE_PHASE("radix pass");
+
+    bool shuffled = temp_is_source ?
+      radix_sort_detail::radix_pass_by_key(Digit(pass), temp1_ptr, temp2_ptr, first1, first2, decomp, histograms_ptr) :
+      radix_sort_detail::radix_pass_by_key(Digit(pass), first1, first2, temp1_ptr, temp2_ptr, decomp, histograms_ptr);
+
+    if(shuffled)
+      temp_is_source = !temp_is_source;
   }
-  else
+
+  if(temp_is_source)
   {
-    thrust::merge_by_key(exec, first1, mid1, mid1, last1, first2, mid2, first3, first4, comp);
+    thrust::copy(exec, temp1.begin(), temp1.end(), first1);
+    thrust::copy(exec, temp2.begin(), temp2.end(), first2);
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<size_t> Decomposition;
+  typedef typename thrust::detail::temporary_array<key_type, DerivedPolicy>::iterator TempIterator1;
+  typedef typename thrust::detail::temporary_array<val_type, DerivedPolicy>::iterator TempIterator2;
+
+  size_t n = thrust::distance(first1, last1);
+
+  Decomposition decomp = thrust::system::tbb::detail::default_decomposition(n);
+
+  const size_t num_tiles = decomp.size();
+
+  if(n < static_cast<size_t>(sort_detail::threshold) || num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::system::detail::internal::serial_policy(exec), first1, last1, first2, comp);
+    return;
+  }
+
+  RandomAccessIterator2 last2 = first2 + n;
+
+  // see merge sort version of stable_sort
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, n);
+  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, n);
+
+  // every thread sorts its own tile
+  {
+    THRUST_TRACE_PHASE("tile sort");
+
+    ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                        sort_tile_by_key_body<RandomAccessIterator1,RandomAccessIterator2,key_type*,val_type*,StrictWeakOrdering,Decomposition>(first1, first2, thrust::raw_pointer_cast(temp1.data()), thrust::raw_pointer_cast(temp2.data()), comp, decomp),
+                        ::tbb::simple_partitioner());
+  }
+
+  bool temp_is_source = (num_merge_levels(num_tiles) % 2) == 1;
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, first1, last1, temp1.begin());
+    thrust::copy(exec, first2, last2, temp2.begin());
+  }
+
+  for(size_t w = 1; w < num_tiles; w *= 2)
+  {
+    THRUST_TRACE_PHASE("merge");
+
+    if(temp_is_source)
+    {
+      ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                          merge_level_by_key_body<TempIterator1,TempIterator2,RandomAccessIterator1,RandomAccessIterator2,StrictWeakOrdering,Decomposition>(temp1.begin(), temp2.begin(), first1, first2, comp, decomp, w),
+                          ::tbb::simple_partitioner());
+    }
+    else
+    {
+      ::tbb::parallel_for(::tbb::blocked_range<size_t>(0, num_tiles, 1),
+                          merge_level_by_key_body<RandomAccessIterator1,RandomAccessIterator2,TempIterator1,TempIterator2,StrictWeakOrdering,Decomposition>(first1, first2, temp1.begin(), temp2.begin(), comp, decomp, w),
+                          ::tbb::simple_partitioner());
+    }
+
+    temp_is_source = !temp_is_source;
   }
 }
 
@@ -230,10 +676,11 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
                  StrictWeakOrdering comp)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+  thrust::system::detail::internal::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
 
-  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
+  THRUST_TRACE_SCOPE("stable_sort", "tbb", last - first);
 
-  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
 }
 
 
@@ -248,14 +695,11 @@ template<typename DerivedPolicy,
                           StrictWeakOrdering comp)
 {
   typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
-
-  RandomAccessIterator2 last2 = first2 + thrust::distance(first1, last1);
+  thrust::system::detail::internal::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
 
-  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
-  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
+  THRUST_TRACE_SCOPE("stable_sort_by_key", "tbb", last1 - first1);
 
-  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  sort_detail::stable_sort_by_key(exec, first1, last1, first2, comp, use_radix_sort);
 }
 
 
@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/stream_compaction.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/uninitialized_copy.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace stream_compaction_detail
+{
+
+
+template <typename InputIterator, typename Predicate, typename Decomposition, typename Size>
+struct count_tile_body
+{
+  InputIterator stencil;
+  Predicate pred;
+  Decomposition decomp;
+  Size *counts;
+
+  count_tile_body(InputIterator stencil, Predicate pred, Decomposition decomp, Size *counts)
+    : stencil(stencil), pred(pred), decomp(decomp), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size t = r.begin(); t != r.end(); ++t)
+    {
+      counts[t + 1] = thrust::count_if(thrust::seq, stencil + decomp[t].begin(), stencil + decomp[t].end(), pred);
+    }
+  }
+}; // end count_tile_body
+
+
+template <typename ForwardIterator, typename Decomposition, typename Size, typename ValueType>
+struct move_tile_body
+{
+  ForwardIterator first;
+  Decomposition decomp;
+  Size *offsets;
+  Size first_moved;
+  ValueType *temp;
+
+  move_tile_body(ForwardIterator first, Decomposition decomp, Size *offsets, Size first_moved, ValueType *temp)
+    : first(first), decomp(decomp), offsets(offsets), first_moved(first_moved), temp(temp)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size t = r.begin(); t != r.end(); ++t)
+    {
+      ForwardIterator tile_first = first + decomp[t].begin();
+
+      thrust::uninitialized_copy(thrust::seq,
+                                 tile_first, tile_first + (offsets[t + 1] - offsets[t]),
+                                 temp + (offsets[t] - offsets[first_moved]));
+    }
+  }
+}; // end move_tile_body
+
+
+} // end stream_compaction_detail
+
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename Predicate,
+          typename Decomposition,
+          typename Size>
+void compaction_offsets(execution_policy<DerivedPolicy> &,
+                        InputIterator stencil,
+                        Predicate pred,
+                        Decomposition decomp,
+                        Size *offsets)
+{
+  typedef thrust::detail::wrapped_function<Predicate,bool> WrappedPredicate;
+
+  const Size num_tiles = decomp.size();
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_tiles, 1),
+    stream_compaction_detail::count_tile_body<InputIterator,WrappedPredicate,Decomposition,Size>(stencil, WrappedPredicate(pred), decomp, offsets),
+    ::tbb::simple_partitioner());
+
+  // there are only as many counts as threads, so scan them serially
+  offsets[0] = 0;
+
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    offsets[t + 1] += offsets[t];
+  }
+}
+
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename Decomposition,
+          typename Size>
+ForwardIterator gather_tiles(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator first,
+                             Decomposition decomp,
+                             Size *counts)
+{
+  typedef typename thrust::iterator_value<ForwardIterator>::type ValueType;
+
+  const Size num_tiles = decomp.size();
+
+  counts[0] = 0;
+
+  for(Size t = 0; t < num_tiles; ++t)
+  {
+    counts[t + 1] += counts[t];
+  }
+
+  // the tiles preceded only by tiles which kept everything are in place already
+  Size first_moved = 1;
+
+  while(first_moved < num_tiles && counts[first_moved] == decomp[first_moved].begin())
+  {
+    ++first_moved;
+  }
+
+  const Size num_moved = counts[num_tiles] - counts[first_moved];
+
+  if(num_moved > 0)
+  {
+    // the destination of a tile may overlap the elements kept by the tiles
+    // before it, so the elements are moved through a temporary buffer
+    thrust::detail::temporary_array<ValueType,DerivedPolicy> temp(0, exec, num_moved);
+
+    ValueType *temp_ptr = thrust::raw_pointer_cast(temp.data());
+
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(first_moved, num_tiles, 1),
+      stream_compaction_detail::move_tile_body<ForwardIterator,Decomposition,Size,ValueType>(first, decomp, counts, first_moved, temp_ptr),
+      ::tbb::simple_partitioner());
+
+    thrust::copy(exec, temp_ptr, temp_ptr + num_moved, first + counts[first_moved]);
+  }
+
+  return first + counts[num_tiles];
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/transform_reduce_multi.h>
+#include <thrust/system/detail/generic/transform_reduce_multi.h>
+#include <thrust/system/detail/internal/transform_reduce_multi.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/detail/type_traits.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace transform_reduce_multi_detail
+{
+
+
+template<typename RandomAccessIterator,
+         typename Transform,
+         typename Combine>
+struct body
+{
+  typedef typename Transform::result_type result_type;
+
+  RandomAccessIterator first;
+  Transform transform;
+  Combine combine;
+  result_type sum;
+  bool first_call;  // TBB can invoke operator() multiple times on the same body
+
+  // note: we only initalize sum with init to avoid calling result_type's default constructor
+  body(RandomAccessIterator first, Transform transform, Combine combine, const result_type &init)
+    : first(first), transform(transform), combine(combine), sum(init), first_call(true)
+  {}
+
+  body(body& b, ::tbb::split)
+    : first(b.first), transform(b.transform), combine(b.combine), sum(b.sum), first_call(true)
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size> &r)
+  {
+    if (r.empty()) return; // nothing to do
+
+    result_type temp = thrust::system::detail::internal::multi_reduce_n(first + r.begin(), r.size(), transform);
+
+    if (first_call)
+    {
+      first_call = false;
+      sum = temp;
+    }
+    else
+    {
+      sum = combine(sum, temp);
+    }
+  } // end operator()()
+
+  void join(body& b)
+  {
+    sum = combine(sum, b.sum);
+  }
+}; // end body
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(execution_policy<DerivedPolicy> &,
+           InputIterator first,
+           InputIterator last,
+           thrust::detail::true_type,
+           Reductions... reductions)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  typedef thrust::system::detail::internal::multi_transform<Reductions...> Transform;
+  typedef thrust::system::detail::internal::multi_combine<Reductions...>   Combine;
+
+  thrust::tuple<Reductions...> reductions_tuple(reductions...);
+
+  Transform transform(reductions_tuple);
+  Combine   combine(reductions_tuple);
+
+  thrust::tuple<typename Reductions::value_type...> init = thrust::system::detail::internal::multi_init(reductions...);
+
+  const Size n = last - first;
+
+  if (n == 0) return init;
+
+  typedef body<InputIterator,Transform,Combine> Body;
+  Body reduce_body(first, transform, combine, init);
+  ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n), reduce_body);
+  return combine(init, reduce_body.sum);
+} // end reduce()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(execution_policy<DerivedPolicy> &exec,
+           InputIterator first,
+           InputIterator last,
+           thrust::detail::false_type,
+           Reductions... reductions)
+{
+  // other ranges take a single reduction of tuples
+  return thrust::system::detail::generic::transform_reduce_multi(exec, first, last, reductions...);
+} // end reduce()
+
+
+} // end transform_reduce_multi_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(execution_policy<DerivedPolicy> &exec,
+                           InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions)
+{
+  return transform_reduce_multi_detail::reduce(exec, first, last, thrust::is_contiguous_iterator<InputIterator>(), reductions...);
+} // end transform_reduce_multi()
+
+
+} // end detail
+} // end tbb
+} // end system
+THRUST_NAMESPACE_END
+
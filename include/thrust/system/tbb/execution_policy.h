@@ -44,12 +44,14 @@
 #include <thrust/system/tbb/detail/gather.h>
 #include <thrust/system/tbb/detail/generate.h>
 #include <thrust/system/tbb/detail/get_value.h>
+#include <thrust/system/tbb/detail/histogram.h>
 #include <thrust/system/tbb/detail/inner_product.h>
 #include <thrust/system/tbb/detail/iter_swap.h>
 #include <thrust/system/tbb/detail/logical.h>
 #include <thrust/system/tbb/detail/malloc_and_free.h>
 #include <thrust/system/tbb/detail/merge.h>
 #include <thrust/system/tbb/detail/mismatch.h>
+#include <thrust/system/tbb/detail/partial_sort.h>
 #include <thrust/system/tbb/detail/partition.h>
 #include <thrust/system/tbb/detail/reduce.h>
 #include <thrust/system/tbb/detail/reduce_by_key.h>
@@ -59,6 +61,8 @@
 #include <thrust/system/tbb/detail/scan.h>
 #include <thrust/system/tbb/detail/scan_by_key.h>
 #include <thrust/system/tbb/detail/scatter.h>
+#include <thrust/system/tbb/detail/segmented_reduce.h>
+#include <thrust/system/tbb/detail/segmented_sort.h>
 #include <thrust/system/tbb/detail/sequence.h>
 #include <thrust/system/tbb/detail/set_operations.h>
 #include <thrust/system/tbb/detail/sort.h>
@@ -66,12 +70,19 @@
 #include <thrust/system/tbb/detail/tabulate.h>
 #include <thrust/system/tbb/detail/transform.h>
 #include <thrust/system/tbb/detail/transform_reduce.h>
+#include <thrust/system/tbb/detail/transform_reduce_multi.h>
 #include <thrust/system/tbb/detail/transform_scan.h>
 #include <thrust/system/tbb/detail/uninitialized_copy.h>
 #include <thrust/system/tbb/detail/uninitialized_fill.h>
 #include <thrust/system/tbb/detail/unique.h>
 #include <thrust/system/tbb/detail/unique_by_key.h>
 
+// the executor of the asynchronous algorithms, so that thrust::async uses it
+// whether or not this system is the host or device system
+#if THRUST_CPP_DIALECT >= 2014
+#include <thrust/system/tbb/detail/async/executor.h>
+#endif
+
 
 // define these entities here for the purpose of Doxygenating them
 // they are actually defined elsewhere
@@ -84,6 +84,17 @@ using universal_allocator = thrust::mr::stateless_resource_allocator<
   T, thrust::system::tbb::universal_memory_resource
 >;
 
+/*! \p tbb::first_touch_allocator allocates memory for the \p tbb system
+ *  from \p tbb::first_touch_memory_resource. Containers using it, such as
+ *  <tt>host_vector<T, tbb::first_touch_allocator<T> ></tt>, have their pages
+ *  placed on the NUMA nodes of the threads which later work on them, and
+ *  construct their elements in parallel on the \p tbb system.
+ */
+template<typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::tbb::first_touch_memory_resource
+>;
+
 }} // namespace system::tbb
 
 /*! \namespace thrust::tbb
@@ -95,6 +106,7 @@ using thrust::system::tbb::malloc;
 using thrust::system::tbb::free;
 using thrust::system::tbb::allocator;
 using thrust::system::tbb::universal_allocator;
+using thrust::system::tbb::first_touch_allocator;
 } // namsespace tbb
 
 THRUST_NAMESPACE_END
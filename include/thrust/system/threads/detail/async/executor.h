@@ -0,0 +1,55 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+#include <thrust/system/threads/detail/execution_policy.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/system/cpp/detail/async/executor.h>
+
+#include <functional>
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace threads { namespace detail
+{
+
+inline __host__
+void submit_to_thread_pool(std::function<void()>&& task)
+{
+  thread_pool::instance().submit(std::move(task));
+}
+
+// ADL hook: asynchronous algorithms run on the pool's idle workers.
+template <typename DerivedPolicy>
+__host__
+thrust::system::cpp::detail::async_executor
+select_async_executor(execution_policy<DerivedPolicy>&)
+{
+  return &submit_to_thread_pool;
+}
+
+}}} // namespace system::threads::detail
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
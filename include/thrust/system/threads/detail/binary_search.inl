@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/binary_search.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/system/detail/internal/sorted_search.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+
+template<template<typename> class Search,
+         typename RandomAccessIterator1,
+         typename Size1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+  struct search_body
+{
+  RandomAccessIterator1 first;
+  Size1 n;
+  RandomAccessIterator2 values_first;
+  RandomAccessIterator3 output;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+
+  search_body(RandomAccessIterator1 first, Size1 n, RandomAccessIterator2 values_first, RandomAccessIterator3 output, StrictWeakOrdering comp, Decomposition decomp)
+    : first(first), n(n), values_first(values_first), output(output), comp(comp), decomp(decomp)
+  {}
+
+  void operator()(std::size_t t) const
+  {
+    thrust::system::detail::internal::sorted_search<Search>(first, n,
+                                                            values_first + decomp[t].begin(), decomp[t].size(),
+                                                            output + decomp[t].begin(),
+                                                            comp);
+  }
+};
+
+
+// every thread searches for a contiguous range of the needles, so that sorted
+// needles are searched for by galloping along the haystack
+template<template<typename> class Search,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+  RandomAccessIterator3 sorted_search(execution_policy<DerivedPolicy> &,
+                                      RandomAccessIterator1 first,
+                                      RandomAccessIterator1 last,
+                                      RandomAccessIterator2 values_first,
+                                      RandomAccessIterator2 values_last,
+                                      RandomAccessIterator3 output,
+                                      StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size1;
+  typedef typename thrust::iterator_difference<RandomAccessIterator2>::type Size2;
+  typedef thrust::system::detail::internal::uniform_decomposition<Size2> Decomposition;
+
+  const Size1 n = thrust::distance(first, last);
+  const Size2 m = thrust::distance(values_first, values_last);
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition(m);
+
+  thread_pool::instance().parallel_for(decomp.size(),
+    search_body<Search,RandomAccessIterator1,Size1,RandomAccessIterator2,RandomAccessIterator3,StrictWeakOrdering,Decomposition>(first, n, values_first, output, comp, decomp));
+
+  return output + m;
+} // end sorted_search()
+
+
+} // end binary_search_detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  return binary_search_detail::sorted_search<thrust::system::detail::internal::lower_bound_search>(exec, first, last, values_first, values_last, output, comp);
+} // end lower_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator first,
+                           ForwardIterator last,
+                           InputIterator values_first,
+                           InputIterator values_last,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  return binary_search_detail::sorted_search<thrust::system::detail::internal::upper_bound_search>(exec, first, last, values_first, values_last, output, comp);
+} // end upper_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator first,
+                             ForwardIterator last,
+                             InputIterator values_first,
+                             InputIterator values_last,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+  return binary_search_detail::sorted_search<thrust::system::detail::internal::binary_search_search>(exec, first, last, values_first, values_last, output, comp);
+} // end binary_search()
+
+
+} // end detail
+} // end threads
+} // end system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/system/threads/detail/copy_if.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace copy_if_detail
+{
+
+
+template<typename InputIterator,
+         typename Predicate,
+         typename Size,
+         typename Decomposition>
+struct count_body
+{
+  InputIterator stencil;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+  Size *counts;
+  Decomposition decomp;
+
+  count_body(InputIterator stencil, Predicate pred, Size *counts, Decomposition decomp)
+    : stencil(stencil), pred(pred), counts(counts), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    counts[i + 1] = thrust::count_if(thrust::seq, stencil + decomp[i].begin(), stencil + decomp[i].end(), pred);
+  }
+};
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate,
+         typename Size,
+         typename Decomposition>
+struct write_body
+{
+  InputIterator1 first;
+  InputIterator2 stencil;
+  OutputIterator result;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+  const Size *offsets;
+  Decomposition decomp;
+
+  write_body(InputIterator1 first, InputIterator2 stencil, OutputIterator result, Predicate pred, const Size *offsets, Decomposition decomp)
+    : first(first), stencil(stencil), result(result), pred(pred), offsets(offsets), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    thrust::copy_if(thrust::seq,
+                    first + decomp[i].begin(), first + decomp[i].end(),
+                    stencil + decomp[i].begin(),
+                    result + offsets[i],
+                    pred);
+  }
+};
+
+
+} // end copy_if_detail
+
+
+// copy_if is computed in three steps:
+//   1. every tile counts the elements it keeps
+//   2. the counts are scanned serially into output offsets
+//   3. every tile copies the elements it keeps to its offset
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Predicate>
+  OutputIterator copy_if(execution_policy<DerivedPolicy> &exec,
+                         InputIterator1 first,
+                         InputIterator1 last,
+                         InputIterator2 stencil,
+                         OutputIterator result,
+                         Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type Size;
+  typedef thrust::system::detail::internal::uniform_decomposition<Size> Decomposition;
+
+  const Size n = thrust::distance(first, last);
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  if(decomp.size() <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::copy_if(thrust::seq, first, last, stencil, result, pred);
+  }
+
+  const Size num_tiles = decomp.size();
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> offsets(0, exec, num_tiles + 1);
+
+  Size *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  offsets_ptr[0] = 0;
+
+  thread_pool::instance().parallel_for(num_tiles,
+    copy_if_detail::count_body<InputIterator2,Predicate,Size,Decomposition>(stencil, pred, offsets_ptr, decomp));
+
+  for(Size i = 0; i < num_tiles; ++i)
+  {
+    offsets_ptr[i + 1] += offsets_ptr[i];
+  }
+
+  thread_pool::instance().parallel_for(num_tiles,
+    copy_if_detail::write_body<InputIterator1,InputIterator2,OutputIterator,Predicate,Size,Decomposition>(first, stencil, result, pred, offsets_ptr, decomp));
+
+  return result + offsets_ptr[num_tiles];
+} // end copy_if()
+
+
+} // end detail
+} // end threads
+} // end system
+THRUST_NAMESPACE_END
+
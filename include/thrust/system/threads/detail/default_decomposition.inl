@@ -0,0 +1,49 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+
+template <typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+{
+  // XXX this value is a tuning opportunity
+  const IndexType grain_size = 1 << 12;
+
+  // generate O(P) intervals of sequential work, none smaller than the grain
+  // size, so a small input is a single interval which runs on the calling
+  // thread without waking the pool
+  const IndexType p = static_cast<IndexType>(thread_pool::instance().size());
+
+  return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, grain_size, p);
+}
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/find.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/system/detail/internal/find.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <thrust/find.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+template<typename RandomAccessIterator,
+         typename Size,
+         typename Predicate>
+  struct body
+{
+  RandomAccessIterator m_first;
+  Predicate m_pred;
+  thrust::system::detail::internal::find_if_state<Size> *m_state;
+
+  body(RandomAccessIterator first, Predicate pred, thrust::system::detail::internal::find_if_state<Size> *state)
+    : m_first(first), m_pred(pred), m_state(state)
+  {}
+
+  void operator()(std::size_t) const
+  {
+    m_state->search(m_first, m_pred);
+  } // end operator()()
+}; // end body
+
+
+} // end find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  const difference_type num_threads = thrust::system::threads::detail::default_decomposition(n).size();
+
+  if(num_threads <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::find_if(thrust::seq, first, last, pred);
+  }
+
+  // rather than splitting the input among the threads up front, every thread
+  // claims chunks in order until the first match is found
+  thrust::system::detail::internal::find_if_state<difference_type> state(n);
+
+  thread_pool::instance().parallel_for(num_threads, find_detail::body<InputIterator,difference_type,Predicate>(first, pred, &state));
+
+  return first + state.result();
+} // end find_if()
+
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace for_each_detail
+{
+
+template<typename RandomAccessIterator,
+         typename Size,
+         typename UnaryFunction>
+  struct body
+{
+  RandomAccessIterator m_first;
+  UnaryFunction m_f;
+  thrust::system::detail::internal::uniform_decomposition<Size> m_decomp;
+
+  body(RandomAccessIterator first, UnaryFunction f, thrust::system::detail::internal::uniform_decomposition<Size> decomp)
+    : m_first(first), m_f(f), m_decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    thrust::for_each_n(thrust::system::detail::sequential::seq, m_first + m_decomp[i].begin(), m_decomp[i].end() - m_decomp[i].begin(), m_f);
+  } // end operator()()
+}; // end body
+
+
+template<typename Size, typename RandomAccessIterator, typename UnaryFunction>
+  body<RandomAccessIterator,Size,UnaryFunction>
+    make_body(RandomAccessIterator first, UnaryFunction f, thrust::system::detail::internal::uniform_decomposition<Size> decomp)
+{
+  return body<RandomAccessIterator,Size,UnaryFunction>(first, f, decomp);
+} // end make_body()
+
+
+} // end for_each_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename UnaryFunction>
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+                                RandomAccessIterator first,
+                                Size n,
+                                UnaryFunction f)
+{
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  thread_pool::instance().parallel_for(decomp.size(), for_each_detail::make_body<Size>(first, f, decomp));
+
+  // return the end of the range
+  return first + n;
+} // end for_each_n
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename UnaryFunction>
+  RandomAccessIterator for_each(execution_policy<DerivedPolicy> &s,
+                                RandomAccessIterator first,
+                                RandomAccessIterator last,
+                                UnaryFunction f)
+{
+  return threads::detail::for_each_n(s, first, thrust::distance(first,last), f);
+} // end for_each()
+
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/histogram.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/system/detail/internal/histogram.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace histogram_detail
+{
+
+
+template<typename InputIterator,
+         typename CountType,
+         typename Size,
+         typename BinFunction,
+         typename Decomposition>
+struct count_body
+{
+  InputIterator first;
+  CountType *private_bins;
+  Size num_bins;
+  BinFunction bin;
+  Decomposition decomp;
+
+  count_body(InputIterator first, CountType *private_bins, Size num_bins, BinFunction bin, Decomposition decomp)
+    : first(first), private_bins(private_bins), num_bins(num_bins), bin(bin), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    thrust::system::detail::internal::count_bins(first + decomp[i].begin(), first + decomp[i].end(),
+                                                 private_bins + i * num_bins,
+                                                 num_bins, bin);
+  }
+};
+
+
+template<typename RandomAccessIterator,
+         typename CountType,
+         typename Size,
+         typename Decomposition>
+struct sum_body
+{
+  RandomAccessIterator histogram;
+  const CountType *private_bins;
+  Size num_bins;
+  Size num_tiles;
+  Decomposition decomp;
+
+  sum_body(RandomAccessIterator histogram, const CountType *private_bins, Size num_bins, Size num_tiles, Decomposition decomp)
+    : histogram(histogram), private_bins(private_bins), num_bins(num_bins), num_tiles(num_tiles), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    for(Size b = decomp[i].begin(); b != decomp[i].end(); ++b)
+    {
+      CountType sum = private_bins[b];
+
+      for(Size t = 1; t < num_tiles; ++t)
+      {
+        sum += private_bins[t * num_bins + b];
+      }
+
+      histogram[b] = sum;
+    }
+  }
+};
+
+
+// every tile counts its samples into private bins, which are summed across
+// tiles at the end, so no two threads ever update the same count
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename BinFunction>
+  RandomAccessIterator histogram(execution_policy<DerivedPolicy> &exec,
+                                 InputIterator first,
+                                 InputIterator last,
+                                 RandomAccessIterator histogram,
+                                 Size num_bins,
+                                 BinFunction bin)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type count_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+
+  if(num_bins <= 0) return histogram;
+
+  const difference_type n    = thrust::distance(first, last);
+  const difference_type bins = static_cast<difference_type>(num_bins);
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  // clearing and summing private bins costs num_bins per tile, so give every
+  // tile at least as many samples as there are bins
+  if(decomp.size() > 1 && decomp.size() > n / bins)
+  {
+    const difference_type num_tiles = n / bins > 1 ? n / bins : 1;
+
+    decomp = Decomposition(n, (n + num_tiles - 1) / num_tiles, num_tiles);
+  }
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::system::detail::internal::count_bins(first, last, histogram, num_bins, bin);
+
+    return histogram + num_bins;
+  }
+
+  thrust::detail::temporary_array<count_type,DerivedPolicy> private_bins(exec, num_tiles * bins);
+
+  count_type *private_bins_ptr = thrust::raw_pointer_cast(private_bins.data());
+
+  thread_pool::instance().parallel_for(num_tiles,
+    count_body<InputIterator,count_type,difference_type,BinFunction,Decomposition>(first, private_bins_ptr, bins, bin, decomp));
+
+  // the bins are summed in as many tiles, each reading a column of private bins
+  const Decomposition bin_decomp = thrust::system::threads::detail::default_decomposition(bins);
+
+  thread_pool::instance().parallel_for(bin_decomp.size(),
+    sum_body<RandomAccessIterator,count_type,difference_type,Decomposition>(histogram, private_bins_ptr, bins, num_tiles, bin_decomp));
+
+  return histogram + num_bins;
+} // end histogram()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator histogram_even(execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      T lower_level,
+                                      T upper_level)
+{
+  thrust::system::detail::internal::even_bin<T,Size> bin(num_bins, lower_level, upper_level);
+
+  return histogram_detail::histogram(exec, first, last, histogram, num_bins, bin);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename LevelIterator,
+         typename RandomAccessIterator>
+  RandomAccessIterator histogram_range(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator first,
+                                       InputIterator last,
+                                       LevelIterator levels_first,
+                                       LevelIterator levels_last,
+                                       RandomAccessIterator histogram)
+{
+  typedef typename thrust::iterator_difference<LevelIterator>::type Size;
+
+  const Size num_bins = thrust::distance(levels_first, levels_last) - 1;
+
+  thrust::system::detail::internal::range_bin<LevelIterator> bin(levels_first, num_bins);
+
+  return histogram_detail::histogram(exec, first, last, histogram, num_bins, bin);
+} // end histogram_range()
+
+
+} // end detail
+} // end threads
+} // end system
+THRUST_NAMESPACE_END
+
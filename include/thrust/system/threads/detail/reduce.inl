@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/threads/detail/reduce.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/reduce_intervals.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/reduce.h>
+#include <thrust/detail/trace.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType reduce(execution_policy<DerivedPolicy> &exec,
+                    InputIterator first,
+                    InputIterator last,
+                    OutputType init,
+                    BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first,last);
+
+  THRUST_TRACE_SCOPE("reduce", "threads", n);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  if(decomp.size() <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::reduce(thrust::seq, first, last, init, binary_op);
+  }
+
+  // accumulate partial sums (first level reduction)
+  thrust::detail::temporary_array<OutputType,DerivedPolicy> partial_sums(exec, decomp.size());
+
+  {
+    THRUST_TRACE_PHASE("reduce intervals");
+
+    thrust::system::threads::detail::reduce_intervals(exec, first, partial_sums.begin(), binary_op, decomp);
+  }
+
+  // reduce partial sums (second level reduction)
+  return thrust::reduce(thrust::seq, partial_sums.begin(), partial_sums.end(), init, binary_op);
+} // end reduce()
+
+
+} // end detail
+} // end threads
+} // end system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/reduce_intervals.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/lane_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace reduce_intervals_detail
+{
+
+
+template<typename InputIterator, typename OutputIterator, typename BinaryFunction, typename Decomposition>
+  struct body
+{
+  typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
+
+  InputIterator input;
+  OutputIterator output;
+  BinaryFunction binary_op;
+  Decomposition decomp;
+
+  body(InputIterator input, OutputIterator output, BinaryFunction binary_op, Decomposition decomp)
+    : input(input), output(output), binary_op(binary_op), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    InputIterator begin = input + decomp[i].begin();
+    InputIterator end   = input + decomp[i].end();
+
+    if (begin != end)
+    {
+      OutputType sum = thrust::raw_reference_cast(*begin);
+
+      sum = thrust::system::detail::internal::lane_reduce_n(begin + 1, (end - begin) - 1, sum, binary_op);
+
+      OutputIterator tmp = output + i;
+      *tmp = sum;
+    }
+  }
+};
+
+
+} // end reduce_intervals_detail
+
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename OutputIterator,
+          typename BinaryFunction,
+          typename Decomposition>
+void reduce_intervals(execution_policy<DerivedPolicy> &,
+                      InputIterator input,
+                      OutputIterator output,
+                      BinaryFunction binary_op,
+                      Decomposition decomp)
+{
+  thread_pool::instance().parallel_for(decomp.size(),
+    reduce_intervals_detail::body<InputIterator,OutputIterator,BinaryFunction,Decomposition>(input, output, binary_op, decomp));
+}
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,249 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/scan.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/reduce_intervals.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/scan.h>
+#include <thrust/detail/trace.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction,
+         typename Decomposition>
+struct inclusive_body
+{
+  InputIterator first;
+  OutputIterator result;
+  const ValueType *carries;
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> binary_op;
+  Decomposition decomp;
+
+  inclusive_body(InputIterator first, OutputIterator result, const ValueType *carries, BinaryFunction binary_op, Decomposition decomp)
+    : first(first), result(result), carries(carries), binary_op(binary_op), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    InputIterator  iter1 = first  + decomp[i].begin();
+    InputIterator  end1  = first  + decomp[i].end();
+    OutputIterator iter2 = result + decomp[i].begin();
+
+    // the first tile has no carry-in
+    ValueType sum = (i == 0) ? ValueType(*iter1) : carries[i - 1];
+
+    if(i == 0)
+    {
+      *iter2 = sum;
+      ++iter1;
+      ++iter2;
+    }
+
+    for(; iter1 != end1; ++iter1, ++iter2)
+    {
+      *iter2 = sum = binary_op(sum, *iter1);
+    }
+  }
+};
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename ValueType,
+         typename BinaryFunction,
+         typename Decomposition>
+struct exclusive_body
+{
+  InputIterator first;
+  OutputIterator result;
+  const ValueType *carries;
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> binary_op;
+  Decomposition decomp;
+
+  exclusive_body(InputIterator first, OutputIterator result, const ValueType *carries, BinaryFunction binary_op, Decomposition decomp)
+    : first(first), result(result), carries(carries), binary_op(binary_op), decomp(decomp)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    InputIterator  iter1 = first  + decomp[i].begin();
+    InputIterator  end1  = first  + decomp[i].end();
+    OutputIterator iter2 = result + decomp[i].begin();
+
+    ValueType sum = carries[i];
+
+    for(; iter1 != end1; ++iter1, ++iter2)
+    {
+      ValueType temp = *iter1; // temporary value allows in-situ scan
+      *iter2 = sum;
+      sum = binary_op(sum, temp);
+    }
+  }
+};
+
+
+} // end scan_detail
+
+
+// Both scans are computed in two passes over the same decomposition:
+//   1. every tile is reduced independently (reduce_intervals)
+//   2. the tile sums are scanned serially to find each tile's carry-in
+//   3. every tile is scanned independently, seeded with its carry-in
+// The input is only read in steps 1 and 3, so in-place scans are safe.
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op)
+{
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator>::type      ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+
+  const difference_type n = thrust::distance(first, last);
+
+  THRUST_TRACE_SCOPE("inclusive_scan", "threads", n);
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  if(decomp.size() <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::inclusive_scan(thrust::seq, first, last, result, binary_op);
+  }
+
+  const difference_type num_tiles = decomp.size();
+
+  // reduce each tile
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> tile_sums(exec, num_tiles);
+  {
+    THRUST_TRACE_PHASE("reduce tiles");
+
+    thrust::system::threads::detail::reduce_intervals(exec, first, tile_sums.begin(), binary_op, decomp);
+  }
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // tile_sums[i] becomes the carry-in of tile i + 1
+  for(difference_type i = 1; i < num_tiles; ++i)
+  {
+    tile_sums[i] = wrapped_binary_op(tile_sums[i - 1], tile_sums[i]);
+  }
+
+  // scan each tile
+  THRUST_TRACE_PHASE("scan tiles");
+
+  thread_pool::instance().parallel_for(num_tiles,
+    scan_detail::inclusive_body<InputIterator,OutputIterator,ValueType,BinaryFunction,Decomposition>(first, result, thrust::raw_pointer_cast(tile_sums.data()), binary_op, decomp));
+
+  return result + n;
+} // end inclusive_scan()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op)
+{
+  // Use the initial value type per https://wg21.link/P0571
+  typedef InitialValueType                                           ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+
+  const difference_type n = thrust::distance(first, last);
+
+  THRUST_TRACE_SCOPE("exclusive_scan", "threads", n);
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  if(decomp.size() <= 1)
+  {
+    // don't bother parallelizing for small n
+    return thrust::exclusive_scan(thrust::seq, first, last, result, init, binary_op);
+  }
+
+  const difference_type num_tiles = decomp.size();
+
+  // reduce each tile
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> tile_sums(exec, num_tiles);
+  {
+    THRUST_TRACE_PHASE("reduce tiles");
+
+    thrust::system::threads::detail::reduce_intervals(exec, first, tile_sums.begin(), binary_op, decomp);
+  }
+
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // tile_sums[i] becomes the carry-in of tile i
+  ValueType carry = init;
+
+  for(difference_type i = 0; i < num_tiles; ++i)
+  {
+    ValueType tile_sum = tile_sums[i];
+    tile_sums[i] = carry;
+    carry = wrapped_binary_op(carry, tile_sum);
+  }
+
+  // scan each tile
+  THRUST_TRACE_PHASE("scan tiles");
+
+  thread_pool::instance().parallel_for(num_tiles,
+    scan_detail::exclusive_body<InputIterator,OutputIterator,ValueType,BinaryFunction,Decomposition>(first, result, thrust::raw_pointer_cast(tile_sums.data()), binary_op, decomp));
+
+  return result + n;
+} // end exclusive_scan()
+
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
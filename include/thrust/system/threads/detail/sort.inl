@@ -0,0 +1,668 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/detail/internal/serial_policy.h>
+#include <thrust/system/detail/internal/sort_tile.h>
+#include <thrust/sort.h>
+#include <thrust/merge.h>
+#include <thrust/copy.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/trace.h>
+#include <thrust/detail/temporary_array.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace sort_detail
+{
+
+
+// sorts tile p, using the same tile of buffer as scratch space
+template<typename RandomAccessIterator,
+         typename Pointer,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+struct sort_tile_body
+{
+  RandomAccessIterator first;
+  Pointer buffer;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+
+  sort_tile_body(RandomAccessIterator first, Pointer buffer, StrictWeakOrdering comp, Decomposition decomp)
+    : first(first), buffer(buffer), comp(comp), decomp(decomp)
+  {}
+
+  void operator()(std::size_t p) const
+  {
+    thrust::system::detail::internal::sort_tile(first + decomp[p].begin(),
+                                                first + decomp[p].end(),
+                                                buffer + decomp[p].begin(),
+                                                comp);
+  }
+};
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Pointer1,
+         typename Pointer2,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+struct sort_tile_by_key_body
+{
+  RandomAccessIterator1 keys_first;
+  RandomAccessIterator2 values_first;
+  Pointer1 keys_buffer;
+  Pointer2 values_buffer;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+
+  sort_tile_by_key_body(RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, Pointer1 keys_buffer, Pointer2 values_buffer, StrictWeakOrdering comp, Decomposition decomp)
+    : keys_first(keys_first), values_first(values_first), keys_buffer(keys_buffer), values_buffer(values_buffer), comp(comp), decomp(decomp)
+  {}
+
+  void operator()(std::size_t p) const
+  {
+    thrust::system::detail::internal::sort_tile_by_key(keys_first + decomp[p].begin(),
+                                                       keys_first + decomp[p].end(),
+                                                       values_first + decomp[p].begin(),
+                                                       keys_buffer + decomp[p].begin(),
+                                                       values_buffer + decomp[p].begin(),
+                                                       comp);
+  }
+};
+
+
+// Merges each pair of adjacent runs of the form
+//   [decomp[j].begin(), decomp[j + w].begin()), [decomp[j + w].begin(), decomp[j + 2w].begin())
+// where j is a multiple of 2w, from src into dst. Output tile p is produced
+// by task p, which locates its share of the two runs with a merge path
+// search, so every level of the merge tree uses all the tiles.
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+struct merge_level_body
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  RandomAccessIterator1 src;
+  RandomAccessIterator2 dst;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+  IndexType w;
+
+  merge_level_body(RandomAccessIterator1 src, RandomAccessIterator2 dst, StrictWeakOrdering comp, Decomposition decomp, IndexType w)
+    : src(src), dst(dst), comp(comp), decomp(decomp), w(w)
+  {}
+
+  void operator()(std::size_t task) const
+  {
+    const IndexType p         = static_cast<IndexType>(task);
+    const IndexType num_tiles = decomp.size();
+    const IndexType n         = decomp[num_tiles - 1].end();
+
+    const IndexType first_tile = (p / (2 * w)) * (2 * w);
+    const IndexType mid_tile   = first_tile + w;
+    const IndexType last_tile  = (first_tile + 2 * w < num_tiles) ? first_tile + 2 * w : num_tiles;
+
+    const IndexType begin1 = decomp[first_tile].begin();
+    const IndexType begin2 = (mid_tile < num_tiles) ? decomp[mid_tile].begin() : n;
+    const IndexType end2   = decomp[last_tile - 1].end();
+
+    const IndexType diag_begin = decomp[p].begin() - begin1;
+    const IndexType diag_end   = decomp[p].end()   - begin1;
+
+    const IndexType i_begin = thrust::system::detail::internal::merge_path(src + begin1, begin2 - begin1, src + begin2, end2 - begin2, diag_begin, comp);
+    const IndexType i_end   = thrust::system::detail::internal::merge_path(src + begin1, begin2 - begin1, src + begin2, end2 - begin2, diag_end,   comp);
+
+    thrust::merge(thrust::seq,
+                  src + begin1 + i_begin, src + begin1 + i_end,
+                  src + begin2 + (diag_begin - i_begin), src + begin2 + (diag_end - i_end),
+                  dst + decomp[p].begin(),
+                  comp);
+  }
+};
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename StrictWeakOrdering,
+         typename Decomposition>
+struct merge_level_by_key_body
+{
+  typedef typename Decomposition::index_type IndexType;
+
+  RandomAccessIterator1 keys_src;
+  RandomAccessIterator2 values_src;
+  RandomAccessIterator3 keys_dst;
+  RandomAccessIterator4 values_dst;
+  StrictWeakOrdering comp;
+  Decomposition decomp;
+  IndexType w;
+
+  merge_level_by_key_body(RandomAccessIterator1 keys_src, RandomAccessIterator2 values_src,
+                          RandomAccessIterator3 keys_dst, RandomAccessIterator4 values_dst,
+                          StrictWeakOrdering comp, Decomposition decomp, IndexType w)
+    : keys_src(keys_src), values_src(values_src),
+      keys_dst(keys_dst), values_dst(values_dst),
+      comp(comp), decomp(decomp), w(w)
+  {}
+
+  void operator()(std::size_t task) const
+  {
+    const IndexType p         = static_cast<IndexType>(task);
+    const IndexType num_tiles = decomp.size();
+    const IndexType n         = decomp[num_tiles - 1].end();
+
+    const IndexType first_tile = (p / (2 * w)) * (2 * w);
+    const IndexType mid_tile   = first_tile + w;
+    const IndexType last_tile  = (first_tile + 2 * w < num_tiles) ? first_tile + 2 * w : num_tiles;
+
+    const IndexType begin1 = decomp[first_tile].begin();
+    const IndexType begin2 = (mid_tile < num_tiles) ? decomp[mid_tile].begin() : n;
+    const IndexType end2   = decomp[last_tile - 1].end();
+
+    const IndexType diag_begin = decomp[p].begin() - begin1;
+    const IndexType diag_end   = decomp[p].end()   - begin1;
+
+    const IndexType i_begin = thrust::system::detail::internal::merge_path(keys_src + begin1, begin2 - begin1, keys_src + begin2, end2 - begin2, diag_begin, comp);
+    const IndexType i_end   = thrust::system::detail::internal::merge_path(keys_src + begin1, begin2 - begin1, keys_src + begin2, end2 - begin2, diag_end,   comp);
+
+    const IndexType j_begin = diag_begin - i_begin;
+    const IndexType j_end   = diag_end   - i_end;
+
+    thrust::merge_by_key(thrust::seq,
+                         keys_src + begin1 + i_begin, keys_src + begin1 + i_end,
+                         keys_src + begin2 + j_begin, keys_src + begin2 + j_end,
+                         values_src + begin1 + i_begin,
+                         values_src + begin2 + j_begin,
+                         keys_dst + decomp[p].begin(),
+                         values_dst + decomp[p].begin(),
+                         comp);
+  }
+};
+
+
+// returns the number of levels in a merge tree with num_tiles leaves
+template<typename IndexType>
+int num_merge_levels(IndexType num_tiles)
+{
+  int result = 0;
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+    ++result;
+
+  return result;
+}
+
+
+template<typename Digit,
+         typename RandomAccessIterator,
+         typename Decomposition>
+struct radix_histogram_body
+{
+  Digit digit;
+  RandomAccessIterator keys;
+  Decomposition decomp;
+  size_t *histograms;
+
+  radix_histogram_body(Digit digit, RandomAccessIterator keys, Decomposition decomp, size_t *histograms)
+    : digit(digit), keys(keys), decomp(decomp), histograms(histograms)
+  {}
+
+  void operator()(std::size_t p) const
+  {
+    thrust::system::detail::internal::radix_histogram(digit, keys, decomp[p].begin(), decomp[p].end(), histograms + p * Digit::num_buckets);
+  }
+};
+
+
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Decomposition>
+struct radix_scatter_body
+{
+  Digit digit;
+  RandomAccessIterator1 src;
+  RandomAccessIterator2 dst;
+  Decomposition decomp;
+  size_t *histograms;
+
+  radix_scatter_body(Digit digit, RandomAccessIterator1 src, RandomAccessIterator2 dst, Decomposition decomp, size_t *histograms)
+    : digit(digit), src(src), dst(dst), decomp(decomp), histograms(histograms)
+  {}
+
+  void operator()(std::size_t p) const
+  {
+    thrust::system::detail::internal::radix_scatter(digit, src, decomp[p].begin(), decomp[p].end(), dst, histograms + p * Digit::num_buckets);
+  }
+};
+
+
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Decomposition>
+struct radix_scatter_by_key_body
+{
+  Digit digit;
+  RandomAccessIterator1 keys_src;
+  RandomAccessIterator2 values_src;
+  RandomAccessIterator3 keys_dst;
+  RandomAccessIterator4 values_dst;
+  Decomposition decomp;
+  size_t *histograms;
+
+  radix_scatter_by_key_body(Digit digit,
+                            RandomAccessIterator1 keys_src, RandomAccessIterator2 values_src,
+                            RandomAccessIterator3 keys_dst, RandomAccessIterator4 values_dst,
+                            Decomposition decomp, size_t *histograms)
+    : digit(digit),
+      keys_src(keys_src), values_src(values_src),
+      keys_dst(keys_dst), values_dst(values_dst),
+      decomp(decomp), histograms(histograms)
+  {}
+
+  void operator()(std::size_t p) const
+  {
+    thrust::system::detail::internal::radix_scatter(digit, keys_src, values_src, decomp[p].begin(), decomp[p].end(), keys_dst, values_dst, histograms + p * Digit::num_buckets);
+  }
+};
+
+
+// Sorts the tiles' elements by one digit from src into dst. Returns false
+// without touching dst if the pass can be skipped.
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Decomposition>
+bool radix_pass(Digit digit,
+                RandomAccessIterator1 src,
+                RandomAccessIterator2 dst,
+                Decomposition decomp,
+                size_t *histograms)
+{
+  const std::size_t num_tiles = decomp.size();
+
+  thread_pool::instance().parallel_for(num_tiles,
+    radix_histogram_body<Digit,RandomAccessIterator1,Decomposition>(digit, src, decomp, histograms));
+
+  if(!thrust::system::detail::internal::radix_scan_histograms<Digit>(histograms, num_tiles, decomp[num_tiles - 1].end()))
+    return false;
+
+  thread_pool::instance().parallel_for(num_tiles,
+    radix_scatter_body<Digit,RandomAccessIterator1,RandomAccessIterator2,Decomposition>(digit, src, dst, decomp, histograms));
+
+  return true;
+}
+
+
+template<typename Digit,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Decomposition>
+bool radix_pass_by_key(Digit digit,
+                       RandomAccessIterator1 keys_src,
+                       RandomAccessIterator2 values_src,
+                       RandomAccessIterator3 keys_dst,
+                       RandomAccessIterator4 values_dst,
+                       Decomposition decomp,
+                       size_t *histograms)
+{
+  const std::size_t num_tiles = decomp.size();
+
+  thread_pool::instance().parallel_for(num_tiles,
+    radix_histogram_body<Digit,RandomAccessIterator1,Decomposition>(digit, keys_src, decomp, histograms));
+
+  if(!thrust::system::detail::internal::radix_scan_histograms<Digit>(histograms, num_tiles, decomp[num_tiles - 1].end()))
+    return false;
+
+  thread_pool::instance().parallel_for(num_tiles,
+    radix_scatter_by_key_body<Digit,RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,RandomAccessIterator4,Decomposition>(digit, keys_src, values_src, keys_dst, values_dst, decomp, histograms));
+
+  return true;
+}
+
+
+// XXX this value is a tuning opportunity
+const static int radix_sort_threshold = 1 << 16;
+
+
+////////////////
+// Radix Sort //
+////////////////
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      KeyType;
+  typedef thrust::system::detail::internal::radix_digit<KeyType,StrictWeakOrdering> Digit;
+
+  const IndexType n = last - first;
+
+  if(n < radix_sort_threshold)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::system::detail::internal::serial_policy(exec), first, last, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  thrust::detail::temporary_array<KeyType,DerivedPolicy> temp(0, exec, n);
+  thrust::detail::temporary_array<size_t,DerivedPolicy>  histograms(0, exec, decomp.size() * Digit::num_buckets);
+
+  KeyType *temp_ptr       = thrust::raw_pointer_cast(temp.data());
+  size_t  *histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  // false if the most recent data is in [first, last)
+  bool temp_is_source = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    THRUST_TRACE_PHASE("radix pass");
+
+    bool shuffled = temp_is_source ?
+      radix_pass(Digit(pass), temp_ptr, first, decomp, histograms_ptr) :
+      radix_pass(Digit(pass), first, temp_ptr, decomp, histograms_ptr);
+
+    if(shuffled)
+      temp_is_source = !temp_is_source;
+  }
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, temp.begin(), temp.end(), first);
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+  typedef thrust::system::detail::internal::radix_digit<KeyType,StrictWeakOrdering> Digit;
+
+  const IndexType n = keys_last - keys_first;
+
+  if(n < radix_sort_threshold)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::system::detail::internal::serial_policy(exec), keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys_temp(0, exec, n);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values_temp(exec, n);
+  thrust::detail::temporary_array<size_t,DerivedPolicy>    histograms(0, exec, decomp.size() * Digit::num_buckets);
+
+  KeyType   *keys_temp_ptr   = thrust::raw_pointer_cast(keys_temp.data());
+  ValueType *values_temp_ptr = thrust::raw_pointer_cast(values_temp.data());
+  size_t    *histograms_ptr  = thrust::raw_pointer_cast(histograms.data());
+
+  // false if the most recent data is in [keys_first, keys_last)
+  bool temp_is_source = false;
+
+  for(unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    THRUST_TRACE_PHASE("radix pass");
+
+    bool shuffled = temp_is_source ?
+      radix_pass_by_key(Digit(pass), keys_temp_ptr, values_temp_ptr, keys_first, values_first, decomp, histograms_ptr) :
+      radix_pass_by_key(Digit(pass), keys_first, values_first, keys_temp_ptr, values_temp_ptr, decomp, histograms_ptr);
+
+    if(shuffled)
+      temp_is_source = !temp_is_source;
+  }
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, keys_temp.begin(), keys_temp.end(), keys_first);
+    thrust::copy(exec, values_temp.begin(), values_temp.end(), values_first);
+  }
+}
+
+
+////////////////
+// Merge Sort //
+////////////////
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      ValueType;
+  typedef thrust::system::detail::internal::uniform_decomposition<IndexType> Decomposition;
+  typedef typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator TempIterator;
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition<IndexType>(last - first);
+
+  const IndexType num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort(thrust::system::detail::internal::serial_policy(exec), first, last, comp);
+    return;
+  }
+
+  // a single buffer, allocated here so that the allocator is never called
+  // from the pool's workers, is the scratch space of the tile sorts and then
+  // the other half of the merges
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> temp(exec, last - first);
+
+  // every thread sorts its own tile
+  {
+    THRUST_TRACE_PHASE("tile sort");
+
+    thread_pool::instance().parallel_for(num_tiles,
+      sort_tile_body<RandomAccessIterator,ValueType*,StrictWeakOrdering,Decomposition>(first, thrust::raw_pointer_cast(temp.data()), comp, decomp));
+  }
+
+  // merge the sorted tiles pairwise, alternating between [first, last) and
+  // the buffer; starting from a copy in the buffer when the number of levels
+  // is odd leaves the result of the last level in [first, last)
+  bool temp_is_source = (sort_detail::num_merge_levels(num_tiles) % 2) == 1;
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, first, last, temp.begin());
+  }
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+  {
+    THRUST_TRACE_PHASE("merge");
+
+    if(temp_is_source)
+    {
+      thread_pool::instance().parallel_for(num_tiles,
+        merge_level_body<TempIterator,RandomAccessIterator,StrictWeakOrdering,Decomposition>(temp.begin(), first, comp, decomp, w));
+    }
+    else
+    {
+      thread_pool::instance().parallel_for(num_tiles,
+        merge_level_body<RandomAccessIterator,TempIterator,StrictWeakOrdering,Decomposition>(first, temp.begin(), comp, decomp, w));
+    }
+
+    temp_is_source = !temp_is_source;
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      ValueType;
+  typedef thrust::system::detail::internal::uniform_decomposition<IndexType> Decomposition;
+  typedef typename thrust::detail::temporary_array<KeyType,DerivedPolicy>::iterator   KeyTempIterator;
+  typedef typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator ValueTempIterator;
+
+  Decomposition decomp = thrust::system::threads::detail::default_decomposition<IndexType>(keys_last - keys_first);
+
+  const IndexType num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    thrust::stable_sort_by_key(thrust::system::detail::internal::serial_policy(exec), keys_first, keys_last, values_first, comp);
+    return;
+  }
+
+  // see merge sort version of stable_sort
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   keys_temp(exec, keys_last - keys_first);
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> values_temp(exec, keys_last - keys_first);
+
+  // every thread sorts its own tile
+  {
+    THRUST_TRACE_PHASE("tile sort");
+
+    thread_pool::instance().parallel_for(num_tiles,
+      sort_tile_by_key_body<RandomAccessIterator1,RandomAccessIterator2,KeyType*,ValueType*,StrictWeakOrdering,Decomposition>(keys_first, values_first, thrust::raw_pointer_cast(keys_temp.data()), thrust::raw_pointer_cast(values_temp.data()), comp, decomp));
+  }
+
+  RandomAccessIterator2 values_last = values_first + (keys_last - keys_first);
+
+  bool temp_is_source = (sort_detail::num_merge_levels(num_tiles) % 2) == 1;
+
+  if(temp_is_source)
+  {
+    thrust::copy(exec, keys_first, keys_last, keys_temp.begin());
+    thrust::copy(exec, values_first, values_last, values_temp.begin());
+  }
+
+  for(IndexType w = 1; w < num_tiles; w *= 2)
+  {
+    THRUST_TRACE_PHASE("merge");
+
+    if(temp_is_source)
+    {
+      thread_pool::instance().parallel_for(num_tiles,
+        merge_level_by_key_body<KeyTempIterator,ValueTempIterator,RandomAccessIterator1,RandomAccessIterator2,StrictWeakOrdering,Decomposition>(keys_temp.begin(), values_temp.begin(), keys_first, values_first, comp, decomp, w));
+    }
+    else
+    {
+      thread_pool::instance().parallel_for(num_tiles,
+        merge_level_by_key_body<RandomAccessIterator1,RandomAccessIterator2,KeyTempIterator,ValueTempIterator,StrictWeakOrdering,Decomposition>(keys_first, values_first, keys_temp.begin(), values_temp.begin(), comp, decomp, w));
+    }
+
+    temp_is_source = !temp_is_source;
+  }
+}
+
+
+} // end sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+  thrust::system::detail::internal::use_radix_sort<KeyType,StrictWeakOrdering> use_radix_sort;
+
+  THRUST_TRACE_SCOPE("stable_sort", "threads", last - first);
+
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+  thrust::system::detail::internal::use_radix_sort<KeyType,StrictWeakOrdering> use_radix_sort;
+
+  THRUST_TRACE_SCOPE("stable_sort_by_key", "threads", keys_last - keys_first);
+
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_radix_sort);
+}
+
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
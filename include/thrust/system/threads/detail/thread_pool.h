@@ -0,0 +1,231 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file thread_pool.h
+ *  \brief The persistent pool of worker threads used by the threads system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+
+
+// A fixed set of worker threads which execute the iterations of parallel_for
+// calls together with the threads which make them.
+//
+// Each call is a job whose iterations are initially split into one
+// contiguous range per thread of the pool. A thread consumes its own range
+// from the front, and when it runs dry it steals the back half of another
+// thread's range, so uneven iterations balance themselves without a central
+// queue. Any number of threads may call parallel_for at once: every caller
+// works on its own job, and the workers join whichever jobs still have
+// iterations left, so concurrent calls share the workers instead of running
+// on their callers alone.
+//
+// Between calls the workers spin for a few microseconds before going to
+// sleep, so a burst of back-to-back algorithm calls does not pay for waking
+// them every time.
+//
+// Idle workers also run the tasks submitted to the pool one at a time; the
+// threads system runs its asynchronous algorithms this way, so the tasks
+// share the pool's threads instead of starting threads of their own.
+class thread_pool
+{
+  public:
+    // the pool shared by every algorithm of the threads system. It has
+    // std::thread::hardware_concurrency() threads, counting the caller of
+    // parallel_for, unless the environment variable
+    // THRUST_THREADS_NUM_THREADS holds another positive number when the pool
+    // is first used
+    inline static thread_pool &instance();
+
+    // the pool runs parallel_for on num_workers threads plus the caller
+    inline explicit thread_pool(std::size_t num_workers);
+
+    inline ~thread_pool();
+
+    // returns the number of threads which execute a parallel_for
+    inline std::size_t size() const;
+
+    // calls f(i) for every i in [0, num_tasks) and returns once all calls
+    // have completed. The calls run on the calling thread alone when there
+    // is at most one task, when the pool has no workers, or when called from
+    // within a task.
+    //
+    // If a call throws, the calls not yet started are skipped, and the first
+    // exception is rethrown on the calling thread once every call in flight
+    // has returned.
+    template<typename Function>
+      void parallel_for(std::size_t num_tasks, Function f);
+
+    // runs task on an idle worker, or on the calling thread before returning
+    // when the pool has no workers. A parallel_for called by the task runs
+    // on the pool like one called from outside it. task must not throw.
+    inline void submit(std::function<void()> &&task);
+
+  private:
+    typedef void (*task_function)(void *, std::size_t);
+
+    // one thread's share of the iterations, padded to its own cache line
+    struct task_range
+    {
+      std::mutex  mutex;
+      std::size_t begin;
+      std::size_t end;
+      char        padding[64];
+    };
+
+    // a parallel_for in progress, which lives on its caller's stack; the
+    // caller is thread 0 of the job and worker i is thread i
+    struct job
+    {
+      task_function function;
+      void         *context;
+      task_range   *ranges;
+
+      // the iterations no thread has taken yet
+      std::atomic<std::size_t> unclaimed;
+
+      // the iterations which have not finished yet
+      std::atomic<std::size_t> pending;
+
+      // the workers which have joined the job
+      std::atomic<std::size_t> active;
+
+      // set once an iteration has thrown; guarded by the pool's m_mutex
+      // together with exception
+      std::atomic<bool>  failed;
+      std::exception_ptr exception;
+    };
+
+    template<typename Function>
+      static void invoke(void *f, std::size_t i)
+    {
+      (*static_cast<Function*>(f))(i);
+    }
+
+    inline static std::size_t default_num_workers();
+
+    inline static bool &inside_parallel_for();
+
+    // marks the calling thread as inside a parallel_for for its lifetime
+    struct nested_scope
+    {
+      bool &nested;
+
+      explicit nested_scope(bool &nested)
+        : nested(nested)
+      {
+        nested = true;
+      }
+
+      ~nested_scope()
+      {
+        nested = false;
+      }
+    };
+
+    inline void fail(job &j, std::exception_ptr e);
+
+    inline void run(std::size_t num_tasks, task_function f, void *context);
+
+    inline void work(job &j, std::size_t id);
+
+    inline bool pop(job &j, std::size_t id, std::size_t &task);
+
+    inline bool steal(job &j, std::size_t id, std::size_t &task);
+
+    // returns a job with iterations left, or 0; m_mutex must be held
+    inline job *find_job(std::size_t id) const;
+
+    inline void worker_loop(std::size_t id);
+
+    // how long an idle worker polls for work before it goes to sleep
+    static std::chrono::microseconds spin_duration()
+    {
+      return std::chrono::microseconds(5);
+    }
+
+    std::vector<std::thread> m_workers;
+
+    // guards m_jobs, m_free_ranges, m_stop & m_submitted
+    std::mutex                                 m_mutex;
+    std::condition_variable                    m_wake;
+    std::vector<job*>                          m_jobs;
+    std::vector<std::unique_ptr<task_range[]>> m_free_ranges;
+    bool                                       m_stop;
+    std::deque<std::function<void()>>          m_submitted;
+
+    // the size of m_submitted and the number of jobs started so far, which
+    // spinning workers poll
+    std::atomic<std::size_t> m_num_submitted;
+    std::atomic<std::size_t> m_num_jobs_started;
+
+    thread_pool(const thread_pool &);
+    thread_pool &operator=(const thread_pool &);
+};
+
+
+template<typename Function>
+  void thread_pool::parallel_for(std::size_t num_tasks, Function f)
+{
+  bool &nested = inside_parallel_for();
+
+  if(num_tasks <= 1 || m_workers.empty() || nested)
+  {
+    for(std::size_t i = 0; i < num_tasks; ++i)
+    {
+      f(i);
+    }
+
+    return;
+  }
+
+  nested_scope scope(nested);
+
+  run(num_tasks, &invoke<Function>, &f);
+}
+
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/threads/detail/thread_pool.inl>
+
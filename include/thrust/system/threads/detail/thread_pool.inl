@@ -0,0 +1,411 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+
+
+thread_pool &thread_pool::instance()
+{
+  static thread_pool pool(default_num_workers());
+
+  return pool;
+}
+
+
+std::size_t thread_pool::default_num_workers()
+{
+  // the calling thread is one of the pool's threads
+  if(const char *value = std::getenv("THRUST_THREADS_NUM_THREADS"))
+  {
+    char *end = 0;
+    const unsigned long num_threads = std::strtoul(value, &end, 10);
+
+    if(end != value && *end == '\0' && num_threads > 0)
+    {
+      return static_cast<std::size_t>(num_threads - 1);
+    }
+  }
+
+  return std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0;
+}
+
+
+thread_pool::thread_pool(std::size_t num_workers)
+  : m_stop(false),
+    m_num_submitted(0),
+    m_num_jobs_started(0)
+{
+  m_workers.reserve(num_workers);
+
+  for(std::size_t i = 0; i < num_workers; ++i)
+  {
+    // the calling thread of parallel_for is thread 0
+    m_workers.push_back(std::thread(&thread_pool::worker_loop, this, i + 1));
+  }
+}
+
+
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  m_wake.notify_all();
+
+  for(std::size_t i = 0; i < m_workers.size(); ++i)
+  {
+    m_workers[i].join();
+  }
+}
+
+
+std::size_t thread_pool::size() const
+{
+  return m_workers.size() + 1;
+}
+
+
+bool &thread_pool::inside_parallel_for()
+{
+  static thread_local bool result = false;
+  return result;
+}
+
+
+void thread_pool::run(std::size_t num_tasks, task_function f, void *context)
+{
+  const std::size_t num_threads = size();
+
+  // the ranges of a finished job are reused, so that a call allocates
+  // nothing once the pool has served as many concurrent calls before
+  std::unique_ptr<task_range[]> ranges;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(!m_free_ranges.empty())
+    {
+      ranges = std::move(m_free_ranges.back());
+      m_free_ranges.pop_back();
+    }
+  }
+
+  if(!ranges)
+  {
+    ranges.reset(new task_range[num_threads]);
+  }
+
+  // no worker touches the ranges before the job is published
+  for(std::size_t i = 0; i < num_threads; ++i)
+  {
+    ranges[i].begin = (num_tasks * i) / num_threads;
+    ranges[i].end   = (num_tasks * (i + 1)) / num_threads;
+  }
+
+  job j;
+  j.function = f;
+  j.context  = context;
+  j.ranges   = ranges.get();
+  j.unclaimed.store(num_tasks);
+  j.pending.store(num_tasks);
+  j.active.store(0);
+  j.failed.store(false);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(&j);
+    ++m_num_jobs_started;
+  }
+
+  m_wake.notify_all();
+
+  work(j, 0);
+
+  // wait for the tasks stolen by the workers
+  while(j.pending.load() != 0)
+  {
+    std::this_thread::yield();
+  }
+
+  // retire the job, then wait for the workers still looking for tasks in it
+  // before its ranges may be reused
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for(std::size_t i = 0; i < m_jobs.size(); ++i)
+    {
+      if(m_jobs[i] == &j)
+      {
+        m_jobs.erase(m_jobs.begin() + i);
+        break;
+      }
+    }
+  }
+
+  while(j.active.load() != 0)
+  {
+    std::this_thread::yield();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free_ranges.push_back(std::move(ranges));
+  }
+
+  if(j.failed.load())
+  {
+    std::rethrow_exception(j.exception);
+  }
+}
+
+
+void thread_pool::submit(std::function<void()> &&task)
+{
+  if(m_workers.empty())
+  {
+    task();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_submitted.push_back(std::move(task));
+    ++m_num_submitted;
+  }
+
+  m_wake.notify_one();
+}
+
+
+void thread_pool::fail(job &j, std::exception_ptr e)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // only the first exception is reported
+  if(!j.failed.load())
+  {
+    j.exception = e;
+    j.failed.store(true);
+  }
+}
+
+
+void thread_pool::work(job &j, std::size_t id)
+{
+  std::size_t task;
+
+  while(pop(j, id, task) || steal(j, id, task))
+  {
+    // a task taken just before another one threw is skipped
+    if(!j.failed.load(std::memory_order_relaxed))
+    {
+      try
+      {
+        j.function(j.context, task);
+      }
+      catch(...)
+      {
+        fail(j, std::current_exception());
+      }
+    }
+
+    j.pending.fetch_sub(1);
+  }
+}
+
+
+bool thread_pool::pop(job &j, std::size_t id, std::size_t &task)
+{
+  task_range &r = j.ranges[id];
+
+  std::lock_guard<std::mutex> lock(r.mutex);
+
+  if(r.begin == r.end)
+    return false;
+
+  // once a task has thrown, the rest of the range is dropped
+  if(j.failed.load(std::memory_order_relaxed))
+  {
+    j.unclaimed.fetch_sub(r.end - r.begin);
+    j.pending.fetch_sub(r.end - r.begin);
+    r.begin = r.end;
+    return false;
+  }
+
+  j.unclaimed.fetch_sub(1);
+  task = r.begin++;
+  return true;
+}
+
+
+bool thread_pool::steal(job &j, std::size_t id, std::size_t &task)
+{
+  const std::size_t num_threads = size();
+
+  for(std::size_t i = 1; i < num_threads; ++i)
+  {
+    task_range &victim = j.ranges[(id + i) % num_threads];
+
+    std::size_t begin, end;
+
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+
+      if(victim.begin == victim.end)
+        continue;
+
+      if(j.failed.load(std::memory_order_relaxed))
+      {
+        j.unclaimed.fetch_sub(victim.end - victim.begin);
+        j.pending.fetch_sub(victim.end - victim.begin);
+        victim.begin = victim.end;
+        continue;
+      }
+
+      // take the back half, rounding up so a single task can be stolen
+      begin = victim.begin + (victim.end - victim.begin) / 2;
+      end   = victim.end;
+
+      victim.end = begin;
+    }
+
+    // run the first stolen task now and expose the rest to other thieves
+    task_range &mine = j.ranges[id];
+
+    {
+      std::lock_guard<std::mutex> lock(mine.mutex);
+      mine.begin = begin + 1;
+      mine.end   = end;
+    }
+
+    j.unclaimed.fetch_sub(1);
+    task = begin;
+    return true;
+  }
+
+  return false;
+}
+
+
+thread_pool::job *thread_pool::find_job(std::size_t id) const
+{
+  // the workers start their search at different jobs, so that concurrent
+  // calls get a share of the workers each
+  for(std::size_t i = 0; i < m_jobs.size(); ++i)
+  {
+    job *j = m_jobs[(id + i) % m_jobs.size()];
+
+    if(j->unclaimed.load() != 0)
+      return j;
+  }
+
+  return 0;
+}
+
+
+void thread_pool::worker_loop(std::size_t id)
+{
+  bool &nested = inside_parallel_for();
+  nested = true;
+
+  for(;;)
+  {
+    job *j = 0;
+    std::function<void()> task;
+    std::size_t seen;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      // the jobs in progress go before the submitted tasks, and the tasks
+      // submitted before the pool's destruction still run
+      j = find_job(id);
+
+      if(j != 0)
+      {
+        ++j->active;
+      }
+      else if(!m_submitted.empty())
+      {
+        task = std::move(m_submitted.front());
+        m_submitted.pop_front();
+        --m_num_submitted;
+      }
+      else if(m_stop)
+      {
+        return;
+      }
+
+      seen = m_num_jobs_started.load();
+    }
+
+    if(j != 0)
+    {
+      work(*j, id);
+
+      // the job may be destroyed as soon as it has no active workers
+      --j->active;
+    }
+    else if(task)
+    {
+      // the task may call parallel_for as the pool's thread 0
+      nested = false;
+      task();
+      nested = true;
+    }
+    else
+    {
+      // poll for about as long as it takes to wake a sleeping thread, so an
+      // idle worker costs no more than a few microseconds of a core after
+      // each call
+      const std::chrono::steady_clock::time_point spin_end = std::chrono::steady_clock::now() + spin_duration();
+
+      while(m_num_jobs_started.load(std::memory_order_relaxed) == seen &&
+            m_num_submitted.load(std::memory_order_relaxed) == 0 &&
+            std::chrono::steady_clock::now() < spin_end)
+      {
+        std::this_thread::yield();
+      }
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      while(!m_stop && m_submitted.empty() && find_job(id) == 0)
+      {
+        m_wake.wait(lock);
+      }
+    }
+  }
+}
+
+
+} // end namespace detail
+} // end namespace threads
+} // end namespace system
+THRUST_NAMESPACE_END
+
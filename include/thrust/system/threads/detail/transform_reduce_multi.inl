@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/detail/transform_reduce_multi.h>
+#include <thrust/system/threads/detail/default_decomposition.h>
+#include <thrust/system/threads/detail/thread_pool.h>
+#include <thrust/system/detail/generic/transform_reduce_multi.h>
+#include <thrust/system/detail/internal/transform_reduce_multi.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+namespace detail
+{
+namespace transform_reduce_multi_detail
+{
+
+
+template<typename RandomAccessIterator,
+         typename Decomposition,
+         typename Transform>
+struct tile_body
+{
+  typedef typename Transform::result_type result_type;
+
+  RandomAccessIterator first;
+  result_type *partials;
+  Decomposition decomp;
+  Transform transform;
+
+  tile_body(RandomAccessIterator first, result_type *partials, Decomposition decomp, Transform transform)
+    : first(first), partials(partials), decomp(decomp), transform(transform)
+  {}
+
+  void operator()(std::size_t i) const
+  {
+    partials[i] = thrust::system::detail::internal::multi_reduce_n(first + decomp[i].begin(), decomp[i].size(), transform);
+  }
+};
+
+
+// every tile reduces its elements into private results, which are combined
+// in tile order at the end
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(execution_policy<DerivedPolicy> &exec,
+           InputIterator first,
+           InputIterator last,
+           thrust::detail::true_type,
+           Reductions... reductions)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::tuple<typename Reductions::value_type...>          result_type;
+  typedef thrust::system::detail::internal::uniform_decomposition<difference_type> Decomposition;
+
+  thrust::tuple<Reductions...> reductions_tuple(reductions...);
+
+  thrust::system::detail::internal::multi_transform<Reductions...> transform(reductions_tuple);
+  thrust::system::detail::internal::multi_combine<Reductions...>   combine(reductions_tuple);
+
+  result_type result = thrust::system::detail::internal::multi_init(reductions...);
+
+  const difference_type n = last - first;
+
+  if(n == 0) return result;
+
+  const Decomposition decomp = thrust::system::threads::detail::default_decomposition(n);
+
+  const difference_type num_tiles = decomp.size();
+
+  if(num_tiles <= 1)
+  {
+    // don't bother parallelizing for small n
+    return combine(result, thrust::system::detail::internal::multi_reduce_n(first, n, transform));
+  }
+
+  thrust::detail::temporary_array<result_type,DerivedPolicy> partials(exec, num_tiles);
+
+  result_type *partials_ptr = thrust::raw_pointer_cast(partials.data());
+
+  thread_pool::instance().parallel_for(num_tiles,
+    tile_body<InputIterator,Decomposition,thrust::system::detail::internal::multi_transform<Reductions...> >(first, partials_ptr, decomp, transform));
+
+  for(difference_type t = 0; t < num_tiles; ++t)
+  {
+    result = combine(result, partials_ptr[t]);
+  }
+
+  return result;
+} // end reduce()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    reduce(execution_policy<DerivedPolicy> &exec,
+           InputIterator first,
+           InputIterator last,
+           thrust::detail::false_type,
+           Reductions... reductions)
+{
+  // other ranges take a single reduction of tuples
+  return thrust::system::detail::generic::transform_reduce_multi(exec, first, last, reductions...);
+} // end reduce()
+
+
+} // end transform_reduce_multi_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(execution_policy<DerivedPolicy> &exec,
+                           InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions)
+{
+  return transform_reduce_multi_detail::reduce(exec, first, last, thrust::is_contiguous_iterator<InputIterator>(), reductions...);
+} // end transform_reduce_multi()
+
+
+} // end detail
+} // end threads
+} // end system
+THRUST_NAMESPACE_END
+
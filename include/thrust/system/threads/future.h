@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thrust/system/threads/future.h
+ *  \brief \p thrust::future and \p thrust::event for the threads system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp14_required.h>
+
+#if THRUST_CPP_DIALECT >= 2014
+
+// this system inherits its events and futures from the cpp system
+#include <thrust/system/cpp/future.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace threads
+{
+
+using thrust::system::cpp::ready_event;
+
+using thrust::system::cpp::ready_future;
+
+using thrust::system::cpp::unique_eager_event;
+
+using thrust::system::cpp::unique_eager_future;
+
+using thrust::system::cpp::when_all;
+
+}} // namespace system::threads
+
+namespace threads
+{
+
+using thrust::system::threads::ready_event;
+
+using thrust::system::threads::ready_future;
+
+using thrust::system::threads::unique_eager_event;
+using event = unique_eager_event;
+
+using thrust::system::threads::unique_eager_future;
+template <typename T> using future = unique_eager_future<T>;
+
+using thrust::system::threads::when_all;
+
+} // namespace threads
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
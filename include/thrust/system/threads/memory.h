@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2008-2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thrust/system/threads/memory.h
+ *  \brief Managing memory associated with Thrust's threads system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/memory_resource.h>
+#include <thrust/memory.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/mr/allocator.h>
+#include <ostream>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace threads
+{
+
+/*! Allocates an area of memory available to Thrust's <tt>threads</tt> system.
+ *  \param n Number of bytes to allocate.
+ *  \return A <tt>threads::pointer<void></tt> pointing to the beginning of the newly
+ *          allocated memory. A null <tt>threads::pointer<void></tt> is returned if
+ *          an error occurs.
+ *  \note The <tt>threads::pointer<void></tt> returned by this function must be
+ *        deallocated with \p threads::free.
+ *  \see threads::free
+ *  \see std::malloc
+ */
+inline pointer<void> malloc(std::size_t n);
+
+/*! Allocates a typed area of memory available to Thrust's <tt>threads</tt> system.
+ *  \param n Number of elements to allocate.
+ *  \return A <tt>threads::pointer<T></tt> pointing to the beginning of the newly
+ *          allocated memory. A null <tt>threads::pointer<T></tt> is returned if
+ *          an error occurs.
+ *  \note The <tt>threads::pointer<T></tt> returned by this function must be
+ *        deallocated with \p threads::free.
+ *  \see threads::free
+ *  \see std::malloc
+ */
+template<typename T>
+inline pointer<T> malloc(std::size_t n);
+
+/*! Deallocates an area of memory previously allocated by <tt>threads::malloc</tt>.
+ *  \param ptr A <tt>threads::pointer<void></tt> pointing to the beginning of an area
+ *         of memory previously allocated with <tt>threads::malloc</tt>.
+ *  \see threads::malloc
+ *  \see std::free
+ */
+inline void free(pointer<void> ptr);
+
+/*! \p threads::allocator is the default allocator used by the \p threads system's
+ *  containers such as <tt>threads::vector</tt> if no user-specified allocator is
+ *  provided. \p threads::allocator allocates (deallocates) storage with \p
+ *  threads::malloc (\p threads::free).
+ */
+template<typename T>
+using allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::threads::memory_resource
+>;
+
+/*! \p threads::universal_allocator allocates memory that can be used by the \p threads
+ *  system and host systems.
+ */
+template<typename T>
+using universal_allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::threads::universal_memory_resource
+>;
+
+/*! \p threads::first_touch_allocator allocates memory for the \p threads system
+ *  from \p threads::first_touch_memory_resource. Containers using it, such as
+ *  <tt>host_vector<T, threads::first_touch_allocator<T> ></tt>, have their pages
+ *  placed on the NUMA nodes of the threads which later work on them, and
+ *  construct their elements in parallel on the \p threads system.
+ */
+template<typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<
+  T, thrust::system::threads::first_touch_memory_resource
+>;
+
+}} // namespace system::threads
+
+/*! \namespace thrust::threads
+ *  \brief \p thrust::threads is a top-level alias for thrust::system::threads.
+ */
+namespace threads
+{
+using thrust::system::threads::malloc;
+using thrust::system::threads::free;
+using thrust::system::threads::allocator;
+using thrust::system::threads::universal_allocator;
+using thrust::system::threads::first_touch_allocator;
+} // namsespace threads
+
+THRUST_NAMESPACE_END
+
+#include <thrust/system/threads/detail/memory.inl>
@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thrust/system/threads/vector.h
+ *  \brief A dynamically-sizable array of elements which reside in memory available to
+ *         Thrust's threads system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/threads/memory.h>
+#include <thrust/detail/vector_base.h>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace system { namespace threads
+{
+
+/*! \p threads::vector is a container that supports random access to elements,
+ *  constant time removal of elements at the end, and linear time insertion
+ *  and removal of elements at the beginning or in the middle. The number of
+ *  elements in a \p threads::vector may vary dynamically; memory management is
+ *  automatic. The elements contained in a \p threads::vector reside in memory
+ *  accessible by the \p threads system.
+ *
+ *  \tparam T The element type of the \p threads::vector.
+ *  \tparam Allocator The allocator type of the \p threads::vector.
+ *          Defaults to \p threads::allocator.
+ *
+ *  \see https://en.cppreference.com/w/cpp/container/vector
+ *  \see host_vector For the documentation of the complete interface which is
+ *                   shared by \p threads::vector.
+ *  \see device_vector
+ *  \see universal_vector
+ */
+template <typename T, typename Allocator = thrust::system::threads::allocator<T>>
+using vector = thrust::detail::vector_base<T, Allocator>;
+
+/*! \p threads::universal_vector is a container that supports random access to
+ *  elements, constant time removal of elements at the end, and linear time
+ *  insertion and removal of elements at the beginning or in the middle. The
+ *  number of elements in a \p threads::universal_vector may vary dynamically;
+ *  memory management is automatic. The elements contained in a
+ *  \p threads::universal_vector reside in memory accessible by the \p threads system
+ *  and host systems.
+ *
+ *  \tparam T The element type of the \p threads::universal_vector.
+ *  \tparam Allocator The allocator type of the \p threads::universal_vector.
+ *          Defaults to \p threads::universal_allocator.
+ *
+ *  \see https://en.cppreference.com/w/cpp/container/vector
+ *  \see host_vector For the documentation of the complete interface which is
+ *                   shared by \p threads::universal_vector
+ *  \see device_vector
+ *  \see universal_vector
+ */
+template <typename T, typename Allocator = thrust::system::threads::universal_allocator<T>>
+using universal_vector = thrust::detail::vector_base<T, Allocator>;
+
+}} // namespace system::threads
+
+namespace threads
+{
+using thrust::system::threads::vector;
+using thrust::system::threads::universal_vector;
+}
+
+THRUST_NAMESPACE_END
@@ -0,0 +1,184 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file thrust/trace.h
+ *  \brief Opt-in reporting of where time and temporary storage go inside
+ *         Thrust's algorithms.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#include <chrono>
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup utility
+ *  \{
+ */
+
+/*! \namespace thrust::trace
+ *  \brief Hooks which report the algorithms run by Thrust's CPU systems, and
+ *         the phases they run in, to a user callback.
+ *
+ *  Tracing is compiled in only when \c THRUST_ENABLE_TRACE is defined before
+ *  any Thrust header is included, consistently across translation units.
+ *  Otherwise the hooks inside the algorithms expand to nothing and
+ *  \p set_callback has no effect.
+ *
+ *  These algorithms report an event, with the phases listed for each system:
+ *
+ *  - \c stable_sort and \c stable_sort_by_key, which \c sort and
+ *    \c sort_by_key call, on the omp, tbb and threads systems: \c "radix pass"
+ *    for each pass over primitive keys, or \c "tile sort" and one \c "merge"
+ *    per merge level for other keys.
+ *  - \c reduce on the omp and threads systems: \c "reduce intervals". On the
+ *    tbb system, without phases.
+ *  - \c inclusive_scan and \c exclusive_scan on the omp and threads systems:
+ *    \c "reduce tiles" and \c "scan tiles". On the tbb system, without
+ *    phases.
+ *
+ *  An input too small to be split reports the algorithm without its phases.
+ *  Other algorithms report nothing of their own; the temporary storage they
+ *  allocate is charged to the event of an algorithm which calls them.
+ *
+ *  The following code snippet records the events of a sort as complete
+ *  ("X") events of the Chrome trace format:
+ *
+ *  \code
+ *  #define THRUST_ENABLE_TRACE
+ *  #include <thrust/trace.h>
+ *  #include <thrust/sort.h>
+ *  #include <thrust/system/omp/execution_policy.h>
+ *  #include <cstdio>
+ *
+ *  void print_event(const thrust::trace::event &e, void *)
+ *  {
+ *    using namespace std::chrono;
+ *
+ *    std::printf("{\"name\": \"%s%s%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %lld, \"dur\": %lld, "
+ *                "\"pid\": 0, \"tid\": 0, \"args\": {\"n\": %zu, \"temporary_bytes\": %zu}},\n",
+ *                e.algorithm, e.phase ? ": " : "", e.phase ? e.phase : "", e.system,
+ *                (long long) duration_cast<microseconds>(e.begin.time_since_epoch()).count(),
+ *                (long long) duration_cast<microseconds>(e.end - e.begin).count(),
+ *                e.num_elements, e.temporary_bytes);
+ *  }
+ *
+ *  ...
+ *  thrust::trace::set_callback(print_event);
+ *  thrust::stable_sort(thrust::omp::par, keys.begin(), keys.end());
+ *  \endcode
+ */
+namespace trace
+{
+
+
+/*! \p event describes an algorithm invocation, or one phase of it, which has
+ *  just completed.
+ */
+struct event
+{
+  /*! The name of the algorithm, e.g. \c "stable_sort". */
+  const char *algorithm;
+
+  /*! The name of the phase, e.g. \c "merge", or null for the whole
+   *  invocation. */
+  const char *phase;
+
+  /*! The name of the system which ran the algorithm, e.g. \c "omp". */
+  const char *system;
+
+  /*! The number of elements the algorithm was invoked on. */
+  std::size_t num_elements;
+
+  /*! The number of bytes of temporary storage the algorithm allocated through
+   *  its execution policy while the event was open, including in the events
+   *  nested in it. Storage allocated by the sequential algorithms it runs on
+   *  its tiles, or on an input too small to split, is not counted, so the
+   *  count doesn't depend on how the tiles were scheduled. */
+  std::size_t temporary_bytes;
+
+  /*! The nesting depth of the event among the events open on the same
+   *  thread; an invocation of an algorithm by the user has depth 0. */
+  int depth;
+
+  /*! When the event was opened. */
+  std::chrono::steady_clock::time_point begin;
+
+  /*! When the event was closed. */
+  std::chrono::steady_clock::time_point end;
+};
+
+
+/*! The type of the user callback, which receives each \p event along with the
+ *  \c user_data given to \p set_callback.
+ */
+typedef void (*callback_type)(const event &e, void *user_data);
+
+
+/*! Installs the callback which receives the events.
+ *
+ *  The callback is invoked on the thread which invoked the algorithm, when an
+ *  event closes, so nested events are reported before the events containing
+ *  them. It must not be changed while algorithms are running.
+ *
+ *  \param callback The callback, or null to stop reporting events.
+ *  \param user_data A pointer passed to every invocation of \p callback.
+ */
+inline void set_callback(callback_type callback, void *user_data = 0);
+
+
+/*! \cond
+ */
+namespace detail
+{
+
+struct callback_state
+{
+  callback_type callback;
+  void *user_data;
+};
+
+inline callback_state &get_callback_state()
+{
+  static callback_state state = {0, 0};
+  return state;
+}
+
+} // end detail
+/*! \endcond
+ */
+
+
+inline void set_callback(callback_type callback, void *user_data)
+{
+  detail::callback_state &state = detail::get_callback_state();
+
+  state.callback  = callback;
+  state.user_data = user_data;
+}
+
+
+} // end trace
+
+/*! \} // utility
+ */
+
+THRUST_NAMESPACE_END
+
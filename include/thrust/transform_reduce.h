@@ -99,6 +99,7 @@ THRUST_NAMESPACE_BEGIN
  *
  *  \see \c transform
  *  \see \c reduce
+ *  \see \ref reductions
  */
 template<typename DerivedPolicy,
          typename InputIterator, 
@@ -173,6 +174,7 @@ __host__ __device__
  *
  *  \see \c transform
  *  \see \c reduce
+ *  \see \ref reductions
  */
 template<typename InputIterator, 
          typename UnaryFunction, 
@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file transform_reduce_multi.h
+ *  \brief Several fused transform / reductions of one sequence in a single pass
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/detail/execution_policy.h>
+#include <thrust/tuple.h>
+
+THRUST_NAMESPACE_BEGIN
+
+/*! \addtogroup reductions
+ *  \{
+ *  \addtogroup transformed_reductions Transformed Reductions
+ *  \ingroup reductions
+ *  \{
+ */
+
+
+/*! \p reduction describes one of the reductions computed by
+ *  \p transform_reduce_multi: the \p unary_op applied to each element, the
+ *  initial value \p init and the \p binary_op which combines the results, just
+ *  as they are passed to \p transform_reduce.
+ *
+ *  \tparam UnaryFunction is a model of <a href="https://en.cppreference.com/w/cpp/utility/functional/unary_function">Unary Function</a>,
+ *          and \p UnaryFunction's \c result_type is convertible to \c T.
+ *  \tparam T is a model of <a href="https://en.cppreference.com/w/cpp/named_req/CopyAssignable">Assignable</a>.
+ *  \tparam BinaryFunction is a model of <a href="https://en.cppreference.com/w/cpp/utility/functional/binary_function">Binary Function</a>,
+ *          and \p BinaryFunction's \c result_type is convertible to \c T.
+ *
+ *  \see make_reduction
+ *  \see transform_reduce_multi
+ */
+template<typename UnaryFunction, typename T, typename BinaryFunction>
+  struct reduction
+{
+  /*! The type of the result of the reduction.
+   */
+  typedef T value_type;
+
+  /*! The function applied to each element.
+   */
+  UnaryFunction unary_op;
+
+  /*! The initial value of the reduction.
+   */
+  T init;
+
+  /*! The function combining the results.
+   */
+  BinaryFunction binary_op;
+
+  /*! This constructor creates a \p reduction from its three parts.
+   */
+  __host__ __device__
+  reduction(UnaryFunction unary_op, T init, BinaryFunction binary_op)
+    : unary_op(unary_op), init(init), binary_op(binary_op)
+  {}
+};
+
+
+/*! \p make_reduction creates a \p reduction, deducing its types.
+ *
+ *  \param unary_op The function applied to each element.
+ *  \param init The initial value of the reduction.
+ *  \param binary_op The function combining the results.
+ *  \return A \p reduction of the three.
+ *
+ *  \see reduction
+ */
+template<typename UnaryFunction, typename T, typename BinaryFunction>
+__host__ __device__
+  reduction<UnaryFunction,T,BinaryFunction> make_reduction(UnaryFunction unary_op, T init, BinaryFunction binary_op)
+{
+  return reduction<UnaryFunction,T,BinaryFunction>(unary_op, init, binary_op);
+}
+
+
+/*! \p transform_reduce_multi computes several \p transform_reduce results of
+ *  the sequence <tt>[first, last)</tt> in a single pass over it. The result
+ *  for each \p reduction \c r is that of
+ *  <tt>transform_reduce(exec, first, last, r.unary_op, r.init, r.binary_op)</tt>;
+ *  the reductions are independent, and each starts from its own \c init.
+ *
+ *  On the \p omp, \p tbb and \p threads systems, contiguous sequences are
+ *  read in tiles small enough to stay in cache while every reduction reads
+ *  them in turn, so the sequence is read from memory once and each reduction
+ *  still runs in its own vectorizable loop. Sequential execution policies
+ *  and the \p cpp system feed each element to every reduction in order.
+ *  Elsewhere the reductions are combined into a single reduction of tuples.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param reductions The reductions to compute, at most nine.
+ *  \return A \p tuple of the results of \p reductions, in order.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/input_iterator">Input Iterator</a>,
+ *          and \c InputIterator's \c value_type is convertible to the argument type of every \c unary_op.
+ *  \tparam Reductions are specializations of \p reduction.
+ *
+ *  The following code snippet demonstrates how to use \p transform_reduce_multi
+ *  to compute descriptive statistics of a sequence in one pass using the
+ *  \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/transform_reduce_multi.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/execution_policy.h>
+ *
+ *  struct square
+ *  {
+ *    __host__ __device__
+ *    float operator()(float x) const { return x * x; }
+ *  };
+ *
+ *  struct is_positive
+ *  {
+ *    __host__ __device__
+ *    int operator()(float x) const { return x > 0; }
+ *  };
+ *  ...
+ *  float data[6] = {1, 0, -2, 3, 2, 1};
+ *
+ *  thrust::tuple<float,float,float,int,float> stats =
+ *    thrust::transform_reduce_multi(thrust::host, data, data + 6,
+ *                                   thrust::make_reduction(thrust::identity<float>(), 0.0f, thrust::plus<float>()),
+ *                                   thrust::make_reduction(thrust::identity<float>(), data[0], thrust::minimum<float>()),
+ *                                   thrust::make_reduction(thrust::identity<float>(), data[0], thrust::maximum<float>()),
+ *                                   thrust::make_reduction(is_positive(), 0, thrust::plus<int>()),
+ *                                   thrust::make_reduction(square(), 0.0f, thrust::plus<float>()));
+ *
+ *  // stats is now (5, -2, 3, 4, 19)
+ *  \endcode
+ *
+ *  \see reduction
+ *  \see transform_reduce
+ */
+template<typename DerivedPolicy, typename InputIterator, typename... Reductions>
+__host__ __device__
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                           InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions);
+
+
+/*! \p transform_reduce_multi computes several \p transform_reduce results of
+ *  the sequence <tt>[first, last)</tt> in a single pass over it. The result
+ *  for each \p reduction \c r is that of
+ *  <tt>transform_reduce(first, last, r.unary_op, r.init, r.binary_op)</tt>;
+ *  the reductions are independent, and each starts from its own \c init.
+ *
+ *  \param first The beginning of the sequence.
+ *  \param last The end of the sequence.
+ *  \param reductions The reductions to compute, at most nine.
+ *  \return A \p tuple of the results of \p reductions, in order.
+ *
+ *  \tparam InputIterator is a model of <a href="https://en.cppreference.com/w/cpp/iterator/input_iterator">Input Iterator</a>,
+ *          and \c InputIterator's \c value_type is convertible to the argument type of every \c unary_op.
+ *  \tparam Reductions are specializations of \p reduction.
+ *
+ *  The following code snippet demonstrates how to use \p transform_reduce_multi
+ *  to compute the mean and the variance of a sequence in one pass.
+ *
+ *  \code
+ *  #include <thrust/transform_reduce_multi.h>
+ *  #include <thrust/functional.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<double> x = ...;
+ *
+ *  thrust::tuple<double,double> sums =
+ *    thrust::transform_reduce_multi(x.begin(), x.end(),
+ *                                   thrust::make_reduction(thrust::identity<double>(), 0.0, thrust::plus<double>()),
+ *                                   thrust::make_reduction(square(), 0.0, thrust::plus<double>()));
+ *
+ *  double mean     = thrust::get<0>(sums) / x.size();
+ *  double variance = thrust::get<1>(sums) / x.size() - mean * mean;
+ *  \endcode
+ *
+ *  \see reduction
+ *  \see transform_reduce
+ */
+template<typename InputIterator, typename... Reductions>
+  thrust::tuple<typename Reductions::value_type...>
+    transform_reduce_multi(InputIterator first,
+                           InputIterator last,
+                           Reductions... reductions);
+
+
+/*! \} // end transformed_reductions
+ *  \} // end reductions
+ */
+
+THRUST_NAMESPACE_END
+
+#include <thrust/detail/transform_reduce_multi.inl>
+
+#endif